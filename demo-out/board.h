@@ -75,52 +75,95 @@
 // }}}
 
 
-#define	SYSPIC(A)	(1<<(A))
 
 
-#define	ALTPIC(A)	(1<<(A))
+typedef	struct	DDR3_PHY_S {
+	unsigned	ph_something;
+} DDR3_PHY;
 
 
-	////////////////////////////////////////////////////////////////////////
-	//
-	// I2C CPU data structures
-	// {{{
-	////////////////////////////////////////////////////////////////////////
-	//
-	//
-#ifndef	I2CCPU_H
-#define	I2CCPU_H
 
-#define	I2CC_WAITING	0x00800000	// True if waiting for synch signal
-#define	I2CC_HALT	0x00400000	// Halt request
-#define	I2CC_ABORT	0x00200000	// Abort
-#define	I2CC_ERROR	0x00100000
-#define	I2CC_HARDHALT	0x00080000
-#define	I2CC_SCL	0x00000200
-#define	I2CC_SDA	0x00000100
-#define I2CC_STOPPED	I2CC_HARDHALT
-#define I2CC_FAULT	(I2CC_ERROR | I2CC_ABORT)
-#define I2CC_CLEAR	(I2CC_FAULT | I2CC_HALT)
+#ifndef	WBSCOPE_H
+#define	WBSCOPE_H
 
-// For the manual port
-#define	I2CC_MANSCL	0x00008000
-#define	I2CC_MANSDA	0x00004000
-#define	I2CC_MANUAL	0x00000800
-#define	I2CC_TVALID	0x00000200
-#define	I2CC_TLAST	0x00000100
+#define	WBSCOPE_NO_RESET	0x80000000u
+#define	WBSCOPE_STOPPED		0x40000000u
+#define	WBSCOPE_TRIGGERED	0x20000000u
+#define	WBSCOPE_PRIMED		0x10000000u
+#define	WBSCOPE_TRIGGER		(WBSCOPE_NO_RESET|0x08000000u)
+#define	WBSCOPE_MANUAL		(WBSCOPE_TRIGGER)
+#define	WBSCOPE_DISABLE		0x04000000u
 
-typedef	struct	I2CCPU_S {
-	volatile unsigned	ic_control,
-				ic_override,
-				ic_address,
-				ic_clkcount;
-} I2CCPU;
+typedef	struct	WBSCOPE_S {
+	volatile unsigned s_ctrl, s_data;
+} WBSCOPE;
+#endif
 
-#endif	// I2CCPU_H
-	// }}}
 
 
 
+//
+// GPIO input wires
+//
+#define	GPIO_HDMIRX_CEC		0x000010000
+#define	GPIO_HDMITX_CEC		0x000020000
+#define	GPIO_SD_DETECTED	0x000080000
+#define	GPIO_HDMITX_DETECT	0x000100000
+#define	GPIO_GPS_3DF		0x000200000
+#define	GPIO_SYSCLK_LOCKED	0x000400000
+#define	GPIO_VIDCLK_LOCKED	0x000800000
+//
+// GPIO output wires
+//
+#define	GPIO_SET(WIRE)	(((WIRE)<<16)|(WIRE))
+#define	GPIO_CLR(WIRE)	 ((WIRE)<<16)
+//
+#define	GPIO_HDMIRX_CEC_SET	0x000010001
+#define	GPIO_HDMIRX_CEC_CLR	0x000010000
+#define	GPIO_HDMITX_CEC_SET	0x000020002
+#define	GPIO_HDMITX_CEC_CLR	0x000020000
+//
+#define	GPIO_HDMIRX_TXEN	0x000000004
+#define	GPIO_HDMIRX_HPA		0x000000008
+#define	GPIO_SD_RESET		0x000000010
+#define	GPIO_OLED_RESET		0x000000020
+#define	GPIO_OLED_PANELEN	0x000000040
+#define	GPIO_OLED_LOGICEN	0x000000080
+#define	GPIO_TRACE		0x000000100
+#define	GPIO_TESTHALT		0x000000200
+//
+#define	GPIO_EDID_SCL_SET	GPIO_SET(GPIO_EDID_SCL)
+#define	GPIO_EDID_SCL_CLR	GPIO_CLR(GPIO_EDID_SCL)
+#define	GPIO_EDID_SDA_SET	GPIO_SET(GPIO_EDID_SDA)
+#define	GPIO_EDID_SDA_CLR	GPIO_CLR(GPIO_EDID_SDA)
+#define	GPIO_HDMIRX_HPA_SET	GPIO_SET(GPIO_HDMIRX_HPA)
+#define	GPIO_HDMIRX_HPA_CLR	GPIO_CLR(GPIO_HDMIRX_HPA)
+#define	GPIO_SD_RESET_SET	GPIO_SET(GPIO_SD_RESET)
+#define	GPIO_SD_RESET_CLR	GPIO_CLR(GPIO_SD_RESET)
+#define	GPIO_HDMIRX_TXEN_SET	GPIO_SET(GPIO_HDMIRX_TXEN)
+#define	GPIO_HDMIRX_TXEN_CLR	GPIO_CLR(GPIO_HDMIRX_TXEN)
+#define	OLED_RESET		GPIO_SET(GPIO_OLED_RESET)
+#define	OLED_RUN		GPIO_CLR(GPIO_OLED_RESET)
+#define	OLED_PANELEN		GPIO_SET(GPIO_OLED_PANELEN)
+#define	OLED_PANELDIS		GPIO_CLR(GPIO_OLED_PANELEN)
+#define	OLED_LOGICEN		GPIO_SET(GPIO_OLED_LOGICEN)
+#define	OLED_LOGICDIS		GPIO_CLR(GPIO_OLED_LOGICEN)
+#define	GPIO_TRACE_SET		GPIO_SET(GPIO_TRACE)
+#define	GPIO_TRACE_CLR		GPIO_CLR(GPIO_TRACE)
+#define	GPIO_HALT_SET		GPIO_SET(GPIO_TESTHALT)
+#define	GPIO_HALT_CLR		GPIO_CLR(GPIO_TESTHALT)
+
+
+typedef	struct	GPSTRACKER_S	{
+	unsigned	g_alpha, g_beta, g_gamma, g_step;
+} GPSTRACKER;
+
+
+typedef	struct	GPSTB_S	{
+	unsigned	tb_maxcount, tb_jump;
+	unsigned long	tb_err, tb_count, tb_step;
+} GPSTB;
+
 
 #ifndef	WBUART_H
 #define	WBUART_H
@@ -203,21 +246,61 @@ typedef struct __attribute__((packed)) VIDPIPE_S {
 #endif // VIDPIPE_H
 
 
-#ifndef	WBSCOPE_H
-#define	WBSCOPE_H
+	////////////////////////////////////////////////////////////////////////
+	//
+	// I2C CPU data structures
+	// {{{
+	////////////////////////////////////////////////////////////////////////
+	//
+	//
+#ifndef	I2CCPU_H
+#define	I2CCPU_H
 
-#define	WBSCOPE_NO_RESET	0x80000000u
-#define	WBSCOPE_STOPPED		0x40000000u
-#define	WBSCOPE_TRIGGERED	0x20000000u
-#define	WBSCOPE_PRIMED		0x10000000u
-#define	WBSCOPE_TRIGGER		(WBSCOPE_NO_RESET|0x08000000u)
-#define	WBSCOPE_MANUAL		(WBSCOPE_TRIGGER)
-#define	WBSCOPE_DISABLE		0x04000000u
+#define	I2CC_WAITING	0x00800000	// True if waiting for synch signal
+#define	I2CC_HALT	0x00400000	// Halt request
+#define	I2CC_ABORT	0x00200000	// Abort
+#define	I2CC_ERROR	0x00100000
+#define	I2CC_HARDHALT	0x00080000
+#define	I2CC_SCL	0x00000200
+#define	I2CC_SDA	0x00000100
+#define I2CC_STOPPED	I2CC_HARDHALT
+#define I2CC_FAULT	(I2CC_ERROR | I2CC_ABORT)
+#define I2CC_CLEAR	(I2CC_FAULT | I2CC_HALT)
 
-typedef	struct	WBSCOPE_S {
-	volatile unsigned s_ctrl, s_data;
-} WBSCOPE;
-#endif
+// For the manual port
+#define	I2CC_MANSCL	0x00008000
+#define	I2CC_MANSDA	0x00004000
+#define	I2CC_MANUAL	0x00000800
+#define	I2CC_TVALID	0x00000200
+#define	I2CC_TLAST	0x00000100
+
+typedef	struct	I2CCPU_S {
+	volatile unsigned	ic_control,
+				ic_override,
+				ic_address,
+				ic_clkcount;
+} I2CCPU;
+
+#endif	// I2CCPU_H
+	// }}}
+
+
+#ifndef	I2CDMA_H
+#define	I2CDMA_H
+	////////////////////////////////////////////////////////////////////////
+	//
+	// I2C DMA data structures
+	// {{{
+	////////////////////////////////////////////////////////////////////////
+	//
+	//
+
+typedef struct  I2CDMA_S        {
+	unsigned	id_control, id_current, id_base, id_memlen;
+} I2CDMA;
+
+#endif	// I2CDMA_H
+	// }}}
 
 
 // Offsets for the ICAPE2 interface
@@ -243,38 +326,6 @@ typedef	struct	WBSCOPE_S {
 #define	CFG_BSPI	31
 
 
-
-
-typedef	struct	DDR3_PHY_S {
-	unsigned	ph_something;
-} DDR3_PHY;
-
-
-
-#ifndef	I2CDMA_H
-#define	I2CDMA_H
-	////////////////////////////////////////////////////////////////////////
-	//
-	// I2C DMA data structures
-	// {{{
-	////////////////////////////////////////////////////////////////////////
-	//
-	//
-
-typedef struct  I2CDMA_S        {
-	unsigned	id_control, id_current, id_base, id_memlen;
-} I2CDMA;
-
-#endif	// I2CDMA_H
-	// }}}
-
-
-typedef	struct	GPSTB_S	{
-	unsigned	tb_maxcount, tb_jump;
-	unsigned long	tb_err, tb_count, tb_step;
-} GPSTB;
-
-
 // Network stream/packet interface
 // {{{
 #ifndef	ENETSTREAM_H
@@ -294,91 +345,6 @@ typedef struct ENETSTREAM_S {
 // }}}
 
 
-typedef	struct	RTCLIGHT_S	{
-	unsigned	r_clock, r_stopwatch, r_timer, r_alarm;
-} RTCLIGHT;
-
-
-#define	SPIO_BTNC	0x01000
-#define	SPIO_BTND	0x00800
-#define	SPIO_BTNL	0x00400
-#define	SPIO_BTNR	0x00200
-#define	SPIO_BTNU	0x00100
-
-
-//
-// GPIO input wires
-//
-#define	GPIO_HDMIRX_CEC		0x000010000
-#define	GPIO_HDMITX_CEC		0x000020000
-#define	GPIO_SD_DETECTED	0x000080000
-#define	GPIO_HDMITX_DETECT	0x000100000
-#define	GPIO_GPS_3DF		0x000200000
-#define	GPIO_SYSCLK_LOCKED	0x000400000
-#define	GPIO_VIDCLK_LOCKED	0x000800000
-//
-// GPIO output wires
-//
-#define	GPIO_SET(WIRE)	(((WIRE)<<16)|(WIRE))
-#define	GPIO_CLR(WIRE)	 ((WIRE)<<16)
-//
-#define	GPIO_HDMIRX_CEC_SET	0x000010001
-#define	GPIO_HDMIRX_CEC_CLR	0x000010000
-#define	GPIO_HDMITX_CEC_SET	0x000020002
-#define	GPIO_HDMITX_CEC_CLR	0x000020000
-//
-#define	GPIO_HDMIRX_TXEN	0x000000004
-#define	GPIO_HDMIRX_HPA		0x000000008
-#define	GPIO_SD_RESET		0x000000010
-#define	GPIO_OLED_RESET		0x000000020
-#define	GPIO_OLED_PANELEN	0x000000040
-#define	GPIO_OLED_LOGICEN	0x000000080
-#define	GPIO_TRACE		0x000000100
-#define	GPIO_TESTHALT		0x000000200
-//
-#define	GPIO_EDID_SCL_SET	GPIO_SET(GPIO_EDID_SCL)
-#define	GPIO_EDID_SCL_CLR	GPIO_CLR(GPIO_EDID_SCL)
-#define	GPIO_EDID_SDA_SET	GPIO_SET(GPIO_EDID_SDA)
-#define	GPIO_EDID_SDA_CLR	GPIO_CLR(GPIO_EDID_SDA)
-#define	GPIO_HDMIRX_HPA_SET	GPIO_SET(GPIO_HDMIRX_HPA)
-#define	GPIO_HDMIRX_HPA_CLR	GPIO_CLR(GPIO_HDMIRX_HPA)
-#define	GPIO_SD_RESET_SET	GPIO_SET(GPIO_SD_RESET)
-#define	GPIO_SD_RESET_CLR	GPIO_CLR(GPIO_SD_RESET)
-#define	GPIO_HDMIRX_TXEN_SET	GPIO_SET(GPIO_HDMIRX_TXEN)
-#define	GPIO_HDMIRX_TXEN_CLR	GPIO_CLR(GPIO_HDMIRX_TXEN)
-#define	OLED_RESET		GPIO_SET(GPIO_OLED_RESET)
-#define	OLED_RUN		GPIO_CLR(GPIO_OLED_RESET)
-#define	OLED_PANELEN		GPIO_SET(GPIO_OLED_PANELEN)
-#define	OLED_PANELDIS		GPIO_CLR(GPIO_OLED_PANELEN)
-#define	OLED_LOGICEN		GPIO_SET(GPIO_OLED_LOGICEN)
-#define	OLED_LOGICDIS		GPIO_CLR(GPIO_OLED_LOGICEN)
-#define	GPIO_TRACE_SET		GPIO_SET(GPIO_TRACE)
-#define	GPIO_TRACE_CLR		GPIO_CLR(GPIO_TRACE)
-#define	GPIO_HALT_SET		GPIO_SET(GPIO_TESTHALT)
-#define	GPIO_HALT_CLR		GPIO_CLR(GPIO_TESTHALT)
-
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// SDIO SD Card constants
-// {{{
-////////////////////////////////////////////////////////////////////////////////
-//
-//
-
-// These will be defined in sdiodrv.h for the SDIO controller
-struct SDIO_S;
-// }}}
-
-
-#define BUSPIC(X) (1<<X)
-
-
-typedef	struct	GPSTRACKER_S	{
-	unsigned	g_alpha, g_beta, g_gamma, g_step;
-} GPSTRACKER;
-
-
 //
 // The Ethernet MDIO interface
 //
@@ -420,6 +386,34 @@ typedef struct ENETMDIO_S {
 
 
 
+#define BUSPIC(X) (1<<X)
+
+
+typedef	struct	RTCLIGHT_S	{
+	unsigned	r_clock, r_stopwatch, r_timer, r_alarm;
+} RTCLIGHT;
+
+
+#define	SPIO_BTNC	0x01000
+#define	SPIO_BTND	0x00800
+#define	SPIO_BTNL	0x00400
+#define	SPIO_BTNR	0x00200
+#define	SPIO_BTNU	0x00100
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// SDIO SD Card constants
+// {{{
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+
+// These will be defined in sdiodrv.h for the SDIO controller
+struct SDIO_S;
+// }}}
+
+
 typedef	struct OLEDBW_S {
 	unsigned	o_cmd, o_override, o_addr, o_clk;
 } OLEDBW;
@@ -438,29 +432,60 @@ typedef struct  WBMIC_S {
 } WBMIC;
 
 
-#ifdef	FLASH_ACCESS
-#define	_BOARD_HAS_FLASH
-extern int _flash[1];
-#endif	// FLASH_ACCESS
-#ifdef	I2CCPU_ACCESS
-#define	_BOARD_HAS_I2CCPU
-static volatile I2CCPU *const _i2c=((I2CCPU *)0x08001420);
-#endif	// I2CCPU_ACCESS
+#define	SYSPIC(A)	(1<<(A))
+
+
+#define	ALTPIC(A)	(1<<(A))
+
+
+#ifdef	BKRAM_ACCESS
+#define	_BOARD_HAS_BKRAM
+extern char	_bkram[0x00100000];
+#endif	// BKRAM_ACCESS
 #define	_BOARD_HAS_BUSERR
 static volatile unsigned *const _buserr = ((unsigned *)0x08001488);
-#define	_BOARD_HAS_SUBSECONDS
-static volatile unsigned *const _subseconds = ((unsigned *)0x080014a4);
+#ifdef	RXETH0CK
+static volatile unsigned *const _rxeth0ck = ((unsigned *)0x0800149c);
+#endif	// RXETH0CK
+#ifdef	TXCLK
+static volatile unsigned *const _txclk = ((unsigned *)0x080014a8);
+#endif	// TXCLK
 #ifdef	ADCCLK
 static volatile unsigned *const _adcclk = ((unsigned *)0x08001480);
 #endif	// ADCCLK
-#ifdef	FLASHCFG_ACCESS
-#define	_BOARD_HAS_FLASHCFG
-static volatile unsigned * const _flashcfg = ((unsigned *)(0x08000400));
-#endif	// FLASHCFG_ACCESS
+#ifdef	SDRAM_ACCESS
+#define	_BOARD_HAS_SDRAM
+extern char	_ddr3[0x40000000];
+#endif	// SDRAM_ACCESS
+#ifdef	DDR3_PHY_ACCESS
+#define	_BOARD_HAS_DDR3_PHY
+static volatile DDR3_PHY *const _ddr3_phy = ((DDR3_PHY *)0x08001000);
+#endif	// DDR3_PHY_ACCESS
+#ifdef	EDIDSLVSCOPE_SCOPC
+#define	_BOARD_HAS_EDIDSLVSCOPE
+static volatile WBSCOPE *const _edidslvscope = ((WBSCOPE *)0x08000600);
+#endif	// EDIDSLVSCOPE_SCOPC
 #ifdef	EDID_ACCESS
 #define	_BOARD_HAS_EDID
 static volatile I2CCPU *const _edid = ((I2CCPU *)0x08001400);
 #endif	// EDID_ACCESS
+static volatile char *const _edidslv = ((char *)0x08001500);
+#ifdef	FLASHCFG_ACCESS
+#define	_BOARD_HAS_FLASHCFG
+static volatile unsigned * const _flashcfg = ((unsigned *)(0x08000400));
+#endif	// FLASHCFG_ACCESS
+#ifdef	FLASH_ACCESS
+#define	_BOARD_HAS_FLASH
+extern int _flash[1];
+#endif	// FLASH_ACCESS
+#ifdef	GPIO_ACCESS
+#define	_BOARD_HAS_GPIO
+static volatile unsigned *const _gpio = ((unsigned *)0x08001490);
+#endif	// GPIO_ACCESS
+#ifdef	GPSTRK_ACCESS
+static volatile GPSTRACKER *const _gps = ((GPSTRACKER *)0x08001410);
+#endif	// GPSTRK_ACCESS
+static volatile GPSTB *const _gpstb = ((GPSTB *)0x08001460);
 #ifdef	GPSUART_ACCESS
 #define	_BOARD_HAS_GPS_UART
 static volatile WBUART *const _gpsu = ((WBUART *)(0x08000a00));
@@ -469,47 +494,35 @@ static volatile WBUART *const _gpsu = ((WBUART *)(0x08000a00));
 #define	_BOARD_HAS_VIDPIPE
 static volatile VIDPIPE *const _hdmi = ((VIDPIPE *)0x08002000);
 #endif	// VIDPIPE_ACCESS
-static volatile char *const _edidslv = ((char *)0x08001500);
-#ifdef	EDIDSLVSCOPE_SCOPC
-#define	_BOARD_HAS_EDIDSLVSCOPE
-static volatile WBSCOPE *const _edidslvscope = ((WBSCOPE *)0x08000600);
-#endif	// EDIDSLVSCOPE_SCOPC
-#ifdef	CFG_ACCESS
-#define	_BOARD_HAS_ICAPETWO
-static volatile unsigned *const _icape = ((unsigned *)0x08000c00);
-#endif	// CFG_ACCESS
-#ifdef	TXCLK
-static volatile unsigned *const _txclk = ((unsigned *)0x080014a8);
-#endif	// TXCLK
-#ifdef	RXETH0CK
-static volatile unsigned *const _rxeth0ck = ((unsigned *)0x0800149c);
-#endif	// RXETH0CK
-#ifdef	BKRAM_ACCESS
-#define	_BOARD_HAS_BKRAM
-extern char	_bkram[0x00100000];
-#endif	// BKRAM_ACCESS
-#ifdef	SDRAM_ACCESS
-#define	_BOARD_HAS_SDRAM
-extern char	_ddr3[0x40000000];
-#endif	// SDRAM_ACCESS
-#ifdef	DDR3_PHY_ACCESS
-#define	_BOARD_HAS_DDR3_PHY
-static volatile DDR3_PHY *const _ddr3_phy = ((DDR3_PHY *)0x08001000);
-#endif	// DDR3_PHY_ACCESS
+#define	_BOARD_HAS_PXPLL
+static volatile unsigned *const _pxclk=((unsigned *)0x08001200);
+#ifdef	I2CCPU_ACCESS
+#define	_BOARD_HAS_I2CCPU
+static volatile I2CCPU *const _i2c=((I2CCPU *)0x08001420);
+#endif	// I2CCPU_ACCESS
 #ifdef	I2CDMA_ACCESS
 #define	_BOARD_HAS_I2CDMA
 static volatile I2CDMA *const _i2cdma=((I2CDMA *)0x08001430);
 #endif	// I2CDMA_ACCESS
-#ifdef	PWRCOUNT_ACCESS
-static volatile unsigned *const _pwrcount = ((unsigned *)0x08001494);
-#endif	// PWRCOUNT_ACCESS
-static volatile GPSTB *const _gpstb = ((GPSTB *)0x08001460);
-#define	_BOARD_HAS_PXPLL
-static volatile unsigned *const _pxclk=((unsigned *)0x08001200);
+#ifdef	CFG_ACCESS
+#define	_BOARD_HAS_ICAPETWO
+static volatile unsigned *const _icape = ((unsigned *)0x08000c00);
+#endif	// CFG_ACCESS
 #ifdef	MEGANET_ACCESS
 #define	_BOARD_HAS_MEGANET
 static volatile ENETSTREAM *const _net = ((ENETSTREAM *)0x08000e00);
 #endif	// MEGANET_ACCESS
+#ifdef	NETCTRL_ACCESS
+#define	_BOARD_HAS_NETMDIO
+static volatile ENETMDIO *const _mdio = ((ENETMDIO *)0x08003000);
+#endif	// NETCTRL_ACCESS
+#ifdef	BUSPIC_ACCESS
+#define	_BOARD_HAS_BUSPIC
+static volatile unsigned *const _buspic = ((unsigned *)0x0800148c);
+#endif	// BUSPIC_ACCESS
+#ifdef	PWRCOUNT_ACCESS
+static volatile unsigned *const _pwrcount = ((unsigned *)0x08001494);
+#endif	// PWRCOUNT_ACCESS
 #ifdef	RTCDATE_ACCESS
 #define	_BOARD_HAS_RTCDATE
 static volatile unsigned *const _rtcdate = ((unsigned *)134223000);
@@ -518,35 +531,22 @@ static volatile unsigned *const _rtcdate = ((unsigned *)134223000);
 #define	_BOARD_HAS_RTC
 static volatile RTCLIGHT *const _rtc = ((RTCLIGHT *)0x08001450);
 #endif	// RTC_ACCESS
+#define	_BOARD_HAS_SUBSECONDS
+static volatile unsigned *const _subseconds = ((unsigned *)0x080014a4);
 #ifdef	SPIO_ACCESS
 #define	_BOARD_HAS_SPIO
 static volatile unsigned *const _spio = ((unsigned *)0x080014a0);
 #endif	// SPIO_ACCESS
-#ifdef	GPIO_ACCESS
-#define	_BOARD_HAS_GPIO
-static volatile unsigned *const _gpio = ((unsigned *)0x08001490);
-#endif	// GPIO_ACCESS
 #ifdef	SDIO_ACCESS
 #define	_BOARD_HAS_SDIO
 static volatile struct SDIO_S *const _sdio = ((struct SDIO_S *)0x00800000);
 #endif	// SDIO_ACCESS
-#ifdef	BUSPIC_ACCESS
-#define	_BOARD_HAS_BUSPIC
-static volatile unsigned *const _buspic = ((unsigned *)0x0800148c);
-#endif	// BUSPIC_ACCESS
-#ifdef	GPSTRK_ACCESS
-static volatile GPSTRACKER *const _gps = ((GPSTRACKER *)0x08001410);
-#endif	// GPSTRK_ACCESS
-#ifdef	NETCTRL_ACCESS
-#define	_BOARD_HAS_NETMDIO
-static volatile ENETMDIO *const _mdio = ((ENETMDIO *)0x08003000);
-#endif	// NETCTRL_ACCESS
-#define	_BOARD_HAS_BUILDTIME
-static volatile unsigned *const _buildtime = ((unsigned *)0x08001484);
 #ifdef	VERSION_ACCESS
 #define	_BOARD_HAS_VERSION
 static volatile unsigned *const _version = ((unsigned *)0x080014ac);
 #endif	// VERSION_ACCESS
+#define	_BOARD_HAS_BUILDTIME
+static volatile unsigned *const _buildtime = ((unsigned *)0x08001484);
 #ifdef	OLEDBW_ACCESS
 #define	_BOARD_HAS_OLEDBW
 static volatile OLEDBW *const _oled = ((OLEDBW *)134222912);
@@ -591,13 +591,13 @@ static volatile WBMIC *const _wbmic = ((WBMIC *)134219776);
 #define	ALTPIC_RTC	ALTPIC(13)
 // PIC: buspic
 #define	BUSPIC_SPIO	BUSPIC(0)
+#define	SYSINT_PPS	SYSINT(12)
+
+
 #define	SYSINT_GPSRXF	ALTINT(@$(INT.GPSRXF.syspic.ID))
 #define	SYSINT_GPSTXF	ALTINT(11)
 #define	SYSINT_GPSRX	ALTINT(8)
 #define	SYSINT_GPSTX	ALTINT(9)
 
 
-#define	SYSINT_PPS	SYSINT(12)
-
-
 #endif	// BOARD_H
@@ -48,19 +48,17 @@ module iscachable(
 		// }}}
 	);
 
+	// 3 memories, decoded using 10 address bits, have been
+	// minimized to 3 product terms using 4 address bits.  Addresses
+	// belonging to no peripheral may be reported either way.
 	always @(*)
 	begin
 		o_cachable = 1'b0;
-		// Bus master: wbwide
-		// Bus master: wbflash
 		// flash
-		if ((i_addr[30:0] & 31'h79000000) == 31'h01000000)
+		if ((i_addr[27:0] & 28'h9000000) == 28'h1000000)
 			o_cachable = 1'b1;
-		// Bus master: wb32
-		// Bus master: wb32_dio
-		// Bus master: wb32_sio
 		// bkram
-		if ((i_addr[30:0] & 31'h78000000) == 31'h10000000)
+		if ((i_addr[28:0] & 29'h10000000) == 29'h10000000)
 			o_cachable = 1'b1;
 		// ddr3
 		if ((i_addr[30:0] & 31'h40000000) == 31'h40000000)
@@ -57,30 +57,30 @@
 // be listed here.
 //
 // First, the independent access fields for any bus masters
-`define	EXBUS_MASTER
 `define	ALLCLOCKS_PRESENT
+`define	EXBUS_MASTER
 `define	VADJ_ACCESS
 // And then for the independent peripherals
-`define	FLASH_ACCESS
-`define	I2CCPU_ACCESS
-`define	EDID_ACCESS
-`define	GPSUART_ACCESS
-`define	VIDPIPE_ACCESS
-`define	EDIDSLVSCOPE_SCOPC
-`define	CFG_ACCESS
 `define	BKRAM_ACCESS
 `define	SDRAM_ACCESS
 `define	DDR3_PHY_ACCESS
+`define	EDIDSLVSCOPE_SCOPC
+`define	EDID_ACCESS
+`define	FLASH_ACCESS
+`define	GPIO_ACCESS
+`define	GPSTRK_ACCESS
+`define	GPSUART_ACCESS
+`define	VIDPIPE_ACCESS
+`define	I2CCPU_ACCESS
 `define	I2CDMA_ACCESS
-`define	PWRCOUNT_ACCESS
+`define	CFG_ACCESS
 `define	MEGANET_ACCESS
+`define	NETCTRL_ACCESS
+`define	BUSPIC_ACCESS
+`define	PWRCOUNT_ACCESS
 `define	RTC_ACCESS
 `define	SPIO_ACCESS
-`define	GPIO_ACCESS
 `define	SDIO_ACCESS
-`define	BUSPIC_ACCESS
-`define	GPSTRK_ACCESS
-`define	NETCTRL_ACCESS
 `define	VERSION_ACCESS
 `define	OLEDBW_ACCESS
 `define	MICROPHONE_ACCESS
@@ -95,14 +95,10 @@
 // Any core with both an @ACCESS and a @DEPENDS tag will show up here.
 // The @DEPENDS tag will turn into a series of ifdef's, with the @ACCESS
 // being defined only if all of the ifdef's are true//
-// Deplist for @$(PREFIX)=rtcdate
-`ifdef	RTC_ACCESS
-`define	RTCDATE_ACCESS
-`endif	// RTC_ACCESS
-// Deplist for @$(PREFIX)=flashcfg
-`ifdef	FLASH_ACCESS
-`define	FLASHCFG_ACCESS
-`endif	// FLASH_ACCESS
+// Deplist for @$(PREFIX)=rxeth0ck
+`ifdef	MEGANET_ACCESS
+`define	RXETH0CK
+`endif	// MEGANET_ACCESS
 // Deplist for @$(PREFIX)=txclk
 `ifdef	ALLCLOCKS_PRESENT
 `define	TXCLK
@@ -111,12 +107,14 @@
 `ifdef	ALLCLOCKS_PRESENT
 `define	ADCCLK
 `endif	// ALLCLOCKS_PRESENT
-// Deplist for @$(PREFIX)=i2saudio
-// Deplist for @$(PREFIX)=rxeth0ck
-`ifdef	MEGANET_ACCESS
-`define	RXETH0CK
-`endif	// MEGANET_ACCESS
-// Deplist for @$(PREFIX)=i2saudio
+// Deplist for @$(PREFIX)=flashcfg
+`ifdef	FLASH_ACCESS
+`define	FLASHCFG_ACCESS
+`endif	// FLASH_ACCESS
+// Deplist for @$(PREFIX)=rtcdate
+`ifdef	RTC_ACCESS
+`define	RTCDATE_ACCESS
+`endif	// RTC_ACCESS
 //
 // The following macros have unmet dependencies.  They are listed
 // here for reference, but their dependencies cannot be met.
@@ -146,29 +144,8 @@
 //
 module	main(i_clk, i_reset,
 	// {{{
-		// The Universal QSPI Flash
-		o_flash_cs_n, o_flash_sck, o_flash_dat, i_flash_dat, o_flash_mod,
-			i_i2c_sda, i_i2c_scl,
-			o_i2c_sda, o_i2c_scl,
-		// UART/host to wishbone interface
-		i_wbu_uart_rx, o_wbu_uart_tx,
-			i_edid_sda, i_edid_scl,
-			o_edid_sda, o_edid_scl,
-		// The GPS-UART
-		i_gpsu_rx, o_gpsu_tx,
-		// HDMI control ports
-`ifndef	VERILATOR
-		i_hdmiclk,
-`endif
-		i_pixclk,
-		i_hdmi_red, i_hdmi_grn, i_hdmi_blu,
-		o_hdmi_red, o_hdmi_grn, o_hdmi_blu,
-		o_hdmi_iodelay, i_hdmi_iodelay,
-		o_pix_reset_n, i_pxpll_locked, o_hdmirx_reset_n,
-		o_pxclk_cksel,
-		// EDID RX definitions
-		i_edidslv_scl, i_edidslv_sda,
-		o_edidslv_scl, o_edidslv_sda,
+		// Extra clocks
+		i_clk_125mhz,
 		// DDR3 Controller Interface
 		i_ddr3_iserdes_data, i_ddr3_iserdes_dqs,
 		i_ddr3_iserdes_bitslip_reference,
@@ -183,23 +160,50 @@ module	main(i_clk, i_reset,
 		o_ddr3_bitslip,
 		o_ddr3_leveling_calib,
 		o_ddr3_reset,
-		o_i2s_lrclk, o_i2s_bclk, o_i2s_mclk, o_i2s_dac, i_i2s_adc,
+			i_edid_sda, i_edid_scl,
+			o_edid_sda, o_edid_scl,
+		// EDID RX definitions
+		i_edidslv_scl, i_edidslv_sda,
+		o_edidslv_scl, o_edidslv_sda,
+		// UART/host to wishbone interface
+		i_wbu_uart_rx, o_wbu_uart_tx,
+		// The Universal QSPI Flash
+		o_flash_cs_n, o_flash_sck, o_flash_dat, i_flash_dat, o_flash_mod,
+		// GPIO ports
+`ifdef	VERILATOR
+		o_trace, o_halt,
+`endif
+		i_gpio, o_gpio,
+		// The GPS 1PPS signal port
+		i_gps_pps,
+		// The GPS-UART
+		i_gpsu_rx, o_gpsu_tx,
+		// HDMI control ports
+`ifndef	VERILATOR
+		i_hdmiclk,
+`endif
+		i_pixclk,
+		i_hdmi_red, i_hdmi_grn, i_hdmi_blu,
+		o_hdmi_red, o_hdmi_grn, o_hdmi_blu,
+		o_hdmi_iodelay, i_hdmi_iodelay,
+		o_pix_reset_n, i_pxpll_locked, o_hdmirx_reset_n,
+		o_pxclk_cksel,
 		o_pxclk_cyc, o_pxclk_stb, o_pxclk_we,
 		o_pxclk_addr, o_pxclk_data, o_pxclk_sel,
 		i_pxclk_stall, i_pxclk_ack, i_pxclk_idata,
+			i_i2c_sda, i_i2c_scl,
+			o_i2c_sda, o_i2c_scl,
+		o_i2s_lrclk, o_i2s_bclk, o_i2s_mclk, o_i2s_dac, i_i2s_adc,
                 // Ethernet control (packets) lines
                 o_net_reset_n,
                 // eth_int_b    // Interrupt, leave floating
                 // eth_pme_b    // Power management event, leave floating
                 i_net_rx_clk, i_net_rx_dv, i_net_rx_err, i_net_rxd,
                 o_net_tx_clk, o_net_tx_ctl, o_net_txd,
+		// The ethernet MDIO wires
+		o_mdclk, o_mdio, o_mdwe, i_mdio,
 		// SPIO interface
 		i_sw, i_btnc, i_btnd, i_btnl, i_btnr, i_btnu, o_led,
-		// GPIO ports
-`ifdef	VERILATOR
-		o_trace, o_halt,
-`endif
-		i_gpio, o_gpio,
 		// SDIO SD Card
 		i_sdio_detect,
 		//
@@ -232,12 +236,6 @@ module	main(i_clk, i_reset,
 		i_sdio_ad_data,
 		o_sdio_hwreset_n, o_sdio_1p8v,
 		i_sdio_debug,
-		// Extra clocks
-		i_clk_125mhz,
-		// The GPS 1PPS signal port
-		i_gps_pps,
-		// The ethernet MDIO wires
-		o_mdclk, o_mdio, o_mdwe, i_mdio,
 		// OLED control interface (roughly SPI)
 		o_oled_sck, o_oled_mosi, o_oled_dcn,
 		// The PMic3 microphone wires
@@ -267,16 +265,6 @@ module	main(i_clk, i_reset,
 // As they aren't connected to the toplevel at all, it would
 // be best to use localparam over parameter, but here we don't
 // check
-	////////////////////////////////////////////////////////////////////////
-	//
-	// EXBUS parameters
-	// {{{
-	// Baudrate :   1000000
-	// Clock    : 100000000
-	localparam [23:0] BUSUART = 24'h64;	//   1000000 baud
-	localparam	DBGBUSBITS = $clog2(BUSUART);
-	// }}}
-	localparam	ICAPE_LGDIV=3;
 	localparam real SDRAMCONTROLLER_CLK_PERIOD = 10_000,  //ps, clock period of the controller interface
 		DDR3_CLK_PERIOD = 2_500; //ps, clock period of the DDR3 RAM device (must be 1/4 of the CONTROLLER_CLK_PERIOD) 
 	localparam SDRAMROW_BITS = 14,  // width of row address
@@ -290,11 +278,21 @@ module	main(i_clk, i_reset,
 		SDRAMCMD_LEN = 4 + 3 + SDRAMBA_BITS + SDRAMROW_BITS;
 
 
+	////////////////////////////////////////////////////////////////////////
+	//
+	// EXBUS parameters
+	// {{{
+	// Baudrate :   1000000
+	// Clock    : 100000000
+	localparam [23:0] BUSUART = 24'h64;	//   1000000 baud
+	localparam	DBGBUSBITS = $clog2(BUSUART);
+	// }}}
+	localparam [31:0] GPSCLOCK_DEFAULT_STEP = 32'haabcc771;
+	localparam	ICAPE_LGDIV=3;
 	parameter	[15:0]	UDP_DBGPORT  = 6784;
 
 	localparam	[47:0]	DEF_HWMAC  = 48'h82_33_48_02_e1_c8;
 	localparam	[31:0]	DEF_IPADDR = { 8'd192, 8'd168, 8'd15, 8'd29 };
-	localparam [31:0] GPSCLOCK_DEFAULT_STEP = 32'haabcc771;
 	////////////////////////////////////////////////////////////////////////
 	//
 	// Variables/definitions/parameters used by the ZipCPU bus master
@@ -342,23 +340,54 @@ module	main(i_clk, i_reset,
 	// verilator lint_off UNUSED
 	input	wire		i_reset;
 	// verilator lint_on UNUSED
-	// The Universal QSPI flash
-	output	wire		o_flash_cs_n, o_flash_sck;
-	output	wire	[3:0]	o_flash_dat;
-	input	wire	[3:0]	i_flash_dat;
-	output	wire	[1:0]	o_flash_mod;
-	// I2C Port declarations
+	// Extra clocks
+	// Verilator lint_off UNUSED
+	input	wire		i_clk_125mhz;
+	// Verilator lint_on  UNUSED
+	// DDR3 Controller I/O declarations
 	// {{{
-	input	wire	i_i2c_sda, i_i2c_scl;
-	output	wire	o_i2c_sda, o_i2c_scl;
+	input	wire	[SDRAMDQ_BITS*SDRAMBYTE_LANES*8-1:0] i_ddr3_iserdes_data;
+	input wire    [SDRAMBYTE_LANES*8-1:0] i_ddr3_iserdes_dqs;
+	input wire    [SDRAMBYTE_LANES*8-1:0] i_ddr3_iserdes_bitslip_reference;
+	input wire    i_ddr3_idelayctrl_rdy;
+	output wire    [SDRAMCMD_LEN*SDRAMSERDES_RATIO-1:0] o_ddr3_cmd;
+	output wire    o_ddr3_dqs_tri_control, o_ddr3_dq_tri_control;
+	output wire    o_ddr3_toggle_dqs;
+	output wire    [SDRAMDQ_BITS*SDRAMBYTE_LANES*8-1:0] o_ddr3_data;
+	output wire    [(SDRAMDQ_BITS*SDRAMBYTE_LANES*8)/8-1:0] o_ddr3_dm;
+	output wire    [4:0] o_ddr3_odelay_data_cntvaluein, o_ddr3_odelay_dqs_cntvaluein;
+	output wire    [4:0] o_ddr3_idelay_data_cntvaluein, o_ddr3_idelay_dqs_cntvaluein;
+	output wire    [SDRAMBYTE_LANES-1:0] o_ddr3_odelay_data_ld, o_ddr3_odelay_dqs_ld;
+	output wire    [SDRAMBYTE_LANES-1:0] o_ddr3_idelay_data_ld, o_ddr3_idelay_dqs_ld;
+	output wire    [SDRAMBYTE_LANES-1:0] o_ddr3_bitslip;
+	output wire    o_ddr3_leveling_calib;
+	output wire    o_ddr3_reset;
 	// }}}
-	input	wire		i_wbu_uart_rx;
-	output	wire		o_wbu_uart_tx;
 	// I2C Port declarations
 	// {{{
 	input	wire	i_edid_sda, i_edid_scl;
 	output	wire	o_edid_sda, o_edid_scl;
 	// }}}
+	// EDID RX definitions
+	input	wire	i_edidslv_scl, i_edidslv_sda;
+	output	wire	o_edidslv_scl, o_edidslv_sda;
+	input	wire		i_wbu_uart_rx;
+	output	wire		o_wbu_uart_tx;
+	// The Universal QSPI flash
+	output	wire		o_flash_cs_n, o_flash_sck;
+	output	wire	[3:0]	o_flash_dat;
+	input	wire	[3:0]	i_flash_dat;
+	output	wire	[1:0]	o_flash_mod;
+	localparam	NGPI = 8, NGPO=10;
+	// GPIO ports
+`ifdef	VERILATOR
+	output	wire			o_trace;
+	output	wire			o_halt;
+`endif
+	input		[(NGPI-1):0]	i_gpio;
+	output	wire	[(NGPO-1):0]	o_gpio;
+	//The GPS Clock
+	input	wire		i_gps_pps;
 	input	wire		i_gpsu_rx;
 	output	wire		o_gpsu_tx;
 	// hdmi declarations
@@ -375,36 +404,19 @@ module	main(i_clk, i_reset,
 	input	wire		i_pxpll_locked;
 	output	wire	[1:0]	o_pxclk_cksel;
 	// }}}
-	// EDID RX definitions
-	input	wire	i_edidslv_scl, i_edidslv_sda;
-	output	wire	o_edidslv_scl, o_edidslv_sda;
-	// DDR3 Controller I/O declarations
-	// {{{
-	input	wire	[SDRAMDQ_BITS*SDRAMBYTE_LANES*8-1:0] i_ddr3_iserdes_data;
-	input wire    [SDRAMBYTE_LANES*8-1:0] i_ddr3_iserdes_dqs;
-	input wire    [SDRAMBYTE_LANES*8-1:0] i_ddr3_iserdes_bitslip_reference;
-	input wire    i_ddr3_idelayctrl_rdy;
-	output wire    [SDRAMCMD_LEN*SDRAMSERDES_RATIO-1:0] o_ddr3_cmd;
-	output wire    o_ddr3_dqs_tri_control, o_ddr3_dq_tri_control;
-	output wire    o_ddr3_toggle_dqs;
-	output wire    [SDRAMDQ_BITS*SDRAMBYTE_LANES*8-1:0] o_ddr3_data;
-	output wire    [(SDRAMDQ_BITS*SDRAMBYTE_LANES*8)/8-1:0] o_ddr3_dm;
-	output wire    [4:0] o_ddr3_odelay_data_cntvaluein, o_ddr3_odelay_dqs_cntvaluein;
-	output wire    [4:0] o_ddr3_idelay_data_cntvaluein, o_ddr3_idelay_dqs_cntvaluein;
-	output wire    [SDRAMBYTE_LANES-1:0] o_ddr3_odelay_data_ld, o_ddr3_odelay_dqs_ld;
-	output wire    [SDRAMBYTE_LANES-1:0] o_ddr3_idelay_data_ld, o_ddr3_idelay_dqs_ld;
-	output wire    [SDRAMBYTE_LANES-1:0] o_ddr3_bitslip;
-	output wire    o_ddr3_leveling_calib;
-	output wire    o_ddr3_reset;
-	// }}}
-	output	wire	o_i2s_lrclk, o_i2s_bclk, o_i2s_mclk, o_i2s_dac;
-	input	wire	i_i2s_adc;
 	output	wire	o_pxclk_cyc, o_pxclk_stb, o_pxclk_we;
 	output	wire	[6:0]	o_pxclk_addr;
 	output	wire	[31:0]	o_pxclk_data;
 	output	wire	[3:0]	o_pxclk_sel;
 	input	wire		i_pxclk_stall, i_pxclk_ack;
 	input	wire	[31:0]	i_pxclk_idata;
+	// I2C Port declarations
+	// {{{
+	input	wire	i_i2c_sda, i_i2c_scl;
+	output	wire	o_i2c_sda, o_i2c_scl;
+	// }}}
+	output	wire	o_i2s_lrclk, o_i2s_bclk, o_i2s_mclk, o_i2s_dac;
+	input	wire	i_i2s_adc;
         // Ethernet (RGMII) control
 	// {{{
 	// Verilator lint_off SYNCASYNCNET
@@ -416,18 +428,13 @@ module	main(i_clk, i_reset,
         output  wire            o_net_tx_ctl;
         output  wire    [7:0]   o_net_txd;
 	// }}}
+	// Ethernet control (MDIO)
+	output	wire		o_mdclk, o_mdio, o_mdwe;
+	input	wire		i_mdio;
 	// SPIO interface
 	input	wire	[8-1:0]	i_sw;
 	input	wire		i_btnc, i_btnd, i_btnl, i_btnr, i_btnu;
 	output	wire	[8-1:0]	o_led;
-	localparam	NGPI = 8, NGPO=10;
-	// GPIO ports
-`ifdef	VERILATOR
-	output	wire			o_trace;
-	output	wire			o_halt;
-`endif
-	input		[(NGPI-1):0]	i_gpio;
-	output	wire	[(NGPO-1):0]	o_gpio;
 	// SDIO SD Card declarations
 	// {{{
 	input	wire		i_sdio_detect;
@@ -465,15 +472,6 @@ module	main(i_clk, i_reset,
 	input	wire	[31:0]	i_sdio_debug;
 	// Verilator lint_on  UNUSED
 	// }}}
-	// Extra clocks
-	// Verilator lint_off UNUSED
-	input	wire		i_clk_125mhz;
-	// Verilator lint_on  UNUSED
-	//The GPS Clock
-	input	wire		i_gps_pps;
-	// Ethernet control (MDIO)
-	output	wire		o_mdclk, o_mdio, o_mdwe;
-	input	wire		i_mdio;
 	// OLEDBW interface
 	output	wire		o_oled_sck, o_oled_mosi, o_oled_dcn;
 	output	wire		o_mic_csn, o_mic_sck;
@@ -507,20 +505,20 @@ module	main(i_clk, i_reset,
 	// These declarations come from the various components values
 	// given under the @INT.<interrupt name>.WIRE key.
 	//
-	wire	i2c_int;	// i2c.INT.I2C.WIRE
+	wire	edidslvscope_int;	// edidslvscope.INT.EDIDSLVSCOPE.WIRE
 	wire	edid_int;	// edid.INT.EDID.WIRE
+	wire	gpio_int;	// gpio.INT.GPIO.WIRE
+	wire	gck_pps;	// gck.INT.PPS.WIRE
+	wire	gpsurx_int;	// gpsu.INT.GPSRX.WIRE
+	wire	gpsutx_int;	// gpsu.INT.GPSTX.WIRE
 	wire	gpsurxf_int;	// gpsu.INT.GPSRXF.WIRE
 	wire	gpsutxf_int;	// gpsu.INT.GPSTXF.WIRE
-	wire	gpsutx_int;	// gpsu.INT.GPSTX.WIRE
-	wire	gpsurx_int;	// gpsu.INT.GPSRX.WIRE
 	wire	hdmi_int;	// hdmi.INT.VIDFRAME.WIRE
-	wire	edidslvscope_int;	// edidslvscope.INT.EDIDSLVSCOPE.WIRE
+	wire	i2c_int;	// i2c.INT.I2C.WIRE
+	wire	w_bus_int;	// buspic.INT.BUS.WIRE
 	wire	rtc_int;	// rtc.INT.RTC.WIRE
 	wire	spio_int;	// spio.INT.SPIO.WIRE
-	wire	gpio_int;	// gpio.INT.GPIO.WIRE
 	wire	sdio_int;	// sdio.INT.SDCARD.WIRE
-	wire	w_bus_int;	// buspic.INT.BUS.WIRE
-	wire	gck_pps;	// gck.INT.PPS.WIRE
 	wire	oled_int;	// oled.INT.OLED.WIRE
 	wire	pmic_int;	// pmic.INT.MIC.WIRE
 	wire	zip_cpu_int;	// zip.INT.ZIP.WIRE
@@ -532,28 +530,34 @@ module	main(i_clk, i_reset,
 	// These declarations come from the @MAIN.DEFNS keys found in the
 	// various components comprising the design.
 	//
-	// Definitions for the flash debug port
+	wire	i_net_tx_clk;
+	reg	[30-1:0]	r_buserr_addr;
 	// Verilator lint_off UNUSED
-	wire		flash_dbg_trigger;
-	wire	[31:0]	flash_debug;
+	reg		rtc_pps;
+	reg	[26:0]	rtc_pps_counter;
+	// Verilator lint_on  UNUSED
+	reg	r_rxeth0ck_ack;
+	reg	r_txclk_ack;
+	reg	r_adcclk_ack;
+	// Verilator lint_off UNUSED
+	wire	[SDRAMAUX_WIDTH-1:0]	ddr3_aux_out;
+	wire	[31:0]	ddr3_debug;
 	// Verilator lint_on  UNUSED
 	// I2C Controller
 	// {{{
 	// Verilator lint_off UNUSED
-	localparam	I2CCPU_WIDTH=(2 == 0) ? 1 : 2;
+	localparam	EDID_WIDTH=(2 == 0) ? 1 : 2;
 
-	wire		i2c_valid, i2c_ready, i2c_last;
-	wire	[7:0]	i2c_data;
-	wire	[I2CCPU_WIDTH-1:0]	i2c_id;
+	wire		edid_valid, edid_ready, edid_last;
+	wire	[7:0]	edid_data;
+	wire	[EDID_WIDTH-1:0]	edid_id;
 
-	wire	[31:0]	i2c_debug;
+	wire	[31:0]	edid_debug;
 	// Verilator lint_on  UNUSED
 	// }}}
-	reg	[30-1:0]	r_buserr_addr;
-`ifndef	GPSTRK_ACCESS
-	reg	[31:0]	r_subseconds_data;
-`endif
-	reg	r_adcclk_ack;
+	// Verilator lint_off UNUSED
+	wire	[31:0]	edidslv_dbg;
+	// Verilator lint_on  UNUSED
 	////////////////////////////////////////////////////////////////////////
 	//
 	// EXBUS: USB-UART interface declarations
@@ -568,18 +572,17 @@ module	main(i_clk, i_reset,
 	wire	[1:0]	ex_gpio;
 	// Verilator lint_on  UNUSED
 	// }}}
-	// I2C Controller
-	// {{{
+	// Definitions for the flash debug port
 	// Verilator lint_off UNUSED
-	localparam	EDID_WIDTH=(2 == 0) ? 1 : 2;
-
-	wire		edid_valid, edid_ready, edid_last;
-	wire	[7:0]	edid_data;
-	wire	[EDID_WIDTH-1:0]	edid_id;
-
-	wire	[31:0]	edid_debug;
+	wire		flash_dbg_trigger;
+	wire	[31:0]	flash_debug;
 	// Verilator lint_on  UNUSED
-	// }}}
+	wire	sd_reset;
+	wire		ck_pps;
+	wire		gps_pps, gps_led, gps_locked, gps_tracking;
+	wire	[63:0]	gps_now, gps_err, gps_step;
+	wire	[1:0]	gps_dbg_tick;
+	wire	tb_pps;
 	wire	w_gpsu_cts_n, w_gpsu_rts_n;
 	assign	w_gpsu_cts_n=1'b1;
 	// Verilator lint_off UNUSED
@@ -589,21 +592,19 @@ module	main(i_clk, i_reset,
 	wire		hdmidbg_ce, hdmidbg_trigger;
 	wire	[31:0]	hdmiclr_debug;
 	// Verilator lint_on  UNUSED
+	// I2C Controller
+	// {{{
 	// Verilator lint_off UNUSED
-	wire	[31:0]	edidslv_dbg;
-	// Verilator lint_on  UNUSED
-	reg	r_txclk_ack;
-	reg	r_rxeth0ck_ack;
-	// Verilator lint_off UNUSED
-	reg		rtc_pps;
-	reg	[26:0]	rtc_pps_counter;
-	// Verilator lint_on  UNUSED
-	// Verilator lint_off UNUSED
-	wire	[SDRAMAUX_WIDTH-1:0]	ddr3_aux_out;
-	wire	[31:0]	ddr3_debug;
+	localparam	I2CCPU_WIDTH=(2 == 0) ? 1 : 2;
+
+	wire		i2c_valid, i2c_ready, i2c_last;
+	wire	[7:0]	i2c_data;
+	wire	[I2CCPU_WIDTH-1:0]	i2c_id;
+
+	wire	[31:0]	i2c_debug;
 	// Verilator lint_on  UNUSED
+	// }}}
 	wire	i2cdma_ready;
-	reg	[31:0]	r_pwrcount_data;
 	////////////////////////////////////////////////////////////////////////
 	//
 	// I2S Audio signal definitions
@@ -623,7 +624,6 @@ module	main(i_clk, i_reset,
 	wire	[31:0]	w_i2saudio_debug;
 	// Verilator lint_on  UNUSED
 	// }}}
-	wire	tb_pps;
         // Ethernet (RGMII) control
 	// {{{
 	// Verilator lint_off UNUSED
@@ -653,14 +653,20 @@ module	main(i_clk, i_reset,
 
 	// Verilator lint_on  UNUSED
 	// }}}
+	// Verilator lint_off UNUSED
+	wire[31:0]	mdio_debug;
+	// Verilator lint_on  UNUSED
+	reg	[31:0]	r_pwrcount_data;
 	// Definitions in support of the GPS driven RTC
 	// This clock step is designed to match 100000000 Hz
 	localparam	[31:0]	RTC_CLKSTEP = 32'h002af31d;
 	wire	rtc_ppd;
 	wire	rtc_pps;
+`ifndef	GPSTRK_ACCESS
+	reg	[31:0]	r_subseconds_data;
+`endif
 	wire	[5-1:0]	w_btn;
 	wire	[8-1:0]	w_led;
-	wire	sd_reset;
 	// SDIO SD Card definitions
 	// Verilator lint_off UNUSED
 	wire	[31:0]	w_sdio_sdwb_debug;
@@ -670,14 +676,6 @@ module	main(i_clk, i_reset,
 	wire	[31:0]	m_sdio_data;
 	// assign		sdio_debug = i_sdio_debug;
 	// Verilator lint_on  UNUSED
-	wire	i_net_tx_clk;
-	wire		ck_pps;
-	wire		gps_pps, gps_led, gps_locked, gps_tracking;
-	wire	[63:0]	gps_now, gps_err, gps_step;
-	wire	[1:0]	gps_dbg_tick;
-	// Verilator lint_off UNUSED
-	wire[31:0]	mdio_debug;
-	// Verilator lint_on  UNUSED
 // BUILDTIME doesnt need to include builddate.v a second time
 // `include "builddate.v"
 	// OLEDBW
@@ -837,36 +835,6 @@ module	main(i_clk, i_reset,
 	wire	[127:0]	wbwide_ddr3_idata;
 	// Verilator lint_on UNUSED
 	// }}}
-	// Bus wbflash
-	// {{{
-	// Wishbone definitions for bus wbflash, component crossflash
-	// Verilator lint_off UNUSED
-	wire		wbflash_crossflash_cyc, wbflash_crossflash_stb, wbflash_crossflash_we;
-	wire	[22:0]	wbflash_crossflash_addr;
-	wire	[31:0]	wbflash_crossflash_data;
-	wire	[3:0]	wbflash_crossflash_sel;
-	wire		wbflash_crossflash_stall, wbflash_crossflash_ack, wbflash_crossflash_err;
-	wire	[31:0]	wbflash_crossflash_idata;
-	// Verilator lint_on UNUSED
-	// Wishbone definitions for bus wbflash, component sdio
-	// Verilator lint_off UNUSED
-	wire		wbflash_sdio_cyc, wbflash_sdio_stb, wbflash_sdio_we;
-	wire	[22:0]	wbflash_sdio_addr;
-	wire	[31:0]	wbflash_sdio_data;
-	wire	[3:0]	wbflash_sdio_sel;
-	wire		wbflash_sdio_stall, wbflash_sdio_ack, wbflash_sdio_err;
-	wire	[31:0]	wbflash_sdio_idata;
-	// Verilator lint_on UNUSED
-	// Wishbone definitions for bus wbflash, component flash
-	// Verilator lint_off UNUSED
-	wire		wbflash_flash_cyc, wbflash_flash_stb, wbflash_flash_we;
-	wire	[22:0]	wbflash_flash_addr;
-	wire	[31:0]	wbflash_flash_data;
-	wire	[3:0]	wbflash_flash_sel;
-	wire		wbflash_flash_stall, wbflash_flash_ack, wbflash_flash_err;
-	wire	[31:0]	wbflash_flash_idata;
-	// Verilator lint_on UNUSED
-	// }}}
 	// Bus wb32
 	// {{{
 	// Wishbone definitions for bus wb32, component crossbus
@@ -1197,6 +1165,36 @@ module	main(i_clk, i_reset,
 	wire	[31:0]	wbu_zip_idata;
 	// Verilator lint_on UNUSED
 	// }}}
+	// Bus wbflash
+	// {{{
+	// Wishbone definitions for bus wbflash, component crossflash
+	// Verilator lint_off UNUSED
+	wire		wbflash_crossflash_cyc, wbflash_crossflash_stb, wbflash_crossflash_we;
+	wire	[22:0]	wbflash_crossflash_addr;
+	wire	[31:0]	wbflash_crossflash_data;
+	wire	[3:0]	wbflash_crossflash_sel;
+	wire		wbflash_crossflash_stall, wbflash_crossflash_ack, wbflash_crossflash_err;
+	wire	[31:0]	wbflash_crossflash_idata;
+	// Verilator lint_on UNUSED
+	// Wishbone definitions for bus wbflash, component sdio
+	// Verilator lint_off UNUSED
+	wire		wbflash_sdio_cyc, wbflash_sdio_stb, wbflash_sdio_we;
+	wire	[22:0]	wbflash_sdio_addr;
+	wire	[31:0]	wbflash_sdio_data;
+	wire	[3:0]	wbflash_sdio_sel;
+	wire		wbflash_sdio_stall, wbflash_sdio_ack, wbflash_sdio_err;
+	wire	[31:0]	wbflash_sdio_idata;
+	// Verilator lint_on UNUSED
+	// Wishbone definitions for bus wbflash, component flash
+	// Verilator lint_off UNUSED
+	wire		wbflash_flash_cyc, wbflash_flash_stb, wbflash_flash_we;
+	wire	[22:0]	wbflash_flash_addr;
+	wire	[31:0]	wbflash_flash_data;
+	wire	[3:0]	wbflash_flash_sel;
+	wire		wbflash_flash_stall, wbflash_flash_ack, wbflash_flash_err;
+	wire	[31:0]	wbflash_flash_idata;
+	// Verilator lint_on UNUSED
+	// }}}
 	// }}}
 	////////////////////////////////////////////////////////////////////////
 	//
@@ -1412,155 +1410,42 @@ module	main(i_clk, i_reset,
 	// End of bus logic for wbwide
 	// }}}
 	//
-	// BUS-LOGIC for wbflash
+	// BUS-LOGIC for wb32
 	// {{{
 	//
-	// No class SINGLE peripherals on the "wbflash" bus
+	// wb32 Bus logic to handle SINGLE slaves
 	//
+	reg		r_wb32_sio_ack;
+	reg	[31:0]	r_wb32_sio_data;
+
+	assign	wb32_sio_stall = 1'b0;
+
+	initial r_wb32_sio_ack = 1'b0;
+	always	@(posedge i_clk)
+		r_wb32_sio_ack <= (wb32_sio_stb);
+	assign	wb32_sio_ack = r_wb32_sio_ack;
+
+	always	@(posedge i_clk)
+	casez( wb32_sio_addr[3:0] )
+	4'h0: r_wb32_sio_data <= wb32_adcclk_idata;
+	4'h1: r_wb32_sio_data <= wb32_buildtime_idata;
+	4'h2: r_wb32_sio_data <= wb32_buserr_idata;
+	4'h3: r_wb32_sio_data <= wb32_buspic_idata;
+	4'h4: r_wb32_sio_data <= wb32_gpio_idata;
+	4'h5: r_wb32_sio_data <= wb32_pwrcount_idata;
+	4'h6: r_wb32_sio_data <= wb32_rtcdate_idata;
+	4'h7: r_wb32_sio_data <= wb32_rxeth0ck_idata;
+	4'h8: r_wb32_sio_data <= wb32_spio_idata;
+	4'h9: r_wb32_sio_data <= wb32_subseconds_idata;
+	4'ha: r_wb32_sio_data <= wb32_txclk_idata;
+	4'hb: r_wb32_sio_data <= wb32_version_idata;
+	default: r_wb32_sio_data <= wb32_version_idata;
+	endcase
+	assign	wb32_sio_idata = r_wb32_sio_data;
 
-	//
-	// No class DOUBLE peripherals on the "wbflash" bus
-	//
 
-`ifdef	SDIO_ACCESS
-	assign	wbflash_sdio_err= 1'b0;
-`endif	// SDIO_ACCESS
-`ifdef	FLASH_ACCESS
-	assign	wbflash_flash_err= 1'b0;
-`endif	// FLASH_ACCESS
-	//
-	// Connect the wbflash bus components together using the wbxbar()
 	//
-	//
-	wbxbar #(
-		.NM(1), .NS(2), .AW(23), .DW(32),
-		.SLAVE_ADDR({
-			// Address width    = 23
-			// Address LSBs     = 2
-			{ 23'h400000 }, // flash: 0x1000000
-			{ 23'h200000 }  //  sdio: 0x0800000
-		}),
-		.SLAVE_MASK({
-			// Address width    = 23
-			// Address LSBs     = 2
-			{ 23'h400000 }, // flash
-			{ 23'h600000 }  //  sdio
-		}),
-		.OPT_DBLBUFFER(1'b1)
-	) wbflash_xbar(
-		.i_clk(i_clk), .i_reset(i_reset),
-		.i_mcyc({
-			wbflash_crossflash_cyc
-		}),
-		.i_mstb({
-			wbflash_crossflash_stb
-		}),
-		.i_mwe({
-			wbflash_crossflash_we
-		}),
-		.i_maddr({
-			wbflash_crossflash_addr
-		}),
-		.i_mdata({
-			wbflash_crossflash_data
-		}),
-		.i_msel({
-			wbflash_crossflash_sel
-		}),
-		.o_mstall({
-			wbflash_crossflash_stall
-		}),
-		.o_mack({
-			wbflash_crossflash_ack
-		}),
-		.o_mdata({
-			wbflash_crossflash_idata
-		}),
-		.o_merr({
-			wbflash_crossflash_err
-		}),
-		// Slave connections
-		.o_scyc({
-			wbflash_flash_cyc,
-			wbflash_sdio_cyc
-		}),
-		.o_sstb({
-			wbflash_flash_stb,
-			wbflash_sdio_stb
-		}),
-		.o_swe({
-			wbflash_flash_we,
-			wbflash_sdio_we
-		}),
-		.o_saddr({
-			wbflash_flash_addr,
-			wbflash_sdio_addr
-		}),
-		.o_sdata({
-			wbflash_flash_data,
-			wbflash_sdio_data
-		}),
-		.o_ssel({
-			wbflash_flash_sel,
-			wbflash_sdio_sel
-		}),
-		.i_sstall({
-			wbflash_flash_stall,
-			wbflash_sdio_stall
-		}),
-		.i_sack({
-			wbflash_flash_ack,
-			wbflash_sdio_ack
-		}),
-		.i_sdata({
-			wbflash_flash_idata,
-			wbflash_sdio_idata
-		}),
-		.i_serr({
-			wbflash_flash_err,
-			wbflash_sdio_err
-		})
-		);
-
-	// End of bus logic for wbflash
-	// }}}
-	//
-	// BUS-LOGIC for wb32
-	// {{{
-	//
-	// wb32 Bus logic to handle SINGLE slaves
-	//
-	reg		r_wb32_sio_ack;
-	reg	[31:0]	r_wb32_sio_data;
-
-	assign	wb32_sio_stall = 1'b0;
-
-	initial r_wb32_sio_ack = 1'b0;
-	always	@(posedge i_clk)
-		r_wb32_sio_ack <= (wb32_sio_stb);
-	assign	wb32_sio_ack = r_wb32_sio_ack;
-
-	always	@(posedge i_clk)
-	casez( wb32_sio_addr[3:0] )
-	4'h0: r_wb32_sio_data <= wb32_adcclk_idata;
-	4'h1: r_wb32_sio_data <= wb32_buildtime_idata;
-	4'h2: r_wb32_sio_data <= wb32_buserr_idata;
-	4'h3: r_wb32_sio_data <= wb32_buspic_idata;
-	4'h4: r_wb32_sio_data <= wb32_gpio_idata;
-	4'h5: r_wb32_sio_data <= wb32_pwrcount_idata;
-	4'h6: r_wb32_sio_data <= wb32_rtcdate_idata;
-	4'h7: r_wb32_sio_data <= wb32_rxeth0ck_idata;
-	4'h8: r_wb32_sio_data <= wb32_spio_idata;
-	4'h9: r_wb32_sio_data <= wb32_subseconds_idata;
-	4'ha: r_wb32_sio_data <= wb32_txclk_idata;
-	4'hb: r_wb32_sio_data <= wb32_version_idata;
-	default: r_wb32_sio_data <= wb32_version_idata;
-	endcase
-	assign	wb32_sio_idata = r_wb32_sio_data;
-
-
-	//
-	// Now to translate this logic to the various SIO slaves
+	// Now to translate this logic to the various SIO slaves
 	//
 	// In this case, the SIO bus has the prefix wb32_sio
 	// and all of the slaves have various wires beginning
@@ -2086,6 +1971,119 @@ module	main(i_clk, i_reset,
 
 	// End of bus logic for wbu
 	// }}}
+	//
+	// BUS-LOGIC for wbflash
+	// {{{
+	//
+	// No class SINGLE peripherals on the "wbflash" bus
+	//
+
+	//
+	// No class DOUBLE peripherals on the "wbflash" bus
+	//
+
+`ifdef	SDIO_ACCESS
+	assign	wbflash_sdio_err= 1'b0;
+`endif	// SDIO_ACCESS
+`ifdef	FLASH_ACCESS
+	assign	wbflash_flash_err= 1'b0;
+`endif	// FLASH_ACCESS
+	//
+	// Connect the wbflash bus components together using the wbxbar()
+	//
+	//
+	wbxbar #(
+		.NM(1), .NS(2), .AW(23), .DW(32),
+		.SLAVE_ADDR({
+			// Address width    = 23
+			// Address LSBs     = 2
+			{ 23'h400000 }, // flash: 0x1000000
+			{ 23'h200000 }  //  sdio: 0x0800000
+		}),
+		.SLAVE_MASK({
+			// Address width    = 23
+			// Address LSBs     = 2
+			{ 23'h400000 }, // flash
+			{ 23'h600000 }  //  sdio
+		}),
+		.OPT_DBLBUFFER(1'b1)
+	) wbflash_xbar(
+		.i_clk(i_clk), .i_reset(i_reset),
+		.i_mcyc({
+			wbflash_crossflash_cyc
+		}),
+		.i_mstb({
+			wbflash_crossflash_stb
+		}),
+		.i_mwe({
+			wbflash_crossflash_we
+		}),
+		.i_maddr({
+			wbflash_crossflash_addr
+		}),
+		.i_mdata({
+			wbflash_crossflash_data
+		}),
+		.i_msel({
+			wbflash_crossflash_sel
+		}),
+		.o_mstall({
+			wbflash_crossflash_stall
+		}),
+		.o_mack({
+			wbflash_crossflash_ack
+		}),
+		.o_mdata({
+			wbflash_crossflash_idata
+		}),
+		.o_merr({
+			wbflash_crossflash_err
+		}),
+		// Slave connections
+		.o_scyc({
+			wbflash_flash_cyc,
+			wbflash_sdio_cyc
+		}),
+		.o_sstb({
+			wbflash_flash_stb,
+			wbflash_sdio_stb
+		}),
+		.o_swe({
+			wbflash_flash_we,
+			wbflash_sdio_we
+		}),
+		.o_saddr({
+			wbflash_flash_addr,
+			wbflash_sdio_addr
+		}),
+		.o_sdata({
+			wbflash_flash_data,
+			wbflash_sdio_data
+		}),
+		.o_ssel({
+			wbflash_flash_sel,
+			wbflash_sdio_sel
+		}),
+		.i_sstall({
+			wbflash_flash_stall,
+			wbflash_sdio_stall
+		}),
+		.i_sack({
+			wbflash_flash_ack,
+			wbflash_sdio_ack
+		}),
+		.i_sdata({
+			wbflash_flash_idata,
+			wbflash_sdio_idata
+		}),
+		.i_serr({
+			wbflash_flash_err,
+			wbflash_sdio_err
+		})
+		);
+
+	// End of bus logic for wbflash
+	// }}}
 	// }}}
 	////////////////////////////////////////////////////////////////////////
 	//
@@ -2175,135 +2173,39 @@ module	main(i_clk, i_reset,
 	// or making sure all of the various interrupt wires are set to
 	// zero if the component is not included.
 	//
-`ifdef	FLASH_ACCESS
-	// {{{
-	////////////////////////////////////////////////////////////////////////
-	//
-	// Flash controller
+	assign	i_net_tx_clk = i_clk_125mhz;
+`ifdef	BKRAM_ACCESS
 	// {{{
-	qflexpress #(
-		// {{{
-		.LGFLASHSZ(24), .OPT_CLKDIV(1),
-		.OPT_ENDIANSWAP(0),
-		.NDUMMY(6), .RDDELAY(2),
-		.OPT_STARTUP_FILE("spansion.hex"),
-`ifdef	FLASHCFG_ACCESS
-		.OPT_CFG(1'b1)
-`else
-		.OPT_CFG(1'b0)
-`endif
-		// }}}
-	) u_flash (
-		// {{{
+	memdev #(
+		.LGMEMSZ(20),
+		.DW(128),
+		.EXTRACLOCK(1)
+	) u_bkram (
 		.i_clk(i_clk),
 		.i_reset(i_reset),
-		// Primary memory reading inputs
-		.i_wb_cyc(wbflash_flash_cyc), .i_wb_stb(wbflash_flash_stb), .i_wb_we(wbflash_flash_we),
-			.i_wb_addr(wbflash_flash_addr[22-1:0]),
-			.i_wb_data(wbflash_flash_data), // 32 bits wide
-			.i_wb_sel(wbflash_flash_sel),  // 32/8 bits wide
-		.o_wb_stall(wbflash_flash_stall),.o_wb_ack(wbflash_flash_ack), .o_wb_data(wbflash_flash_idata),
-		// Configuration bus ports
-		.i_cfg_cyc(wb32_flashcfg_cyc), .i_cfg_stb(wb32_flashcfg_stb), .i_cfg_we(wb32_flashcfg_we),
-			.i_cfg_data(wb32_flashcfg_data), // 32 bits wide
-			.i_cfg_sel(wb32_flashcfg_sel),  // 32/8 bits wide
-		.o_cfg_stall(wb32_flashcfg_stall),.o_cfg_ack(wb32_flashcfg_ack), .o_cfg_data(wb32_flashcfg_idata),
-		.o_qspi_sck(o_flash_sck),
-		.o_qspi_cs_n(o_flash_cs_n),
-		.o_qspi_mod(o_flash_mod),
-		.o_qspi_dat(o_flash_dat),
-		.i_qspi_dat(i_flash_dat),
-		.o_dbg_trigger(flash_dbg_trigger),
-		.o_debug(flash_debug)
-		// }}}
+		.i_wb_cyc(wbwide_bkram_cyc), .i_wb_stb(wbwide_bkram_stb), .i_wb_we(wbwide_bkram_we),
+			.i_wb_addr(wbwide_bkram_addr[16-1:0]),
+			.i_wb_data(wbwide_bkram_data), // 128 bits wide
+			.i_wb_sel(wbwide_bkram_sel),  // 128/8 bits wide
+		.o_wb_stall(wbwide_bkram_stall),.o_wb_ack(wbwide_bkram_ack), .o_wb_data(wbwide_bkram_idata)
 	);
 	// }}}
-	// }}}
-`else	// FLASH_ACCESS
+`else	// BKRAM_ACCESS
 	// {{{
-	assign	o_flash_sck  = 1'b1;
-	assign	o_flash_cs_n = 1'b1;
-	assign	o_flash_mod  = 2'b01;
-	assign	o_flash_dat  = 4'b1111;
-	// Verilator lint_off UNUSED
-	wire	flash_unused = &{ 1'b0, i_flash_dat };
-	// Verilator lint_on UNUSED
 	// Null bus slave
 	// {{{
 
 	//
-	// In the case that there is no wbflash_flash peripheral
-	// responding on the wbflash bus
-	assign	wbflash_flash_ack   = 1'b0;
-	assign	wbflash_flash_err   = (wbflash_flash_stb);
-	assign	wbflash_flash_stall = 0;
-	assign	wbflash_flash_idata = 0;
+	// In the case that there is no wbwide_bkram peripheral
+	// responding on the wbwide bus
+	assign	wbwide_bkram_ack   = 1'b0;
+	assign	wbwide_bkram_err   = (wbwide_bkram_stb);
+	assign	wbwide_bkram_stall = 0;
+	assign	wbwide_bkram_idata = 0;
 
 	// }}}
 	// }}}
-`endif	// FLASH_ACCESS
-
-`ifdef	I2CCPU_ACCESS
-	// {{{
-	////////////////////////////////////////////////////////////////////////
-	//
-	// The I2C Controller
-	// {{{
-
-	wbi2ccpu #(
-		.ADDRESS_WIDTH(27),
-		.DATA_WIDTH(128),
-		.AXIS_ID_WIDTH(2)
-	) u_i2c (
-		// {{{
-		.i_clk(i_clk), .i_reset(i_reset),
-		.i_wb_cyc(wb32_i2cs_cyc), .i_wb_stb(wb32_i2cs_stb), .i_wb_we(wb32_i2cs_we),
-			.i_wb_addr(wb32_i2cs_addr[2-1:0]),
-			.i_wb_data(wb32_i2cs_data), // 32 bits wide
-			.i_wb_sel(wb32_i2cs_sel),  // 32/8 bits wide
-		.o_wb_stall(wb32_i2cs_stall),.o_wb_ack(wb32_i2cs_ack), .o_wb_data(wb32_i2cs_idata),
-		.o_pf_cyc(wbwide_i2cm_cyc), .o_pf_stb(wbwide_i2cm_stb), .o_pf_we(wbwide_i2cm_we),
-			.o_pf_addr(wbwide_i2cm_addr[27-1:0]),
-			.o_pf_data(wbwide_i2cm_data), // 128 bits wide
-			.o_pf_sel(wbwide_i2cm_sel),  // 128/8 bits wide
-		.i_pf_stall(wbwide_i2cm_stall), .i_pf_ack(wbwide_i2cm_ack), .i_pf_data(wbwide_i2cm_idata), .i_pf_err(wbwide_i2cm_err),
-		.i_i2c_sda(i_i2c_sda), .i_i2c_scl(i_i2c_scl),
-		.o_i2c_sda(o_i2c_sda), .o_i2c_scl(o_i2c_scl),
-		.M_AXIS_TVALID(i2c_valid), .M_AXIS_TREADY(i2c_ready),
-			.M_AXIS_TDATA(i2c_data), .M_AXIS_TLAST(i2c_last),
-			.M_AXIS_TID(i2c_id),
-		.i_sync_signal(rtc_pps),
-		//
-		.o_interrupt(i2c_int),
-		.o_debug(i2c_debug)
-		// }}}
-	);
-
-	assign	i2c_ready = (!i2c_valid) || (1'b0
-			|| (i2c_id == 0)		// NULL address
-			|| (i2c_id == 1)
-`ifdef	I2CDMA_ACCESS
-			|| (i2c_id == 2 && i2cdma_ready)
-`else
-			|| (i2c_id == 2)
-`endif
-			|| (i2c_id > 2));
-
-	// }}}
-	// }}}
-`else	// I2CCPU_ACCESS
-	// {{{
-	assign	o_i2c_scl = 1'b1;
-	assign	o_i2c_sda = 1'b1;
-	// Null bus master
-	// {{{
-	// }}}
-	// Null interrupt definitions
-	// {{{
-	assign	i2c_int = 1'b0;	// i2c.INT.I2C.WIRE
-	// }}}
-	// }}}
-`endif	// I2CCPU_ACCESS
+`endif	// BKRAM_ACCESS
 
 	always @(posedge i_clk)
 	if (wbwide_zip_err)
@@ -2319,18 +2221,61 @@ module	main(i_clk, i_reset,
 	assign	wb32_buserr_ack  = wb32_buserr_stb;
 	assign	wb32_buserr_idata = { {(30-30){1'b0}},
 			r_buserr_addr, 2'b00 };
-`ifdef	GPSTRK_ACCESS
-	assign	wb32_subseconds_idata = gps_now[31:0];
-`else
+	initial	rtc_pps = 1'b0;
+	initial	rtc_pps_counter = 0;
 	always @(posedge i_clk)
-	if (wb32_subseconds_stb && wb32_subseconds_we)
-		r_subseconds_data <= wb32_subseconds_data;
-	else
-		r_subseconds_data <= r_subseconds_data
-			+ { 16'h0, RTC_CLKSTEP[31:16] };
+	if (rtc_pps_counter > 0)
+	begin
+		rtc_pps_counter <= rtc_pps_counter - 1;
+		rtc_pps <= 1'b0;
+	end else begin
+		rtc_pps_counter <= 27'd100_000_000 - 1;
+		rtc_pps <= 1'b1;
+	end
+`ifdef	RXETH0CK
+	// {{{
+	clkcounter #(
+		.CLOCKFREQ_HZ(0)	// We'll count PPS externally
+	) clkrxeth0ckctr(
+		.i_sys_clk(i_clk),
+		.i_tst_clk(i_eth0_rx_clk),
+		.i_sys_pps(rtc_pps),
+		.o_sys_counts(wb32_rxeth0ck_idata)
+	);
+
+	initial	r_rxeth0ck_ack = 0;
+	always @(posedge i_clk)
+		r_rxeth0ck_ack <= !i_reset && wb32_rxeth0ck_stb;
+	assign	wb32_rxeth0ck_ack   = r_rxeth0ck_ack;
+	assign	wb32_rxeth0ck_stall = 1'b0;
+	// }}}
+`else	// RXETH0CK
+	// {{{
+	// }}}
+`endif	// RXETH0CK
+
+`ifdef	TXCLK
+	// {{{
+	clkcounter #(
+		.CLOCKFREQ_HZ(0)	// We'll count PPS externally
+	) clktxclkctr(
+		.i_sys_clk(i_clk),
+		.i_tst_clk(i_net_tx_clk),
+		.i_sys_pps(rtc_pps),
+		.o_sys_counts(wb32_txclk_idata)
+	);
+
+	initial	r_txclk_ack = 0;
+	always @(posedge i_clk)
+		r_txclk_ack <= !i_reset && wb32_txclk_stb;
+	assign	wb32_txclk_ack   = r_txclk_ack;
+	assign	wb32_txclk_stall = 1'b0;
+	// }}}
+`else	// TXCLK
+	// {{{
+	// }}}
+`endif	// TXCLK
 
-	assign	wb32_subseconds_idata = r_subseconds_data;
-`endif
 `ifdef	ADCCLK
 	// {{{
 	clkcounter #(
@@ -2353,113 +2298,182 @@ module	main(i_clk, i_reset,
 	// }}}
 `endif	// ADCCLK
 
-`ifdef	EXBUS_MASTER
-	// {{{
-	////////////////////////////////////////////////////////////////////////
-	//
-	// EXBUS: USB-UART driven bus master and console
-	// {{{
-	// The Host USB interface, to be used by the WB-UART bus
-	rxuartlite	#(
+	wbdown #(
 		// {{{
-		.TIMER_BITS(DBGBUSBITS),
-		.CLOCKS_PER_BAUD(BUSUART[DBGBUSBITS-1:0])
+		// Slave bus address width: 27
+		// Slave address width    : 10
+		// Master address width   : 12
+		.ADDRESS_WIDTH(10+$clog2(128/8)),
+		.WIDE_DW(128),
+		.SMALL_DW(32),
+		.OPT_LITTLE_ENDIAN(1'b0),
+		.OPT_LOWLOGIC(1'b0)
 		// }}}
-	) rcv(
+	) u_crossbus (
 		// {{{
-		.i_clk(      i_clk),
-		.i_uart_rx(i_wbu_uart_rx),
-		.o_wr(       wbu_rx_stb),
-		.o_data(     wbu_rx_data)
-		// }}}
-	);
-
-	txuartlite	#(
+		.i_clk(i_clk),
+		.i_reset(i_reset),
+		// Slave/incoming
 		// {{{
-		.TIMING_BITS(DBGBUSBITS[4:0]),
-		.CLOCKS_PER_BAUD(BUSUART[DBGBUSBITS-1:0])
+		.i_wcyc(  wbwide_crossbus_cyc),
+		.i_wstb(  wbwide_crossbus_stb),
+		.i_wwe(   wbwide_crossbus_we),
+		.i_waddr( wbwide_crossbus_addr[10-1:0]),
+		.i_wdata( wbwide_crossbus_data),
+		.i_wsel(  wbwide_crossbus_sel),
+		.o_wstall(wbwide_crossbus_stall),
+		.o_wack(  wbwide_crossbus_ack),
+		.o_wdata( wbwide_crossbus_idata),
+		.o_werr(  wbwide_crossbus_err),
 		// }}}
-	) txv(
+		// Master/down-range/outgoing
 		// {{{
-		.i_clk(    i_clk),
-		.i_wr(     wbu_tx_stb),
-		.i_data(   wbu_tx_data),
-		.o_uart_tx(o_wbu_uart_tx),
-		.o_busy(   wbu_tx_busy)
+		.o_scyc(  wb32_crossbus_cyc),
+		.o_sstb(  wb32_crossbus_stb),
+		.o_swe(   wb32_crossbus_we),
+		.o_saddr( wb32_crossbus_addr[12-1:0]),
+		.o_sdata( wb32_crossbus_data),
+		.o_ssel(  wb32_crossbus_sel),
+		.i_sstall(wb32_crossbus_stall),
+		.i_sack(  wb32_crossbus_ack),
+		.i_sdata( wb32_crossbus_idata),
+		.i_serr(  wb32_crossbus_err)
+		// }}}
 		// }}}
 	);
-
-`ifndef	BUSPIC_ACCESS
-	wire	w_bus_int;
-	assign	w_bus_int = 1'b0;
-`endif
-	// Verilator lint_off UNUSED
-	wire	[29:0]	wbu_tmp_addr;
-	// Verilator lint_on  UNUSED
-	exbuswb #(
+`ifdef	SDRAM_ACCESS
+	// {{{
+	////////////////////////////////////////////////////////////////////////
+	//
+	// DDR3 Controller instantiation
+	// {{{
+           
+	ddr3_controller #(
 		// {{{
-		// .LGWATCHDOG(DBGBUSWATCHDOG)
-		.ADDRESS_WIDTH(30)
+		.CONTROLLER_CLK_PERIOD(SDRAMCONTROLLER_CLK_PERIOD), //ps, clock period of the controller interface
+		.DDR3_CLK_PERIOD(DDR3_CLK_PERIOD), //ps, clock period of the DDR3 RAM device (must be 1/4 of the CONTROLLER_CLK_PERIOD) 
+		.ROW_BITS(SDRAMROW_BITS),	//width of row address
+		.COL_BITS(SDRAMCOL_BITS),	//width of column address
+		.BA_BITS(SDRAMBA_BITS),	//width of bank address
+		.DQ_BITS(SDRAMDQ_BITS),	//width of DQ
+		.LANES(SDRAMBYTE_LANES),		// byte lanes
+		.AUX_WIDTH(SDRAMAUX_WIDTH),	//width of aux line (must be >= 4) 
+		.WB2_ADDR_BITS(7), 		//width of 2nd wishbone address bus 
+            	.WB2_DATA_BITS(32),  		//width of 2nd wishbone data bus
+		.MICRON_SIM(0),		//simulation for micron ddr3 model (shorten POWER_ON_RESET_HIGH and INITIAL_CKE_LOW)
+		.ODELAY_SUPPORTED(1),		//set to 1 when ODELAYE2 is supported
+		.SECOND_WISHBONE(1) 		//set to 1 if 2nd wishbone is needed 
 		// }}}
-	) u_exbus(
+	) u_ddr3 (
 		// {{{
-		.i_clk(i_clk), .i_reset(i_reset),
-		.o_reset(ex_reset),
-		.i_rx_stb(wbu_rx_stb), .i_rx_byte(wbu_rx_data),
-		.o_tx_stb(wbu_tx_stb), .o_tx_byte(wbu_tx_data),
-			.i_tx_busy(wbu_tx_busy),
-		//
-		.i_gpio(2'b00), .o_gpio(ex_gpio),
-		//
-		.i_console_stb(w_console_tx_stb),
-			.i_console_byte(w_console_tx_data),
-			.o_console_busy(w_console_busy),
-		.o_console_stb(w_console_rx_stb),
-			.o_console_byte(w_console_rx_data),
+		.i_controller_clk(i_clk), //i_controller_clk has period of CONTROLLER_CLK_PERIOD
+		.i_rst_n(!i_reset), //200MHz input clock
+		// Wishbone 1 (Controller)
+		.i_wb_cyc(wbwide_ddr3_cyc), .i_wb_stb(wbwide_ddr3_stb), .i_wb_we(wbwide_ddr3_we),
+			.i_wb_addr(wbwide_ddr3_addr[26-1:0]),
+			.i_wb_data(wbwide_ddr3_data), // 128 bits wide
+			.i_wb_sel(wbwide_ddr3_sel),  // 128/8 bits wide
+		.o_wb_stall(wbwide_ddr3_stall),.o_wb_ack(wbwide_ddr3_ack), .o_wb_data(wbwide_ddr3_idata),
+		.i_aux(0),
+		.o_aux(ddr3_aux_out),	// Leaving this empty would've caused a Verilator warning
+		// Wishbone 2 (PHY)
+		.i_wb2_cyc(wb32_ddr3_phy_cyc), .i_wb2_stb(wb32_ddr3_phy_stb), .i_wb2_we(wb32_ddr3_phy_we),
+			.i_wb2_addr(wb32_ddr3_phy_addr[7-1:0]),
+			.i_wb2_data(wb32_ddr3_phy_data), // 32 bits wide
+			.i_wb2_sel(wb32_ddr3_phy_sel),  // 32/8 bits wide
+		.o_wb2_stall(wb32_ddr3_phy_stall),.o_wb2_ack(wb32_ddr3_phy_ack), .o_wb2_data(wb32_ddr3_phy_idata),
 		//
-		.o_wb_cyc(wbu_cyc), .o_wb_stb(wbu_stb),
-			.o_wb_we(wbu_we),
-			.o_wb_addr(wbu_addr),
-			.o_wb_data(wbu_data),
-			.o_wb_sel(wbu_sel),
-		.i_wb_stall(wbu_stall),
-			.i_wb_ack(wbu_ack),
-		.i_wb_data(wbu_idata),
-		.i_wb_err(wbu_err),
-		.i_interrupt(w_bus_int)
+		// PHY interface
+		.i_phy_iserdes_data(i_ddr3_iserdes_data),
+		.i_phy_iserdes_dqs(i_ddr3_iserdes_dqs),
+		.i_phy_iserdes_bitslip_reference(i_ddr3_iserdes_bitslip_reference),
+		.i_phy_idelayctrl_rdy(i_ddr3_idelayctrl_rdy),
+		.o_phy_cmd(o_ddr3_cmd),
+		.o_phy_dqs_tri_control(o_ddr3_dqs_tri_control),
+		.o_phy_dq_tri_control(o_ddr3_dq_tri_control),
+		.o_phy_toggle_dqs(o_ddr3_toggle_dqs),
+		.o_phy_data(o_ddr3_data),
+		.o_phy_dm(o_ddr3_dm),
+		.o_phy_odelay_data_cntvaluein(o_ddr3_odelay_data_cntvaluein),
+		.o_phy_odelay_dqs_cntvaluein(o_ddr3_odelay_dqs_cntvaluein),
+		.o_phy_idelay_data_cntvaluein(o_ddr3_idelay_data_cntvaluein),
+		.o_phy_idelay_dqs_cntvaluein(o_ddr3_idelay_dqs_cntvaluein),
+		.o_phy_odelay_data_ld(o_ddr3_odelay_data_ld),
+		.o_phy_odelay_dqs_ld(o_ddr3_odelay_dqs_ld),
+		.o_phy_idelay_data_ld(o_ddr3_idelay_data_ld),
+		.o_phy_idelay_dqs_ld(o_ddr3_idelay_dqs_ld),
+		.o_phy_bitslip(o_ddr3_bitslip),
+		.o_phy_write_leveling_calib(o_ddr3_leveling_calib),
+		.o_phy_reset(o_ddr3_reset),
+		// Debug port
+		.o_debug1(ddr3_debug),
+		// Verilator lint_off PINCONNECTEMPTY
+		.o_debug2(),
+		.o_debug3()
+		// Verilator lint_on  PINCONNECTEMPTY
 		// }}}
 	);
 	// }}}
 	// }}}
-`else	// EXBUS_MASTER
+`else	// SDRAM_ACCESS
 	// {{{
-	// Null bus master
+	// Null bus slave
 	// {{{
+
+	//
+	// In the case that there is no wbwide_ddr3 peripheral
+	// responding on the wbwide bus
+	assign	wbwide_ddr3_ack   = 1'b0;
+	assign	wbwide_ddr3_err   = (wbwide_ddr3_stb);
+	assign	wbwide_ddr3_stall = 0;
+	assign	wbwide_ddr3_idata = 0;
+
 	// }}}
 	// }}}
-`endif	// EXBUS_MASTER
+`endif	// SDRAM_ACCESS
 
-`ifdef	FLASHCFG_ACCESS
+`ifdef	EDIDSLVSCOPE_SCOPC
 	// {{{
-	// The Flash control interface is defined by the flash instantiation
-	// hence we don't need to do anything to define it here.
+	wbscopc #(
+		// {{{
+		.LGMEM(13),
+		.SYNCHRONOUS(1),
+		.DEFAULT_HOLDOFF(0)
+		// }}}
+	) u_edidslvscope (
+		// {{{
+		.i_data_clk(i_clk), .i_ce(1'b1),
+		.i_trigger(edidslv_dbg[31]), .i_data(edidslv_dbg[30:0]),
+		.i_wb_clk(i_clk),
+		.i_wb_cyc(wb32_edidslvscope_cyc), .i_wb_stb(wb32_edidslvscope_stb), .i_wb_we(wb32_edidslvscope_we),
+			.i_wb_addr(wb32_edidslvscope_addr[1-1:0]),
+			.i_wb_data(wb32_edidslvscope_data), // 32 bits wide
+			.i_wb_sel(wb32_edidslvscope_sel),  // 32/8 bits wide
+		.o_wb_stall(wb32_edidslvscope_stall),.o_wb_ack(wb32_edidslvscope_ack), .o_wb_data(wb32_edidslvscope_idata),
+		.o_interrupt(edidslvscope_int)
+		// }}}
+	);
 	// }}}
-`else	// FLASHCFG_ACCESS
+`else	// EDIDSLVSCOPE_SCOPC
 	// {{{
 	// Null bus slave
 	// {{{
 
 	//
-	// In the case that there is no wb32_flashcfg peripheral
+	// In the case that there is no wb32_edidslvscope peripheral
 	// responding on the wb32 bus
-	assign	wb32_flashcfg_ack   = 1'b0;
-	assign	wb32_flashcfg_err   = (wb32_flashcfg_stb);
-	assign	wb32_flashcfg_stall = 0;
-	assign	wb32_flashcfg_idata = 0;
+	assign	wb32_edidslvscope_ack   = 1'b0;
+	assign	wb32_edidslvscope_err   = (wb32_edidslvscope_stb);
+	assign	wb32_edidslvscope_stall = 0;
+	assign	wb32_edidslvscope_idata = 0;
 
+	// }}}
+	// Null interrupt definitions
+	// {{{
+	assign	edidslvscope_int = 1'b0;	// edidslvscope.INT.EDIDSLVSCOPE.WIRE
 	// }}}
 	// }}}
-`endif	// FLASHCFG_ACCESS
+`endif	// EDIDSLVSCOPE_SCOPC
 
 `ifdef	EDID_ACCESS
 	// {{{
@@ -2513,119 +2527,6 @@ module	main(i_clk, i_reset,
 	// }}}
 `endif	// EDID_ACCESS
 
-`ifdef	GPSUART_ACCESS
-	// {{{
-	wbuart #(
-		.INITIAL_SETUP(31'h000028b0)
-	) u_gpsu_uart(
-		i_clk, 1'b0,
-		wb32_gpsu_cyc, wb32_gpsu_stb, wb32_gpsu_we,
-			wb32_gpsu_addr[2-1:0],
-			wb32_gpsu_data, // 32 bits wide
-			wb32_gpsu_sel,  // 32/8 bits wide
-		wb32_gpsu_stall, wb32_gpsu_ack, wb32_gpsu_idata,
-		i_gpsu_rx, o_gpsu_tx, w_gpsu_cts_n, w_gpsu_rts_n,
-		gpsurx_int, gpsutx_int,
-		gpsurxf_int, gpsutxf_int
-	);
-	// }}}
-`else	// GPSUART_ACCESS
-	// {{{
-	assign	o_gpsu_tx    = 1'b1;
-	assign	w_gpsu_rts_n = 1'b0;
-	// Null bus slave
-	// {{{
-
-	//
-	// In the case that there is no wb32_gpsu peripheral
-	// responding on the wb32 bus
-	assign	wb32_gpsu_ack   = 1'b0;
-	assign	wb32_gpsu_err   = (wb32_gpsu_stb);
-	assign	wb32_gpsu_stall = 0;
-	assign	wb32_gpsu_idata = 0;
-
-	// }}}
-	// Null interrupt definitions
-	// {{{
-	assign	gpsurxf_int = 1'b0;	// gpsu.INT.GPSRXF.WIRE
-	assign	gpsutxf_int = 1'b0;	// gpsu.INT.GPSTXF.WIRE
-	assign	gpsutx_int = 1'b0;	// gpsu.INT.GPSTX.WIRE
-	assign	gpsurx_int = 1'b0;	// gpsu.INT.GPSRX.WIRE
-	// }}}
-	// }}}
-`endif	// GPSUART_ACCESS
-
-`ifdef	VIDPIPE_ACCESS
-	// {{{
-	////////////////////////////////////////////////////////////////////////
-	//
-	// HDMI Video processing pipeline
-	// {{{
-`ifdef	VERILATOR
-	assign	i_hdmiclk = i_pixclk;
-`endif
-
-	vidpipe #(
-		.AW(27),
-		.DW(128)
-	) u_hdmi (
-		.i_clk(i_clk), .i_reset(i_reset),
-		.i_wb_cyc(wb32_hdmi_cyc), .i_wb_stb(wb32_hdmi_stb), .i_wb_we(wb32_hdmi_we),
-			.i_wb_addr(wb32_hdmi_addr[10-1:0]),
-			.i_wb_data(wb32_hdmi_data), // 32 bits wide
-			.i_wb_sel(wb32_hdmi_sel),  // 32/8 bits wide
-		.o_wb_stall(wb32_hdmi_stall),.o_wb_ack(wb32_hdmi_ack), .o_wb_data(wb32_hdmi_idata),
-		.i_hdmiclk(i_hdmiclk),
-		.i_altclk(i_pixclk),
-		.i_pixclk(i_pixclk),
-		.i_hdmi_red(i_hdmi_red), .i_hdmi_grn(i_hdmi_grn),
-				.i_hdmi_blu(i_hdmi_blu),
-		.o_dma_cyc(wbwide_hdmi_cyc), .o_dma_stb(wbwide_hdmi_stb), .o_dma_we(wbwide_hdmi_we),
-			.o_dma_addr(wbwide_hdmi_addr[27-1:0]),
-			.o_dma_data(wbwide_hdmi_data), // 128 bits wide
-			.o_dma_sel(wbwide_hdmi_sel),  // 128/8 bits wide
-		.i_dma_stall(wbwide_hdmi_stall), .i_dma_ack(wbwide_hdmi_ack), .i_dma_data(wbwide_hdmi_idata), .i_dma_err(wbwide_hdmi_err),
-		.o_hdmi_red(o_hdmi_red), .o_hdmi_grn(o_hdmi_grn),
-				.o_hdmi_blu(o_hdmi_blu),
-		.o_pix_reset_n(o_pix_reset_n),
-		.i_pxpll_locked(i_pxpll_locked),
-		.o_hdmirx_reset_n(o_hdmirx_reset_n),
-		.o_pxclk_sel(o_pxclk_cksel),
-		.o_iodelay(o_hdmi_iodelay),
-		.i_iodelay(i_hdmi_iodelay),
-		.o_interrupt(hdmi_int),
-		//
-		.o_dbg_ce(hdmidbg_ce),
-		.o_dbg_trigger(hdmidbg_trigger),
-		.o_pixdebug(hdmiclr_debug)
-	);
-
-	// }}}
-	// }}}
-`else	// VIDPIPE_ACCESS
-	// {{{
-	// Null bus master
-	// {{{
-	// }}}
-	// Null bus slave
-	// {{{
-
-	//
-	// In the case that there is no wb32_hdmi peripheral
-	// responding on the wb32 bus
-	assign	wb32_hdmi_ack   = 1'b0;
-	assign	wb32_hdmi_err   = (wb32_hdmi_stb);
-	assign	wb32_hdmi_stall = 0;
-	assign	wb32_hdmi_idata = 0;
-
-	// }}}
-	// Null interrupt definitions
-	// {{{
-	assign	hdmi_int = 1'b0;	// hdmi.INT.VIDFRAME.WIRE
-	// }}}
-	// }}}
-`endif	// VIDPIPE_ACCESS
-
 	////////////////////////////////////////////////////////////////////////
 	//
 	// EDIDRX
@@ -2648,54 +2549,187 @@ module	main(i_clk, i_reset,
 	);
 	// }}}
 
-`ifdef	EDIDSLVSCOPE_SCOPC
+`ifdef	EXBUS_MASTER
 	// {{{
-	wbscopc #(
+	////////////////////////////////////////////////////////////////////////
+	//
+	// EXBUS: USB-UART driven bus master and console
+	// {{{
+	// The Host USB interface, to be used by the WB-UART bus
+	rxuartlite	#(
 		// {{{
-		.LGMEM(13),
-		.SYNCHRONOUS(1),
-		.DEFAULT_HOLDOFF(0)
+		.TIMER_BITS(DBGBUSBITS),
+		.CLOCKS_PER_BAUD(BUSUART[DBGBUSBITS-1:0])
 		// }}}
-	) u_edidslvscope (
+	) rcv(
 		// {{{
-		.i_data_clk(i_clk), .i_ce(1'b1),
-		.i_trigger(edidslv_dbg[31]), .i_data(edidslv_dbg[30:0]),
-		.i_wb_clk(i_clk),
-		.i_wb_cyc(wb32_edidslvscope_cyc), .i_wb_stb(wb32_edidslvscope_stb), .i_wb_we(wb32_edidslvscope_we),
-			.i_wb_addr(wb32_edidslvscope_addr[1-1:0]),
-			.i_wb_data(wb32_edidslvscope_data), // 32 bits wide
-			.i_wb_sel(wb32_edidslvscope_sel),  // 32/8 bits wide
-		.o_wb_stall(wb32_edidslvscope_stall),.o_wb_ack(wb32_edidslvscope_ack), .o_wb_data(wb32_edidslvscope_idata),
-		.o_interrupt(edidslvscope_int)
+		.i_clk(      i_clk),
+		.i_uart_rx(i_wbu_uart_rx),
+		.o_wr(       wbu_rx_stb),
+		.o_data(     wbu_rx_data)
 		// }}}
 	);
-	// }}}
-`else	// EDIDSLVSCOPE_SCOPC
-	// {{{
-	// Null bus slave
-	// {{{
-
-	//
-	// In the case that there is no wb32_edidslvscope peripheral
-	// responding on the wb32 bus
-	assign	wb32_edidslvscope_ack   = 1'b0;
-	assign	wb32_edidslvscope_err   = (wb32_edidslvscope_stb);
-	assign	wb32_edidslvscope_stall = 0;
-	assign	wb32_edidslvscope_idata = 0;
-
-	// }}}
-	// Null interrupt definitions
-	// {{{
-	assign	edidslvscope_int = 1'b0;	// edidslvscope.INT.EDIDSLVSCOPE.WIRE
-	// }}}
-	// }}}
-`endif	// EDIDSLVSCOPE_SCOPC
 
-	wbdown #(
+	txuartlite	#(
 		// {{{
-		// Slave bus address width: 27
-		// Slave address width    : 21
-		// Master address width   : 23
+		.TIMING_BITS(DBGBUSBITS[4:0]),
+		.CLOCKS_PER_BAUD(BUSUART[DBGBUSBITS-1:0])
+		// }}}
+	) txv(
+		// {{{
+		.i_clk(    i_clk),
+		.i_wr(     wbu_tx_stb),
+		.i_data(   wbu_tx_data),
+		.o_uart_tx(o_wbu_uart_tx),
+		.o_busy(   wbu_tx_busy)
+		// }}}
+	);
+
+`ifndef	BUSPIC_ACCESS
+	wire	w_bus_int;
+	assign	w_bus_int = 1'b0;
+`endif
+	// Verilator lint_off UNUSED
+	wire	[29:0]	wbu_tmp_addr;
+	// Verilator lint_on  UNUSED
+	exbuswb #(
+		// {{{
+		// .LGWATCHDOG(DBGBUSWATCHDOG)
+		.ADDRESS_WIDTH(30)
+		// }}}
+	) u_exbus(
+		// {{{
+		.i_clk(i_clk), .i_reset(i_reset),
+		.o_reset(ex_reset),
+		.i_rx_stb(wbu_rx_stb), .i_rx_byte(wbu_rx_data),
+		.o_tx_stb(wbu_tx_stb), .o_tx_byte(wbu_tx_data),
+			.i_tx_busy(wbu_tx_busy),
+		//
+		.i_gpio(2'b00), .o_gpio(ex_gpio),
+		//
+		.i_console_stb(w_console_tx_stb),
+			.i_console_byte(w_console_tx_data),
+			.o_console_busy(w_console_busy),
+		.o_console_stb(w_console_rx_stb),
+			.o_console_byte(w_console_rx_data),
+		//
+		.o_wb_cyc(wbu_cyc), .o_wb_stb(wbu_stb),
+			.o_wb_we(wbu_we),
+			.o_wb_addr(wbu_addr),
+			.o_wb_data(wbu_data),
+			.o_wb_sel(wbu_sel),
+		.i_wb_stall(wbu_stall),
+			.i_wb_ack(wbu_ack),
+		.i_wb_data(wbu_idata),
+		.i_wb_err(wbu_err),
+		.i_interrupt(w_bus_int)
+		// }}}
+	);
+	// }}}
+	// }}}
+`else	// EXBUS_MASTER
+	// {{{
+	// Null bus master
+	// {{{
+	// }}}
+	// }}}
+`endif	// EXBUS_MASTER
+
+`ifdef	FLASHCFG_ACCESS
+	// {{{
+	// The Flash control interface is defined by the flash instantiation
+	// hence we don't need to do anything to define it here.
+	// }}}
+`else	// FLASHCFG_ACCESS
+	// {{{
+	// Null bus slave
+	// {{{
+
+	//
+	// In the case that there is no wb32_flashcfg peripheral
+	// responding on the wb32 bus
+	assign	wb32_flashcfg_ack   = 1'b0;
+	assign	wb32_flashcfg_err   = (wb32_flashcfg_stb);
+	assign	wb32_flashcfg_stall = 0;
+	assign	wb32_flashcfg_idata = 0;
+
+	// }}}
+	// }}}
+`endif	// FLASHCFG_ACCESS
+
+`ifdef	FLASH_ACCESS
+	// {{{
+	////////////////////////////////////////////////////////////////////////
+	//
+	// Flash controller
+	// {{{
+	qflexpress #(
+		// {{{
+		.LGFLASHSZ(24), .OPT_CLKDIV(1),
+		.OPT_ENDIANSWAP(0),
+		.NDUMMY(6), .RDDELAY(2),
+		.OPT_STARTUP_FILE("spansion.hex"),
+`ifdef	FLASHCFG_ACCESS
+		.OPT_CFG(1'b1)
+`else
+		.OPT_CFG(1'b0)
+`endif
+		// }}}
+	) u_flash (
+		// {{{
+		.i_clk(i_clk),
+		.i_reset(i_reset),
+		// Primary memory reading inputs
+		.i_wb_cyc(wbflash_flash_cyc), .i_wb_stb(wbflash_flash_stb), .i_wb_we(wbflash_flash_we),
+			.i_wb_addr(wbflash_flash_addr[22-1:0]),
+			.i_wb_data(wbflash_flash_data), // 32 bits wide
+			.i_wb_sel(wbflash_flash_sel),  // 32/8 bits wide
+		.o_wb_stall(wbflash_flash_stall),.o_wb_ack(wbflash_flash_ack), .o_wb_data(wbflash_flash_idata),
+		// Configuration bus ports
+		.i_cfg_cyc(wb32_flashcfg_cyc), .i_cfg_stb(wb32_flashcfg_stb), .i_cfg_we(wb32_flashcfg_we),
+			.i_cfg_data(wb32_flashcfg_data), // 32 bits wide
+			.i_cfg_sel(wb32_flashcfg_sel),  // 32/8 bits wide
+		.o_cfg_stall(wb32_flashcfg_stall),.o_cfg_ack(wb32_flashcfg_ack), .o_cfg_data(wb32_flashcfg_idata),
+		.o_qspi_sck(o_flash_sck),
+		.o_qspi_cs_n(o_flash_cs_n),
+		.o_qspi_mod(o_flash_mod),
+		.o_qspi_dat(o_flash_dat),
+		.i_qspi_dat(i_flash_dat),
+		.o_dbg_trigger(flash_dbg_trigger),
+		.o_debug(flash_debug)
+		// }}}
+	);
+	// }}}
+	// }}}
+`else	// FLASH_ACCESS
+	// {{{
+	assign	o_flash_sck  = 1'b1;
+	assign	o_flash_cs_n = 1'b1;
+	assign	o_flash_mod  = 2'b01;
+	assign	o_flash_dat  = 4'b1111;
+	// Verilator lint_off UNUSED
+	wire	flash_unused = &{ 1'b0, i_flash_dat };
+	// Verilator lint_on UNUSED
+	// Null bus slave
+	// {{{
+
+	//
+	// In the case that there is no wbflash_flash peripheral
+	// responding on the wbflash bus
+	assign	wbflash_flash_ack   = 1'b0;
+	assign	wbflash_flash_err   = (wbflash_flash_stb);
+	assign	wbflash_flash_stall = 0;
+	assign	wbflash_flash_idata = 0;
+
+	// }}}
+	// }}}
+`endif	// FLASH_ACCESS
+
+	wbdown #(
+		// {{{
+		// Slave bus address width: 27
+		// Slave address width    : 21
+		// Master address width   : 23
 		.ADDRESS_WIDTH(21+$clog2(128/8)),
 		.WIDE_DW(128),
 		.SMALL_DW(32),
@@ -2734,278 +2768,312 @@ module	main(i_clk, i_reset,
 		// }}}
 		// }}}
 	);
-`ifdef	CFG_ACCESS
+`ifdef	GPIO_ACCESS
 	// {{{
 	////////////////////////////////////////////////////////////////////////
 	//
-	// ICAPE2 driver/controller
+	// GPIO
 	// {{{
-	////////////////////////////////////////////////////////////////////////
-	//
+	// This interface should allow us to control up to 16 GPIO inputs,
+	// and another 16 GPIO outputs.  The interrupt trips when any of
+	// the inputs changes.  (Sorry, which input isn't (yet) selectable.)
 	//
-`ifdef	VERILATOR
-	reg	r_icape_ack;
+	localparam [NGPO-1:0]	INITIAL_GPIO = 10'h13;
 
-	initial	r_icape_ack = 1'b0;
-	always @(posedge i_clk)
-		r_icape_ack <= wb32_icape_stb;
-	assign	wb32_icape_ack   = r_icape_ack;
-	assign	wb32_icape_stall = 1'b0;
-	assign	wb32_icape_idata = 32'h00;
-`else
-	wbicapetwo #(
-		.LGDIV(ICAPE_LGDIV)
-	) u_icape (
+	wbgpio	#(
+		.NIN(NGPI), .NOUT(NGPO), .DEFAULT(INITIAL_GPIO)
+	) u_gpio (
 		// {{{
-		.i_clk(i_clk), .i_reset(i_reset),
-		.i_wb_cyc(wb32_icape_cyc), .i_wb_stb(wb32_icape_stb), .i_wb_we(wb32_icape_we),
-			.i_wb_addr(wb32_icape_addr[5-1:0]),
-			.i_wb_data(wb32_icape_data), // 32 bits wide
-			.i_wb_sel(wb32_icape_sel),  // 32/8 bits wide
-		.o_wb_stall(wb32_icape_stall),.o_wb_ack(wb32_icape_ack), .o_wb_data(wb32_icape_idata)
+		.i_clk(i_clk),
+		.i_wb_cyc(wb32_gpio_cyc), .i_wb_stb(wb32_gpio_stb), .i_wb_we(wb32_gpio_we),
+			.i_wb_data(wb32_gpio_data), // 32 bits wide
+			.i_wb_sel(wb32_gpio_sel),  // 32/8 bits wide
+		.o_wb_stall(wb32_gpio_stall),.o_wb_ack(wb32_gpio_ack), .o_wb_data(wb32_gpio_idata),
+		.i_gpio(i_gpio), .o_gpio(o_gpio),
+		.o_int(gpio_int)
 		// }}}
 	);
+
+`ifdef	SDIO_ACCESS
+	// This bit is used by the SDSPI controller, not the SDIO controller.
+	assign	sd_reset = !o_sdio_hwreset_n;
+`else
+	assign	sd_reset = o_gpio[3];
+`endif
+
+`ifdef	VERILATOR
+	wire	verilator_halt;
+	assign	o_trace = o_gpio[8];
+
+	assign	verilator_halt = o_gpio[9];
+	assign	o_halt = verilator_halt;
+	always @(posedge verilator_halt)
+		$finish;
 `endif
 	// }}}
 	// }}}
-`else	// CFG_ACCESS
+`else	// GPIO_ACCESS
 	// {{{
-	// Null bus slave
+	// Null interrupt definitions
 	// {{{
-
-	//
-	// In the case that there is no wb32_icape peripheral
-	// responding on the wb32 bus
-	assign	wb32_icape_ack   = 1'b0;
-	assign	wb32_icape_err   = (wb32_icape_stb);
-	assign	wb32_icape_stall = 0;
-	assign	wb32_icape_idata = 0;
-
+	assign	gpio_int = 1'b0;	// gpio.INT.GPIO.WIRE
 	// }}}
 	// }}}
-`endif	// CFG_ACCESS
+`endif	// GPIO_ACCESS
 
-`ifdef	TXCLK
+`ifdef	GPSTRK_ACCESS
 	// {{{
-	clkcounter #(
-		.CLOCKFREQ_HZ(0)	// We'll count PPS externally
-	) clktxclkctr(
-		.i_sys_clk(i_clk),
-		.i_tst_clk(i_net_tx_clk),
-		.i_sys_pps(rtc_pps),
-		.o_sys_counts(wb32_txclk_idata)
+	// Verilator lint_off UNUSED
+	wire	[1:0]	ck_dbg;
+	// Verilator lint_on  UNUSED
+
+	gpsclock #(
+		.DEFAULT_STEP(GPSCLOCK_DEFAULT_STEP)
+	) ppsck (
+		.i_clk(i_clk), .i_rst(1'b0), .i_pps(gps_pps), .o_pps(ck_pps),
+			.o_led(gps_led),
+		.i_wb_cyc(wb32_gck_cyc), .i_wb_stb(wb32_gck_stb), .i_wb_we(wb32_gck_we),
+			.i_wb_addr(wb32_gck_addr[2-1:0]),
+			.i_wb_data(wb32_gck_data), // 32 bits wide
+			.i_wb_sel(wb32_gck_sel),  // 32/8 bits wide
+		.o_wb_stall(wb32_gck_stall),.o_wb_ack(wb32_gck_ack), .o_wb_data(wb32_gck_idata),
+		.o_tracking(gps_tracking), .o_count(gps_now), .o_step(gps_step),
+		.o_err(gps_err), .o_locked(gps_locked), .o_dbg(ck_dbg)
 	);
 
-	initial	r_txclk_ack = 0;
-	always @(posedge i_clk)
-		r_txclk_ack <= !i_reset && wb32_txclk_stb;
-	assign	wb32_txclk_ack   = r_txclk_ack;
-	assign	wb32_txclk_stall = 1'b0;
-	// }}}
-`else	// TXCLK
-	// {{{
-	// }}}
-`endif	// TXCLK
+	assign	gck_pps = ck_pps;
 
-`ifdef	RXETH0CK
+	// }}}
+`else	// GPSTRK_ACCESS
 	// {{{
-	clkcounter #(
-		.CLOCKFREQ_HZ(0)	// We'll count PPS externally
-	) clkrxeth0ckctr(
-		.i_sys_clk(i_clk),
-		.i_tst_clk(i_eth0_rx_clk),
-		.i_sys_pps(rtc_pps),
-		.o_sys_counts(wb32_rxeth0ck_idata)
-	);
+	reg		r_ck_pps;
+	reg	[63:0]	r_gps_now;
+	reg	[31:0]	r_gps_prior;
+	wire	[47:0]	pre_step;
+	assign	pre_step = { 16'h00, (({GPSCLOCK_DEFAULT_STEP[27:0],20'h00})
+				>>GPSCLOCK_DEFAULT_STEP[31:28]) };
 
-	initial	r_rxeth0ck_ack = 0;
+	initial	{ r_ck_pps, r_gps_prior } = 33'h0;
 	always @(posedge i_clk)
-		r_rxeth0ck_ack <= !i_reset && wb32_rxeth0ck_stb;
-	assign	wb32_rxeth0ck_ack   = r_rxeth0ck_ack;
-	assign	wb32_rxeth0ck_stall = 1'b0;
-	// }}}
-`else	// RXETH0CK
-	// {{{
-	// }}}
-`endif	// RXETH0CK
+		{ r_ck_pps, r_gps_prior[31:0] } <= r_gps_prior + pre_step[31:0];
 
-	initial	rtc_pps = 1'b0;
-	initial	rtc_pps_counter = 0;
+	initial	r_gps_now = 64'h0;
 	always @(posedge i_clk)
-	if (rtc_pps_counter > 0)
 	begin
-		rtc_pps_counter <= rtc_pps_counter - 1;
-		rtc_pps <= 1'b0;
-	end else begin
-		rtc_pps_counter <= 27'd100_000_000 - 1;
-		rtc_pps <= 1'b1;
+		r_gps_now[63:32] <= r_gps_now[63:32]+(r_ck_pps ? 32'h1:32'h0);
+		r_gps_now[31:0]  <= r_gps_prior;
 	end
-`ifdef	BKRAM_ACCESS
+	assign	ck_pps     = r_ck_pps;
+	assign	gps_now    = r_gps_now;
+	assign	gps_err    = 64'h0;
+	assign	gps_step   = pre_step;
+	assign	gps_led    = 1'b0;
+	assign	gps_locked = 1'b0;
+
+	// Null interrupt definitions
 	// {{{
-	memdev #(
-		.LGMEMSZ(20),
-		.DW(128),
-		.EXTRACLOCK(1)
-	) u_bkram (
-		.i_clk(i_clk),
-		.i_reset(i_reset),
-		.i_wb_cyc(wbwide_bkram_cyc), .i_wb_stb(wbwide_bkram_stb), .i_wb_we(wbwide_bkram_we),
-			.i_wb_addr(wbwide_bkram_addr[16-1:0]),
-			.i_wb_data(wbwide_bkram_data), // 128 bits wide
-			.i_wb_sel(wbwide_bkram_sel),  // 128/8 bits wide
-		.o_wb_stall(wbwide_bkram_stall),.o_wb_ack(wbwide_bkram_ack), .o_wb_data(wbwide_bkram_idata)
+	assign	gck_pps = 1'b0;	// gck.INT.PPS.WIRE
+	// }}}
+	// }}}
+`endif	// GPSTRK_ACCESS
+
+	// Generate a PPS signal independent of the GPS--useful for testing
+	gpsclock_tb #(
+		.CLOCK_FREQUENCY_HZ(100000000)
+	) ppstb(
+		.i_clk(i_clk), .i_lcl_pps(ck_pps), .o_pps(tb_pps),
+		.i_wb_cyc(wb32_gtb_cyc), .i_wb_stb(wb32_gtb_stb), .i_wb_we(wb32_gtb_we),
+			.i_wb_addr(wb32_gtb_addr[3-1:0]),
+			.i_wb_data(wb32_gtb_data), // 32 bits wide
+			.i_wb_sel(wb32_gtb_sel),  // 32/8 bits wide
+		.o_wb_stall(wb32_gtb_stall),.o_wb_ack(wb32_gtb_ack), .o_wb_data(wb32_gtb_idata),
+		.i_err(gps_err), .i_count(gps_now), .i_step(gps_step)
+	);
+
+	assign	gps_pps = tb_pps;
+`ifdef	GPSUART_ACCESS
+	// {{{
+	wbuart #(
+		.INITIAL_SETUP(31'h000028b0)
+	) u_gpsu_uart(
+		i_clk, 1'b0,
+		wb32_gpsu_cyc, wb32_gpsu_stb, wb32_gpsu_we,
+			wb32_gpsu_addr[2-1:0],
+			wb32_gpsu_data, // 32 bits wide
+			wb32_gpsu_sel,  // 32/8 bits wide
+		wb32_gpsu_stall, wb32_gpsu_ack, wb32_gpsu_idata,
+		i_gpsu_rx, o_gpsu_tx, w_gpsu_cts_n, w_gpsu_rts_n,
+		gpsurx_int, gpsutx_int,
+		gpsurxf_int, gpsutxf_int
 	);
 	// }}}
-`else	// BKRAM_ACCESS
+`else	// GPSUART_ACCESS
 	// {{{
+	assign	o_gpsu_tx    = 1'b1;
+	assign	w_gpsu_rts_n = 1'b0;
 	// Null bus slave
 	// {{{
 
 	//
-	// In the case that there is no wbwide_bkram peripheral
-	// responding on the wbwide bus
-	assign	wbwide_bkram_ack   = 1'b0;
-	assign	wbwide_bkram_err   = (wbwide_bkram_stb);
-	assign	wbwide_bkram_stall = 0;
-	assign	wbwide_bkram_idata = 0;
+	// In the case that there is no wb32_gpsu peripheral
+	// responding on the wb32 bus
+	assign	wb32_gpsu_ack   = 1'b0;
+	assign	wb32_gpsu_err   = (wb32_gpsu_stb);
+	assign	wb32_gpsu_stall = 0;
+	assign	wb32_gpsu_idata = 0;
 
+	// }}}
+	// Null interrupt definitions
+	// {{{
+	assign	gpsurx_int = 1'b0;	// gpsu.INT.GPSRX.WIRE
+	assign	gpsutx_int = 1'b0;	// gpsu.INT.GPSTX.WIRE
+	assign	gpsurxf_int = 1'b0;	// gpsu.INT.GPSRXF.WIRE
+	assign	gpsutxf_int = 1'b0;	// gpsu.INT.GPSTXF.WIRE
 	// }}}
 	// }}}
-`endif	// BKRAM_ACCESS
+`endif	// GPSUART_ACCESS
 
-	wbdown #(
-		// {{{
-		// Slave bus address width: 27
-		// Slave address width    : 10
-		// Master address width   : 12
-		.ADDRESS_WIDTH(10+$clog2(128/8)),
-		.WIDE_DW(128),
-		.SMALL_DW(32),
-		.OPT_LITTLE_ENDIAN(1'b0),
-		.OPT_LOWLOGIC(1'b0)
-		// }}}
-	) u_crossbus (
-		// {{{
-		.i_clk(i_clk),
-		.i_reset(i_reset),
-		// Slave/incoming
-		// {{{
-		.i_wcyc(  wbwide_crossbus_cyc),
-		.i_wstb(  wbwide_crossbus_stb),
-		.i_wwe(   wbwide_crossbus_we),
-		.i_waddr( wbwide_crossbus_addr[10-1:0]),
-		.i_wdata( wbwide_crossbus_data),
-		.i_wsel(  wbwide_crossbus_sel),
-		.o_wstall(wbwide_crossbus_stall),
-		.o_wack(  wbwide_crossbus_ack),
-		.o_wdata( wbwide_crossbus_idata),
-		.o_werr(  wbwide_crossbus_err),
-		// }}}
-		// Master/down-range/outgoing
-		// {{{
-		.o_scyc(  wb32_crossbus_cyc),
-		.o_sstb(  wb32_crossbus_stb),
-		.o_swe(   wb32_crossbus_we),
-		.o_saddr( wb32_crossbus_addr[12-1:0]),
-		.o_sdata( wb32_crossbus_data),
-		.o_ssel(  wb32_crossbus_sel),
-		.i_sstall(wb32_crossbus_stall),
-		.i_sack(  wb32_crossbus_ack),
-		.i_sdata( wb32_crossbus_idata),
-		.i_serr(  wb32_crossbus_err)
-		// }}}
-		// }}}
+`ifdef	VIDPIPE_ACCESS
+	// {{{
+	////////////////////////////////////////////////////////////////////////
+	//
+	// HDMI Video processing pipeline
+	// {{{
+`ifdef	VERILATOR
+	assign	i_hdmiclk = i_pixclk;
+`endif
+
+	vidpipe #(
+		.AW(27),
+		.DW(128)
+	) u_hdmi (
+		.i_clk(i_clk), .i_reset(i_reset),
+		.i_wb_cyc(wb32_hdmi_cyc), .i_wb_stb(wb32_hdmi_stb), .i_wb_we(wb32_hdmi_we),
+			.i_wb_addr(wb32_hdmi_addr[10-1:0]),
+			.i_wb_data(wb32_hdmi_data), // 32 bits wide
+			.i_wb_sel(wb32_hdmi_sel),  // 32/8 bits wide
+		.o_wb_stall(wb32_hdmi_stall),.o_wb_ack(wb32_hdmi_ack), .o_wb_data(wb32_hdmi_idata),
+		.i_hdmiclk(i_hdmiclk),
+		.i_altclk(i_pixclk),
+		.i_pixclk(i_pixclk),
+		.i_hdmi_red(i_hdmi_red), .i_hdmi_grn(i_hdmi_grn),
+				.i_hdmi_blu(i_hdmi_blu),
+		.o_dma_cyc(wbwide_hdmi_cyc), .o_dma_stb(wbwide_hdmi_stb), .o_dma_we(wbwide_hdmi_we),
+			.o_dma_addr(wbwide_hdmi_addr[27-1:0]),
+			.o_dma_data(wbwide_hdmi_data), // 128 bits wide
+			.o_dma_sel(wbwide_hdmi_sel),  // 128/8 bits wide
+		.i_dma_stall(wbwide_hdmi_stall), .i_dma_ack(wbwide_hdmi_ack), .i_dma_data(wbwide_hdmi_idata), .i_dma_err(wbwide_hdmi_err),
+		.o_hdmi_red(o_hdmi_red), .o_hdmi_grn(o_hdmi_grn),
+				.o_hdmi_blu(o_hdmi_blu),
+		.o_pix_reset_n(o_pix_reset_n),
+		.i_pxpll_locked(i_pxpll_locked),
+		.o_hdmirx_reset_n(o_hdmirx_reset_n),
+		.o_pxclk_sel(o_pxclk_cksel),
+		.o_iodelay(o_hdmi_iodelay),
+		.i_iodelay(i_hdmi_iodelay),
+		.o_interrupt(hdmi_int),
+		//
+		.o_dbg_ce(hdmidbg_ce),
+		.o_dbg_trigger(hdmidbg_trigger),
+		.o_pixdebug(hdmiclr_debug)
 	);
-`ifdef	SDRAM_ACCESS
+
+	// }}}
+	// }}}
+`else	// VIDPIPE_ACCESS
+	// {{{
+	// Null bus master
+	// {{{
+	// }}}
+	// Null bus slave
+	// {{{
+
+	//
+	// In the case that there is no wb32_hdmi peripheral
+	// responding on the wb32 bus
+	assign	wb32_hdmi_ack   = 1'b0;
+	assign	wb32_hdmi_err   = (wb32_hdmi_stb);
+	assign	wb32_hdmi_stall = 0;
+	assign	wb32_hdmi_idata = 0;
+
+	// }}}
+	// Null interrupt definitions
+	// {{{
+	assign	hdmi_int = 1'b0;	// hdmi.INT.VIDFRAME.WIRE
+	// }}}
+	// }}}
+`endif	// VIDPIPE_ACCESS
+
+	assign	o_pxclk_cyc  = wb32_pxclk_cyc;
+	assign	o_pxclk_stb  = wb32_pxclk_stb;
+	assign	o_pxclk_we   = wb32_pxclk_we;
+	assign	o_pxclk_addr = wb32_pxclk_addr[6:0];
+	assign	o_pxclk_data = wb32_pxclk_data;
+	assign	o_pxclk_sel  = wb32_pxclk_sel;
+	assign	wb32_pxclk_stall = i_pxclk_stall;
+	assign	wb32_pxclk_ack   = i_pxclk_ack;
+	assign	wb32_pxclk_idata = i_pxclk_idata;
+`ifdef	I2CCPU_ACCESS
 	// {{{
 	////////////////////////////////////////////////////////////////////////
 	//
-	// DDR3 Controller instantiation
+	// The I2C Controller
 	// {{{
-           
-	ddr3_controller #(
-		// {{{
-		.CONTROLLER_CLK_PERIOD(SDRAMCONTROLLER_CLK_PERIOD), //ps, clock period of the controller interface
-		.DDR3_CLK_PERIOD(DDR3_CLK_PERIOD), //ps, clock period of the DDR3 RAM device (must be 1/4 of the CONTROLLER_CLK_PERIOD) 
-		.ROW_BITS(SDRAMROW_BITS),	//width of row address
-		.COL_BITS(SDRAMCOL_BITS),	//width of column address
-		.BA_BITS(SDRAMBA_BITS),	//width of bank address
-		.DQ_BITS(SDRAMDQ_BITS),	//width of DQ
-		.LANES(SDRAMBYTE_LANES),		// byte lanes
-		.AUX_WIDTH(SDRAMAUX_WIDTH),	//width of aux line (must be >= 4) 
-		.WB2_ADDR_BITS(7), 		//width of 2nd wishbone address bus 
-            	.WB2_DATA_BITS(32),  		//width of 2nd wishbone data bus
-		.MICRON_SIM(0),		//simulation for micron ddr3 model (shorten POWER_ON_RESET_HIGH and INITIAL_CKE_LOW)
-		.ODELAY_SUPPORTED(1),		//set to 1 when ODELAYE2 is supported
-		.SECOND_WISHBONE(1) 		//set to 1 if 2nd wishbone is needed 
-		// }}}
-	) u_ddr3 (
+
+	wbi2ccpu #(
+		.ADDRESS_WIDTH(27),
+		.DATA_WIDTH(128),
+		.AXIS_ID_WIDTH(2)
+	) u_i2c (
 		// {{{
-		.i_controller_clk(i_clk), //i_controller_clk has period of CONTROLLER_CLK_PERIOD
-		.i_rst_n(!i_reset), //200MHz input clock
-		// Wishbone 1 (Controller)
-		.i_wb_cyc(wbwide_ddr3_cyc), .i_wb_stb(wbwide_ddr3_stb), .i_wb_we(wbwide_ddr3_we),
-			.i_wb_addr(wbwide_ddr3_addr[26-1:0]),
-			.i_wb_data(wbwide_ddr3_data), // 128 bits wide
-			.i_wb_sel(wbwide_ddr3_sel),  // 128/8 bits wide
-		.o_wb_stall(wbwide_ddr3_stall),.o_wb_ack(wbwide_ddr3_ack), .o_wb_data(wbwide_ddr3_idata),
-		.i_aux(0),
-		.o_aux(ddr3_aux_out),	// Leaving this empty would've caused a Verilator warning
-		// Wishbone 2 (PHY)
-		.i_wb2_cyc(wb32_ddr3_phy_cyc), .i_wb2_stb(wb32_ddr3_phy_stb), .i_wb2_we(wb32_ddr3_phy_we),
-			.i_wb2_addr(wb32_ddr3_phy_addr[7-1:0]),
-			.i_wb2_data(wb32_ddr3_phy_data), // 32 bits wide
-			.i_wb2_sel(wb32_ddr3_phy_sel),  // 32/8 bits wide
-		.o_wb2_stall(wb32_ddr3_phy_stall),.o_wb2_ack(wb32_ddr3_phy_ack), .o_wb2_data(wb32_ddr3_phy_idata),
+		.i_clk(i_clk), .i_reset(i_reset),
+		.i_wb_cyc(wb32_i2cs_cyc), .i_wb_stb(wb32_i2cs_stb), .i_wb_we(wb32_i2cs_we),
+			.i_wb_addr(wb32_i2cs_addr[2-1:0]),
+			.i_wb_data(wb32_i2cs_data), // 32 bits wide
+			.i_wb_sel(wb32_i2cs_sel),  // 32/8 bits wide
+		.o_wb_stall(wb32_i2cs_stall),.o_wb_ack(wb32_i2cs_ack), .o_wb_data(wb32_i2cs_idata),
+		.o_pf_cyc(wbwide_i2cm_cyc), .o_pf_stb(wbwide_i2cm_stb), .o_pf_we(wbwide_i2cm_we),
+			.o_pf_addr(wbwide_i2cm_addr[27-1:0]),
+			.o_pf_data(wbwide_i2cm_data), // 128 bits wide
+			.o_pf_sel(wbwide_i2cm_sel),  // 128/8 bits wide
+		.i_pf_stall(wbwide_i2cm_stall), .i_pf_ack(wbwide_i2cm_ack), .i_pf_data(wbwide_i2cm_idata), .i_pf_err(wbwide_i2cm_err),
+		.i_i2c_sda(i_i2c_sda), .i_i2c_scl(i_i2c_scl),
+		.o_i2c_sda(o_i2c_sda), .o_i2c_scl(o_i2c_scl),
+		.M_AXIS_TVALID(i2c_valid), .M_AXIS_TREADY(i2c_ready),
+			.M_AXIS_TDATA(i2c_data), .M_AXIS_TLAST(i2c_last),
+			.M_AXIS_TID(i2c_id),
+		.i_sync_signal(rtc_pps),
 		//
-		// PHY interface
-		.i_phy_iserdes_data(i_ddr3_iserdes_data),
-		.i_phy_iserdes_dqs(i_ddr3_iserdes_dqs),
-		.i_phy_iserdes_bitslip_reference(i_ddr3_iserdes_bitslip_reference),
-		.i_phy_idelayctrl_rdy(i_ddr3_idelayctrl_rdy),
-		.o_phy_cmd(o_ddr3_cmd),
-		.o_phy_dqs_tri_control(o_ddr3_dqs_tri_control),
-		.o_phy_dq_tri_control(o_ddr3_dq_tri_control),
-		.o_phy_toggle_dqs(o_ddr3_toggle_dqs),
-		.o_phy_data(o_ddr3_data),
-		.o_phy_dm(o_ddr3_dm),
-		.o_phy_odelay_data_cntvaluein(o_ddr3_odelay_data_cntvaluein),
-		.o_phy_odelay_dqs_cntvaluein(o_ddr3_odelay_dqs_cntvaluein),
-		.o_phy_idelay_data_cntvaluein(o_ddr3_idelay_data_cntvaluein),
-		.o_phy_idelay_dqs_cntvaluein(o_ddr3_idelay_dqs_cntvaluein),
-		.o_phy_odelay_data_ld(o_ddr3_odelay_data_ld),
-		.o_phy_odelay_dqs_ld(o_ddr3_odelay_dqs_ld),
-		.o_phy_idelay_data_ld(o_ddr3_idelay_data_ld),
-		.o_phy_idelay_dqs_ld(o_ddr3_idelay_dqs_ld),
-		.o_phy_bitslip(o_ddr3_bitslip),
-		.o_phy_write_leveling_calib(o_ddr3_leveling_calib),
-		.o_phy_reset(o_ddr3_reset),
-		// Debug port
-		.o_debug1(ddr3_debug),
-		// Verilator lint_off PINCONNECTEMPTY
-		.o_debug2(),
-		.o_debug3()
-		// Verilator lint_on  PINCONNECTEMPTY
+		.o_interrupt(i2c_int),
+		.o_debug(i2c_debug)
 		// }}}
 	);
+
+	assign	i2c_ready = (!i2c_valid) || (1'b0
+			|| (i2c_id == 0)		// NULL address
+			|| (i2c_id == 1)
+`ifdef	I2CDMA_ACCESS
+			|| (i2c_id == 2 && i2cdma_ready)
+`else
+			|| (i2c_id == 2)
+`endif
+			|| (i2c_id > 2));
+
 	// }}}
 	// }}}
-`else	// SDRAM_ACCESS
+`else	// I2CCPU_ACCESS
 	// {{{
-	// Null bus slave
+	assign	o_i2c_scl = 1'b1;
+	assign	o_i2c_sda = 1'b1;
+	// Null bus master
 	// {{{
-
-	//
-	// In the case that there is no wbwide_ddr3 peripheral
-	// responding on the wbwide bus
-	assign	wbwide_ddr3_ack   = 1'b0;
-	assign	wbwide_ddr3_err   = (wbwide_ddr3_stb);
-	assign	wbwide_ddr3_stall = 0;
-	assign	wbwide_ddr3_idata = 0;
-
+	// }}}
+	// Null interrupt definitions
+	// {{{
+	assign	i2c_int = 1'b0;	// i2c.INT.I2C.WIRE
 	// }}}
 	// }}}
-`endif	// SDRAM_ACCESS
+`endif	// I2CCPU_ACCESS
 
 `ifdef	I2CDMA_ACCESS
 	// {{{
@@ -3043,24 +3111,6 @@ module	main(i_clk, i_reset,
 	// }}}
 `endif	// I2CDMA_ACCESS
 
-`ifdef	PWRCOUNT_ACCESS
-	// {{{
-	initial	r_pwrcount_data = 32'h0;
-	always @(posedge i_clk)
-	if (r_pwrcount_data[31])
-		r_pwrcount_data[30:0] <= r_pwrcount_data[30:0] + 1'b1;
-	else
-		r_pwrcount_data[31:0] <= r_pwrcount_data[31:0] + 1'b1;
-
-	assign	wb32_pwrcount_stall = 1'b0;
-	assign	wb32_pwrcount_ack   = wb32_pwrcount_stb;
-	assign	wb32_pwrcount_idata = r_pwrcount_data;
-	// }}}
-`else	// PWRCOUNT_ACCESS
-	// {{{
-	// }}}
-`endif	// PWRCOUNT_ACCESS
-
 `ifdef	I2SAUDIO
 	// {{{
 	////////////////////////////////////////////////////////////////////////
@@ -3132,29 +3182,57 @@ module	main(i_clk, i_reset,
 	// }}}
 `endif	// I2SAUDIO
 
-	// Generate a PPS signal independent of the GPS--useful for testing
-	gpsclock_tb #(
-		.CLOCK_FREQUENCY_HZ(100000000)
-	) ppstb(
-		.i_clk(i_clk), .i_lcl_pps(ck_pps), .o_pps(tb_pps),
-		.i_wb_cyc(wb32_gtb_cyc), .i_wb_stb(wb32_gtb_stb), .i_wb_we(wb32_gtb_we),
-			.i_wb_addr(wb32_gtb_addr[3-1:0]),
-			.i_wb_data(wb32_gtb_data), // 32 bits wide
-			.i_wb_sel(wb32_gtb_sel),  // 32/8 bits wide
-		.o_wb_stall(wb32_gtb_stall),.o_wb_ack(wb32_gtb_ack), .o_wb_data(wb32_gtb_idata),
-		.i_err(gps_err), .i_count(gps_now), .i_step(gps_step)
+`ifdef	CFG_ACCESS
+	// {{{
+	////////////////////////////////////////////////////////////////////////
+	//
+	// ICAPE2 driver/controller
+	// {{{
+	////////////////////////////////////////////////////////////////////////
+	//
+	//
+`ifdef	VERILATOR
+	reg	r_icape_ack;
+
+	initial	r_icape_ack = 1'b0;
+	always @(posedge i_clk)
+		r_icape_ack <= wb32_icape_stb;
+	assign	wb32_icape_ack   = r_icape_ack;
+	assign	wb32_icape_stall = 1'b0;
+	assign	wb32_icape_idata = 32'h00;
+`else
+	wbicapetwo #(
+		.LGDIV(ICAPE_LGDIV)
+	) u_icape (
+		// {{{
+		.i_clk(i_clk), .i_reset(i_reset),
+		.i_wb_cyc(wb32_icape_cyc), .i_wb_stb(wb32_icape_stb), .i_wb_we(wb32_icape_we),
+			.i_wb_addr(wb32_icape_addr[5-1:0]),
+			.i_wb_data(wb32_icape_data), // 32 bits wide
+			.i_wb_sel(wb32_icape_sel),  // 32/8 bits wide
+		.o_wb_stall(wb32_icape_stall),.o_wb_ack(wb32_icape_ack), .o_wb_data(wb32_icape_idata)
+		// }}}
 	);
+`endif
+	// }}}
+	// }}}
+`else	// CFG_ACCESS
+	// {{{
+	// Null bus slave
+	// {{{
+
+	//
+	// In the case that there is no wb32_icape peripheral
+	// responding on the wb32 bus
+	assign	wb32_icape_ack   = 1'b0;
+	assign	wb32_icape_err   = (wb32_icape_stb);
+	assign	wb32_icape_stall = 0;
+	assign	wb32_icape_idata = 0;
+
+	// }}}
+	// }}}
+`endif	// CFG_ACCESS
 
-	assign	gps_pps = tb_pps;
-	assign	o_pxclk_cyc  = wb32_pxclk_cyc;
-	assign	o_pxclk_stb  = wb32_pxclk_stb;
-	assign	o_pxclk_we   = wb32_pxclk_we;
-	assign	o_pxclk_addr = wb32_pxclk_addr[6:0];
-	assign	o_pxclk_data = wb32_pxclk_data;
-	assign	o_pxclk_sel  = wb32_pxclk_sel;
-	assign	wb32_pxclk_stall = i_pxclk_stall;
-	assign	wb32_pxclk_ack   = i_pxclk_ack;
-	assign	wb32_pxclk_idata = i_pxclk_idata;
 `ifdef	MEGANET_ACCESS
 	// {{{
 	////////////////////////////////////////////////////////////////////////
@@ -3281,27 +3359,105 @@ module	main(i_clk, i_reset,
 	assign	netcputx_last  =  1'b1;
 	assign	netcputx_abort =  1'b0;
 	// }}}
-`endif
+`endif
+
+
+	// }}}
+	// }}}
+`else	// MEGANET_ACCESS
+	// {{{
+	// Null bus slave
+	// {{{
+
+	//
+	// In the case that there is no wb32_net peripheral
+	// responding on the wb32 bus
+	assign	wb32_net_ack   = 1'b0;
+	assign	wb32_net_err   = (wb32_net_stb);
+	assign	wb32_net_stall = 0;
+	assign	wb32_net_idata = 0;
+
+	// }}}
+	// }}}
+`endif	// MEGANET_ACCESS
+
+`ifdef	NETCTRL_ACCESS
+	// {{{
+	enetctrl #(
+		.CLKBITS(6)
+	) u_mdio (
+		.i_clk(i_clk), .i_reset(i_reset),
+		.i_wb_cyc(wb32_mdio_cyc), .i_wb_stb(wb32_mdio_stb), .i_wb_we(wb32_mdio_we),
+			.i_wb_addr(wb32_mdio_addr[10-1:0]),
+			.i_wb_data(wb32_mdio_data), // 32 bits wide
+			.i_wb_sel(wb32_mdio_sel),  // 32/8 bits wide
+		.o_wb_stall(wb32_mdio_stall),.o_wb_ack(wb32_mdio_ack), .o_wb_data(wb32_mdio_idata),
+		.o_mdclk(o_mdclk), .o_mdio(o_mdio), .i_mdio(i_mdio),
+		.o_mdwe(o_mdwe), .o_debug(mdio_debug)
+	);
+	// }}}
+`else	// NETCTRL_ACCESS
+	// {{{
+	assign	o_mdclk = 1'b1;
+	assign	o_mdio  = 1'b1;
+	assign	o_mdwe  = 1'b0;
+	// Null bus slave
+	// {{{
 
+	//
+	// In the case that there is no wb32_mdio peripheral
+	// responding on the wb32 bus
+	assign	wb32_mdio_ack   = 1'b0;
+	assign	wb32_mdio_err   = (wb32_mdio_stb);
+	assign	wb32_mdio_stall = 0;
+	assign	wb32_mdio_idata = 0;
 
 	// }}}
 	// }}}
-`else	// MEGANET_ACCESS
+`endif	// NETCTRL_ACCESS
+
+`ifdef	BUSPIC_ACCESS
 	// {{{
-	// Null bus slave
+	//
+	// The BUS Interrupt controller
+	//
+	icontrol #(15)
+	u_buspic (
+		.i_clk(i_clk), .i_reset(1'b0),
+		.i_wb_cyc(wb32_buspic_cyc), .i_wb_stb(wb32_buspic_stb), .i_wb_we(wb32_buspic_we),
+			.i_wb_data(wb32_buspic_data), // 32 bits wide
+			.i_wb_sel(wb32_buspic_sel),  // 32/8 bits wide
+		.o_wb_stall(wb32_buspic_stall),.o_wb_ack(wb32_buspic_ack), .o_wb_data(wb32_buspic_idata),
+		.i_brd_ints(bus_int_vector),
+		.o_interrupt(w_bus_int)
+	);
+	// }}}
+`else	// BUSPIC_ACCESS
 	// {{{
+	// Null interrupt definitions
+	// {{{
+	assign	w_bus_int = 1'b0;	// buspic.INT.BUS.WIRE
+	// }}}
+	// }}}
+`endif	// BUSPIC_ACCESS
 
-	//
-	// In the case that there is no wb32_net peripheral
-	// responding on the wb32 bus
-	assign	wb32_net_ack   = 1'b0;
-	assign	wb32_net_err   = (wb32_net_stb);
-	assign	wb32_net_stall = 0;
-	assign	wb32_net_idata = 0;
+`ifdef	PWRCOUNT_ACCESS
+	// {{{
+	initial	r_pwrcount_data = 32'h0;
+	always @(posedge i_clk)
+	if (r_pwrcount_data[31])
+		r_pwrcount_data[30:0] <= r_pwrcount_data[30:0] + 1'b1;
+	else
+		r_pwrcount_data[31:0] <= r_pwrcount_data[31:0] + 1'b1;
 
+	assign	wb32_pwrcount_stall = 1'b0;
+	assign	wb32_pwrcount_ack   = wb32_pwrcount_stb;
+	assign	wb32_pwrcount_idata = r_pwrcount_data;
 	// }}}
+`else	// PWRCOUNT_ACCESS
+	// {{{
 	// }}}
-`endif	// MEGANET_ACCESS
+`endif	// PWRCOUNT_ACCESS
 
 `ifdef	RTCDATE_ACCESS
 	// {{{
@@ -3379,6 +3535,18 @@ module	main(i_clk, i_reset,
 	// }}}
 `endif	// RTC_ACCESS
 
+`ifdef	GPSTRK_ACCESS
+	assign	wb32_subseconds_idata = gps_now[31:0];
+`else
+	always @(posedge i_clk)
+	if (wb32_subseconds_stb && wb32_subseconds_we)
+		r_subseconds_data <= wb32_subseconds_data;
+	else
+		r_subseconds_data <= r_subseconds_data
+			+ { 16'h0, RTC_CLKSTEP[31:16] };
+
+	assign	wb32_subseconds_idata = r_subseconds_data;
+`endif
 `ifdef	SPIO_ACCESS
 	// {{{
 	//
@@ -3412,59 +3580,6 @@ module	main(i_clk, i_reset,
 	// }}}
 `endif	// SPIO_ACCESS
 
-`ifdef	GPIO_ACCESS
-	// {{{
-	////////////////////////////////////////////////////////////////////////
-	//
-	// GPIO
-	// {{{
-	// This interface should allow us to control up to 16 GPIO inputs,
-	// and another 16 GPIO outputs.  The interrupt trips when any of
-	// the inputs changes.  (Sorry, which input isn't (yet) selectable.)
-	//
-	localparam [NGPO-1:0]	INITIAL_GPIO = 10'h13;
-
-	wbgpio	#(
-		.NIN(NGPI), .NOUT(NGPO), .DEFAULT(INITIAL_GPIO)
-	) u_gpio (
-		// {{{
-		.i_clk(i_clk),
-		.i_wb_cyc(wb32_gpio_cyc), .i_wb_stb(wb32_gpio_stb), .i_wb_we(wb32_gpio_we),
-			.i_wb_data(wb32_gpio_data), // 32 bits wide
-			.i_wb_sel(wb32_gpio_sel),  // 32/8 bits wide
-		.o_wb_stall(wb32_gpio_stall),.o_wb_ack(wb32_gpio_ack), .o_wb_data(wb32_gpio_idata),
-		.i_gpio(i_gpio), .o_gpio(o_gpio),
-		.o_int(gpio_int)
-		// }}}
-	);
-
-`ifdef	SDIO_ACCESS
-	// This bit is used by the SDSPI controller, not the SDIO controller.
-	assign	sd_reset = !o_sdio_hwreset_n;
-`else
-	assign	sd_reset = o_gpio[3];
-`endif
-
-`ifdef	VERILATOR
-	wire	verilator_halt;
-	assign	o_trace = o_gpio[8];
-
-	assign	verilator_halt = o_gpio[9];
-	assign	o_halt = verilator_halt;
-	always @(posedge verilator_halt)
-		$finish;
-`endif
-	// }}}
-	// }}}
-`else	// GPIO_ACCESS
-	// {{{
-	// Null interrupt definitions
-	// {{{
-	assign	gpio_int = 1'b0;	// gpio.INT.GPIO.WIRE
-	// }}}
-	// }}}
-`endif	// GPIO_ACCESS
-
 `ifdef	SDIO_ACCESS
 	// {{{
 	////////////////////////////////////////////////////////////////////////
@@ -3591,126 +3706,6 @@ module	main(i_clk, i_reset,
 	// }}}
 `endif	// SDIO_ACCESS
 
-	assign	i_net_tx_clk = i_clk_125mhz;
-`ifdef	BUSPIC_ACCESS
-	// {{{
-	//
-	// The BUS Interrupt controller
-	//
-	icontrol #(15)
-	u_buspic (
-		.i_clk(i_clk), .i_reset(1'b0),
-		.i_wb_cyc(wb32_buspic_cyc), .i_wb_stb(wb32_buspic_stb), .i_wb_we(wb32_buspic_we),
-			.i_wb_data(wb32_buspic_data), // 32 bits wide
-			.i_wb_sel(wb32_buspic_sel),  // 32/8 bits wide
-		.o_wb_stall(wb32_buspic_stall),.o_wb_ack(wb32_buspic_ack), .o_wb_data(wb32_buspic_idata),
-		.i_brd_ints(bus_int_vector),
-		.o_interrupt(w_bus_int)
-	);
-	// }}}
-`else	// BUSPIC_ACCESS
-	// {{{
-	// Null interrupt definitions
-	// {{{
-	assign	w_bus_int = 1'b0;	// buspic.INT.BUS.WIRE
-	// }}}
-	// }}}
-`endif	// BUSPIC_ACCESS
-
-`ifdef	GPSTRK_ACCESS
-	// {{{
-	// Verilator lint_off UNUSED
-	wire	[1:0]	ck_dbg;
-	// Verilator lint_on  UNUSED
-
-	gpsclock #(
-		.DEFAULT_STEP(GPSCLOCK_DEFAULT_STEP)
-	) ppsck (
-		.i_clk(i_clk), .i_rst(1'b0), .i_pps(gps_pps), .o_pps(ck_pps),
-			.o_led(gps_led),
-		.i_wb_cyc(wb32_gck_cyc), .i_wb_stb(wb32_gck_stb), .i_wb_we(wb32_gck_we),
-			.i_wb_addr(wb32_gck_addr[2-1:0]),
-			.i_wb_data(wb32_gck_data), // 32 bits wide
-			.i_wb_sel(wb32_gck_sel),  // 32/8 bits wide
-		.o_wb_stall(wb32_gck_stall),.o_wb_ack(wb32_gck_ack), .o_wb_data(wb32_gck_idata),
-		.o_tracking(gps_tracking), .o_count(gps_now), .o_step(gps_step),
-		.o_err(gps_err), .o_locked(gps_locked), .o_dbg(ck_dbg)
-	);
-
-	assign	gck_pps = ck_pps;
-
-	// }}}
-`else	// GPSTRK_ACCESS
-	// {{{
-	reg		r_ck_pps;
-	reg	[63:0]	r_gps_now;
-	reg	[31:0]	r_gps_prior;
-	wire	[47:0]	pre_step;
-	assign	pre_step = { 16'h00, (({GPSCLOCK_DEFAULT_STEP[27:0],20'h00})
-				>>GPSCLOCK_DEFAULT_STEP[31:28]) };
-
-	initial	{ r_ck_pps, r_gps_prior } = 33'h0;
-	always @(posedge i_clk)
-		{ r_ck_pps, r_gps_prior[31:0] } <= r_gps_prior + pre_step[31:0];
-
-	initial	r_gps_now = 64'h0;
-	always @(posedge i_clk)
-	begin
-		r_gps_now[63:32] <= r_gps_now[63:32]+(r_ck_pps ? 32'h1:32'h0);
-		r_gps_now[31:0]  <= r_gps_prior;
-	end
-	assign	ck_pps     = r_ck_pps;
-	assign	gps_now    = r_gps_now;
-	assign	gps_err    = 64'h0;
-	assign	gps_step   = pre_step;
-	assign	gps_led    = 1'b0;
-	assign	gps_locked = 1'b0;
-
-	// Null interrupt definitions
-	// {{{
-	assign	gck_pps = 1'b0;	// gck.INT.PPS.WIRE
-	// }}}
-	// }}}
-`endif	// GPSTRK_ACCESS
-
-`ifdef	NETCTRL_ACCESS
-	// {{{
-	enetctrl #(
-		.CLKBITS(6)
-	) u_mdio (
-		.i_clk(i_clk), .i_reset(i_reset),
-		.i_wb_cyc(wb32_mdio_cyc), .i_wb_stb(wb32_mdio_stb), .i_wb_we(wb32_mdio_we),
-			.i_wb_addr(wb32_mdio_addr[10-1:0]),
-			.i_wb_data(wb32_mdio_data), // 32 bits wide
-			.i_wb_sel(wb32_mdio_sel),  // 32/8 bits wide
-		.o_wb_stall(wb32_mdio_stall),.o_wb_ack(wb32_mdio_ack), .o_wb_data(wb32_mdio_idata),
-		.o_mdclk(o_mdclk), .o_mdio(o_mdio), .i_mdio(i_mdio),
-		.o_mdwe(o_mdwe), .o_debug(mdio_debug)
-	);
-	// }}}
-`else	// NETCTRL_ACCESS
-	// {{{
-	assign	o_mdclk = 1'b1;
-	assign	o_mdio  = 1'b1;
-	assign	o_mdwe  = 1'b0;
-	// Null bus slave
-	// {{{
-
-	//
-	// In the case that there is no wb32_mdio peripheral
-	// responding on the wb32 bus
-	assign	wb32_mdio_ack   = 1'b0;
-	assign	wb32_mdio_err   = (wb32_mdio_stb);
-	assign	wb32_mdio_stall = 0;
-	assign	wb32_mdio_idata = 0;
-
-	// }}}
-	// }}}
-`endif	// NETCTRL_ACCESS
-
-	assign	wb32_buildtime_idata = `BUILDTIME;
-	assign	wb32_buildtime_ack = wb32_buildtime_stb;
-	assign	wb32_buildtime_stall = 1'b0;
 `ifdef	VERSION_ACCESS
 	// {{{
 	assign	wb32_version_idata = `DATESTAMP;
@@ -3722,6 +3717,9 @@ module	main(i_clk, i_reset,
 	// }}}
 `endif	// VERSION_ACCESS
 
+	assign	wb32_buildtime_idata = `BUILDTIME;
+	assign	wb32_buildtime_ack = wb32_buildtime_stb;
+	assign	wb32_buildtime_stall = 1'b0;
 `ifdef	OLEDBW_ACCESS
 	// {{{
 	spicpu #(
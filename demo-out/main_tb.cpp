@@ -53,15 +53,15 @@
 #include "design.h"
 #include "regdefs.h"
 #include "testb.h"
-#include "flashsim.h"
+#include "byteswap.h"
 #include "dbluartsim.h"
+#include "flashsim.h"
 #include "uartsim.h"
 #include "hdmisource.h"
 #include "hdmisim.h"
-#include "byteswap.h"
 #include "netsim.h"
-#include "sdiosim.h"
 #include "enetctrlsim.h"
+#include "sdiosim.h"
 #include "zipelf.h"
 
 //
@@ -113,10 +113,10 @@ public:
 		// If you have any simulation components, create a
 		// SIM.DEFNS tag to have those components defined here
 		// as part of the main_tb.cpp function.
+	DBLUARTSIM	*m_wbu;
 #ifdef	FLASH_ACCESS
 	FLASHSIM	*m_flash;
 #endif // FLASH_ACCESS
-	DBLUARTSIM	*m_wbu;
 #ifdef	GPSUART_ACCESS
 	UARTSIM	*m_gpsu;
 #endif // GPSUART_ACCESS
@@ -125,10 +125,10 @@ public:
 	HDMIWIN		*m_hdmitx;
 #endif	// VIDPIPE_ACCESS
 		NETSIM	*m_net;
-	SDIOSIM		*m_sdio;
 #ifdef	NETCTRL_ACCESS
 	ENETCTRLSIM	*m_mdio;
 #endif // NETCTRL_ACCESS
+	SDIOSIM		*m_sdio;
 	int	m_cpu_bombed;
 	MAINTB(void) {
 		// SIM.INIT
@@ -137,13 +137,13 @@ public:
 		// create a SIM.INIT tag.  That tag's value will be pasted
 		// here.
 		//
+		// From wbu
+		m_wbu = new DBLUARTSIM();
+		m_wbu->setup(100);
 		// From flash
 #ifdef	FLASH_ACCESS
 		m_flash = new FLASHSIM(FLASHLGLEN, false, 2, 6);
 #endif // FLASH_ACCESS
-		// From wbu
-		m_wbu = new DBLUARTSIM();
-		m_wbu->setup(100);
 		// From gpsu
 #ifdef	GPSUART_ACCESS
 		m_gpsu = new UARTSIM(FPGAPORT+2);
@@ -184,6 +184,10 @@ public:
 		m_net->local_ip[3] = 0x1d & 0x0ff; //  29
 		m_net->local_ipu = 0xc0a80f1d;
 		// }}}
+		// From mdio
+#ifdef	NETCTRL_ACCESS
+		m_mdio = new ENETCTRLSIM;
+#endif // NETCTRL_ACCESS
 		// From sdio
 #ifdef	SDIO_ACCESS
 		m_sdio = new SDIOSIM("sdcard.img");
@@ -191,10 +195,6 @@ public:
 		m_core->i_sdio_crcack = 0;
 		m_core->i_sdio_crcnak = 0;
 #endif
-		// From mdio
-#ifdef	NETCTRL_ACCESS
-		m_mdio = new ENETCTRLSIM;
-#endif // NETCTRL_ACCESS
 		// From zip
 		m_cpu_bombed = 0;
 	}
@@ -240,6 +240,11 @@ public:
 		//
 		// SIM.TICK tags go here for SIM.CLOCK=clk
 		//
+		// SIM.TICK from edid
+		m_core->i_edid_scl = m_core->o_edid_scl;
+		m_core->i_edid_sda = m_core->o_edid_sda;
+		// SIM.TICK from wbu
+		m_core->i_wbu_uart_rx = (*m_wbu)(m_core->o_wbu_uart_tx);
 		// SIM.TICK from flash
 #ifdef	FLASH_ACCESS
 		m_core->i_flash_dat = m_flash->simtick(
@@ -248,18 +253,21 @@ public:
 			m_core->o_flash_dat,
 			m_core->o_flash_mod);
 #endif // FLASH_ACCESS
-		// SIM.TICK from i2c
-		m_core->i_i2c_scl = m_core->o_i2c_scl;
-		m_core->i_i2c_sda = m_core->o_i2c_sda;
-		// SIM.TICK from wbu
-		m_core->i_wbu_uart_rx = (*m_wbu)(m_core->o_wbu_uart_tx);
-		// SIM.TICK from edid
-		m_core->i_edid_scl = m_core->o_edid_scl;
-		m_core->i_edid_sda = m_core->o_edid_sda;
 		// SIM.TICK from pxclk
 		m_core->i_pxclk_stall = 0;
 		m_core->i_pxclk_ack   = m_core->o_pxclk_stb;
 		m_core->i_pxclk_idata = m_core->o_pxclk_data;
+		// SIM.TICK from i2c
+		m_core->i_i2c_scl = m_core->o_i2c_scl;
+		m_core->i_i2c_sda = m_core->o_i2c_sda;
+		// SIM.TICK from mdio
+#ifdef	NETCTRL_ACCESS
+		m_core->i_mdio = (*m_mdio)((m_core->i_reset)?1:0,
+				m_core->o_mdclk,
+				((m_core->o_mdwe)&&(!m_core->o_mdio))?0:1);
+#else
+		m_core->i_mdio = ((m_core->o_mdwe)&&(!m_core->o_mdio))?0:1;
+#endif // NETCTRL_ACCESS
 		// SIM.TICK from sdio
 #ifdef	SDIO_ACCESS
 		{ unsigned	tmp, tmp_async;
@@ -293,14 +301,6 @@ public:
 			m_core->i_sdio_ad_data = 0;
 		} }
 #endif
-		// SIM.TICK from mdio
-#ifdef	NETCTRL_ACCESS
-		m_core->i_mdio = (*m_mdio)((m_core->i_reset)?1:0,
-				m_core->o_mdclk,
-				((m_core->o_mdwe)&&(!m_core->o_mdio))?0:1);
-#else
-		m_core->i_mdio = ((m_core->o_mdwe)&&(!m_core->o_mdio))?0:1;
-#endif // NETCTRL_ACCESS
 		// SIM.TICK from zip
 #ifdef	INCLUDE_ZIPCPU
 		// ZipCPU Sim instruction support
@@ -317,6 +317,18 @@ public:
 
 	}
 
+	// Evaluating clock clk_125mhz
+
+	// sim_clk_125mhz_tick() will be called from TESTB<Vmain>::tick()
+	//   following any falling edge of clock clk_125mhz
+	virtual	void	sim_clk_125mhz_tick(void) {
+		//
+		// SIM.TICK tags go here for SIM.CLOCK=clk_125mhz
+		//
+		// No SIM.TICK tags defined
+		m_changed = false;
+	}
+
 	// Evaluating clock pixclk
 
 	// sim_pixclk_tick() will be called from TESTB<Vmain>::tick()
@@ -373,18 +385,6 @@ public:
 		}
 		// }}}
 	}
-
-	// Evaluating clock clk_125mhz
-
-	// sim_clk_125mhz_tick() will be called from TESTB<Vmain>::tick()
-	//   following any falling edge of clock clk_125mhz
-	virtual	void	sim_clk_125mhz_tick(void) {
-		//
-		// SIM.TICK tags go here for SIM.CLOCK=clk_125mhz
-		//
-		// No SIM.TICK tags defined
-		m_changed = false;
-	}
 	//
 	// Step until clock clk ticks
 	//
@@ -396,30 +396,30 @@ public:
 	}
 
 	//
-	// Step until clock pixclk ticks
+	// Step until clock clk_125mhz ticks
 	//
-	virtual	void	tick_pixclk(void) {
+	virtual	void	tick_clk_125mhz(void) {
 		do {
 			tick();
-		} while(!m_pixclk.rising_edge());
+		} while(!m_clk_125mhz.rising_edge());
 	}
 
 	//
-	// Step until clock net_rx_clk ticks
+	// Step until clock pixclk ticks
 	//
-	virtual	void	tick_net_rx_clk(void) {
+	virtual	void	tick_pixclk(void) {
 		do {
 			tick();
-		} while(!m_net_rx_clk.rising_edge());
+		} while(!m_pixclk.rising_edge());
 	}
 
 	//
-	// Step until clock clk_125mhz ticks
+	// Step until clock net_rx_clk ticks
 	//
-	virtual	void	tick_clk_125mhz(void) {
+	virtual	void	tick_net_rx_clk(void) {
 		do {
 			tick();
-		} while(!m_clk_125mhz.rising_edge());
+		} while(!m_net_rx_clk.rising_edge());
 	}
 
 	//
@@ -433,35 +433,6 @@ public:
 	bool	load(uint32_t addr, const char *buf, uint32_t len) {
 		uint32_t	start, offset, wlen, base, adrln;
 
-		//
-		// Loading the flash component
-		//
-		base  = 0x01000000; // in octets
-		adrln = 0x01000000;
-
-		if ((addr >= base)&&(addr < base + adrln)) {
-			// If the start access is in flash
-			start = (addr > base) ? (addr-base) : 0;
-			offset = (start + base) - addr;
-			wlen = (len-offset > adrln - start)
-				? (adrln - start) : len - offset;
-#ifdef	FLASH_ACCESS
-			// FROM flash.SIM.LOAD
-			m_flash->load(start, &buf[offset], wlen);
-			// AUTOFPGA::Now clean up anything else
-			// Was there more to write than we wrote?
-			if (addr + len > base + adrln)
-				return load(base + adrln, &buf[offset+wlen], len-wlen);
-			return true;
-#else	// FLASH_ACCESS
-			return false;
-#endif	// FLASH_ACCESS
-		//
-		// End of components with a SIM.LOAD tag, and a
-		// non-zero number of addresses (NADDR)
-		//
-		}
-
 		//
 		// Loading the bkram component
 		//
@@ -518,6 +489,35 @@ public:
 		//
 		}
 
+		//
+		// Loading the flash component
+		//
+		base  = 0x01000000; // in octets
+		adrln = 0x01000000;
+
+		if ((addr >= base)&&(addr < base + adrln)) {
+			// If the start access is in flash
+			start = (addr > base) ? (addr-base) : 0;
+			offset = (start + base) - addr;
+			wlen = (len-offset > adrln - start)
+				? (adrln - start) : len - offset;
+#ifdef	FLASH_ACCESS
+			// FROM flash.SIM.LOAD
+			m_flash->load(start, &buf[offset], wlen);
+			// AUTOFPGA::Now clean up anything else
+			// Was there more to write than we wrote?
+			if (addr + len > base + adrln)
+				return load(base + adrln, &buf[offset+wlen], len-wlen);
+			return true;
+#else	// FLASH_ACCESS
+			return false;
+#endif	// FLASH_ACCESS
+		//
+		// End of components with a SIM.LOAD tag, and a
+		// non-zero number of addresses (NADDR)
+		//
+		}
+
 		return false;
 	}
 
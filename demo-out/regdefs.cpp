@@ -307,6 +307,137 @@ const	REGNAME	raw_bregs[] = {
 	{ R_ZIPUDMAC        ,	"ZIPDMAC"         	}
 };
 
+//
+// Register lookup tables, from @REGS.#d
+//
+// regdefs_find_name() is based upon a perfect hash of the (case folded)
+// register names, regdefs_find_addr() upon a table of addresses.  Both
+// return an index into raw_bregs[], or -1 if the register isn't found.
+//
+static const unsigned	regdefs_name_seeds[64] = {
+	0x0001b, 0x00001, 0x00009, 0x00014, 0x0000c, 0x00001, 0x00004, 0x00011,
+	0x0000d, 0x00003, 0x00001, 0x00007, 0x00012, 0x0000b, 0x00003, 0x00009,
+	0x00014, 0x00001, 0x00007, 0x00019, 0x00000, 0x00001, 0x00000, 0x00016,
+	0x0000e, 0x00005, 0x00001, 0x00001, 0x00006, 0x00013, 0x00018, 0x00002,
+	0x00009, 0x00028, 0x00004, 0x00002, 0x00005, 0x00008, 0x00007, 0x0000e,
+	0x00034, 0x00001, 0x0002d, 0x00034, 0x00001, 0x00006, 0x00068, 0x00001,
+	0x00011, 0x0003a, 0x00009, 0x0003c, 0x00054, 0x00004, 0x0013a, 0x00003,
+	0x00025, 0x00004, 0x0000e, 0x0001a, 0x00001, 0x00001, 0x00001, 0x0000f
+};
+
+static const int	regdefs_name_slots[319] = {
+	  68,  214,  111,   -1,   -1,   -1,   -1,   -1,   94,  224,   18,  109,
+	 256,  130,   86,   89,  187,  171,   -1,   59,    4,   93,  219,  178,
+	  27,  184,   92,  115,  157,  188,  161,   47,   55,  143,   -1,   54,
+	 235,  193,  252,  198,  147,  101,  122,   76,  258,   15,   -1,   -1,
+	 102,   -1,  208,  200,   -1,  112,  172,   -1,  186,   56,   65,   -1,
+	  60,   -1,  129,   -1,   -1,   12,    2,   96,  223,  207,  254,   32,
+	  84,   14,  141,  191,   -1,   77,   39,   -1,  197,  165,   -1,   69,
+	 125,   98,  103,   19,  246,   -1,   75,   21,   -1,   42,   49,   -1,
+	  -1,   -1,   40,   13,  135,  124,  104,  243,   -1,   17,  257,  133,
+	 154,  247,    1,   -1,   62,  216,  177,  231,   -1,  152,   58,   -1,
+	 201,   -1,  233,   66,   10,  174,   -1,  113,    6,   57,   -1,   -1,
+	 168,  183,  176,  117,   11,  241,  239,  211,  221,   87,  116,  209,
+	   9,  160,  100,  142,   37,   -1,   -1,  249,  167,   82,  166,  253,
+	 205,  169,   63,  155,   71,  138,  202,   61,   81,  175,  226,  222,
+	 234,    3,   95,  156,  151,   38,  163,   48,   -1,   -1,  179,   23,
+	 106,  148,   83,   43,  210,   41,   67,   -1,  170,  144,  164,   64,
+	 195,   -1,   -1,   79,  237,   52,   72,  123,  250,   78,   45,  248,
+	 107,  245,   -1,   -1,   -1,  206,  244,   91,   22,  118,  192,   -1,
+	  -1,    8,  105,  190,   -1,   -1,  203,  204,  199,  136,   29,  251,
+	 159,   90,   34,   -1,   50,  227,   33,  134,    7,   74,  158,  215,
+	  -1,   -1,   -1,  225,   16,   -1,   -1,   -1,   25,   80,  194,   36,
+	  88,   30,   51,  213,  145,  242,   -1,  189,  139,  137,   44,  162,
+	 114,   35,    5,   31,  128,   99,    0,  150,  108,   70,   85,  240,
+	 132,   97,  217,   26,   -1,  232,  127,  182,  236,  119,   -1,  146,
+	  73,   -1,   -1,   53,  153,   -1,  180,  220,   -1,   20,   -1,  110,
+	  -1,  126,   24,  173,  121,  149,   28,   46,  131,  196,  185,  255,
+	 212,  218,  181,   -1,  238,  140,   -1
+};
+
+static unsigned	regdefs_hash(const char *v) {
+	unsigned	h = 0x811c9dc5u;
+
+	for(; *v; v++) {
+		unsigned	c = (unsigned char)*v;
+
+		if ((c >= 'A')&&(c <= 'Z'))
+			c += 'a'-'A';
+		h ^= c;
+		h *= 16777619u;
+	} return h & 0x0ffffffffu;
+}
+
+static unsigned	regdefs_mix(unsigned h) {
+	h &= 0x0ffffffffu;
+	h ^= h >> 16;
+	h = (h * 0x85ebca6bu) & 0x0ffffffffu;
+	h ^= h >> 13;
+	h = (h * 0xc2b2ae35u) & 0x0ffffffffu;
+	h ^= h >> 16;
+	return h;
+}
+
+static bool	regdefs_same_name(const char *a, const char *b) {
+	for(; *a && *b; a++, b++) {
+		unsigned	ca = (unsigned char)*a, cb = (unsigned char)*b;
+
+		if ((ca >= 'A')&&(ca <= 'Z'))
+			ca += 'a'-'A';
+		if ((cb >= 'A')&&(cb <= 'Z'))
+			cb += 'a'-'A';
+		if (ca != cb)
+			return false;
+	} return (*a == *b);
+}
+
+int	regdefs_find_name(const char *v) {
+	unsigned	h = regdefs_hash(v);
+	int	idx;
+
+	idx = regdefs_name_slots[regdefs_mix(h ^ regdefs_name_seeds[h % 64u]) % 319u];
+	if ((idx >= 0)&&(regdefs_same_name(v, raw_bregs[idx].m_name)))
+		return idx;
+	return -1;
+}
+
+static const int	regdefs_addr_sorted[208] = {
+	   0,    1,    2,    5,    8,    9,   10,   12,   13,   14,   15,   16,
+	  17,   18,   19,   20,   21,   22,   23,   24,   25,   26,   27,   28,
+	  29,   30,   31,   32,   33,   34,   35,   36,   37,   38,   39,   40,
+	  41,   42,   43,   44,   46,   47,   48,   49,   51,   52,   53,   54,
+	  55,   56,   57,   58,   59,   60,   62,   64,   66,   68,   70,   72,
+	  74,   75,   78,   80,   82,   84,   85,   86,   87,   88,   91,   93,
+	  95,   97,   98,   99,  100,  101,  102,  103,  104,  105,  106,  107,
+	 108,  110,  111,  112,  113,  114,  115,  116,  117,  118,  119,  121,
+	 122,  123,  126,  127,  129,  130,  131,  132,  133,  134,  135,  137,
+	 138,  139,  140,  141,  142,  143,  144,  145,  146,  147,  148,  149,
+	 150,  151,  152,  153,  154,  155,  156,  157,  158,  159,  160,  161,
+	 162,  163,  164,  165,  166,  167,  168,  169,  170,  171,  172,  173,
+	 174,  175,  176,  183,  177,  187,  178,  188,  179,  180,  185,  186,
+	 189,  190,  191,  193,  195,  196,  197,  198,  199,  200,  201,  202,
+	 203,  204,  205,  206,  207,  209,  213,  217,  219,  220,  221,  222,
+	 223,  224,  225,  226,  227,  228,  229,  230,  231,  233,  235,  237,
+	 239,  240,  241,  243,  245,  247,  249,  250,  251,  252,  253,  254,
+	 255,  256,  257,  258
+};
+
+int	regdefs_find_addr(unsigned v) {
+	int	lo = 0, hi = 208;
+
+	while(lo < hi) {
+		int	mid = lo + (hi-lo)/2;
+		unsigned	a = raw_bregs[regdefs_addr_sorted[mid]].m_addr;
+
+		if (a == v)
+			return regdefs_addr_sorted[mid];
+		else if (a < v)
+			lo = mid+1;
+		else
+			hi = mid;
+	} return -1;
+}
+
 // REGSDEFS.CPP.INSERT for any bus masters
 // And then from the peripherals
 // And finally any master REGS.CPP.INSERT tags
@@ -317,9 +448,9 @@ const	int	NREGS = RAW_NREGS;
 
 unsigned	addrdecode(const char *v) {
 	if (isalpha(v[0])) {
-		for(int i=0; i<NREGS; i++)
-			if (strcasecmp(v, bregs[i].m_name)==0)
-				return bregs[i].m_addr;
+		int	i = regdefs_find_name(v);
+		if (i >= 0)
+			return raw_bregs[i].m_addr;
 		fprintf(stderr, "Unknown register: %s\n", v);
 		exit(-2);
 	} else
@@ -327,9 +458,9 @@ unsigned	addrdecode(const char *v) {
 }
 
 const	char *addrname(const unsigned v) {
-	for(int i=0; i<NREGS; i++)
-		if (bregs[i].m_addr == v)
-			return bregs[i].m_name;
+	int	i = regdefs_find_addr(v);
+	if (i >= 0)
+		return raw_bregs[i].m_name;
 	return NULL;
 }
 
@@ -302,9 +302,13 @@
 // The @REGDEFS.H.DEFNS tag
 //
 // @REGDEFS.H.DEFNS for masters
-#define	BAUDRATE	1000000
 #define	CLKFREQHZ	100000000
+#define	BAUDRATE	1000000
 // @REGDEFS.H.DEFNS for peripherals
+#define	BKRAMBASE	0x10000000
+#define	BKRAMLEN	0x00100000
+#define	SDRAMBASE	0x40000000
+#define	SDRAMLEN	0x40000000
 #define	FLASHBASE	0x01000000
 #define	FLASHLEN	0x01000000
 #define	FLASHLGLEN	24
@@ -312,10 +316,6 @@
 #define	FLASH_RDDELAY	2
 #define	FLASH_NDUMMY	6
 //
-#define	BKRAMBASE	0x10000000
-#define	BKRAMLEN	0x00100000
-#define	SDRAMBASE	0x40000000
-#define	SDRAMLEN	0x40000000
 // @REGDEFS.H.DEFNS at the top level
 // End of definitions from REGDEFS.H.DEFNS
 //
@@ -388,5 +388,12 @@ extern	unsigned	addrdecode(const char *v);
 extern	const	char *addrname(const unsigned v);
 // End of definitions from REGDEFS.H.INSERT
 
+//
+// Register lookup, by name or address, from regdefs.cpp.  Each
+// returns an index into raw_bregs[], or -1 if not found.
+//
+extern	int	regdefs_find_name(const char *v);
+extern	int	regdefs_find_addr(unsigned v);
+
 
 #endif	// REGDEFS_H
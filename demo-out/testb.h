@@ -55,6 +55,46 @@
 #endif
 #include <tbclock.h>
 
+	//
+	// TBSCHEDCLOCK is a minimal clock class, whose edges are scheduled by
+	// TESTB::tick() below.  It is only touched when it toggles, yet still
+	// provides the time_to_edge(), rising_edge(), and falling_edge()
+	// indicators of a TBCLOCK.
+	//
+class	TBSCHEDCLOCK {
+public:
+	const uint64_t	*m_now_ps;
+	uint64_t	m_edge_ps;
+	unsigned long	m_increment_ps;
+	int		m_level;
+
+	void	init(const uint64_t *now_ps, unsigned long increment_ps) {
+		m_now_ps = now_ps;
+		m_increment_ps = increment_ps;
+		// The first edge, a rising edge, is at increment_ps-1
+		m_edge_ps = (uint64_t)-1;
+		m_level = 0;
+	}
+
+	int	toggle(void) {
+		m_edge_ps = *m_now_ps;
+		m_level = !m_level;
+		return m_level;
+	}
+
+	unsigned long	time_to_edge(void) const {
+		return (unsigned long)(m_edge_ps + m_increment_ps - *m_now_ps);
+	}
+
+	bool	rising_edge(void) const {
+		return (m_level)&&(m_edge_ps == *m_now_ps);
+	}
+
+	bool	falling_edge(void) const {
+		return (!m_level)&&(m_edge_ps == *m_now_ps);
+	}
+};
+
 	//
 	// The TESTB class is a useful wrapper for interacting with a Verilator
 	// based design.  Key to its capabilities are the tick() method for
@@ -69,13 +109,18 @@ public:
 	bool		m_changed;
 	TRACECLASS*	m_trace;
 	bool		m_done, m_paused_trace;
+	uint64_t	m_trace_start_ps, m_trace_stop_ps;
+	unsigned	m_trace_flush_ticks, m_trace_flush_count;
 	uint64_t	m_time_ps;
-	// TBCLOCK is a clock support class, enabling multiclock simulation
+	// TBSCHEDCLOCK is a clock support class, enabling multiclock simulation
 	// operation.
-	TBCLOCK	m_clk;
-	TBCLOCK	m_pixclk;
-	TBCLOCK	m_net_rx_clk;
-	TBCLOCK	m_clk_125mhz;
+	TBSCHEDCLOCK	m_clk;
+	TBSCHEDCLOCK	m_clk_125mhz;
+	TBSCHEDCLOCK	m_pixclk;
+	TBSCHEDCLOCK	m_net_rx_clk;
+	// Clock edge schedule, one step per edge
+	unsigned	m_clock_step;
+	uint64_t	m_clock_base_ps;
 
 	TESTB(void) {
 		// {{{
@@ -84,12 +129,18 @@ public:
 		m_trace    = NULL;
 		m_done     = false;
 		m_paused_trace = false;
+		m_trace_start_ps = 0;
+		m_trace_stop_ps  = ~(uint64_t)0;
+		m_trace_flush_ticks = 1;
+		m_trace_flush_count = 0;
 		Verilated::traceEverOn(true);
 // Set the initial clock periods
-		m_clk.init(10000);	//  100.00 MHz
-		m_pixclk.init(25000);	//   40.00 MHz
-		m_net_rx_clk.init(8000);	//  125.00 MHz
-		m_clk_125mhz.init(8000);	//  125.00 MHz
+		m_clk.init(&m_time_ps, 5000);	//  100.00 MHz
+		m_clk_125mhz.init(&m_time_ps, 4000);	//  125.00 MHz
+		m_pixclk.init(&m_time_ps, 12500);	//   40.00 MHz
+		m_net_rx_clk.init(&m_time_ps, 4000);	//  125.00 MHz
+		m_clock_step = 0;
+		m_clock_base_ps = 0;
 	}
 	// }}}
 
@@ -170,6 +221,48 @@ public:
 	}
 	// }}}
 
+	//
+	// tracewindow(start_ps, stop_ps)
+	// {{{
+	// Limits the trace to simulation times from start_ps up to, but not
+	// including, stop_ps.  Outside of this window nothing is written to
+	// the trace, so a long simulation need only pay for tracing where
+	// it's needed.  tracewindow(0) traces everything again.
+	//
+	virtual	void	tracewindow(uint64_t start_ps,
+			uint64_t stop_ps = ~(uint64_t)0) {
+		m_trace_start_ps = start_ps;
+		m_trace_stop_ps  = stop_ps;
+	}
+	// }}}
+
+	//
+	// tracing()
+	// {{{
+	// Returns true if the current time step is to be written to the
+	// trace: the trace is open, isn't paused, and we are within the
+	// trace window.
+	//
+	bool	tracing(void) const {
+		return (m_trace)&&(!m_paused_trace)
+			&&(m_time_ps >= m_trace_start_ps)
+			&&(m_time_ps <  m_trace_stop_ps);
+	}
+	// }}}
+
+	//
+	// flushinterval(ticks)
+	// {{{
+	// Sets how often, in calls to tick(), the trace is flushed to its
+	// file.  The default is set by the @SIM.TRACE.FLUSH tag.  Zero will
+	// leave flushing to the trace class, such as when it is closed.
+	//
+	virtual	void	flushinterval(unsigned ticks) {
+		m_trace_flush_ticks = ticks;
+		m_trace_flush_count = 0;
+	}
+	// }}}
+
 	//
 	// eval()
 	// {{{
@@ -192,55 +285,514 @@ public:
 	// design, this will advance the clocks up until the nearest clock
 	// transition.
 	virtual	void	tick(void) {
-		unsigned	mintime = m_clk.time_to_edge();
-
-		if (m_pixclk.time_to_edge() < mintime)
-			mintime = m_pixclk.time_to_edge();
-
-		if (m_net_rx_clk.time_to_edge() < mintime)
-			mintime = m_net_rx_clk.time_to_edge();
-
-		if (m_clk_125mhz.time_to_edge() < mintime)
-			mintime = m_clk_125mhz.time_to_edge();
-
-		assert(mintime > 1);
+		unsigned	falling = 0;
 
 		// Pre-evaluate, to give verilator a chance to settle any
-		// combinatorial logic thatthat may have changed since the
-		// last clockevaluation, and then record that in the trace.
+		// combinatorial logic that may have changed since the
+		// last clock evaluation, and then record that in the trace.
 		eval();
-		if (m_trace && !m_paused_trace) m_trace->dump(m_time_ps+1);
+		if (tracing()) m_trace->dump(m_time_ps+1);
 
-		// Advance each clock
-		m_core->i_clk = m_clk.advance(mintime);
-		m_core->i_pixclk = m_pixclk.advance(mintime);
-		m_core->i_net_rx_clk = m_net_rx_clk.advance(mintime);
-		m_core->i_clk_125mhz = m_clk_125mhz.advance(mintime);
+		// Advance to the next clock edge, toggling only those clocks
+		// with an edge at that time.  The edges repeat every 200000 ps.
+		switch(m_clock_step++) {
+		case 0:
+			m_time_ps = m_clock_base_ps + 3999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			break;
+		case 1:
+			m_time_ps = m_clock_base_ps + 4999;
+			m_core->i_clk = m_clk.toggle();
+			break;
+		case 2:
+			m_time_ps = m_clock_base_ps + 7999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			falling = 0xa;
+			break;
+		case 3:
+			m_time_ps = m_clock_base_ps + 9999;
+			m_core->i_clk = m_clk.toggle();
+			falling = 0x1;
+			break;
+		case 4:
+			m_time_ps = m_clock_base_ps + 11999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			break;
+		case 5:
+			m_time_ps = m_clock_base_ps + 12499;
+			m_core->i_pixclk = m_pixclk.toggle();
+			break;
+		case 6:
+			m_time_ps = m_clock_base_ps + 14999;
+			m_core->i_clk = m_clk.toggle();
+			break;
+		case 7:
+			m_time_ps = m_clock_base_ps + 15999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			falling = 0xa;
+			break;
+		case 8:
+			m_time_ps = m_clock_base_ps + 19999;
+			m_core->i_clk = m_clk.toggle();
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			falling = 0x1;
+			break;
+		case 9:
+			m_time_ps = m_clock_base_ps + 23999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			falling = 0xa;
+			break;
+		case 10:
+			m_time_ps = m_clock_base_ps + 24999;
+			m_core->i_clk = m_clk.toggle();
+			m_core->i_pixclk = m_pixclk.toggle();
+			falling = 0x4;
+			break;
+		case 11:
+			m_time_ps = m_clock_base_ps + 27999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			break;
+		case 12:
+			m_time_ps = m_clock_base_ps + 29999;
+			m_core->i_clk = m_clk.toggle();
+			falling = 0x1;
+			break;
+		case 13:
+			m_time_ps = m_clock_base_ps + 31999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			falling = 0xa;
+			break;
+		case 14:
+			m_time_ps = m_clock_base_ps + 34999;
+			m_core->i_clk = m_clk.toggle();
+			break;
+		case 15:
+			m_time_ps = m_clock_base_ps + 35999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			break;
+		case 16:
+			m_time_ps = m_clock_base_ps + 37499;
+			m_core->i_pixclk = m_pixclk.toggle();
+			break;
+		case 17:
+			m_time_ps = m_clock_base_ps + 39999;
+			m_core->i_clk = m_clk.toggle();
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			falling = 0xb;
+			break;
+		case 18:
+			m_time_ps = m_clock_base_ps + 43999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			break;
+		case 19:
+			m_time_ps = m_clock_base_ps + 44999;
+			m_core->i_clk = m_clk.toggle();
+			break;
+		case 20:
+			m_time_ps = m_clock_base_ps + 47999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			falling = 0xa;
+			break;
+		case 21:
+			m_time_ps = m_clock_base_ps + 49999;
+			m_core->i_clk = m_clk.toggle();
+			m_core->i_pixclk = m_pixclk.toggle();
+			falling = 0x5;
+			break;
+		case 22:
+			m_time_ps = m_clock_base_ps + 51999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			break;
+		case 23:
+			m_time_ps = m_clock_base_ps + 54999;
+			m_core->i_clk = m_clk.toggle();
+			break;
+		case 24:
+			m_time_ps = m_clock_base_ps + 55999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			falling = 0xa;
+			break;
+		case 25:
+			m_time_ps = m_clock_base_ps + 59999;
+			m_core->i_clk = m_clk.toggle();
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			falling = 0x1;
+			break;
+		case 26:
+			m_time_ps = m_clock_base_ps + 62499;
+			m_core->i_pixclk = m_pixclk.toggle();
+			break;
+		case 27:
+			m_time_ps = m_clock_base_ps + 63999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			falling = 0xa;
+			break;
+		case 28:
+			m_time_ps = m_clock_base_ps + 64999;
+			m_core->i_clk = m_clk.toggle();
+			break;
+		case 29:
+			m_time_ps = m_clock_base_ps + 67999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			break;
+		case 30:
+			m_time_ps = m_clock_base_ps + 69999;
+			m_core->i_clk = m_clk.toggle();
+			falling = 0x1;
+			break;
+		case 31:
+			m_time_ps = m_clock_base_ps + 71999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			falling = 0xa;
+			break;
+		case 32:
+			m_time_ps = m_clock_base_ps + 74999;
+			m_core->i_clk = m_clk.toggle();
+			m_core->i_pixclk = m_pixclk.toggle();
+			falling = 0x4;
+			break;
+		case 33:
+			m_time_ps = m_clock_base_ps + 75999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			break;
+		case 34:
+			m_time_ps = m_clock_base_ps + 79999;
+			m_core->i_clk = m_clk.toggle();
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			falling = 0xb;
+			break;
+		case 35:
+			m_time_ps = m_clock_base_ps + 83999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			break;
+		case 36:
+			m_time_ps = m_clock_base_ps + 84999;
+			m_core->i_clk = m_clk.toggle();
+			break;
+		case 37:
+			m_time_ps = m_clock_base_ps + 87499;
+			m_core->i_pixclk = m_pixclk.toggle();
+			break;
+		case 38:
+			m_time_ps = m_clock_base_ps + 87999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			falling = 0xa;
+			break;
+		case 39:
+			m_time_ps = m_clock_base_ps + 89999;
+			m_core->i_clk = m_clk.toggle();
+			falling = 0x1;
+			break;
+		case 40:
+			m_time_ps = m_clock_base_ps + 91999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			break;
+		case 41:
+			m_time_ps = m_clock_base_ps + 94999;
+			m_core->i_clk = m_clk.toggle();
+			break;
+		case 42:
+			m_time_ps = m_clock_base_ps + 95999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			falling = 0xa;
+			break;
+		case 43:
+			m_time_ps = m_clock_base_ps + 99999;
+			m_core->i_clk = m_clk.toggle();
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_pixclk = m_pixclk.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			falling = 0x5;
+			break;
+		case 44:
+			m_time_ps = m_clock_base_ps + 103999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			falling = 0xa;
+			break;
+		case 45:
+			m_time_ps = m_clock_base_ps + 104999;
+			m_core->i_clk = m_clk.toggle();
+			break;
+		case 46:
+			m_time_ps = m_clock_base_ps + 107999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			break;
+		case 47:
+			m_time_ps = m_clock_base_ps + 109999;
+			m_core->i_clk = m_clk.toggle();
+			falling = 0x1;
+			break;
+		case 48:
+			m_time_ps = m_clock_base_ps + 111999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			falling = 0xa;
+			break;
+		case 49:
+			m_time_ps = m_clock_base_ps + 112499;
+			m_core->i_pixclk = m_pixclk.toggle();
+			break;
+		case 50:
+			m_time_ps = m_clock_base_ps + 114999;
+			m_core->i_clk = m_clk.toggle();
+			break;
+		case 51:
+			m_time_ps = m_clock_base_ps + 115999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			break;
+		case 52:
+			m_time_ps = m_clock_base_ps + 119999;
+			m_core->i_clk = m_clk.toggle();
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			falling = 0xb;
+			break;
+		case 53:
+			m_time_ps = m_clock_base_ps + 123999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			break;
+		case 54:
+			m_time_ps = m_clock_base_ps + 124999;
+			m_core->i_clk = m_clk.toggle();
+			m_core->i_pixclk = m_pixclk.toggle();
+			falling = 0x4;
+			break;
+		case 55:
+			m_time_ps = m_clock_base_ps + 127999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			falling = 0xa;
+			break;
+		case 56:
+			m_time_ps = m_clock_base_ps + 129999;
+			m_core->i_clk = m_clk.toggle();
+			falling = 0x1;
+			break;
+		case 57:
+			m_time_ps = m_clock_base_ps + 131999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			break;
+		case 58:
+			m_time_ps = m_clock_base_ps + 134999;
+			m_core->i_clk = m_clk.toggle();
+			break;
+		case 59:
+			m_time_ps = m_clock_base_ps + 135999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			falling = 0xa;
+			break;
+		case 60:
+			m_time_ps = m_clock_base_ps + 137499;
+			m_core->i_pixclk = m_pixclk.toggle();
+			break;
+		case 61:
+			m_time_ps = m_clock_base_ps + 139999;
+			m_core->i_clk = m_clk.toggle();
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			falling = 0x1;
+			break;
+		case 62:
+			m_time_ps = m_clock_base_ps + 143999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			falling = 0xa;
+			break;
+		case 63:
+			m_time_ps = m_clock_base_ps + 144999;
+			m_core->i_clk = m_clk.toggle();
+			break;
+		case 64:
+			m_time_ps = m_clock_base_ps + 147999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			break;
+		case 65:
+			m_time_ps = m_clock_base_ps + 149999;
+			m_core->i_clk = m_clk.toggle();
+			m_core->i_pixclk = m_pixclk.toggle();
+			falling = 0x5;
+			break;
+		case 66:
+			m_time_ps = m_clock_base_ps + 151999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			falling = 0xa;
+			break;
+		case 67:
+			m_time_ps = m_clock_base_ps + 154999;
+			m_core->i_clk = m_clk.toggle();
+			break;
+		case 68:
+			m_time_ps = m_clock_base_ps + 155999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			break;
+		case 69:
+			m_time_ps = m_clock_base_ps + 159999;
+			m_core->i_clk = m_clk.toggle();
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			falling = 0xb;
+			break;
+		case 70:
+			m_time_ps = m_clock_base_ps + 162499;
+			m_core->i_pixclk = m_pixclk.toggle();
+			break;
+		case 71:
+			m_time_ps = m_clock_base_ps + 163999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			break;
+		case 72:
+			m_time_ps = m_clock_base_ps + 164999;
+			m_core->i_clk = m_clk.toggle();
+			break;
+		case 73:
+			m_time_ps = m_clock_base_ps + 167999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			falling = 0xa;
+			break;
+		case 74:
+			m_time_ps = m_clock_base_ps + 169999;
+			m_core->i_clk = m_clk.toggle();
+			falling = 0x1;
+			break;
+		case 75:
+			m_time_ps = m_clock_base_ps + 171999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			break;
+		case 76:
+			m_time_ps = m_clock_base_ps + 174999;
+			m_core->i_clk = m_clk.toggle();
+			m_core->i_pixclk = m_pixclk.toggle();
+			falling = 0x4;
+			break;
+		case 77:
+			m_time_ps = m_clock_base_ps + 175999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			falling = 0xa;
+			break;
+		case 78:
+			m_time_ps = m_clock_base_ps + 179999;
+			m_core->i_clk = m_clk.toggle();
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			falling = 0x1;
+			break;
+		case 79:
+			m_time_ps = m_clock_base_ps + 183999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			falling = 0xa;
+			break;
+		case 80:
+			m_time_ps = m_clock_base_ps + 184999;
+			m_core->i_clk = m_clk.toggle();
+			break;
+		case 81:
+			m_time_ps = m_clock_base_ps + 187499;
+			m_core->i_pixclk = m_pixclk.toggle();
+			break;
+		case 82:
+			m_time_ps = m_clock_base_ps + 187999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			break;
+		case 83:
+			m_time_ps = m_clock_base_ps + 189999;
+			m_core->i_clk = m_clk.toggle();
+			falling = 0x1;
+			break;
+		case 84:
+			m_time_ps = m_clock_base_ps + 191999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			falling = 0xa;
+			break;
+		case 85:
+			m_time_ps = m_clock_base_ps + 194999;
+			m_core->i_clk = m_clk.toggle();
+			break;
+		case 86:
+			m_time_ps = m_clock_base_ps + 195999;
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			break;
+		case 87:
+			m_time_ps = m_clock_base_ps + 199999;
+			m_core->i_clk = m_clk.toggle();
+			m_core->i_clk_125mhz = m_clk_125mhz.toggle();
+			m_core->i_pixclk = m_pixclk.toggle();
+			m_core->i_net_rx_clk = m_net_rx_clk.toggle();
+			falling = 0xf;
+			m_clock_base_ps += 200000;
+			m_clock_step = 0;
+			break;
+		}
 
-		m_time_ps += mintime;
 		eval();
 		// If we are keeping a trace, dump the current state to that
 		// trace now
-		if (m_trace && !m_paused_trace) {
+		if (tracing()) {
 			m_trace->dump(m_time_ps);
-			m_trace->flush();
+			if ((m_trace_flush_ticks)&&(++m_trace_flush_count
+					>= m_trace_flush_ticks)) {
+				m_trace->flush();
+				m_trace_flush_count = 0;
+			}
 		}
 
-		if (m_clk.falling_edge()) {
+		// Call to see if any simulation components need
+		// to advance their inputs based upon these clocks
+		if (falling & 0x1) {
 			m_changed = true;
 			sim_clk_tick();
 		}
-		if (m_pixclk.falling_edge()) {
+		if (falling & 0x2) {
 			m_changed = true;
-			sim_pixclk_tick();
+			sim_clk_125mhz_tick();
 		}
-		if (m_net_rx_clk.falling_edge()) {
+		if (falling & 0x4) {
 			m_changed = true;
-			sim_net_rx_clk_tick();
+			sim_pixclk_tick();
 		}
-		if (m_clk_125mhz.falling_edge()) {
+		if (falling & 0x8) {
 			m_changed = true;
-			sim_clk_125mhz_tick();
+			sim_net_rx_clk_tick();
 		}
 	}
 	// }}}
@@ -254,7 +806,7 @@ public:
 		m_changed = false;
 	}
 	// }}}
-	virtual	void	sim_pixclk_tick(void) {
+	virtual	void	sim_clk_125mhz_tick(void) {
 		// {{{
 		// AutoFPGA will override this method within main_tb.cpp if any
 		// @SIM.TICK key is present within a design component also
@@ -263,7 +815,7 @@ public:
 		m_changed = false;
 	}
 	// }}}
-	virtual	void	sim_net_rx_clk_tick(void) {
+	virtual	void	sim_pixclk_tick(void) {
 		// {{{
 		// AutoFPGA will override this method within main_tb.cpp if any
 		// @SIM.TICK key is present within a design component also
@@ -272,7 +824,7 @@ public:
 		m_changed = false;
 	}
 	// }}}
-	virtual	void	sim_clk_125mhz_tick(void) {
+	virtual	void	sim_net_rx_clk_tick(void) {
 		// {{{
 		// AutoFPGA will override this method within main_tb.cpp if any
 		// @SIM.TICK key is present within a design component also
@@ -0,0 +1,371 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/addrpack.cpp
+//
+// Project:	AutoFPGA, a utility for composing FPGA designs from peripherals
+// {{{
+// Purpose:	Place the peripherals of one bus within its address space.
+//
+//	Every peripheral is decoded from a naturally aligned, power of two
+//	sized region.  Once the sizes of those regions are chosen, placing them
+//	largest first, each into the smallest free block that will hold it,
+//	fits them whenever they can be made to fit at all.  The search is then
+//	over region sizes alone: for each candidate address width, start with
+//	every region as small as its peripheral, and then grow the smallest
+//	regions one level at a time (shrinking the number of address bits
+//	their decoders need to compare) for as long as everything still fits.
+//	The best layout, by the selected cost, is kept.
+//
+//	This finds the narrowest bus (AWID) exactly, but the LUTS and DEPTH
+//	costs are only reduced greedily.  There is no bound on how far the
+//	result may be from their true minimum.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdio.h>
+#include <strings.h>
+#include <set>
+#include <vector>
+#include <algorithm>
+
+#include "addrpack.h"
+#include "bitlib.h"
+
+// Addresses, in octets, are limited to this many bits
+#define	MAX_PACK_WIDTH	32
+
+//
+// packing_objective
+// {{{
+bool	packing_objective(const STRING &name, PACKOBJ &obj) {
+	static const struct {
+		const char	*m_name;
+		PACKOBJ		m_obj;
+	} objectives[] = {
+		{ "SEQUENTIAL",	PACK_SEQUENTIAL },
+		{ "AWID",	PACK_AWID },
+		{ "LUTS",	PACK_LUTS },
+		{ "DEPTH",	PACK_DEPTH }
+	};
+
+	for(unsigned k=0; k<sizeof(objectives)/sizeof(objectives[0]); k++) {
+		if (0 == strcasecmp(name.c_str(), objectives[k].m_name)) {
+			obj = objectives[k].m_obj;
+			return true;
+		}
+	} return false;
+}
+// }}}
+
+//
+// FREELIST
+// {{{
+// The free space remaining, kept as one set of aligned blocks for each
+// power of two block size.
+//
+class	FREELIST {
+	std::vector<std::set<unsigned long> >	m_free;
+public:
+	FREELIST(unsigned lgsize) : m_free(lgsize+1) {}
+
+	// Release [lo,hi), as the fewest aligned blocks that will cover it
+	void	release(unsigned long lo, unsigned long hi) {
+		while(lo < hi) {
+			unsigned	lg = 0;
+
+			while((lg+1 < m_free.size())
+					&&(0 == (lo & ((2ul<<lg)-1)))
+					&&(lo + (2ul<<lg) <= hi))
+				lg++;
+			m_free[lg].insert(lo);
+			lo += (1ul << lg);
+		}
+	}
+
+	// Take the lowest block of the smallest size that will hold 2^lg
+	// octets, returning any excess to the free lists
+	bool	take(unsigned lg, unsigned long &addr) {
+		unsigned	k;
+
+		for(k=lg; k<m_free.size() && m_free[k].empty(); k++)
+			;
+		if (k >= m_free.size())
+			return false;
+		addr = *m_free[k].begin();
+		m_free[k].erase(m_free[k].begin());
+		while(k > lg) {
+			k--;
+			m_free[k].insert(addr + (1ul << k));
+		} return true;
+	}
+};
+// }}}
+
+//
+// PACKER
+// {{{
+// The state of one call to pack_addresses()
+//
+class	PACKER {
+	std::vector<PACKITEM>	&m_items;
+	std::vector<unsigned>	m_movable, m_region;
+	// The fixed regions, as (base, end) pairs, sorted by base
+	std::vector<std::pair<unsigned long, unsigned long> >	m_fixed;
+	unsigned long		m_nullsz;
+	unsigned		m_min_width;
+	bool			m_widen;
+	PACKOBJ			m_obj;
+
+	bool			m_found;
+	unsigned long		m_best_cost[3];
+	std::vector<PACKITEM>	m_best;
+
+	// Place every movable item, using the current region sizes, within
+	// an address space of 2^lgsize octets
+	bool	place(unsigned lgsize) {
+		FREELIST	freelist(lgsize);
+		unsigned long	cursor = m_nullsz;
+		std::vector<unsigned>	order = m_movable;
+
+		for(unsigned k=0; k<m_fixed.size(); k++) {
+			if (m_fixed[k].first > cursor)
+				freelist.release(cursor, m_fixed[k].first);
+			if (m_fixed[k].second > cursor)
+				cursor = m_fixed[k].second;
+		} if (cursor < (1ul << lgsize))
+			freelist.release(cursor, (1ul << lgsize));
+
+		// Largest first.  Ties keep their original order, so that
+		// the first of several equal peripherals gets the lower address
+		std::stable_sort(order.begin(), order.end(),
+			[this](unsigned a, unsigned b) {
+				return m_region[a] > m_region[b]; });
+
+		for(unsigned k=0; k<order.size(); k++) {
+			PACKITEM	&item = m_items[order[k]];
+
+			if (!freelist.take(m_region[order[k]], item.m_base))
+				return false;
+			item.m_lgregion = m_region[order[k]];
+		} return true;
+	}
+
+	// Compare the layout just placed against the best so far
+	void	consider(void) {
+		unsigned long	end = m_nullsz, bits = 0, cost[3];
+		unsigned	awid, depth = 0, ewid;
+
+		for(unsigned k=0; k<m_items.size(); k++) {
+			unsigned long	last = m_items[k].m_base
+					+ (1ul << m_items[k].m_lgregion);
+			if (last > end)
+				end = last;
+		}
+
+		awid = nextlg(end);
+		for(unsigned k=0; k<m_items.size(); k++) {
+			unsigned	d = awid - m_items[k].m_lgregion;
+
+			bits += d;
+			if (d > depth)
+				depth = d;
+		}
+
+		ewid = (awid < m_min_width) ? m_min_width : awid;
+		switch(m_obj) {
+		case PACK_LUTS:
+			cost[0] = bits; cost[1] = ewid; cost[2] = depth;
+			break;
+		case PACK_DEPTH:
+			cost[0] = depth; cost[1] = ewid; cost[2] = bits;
+			break;
+		default:
+			cost[0] = ewid; cost[1] = bits; cost[2] = depth;
+			break;
+		}
+
+		if (m_found && !std::lexicographical_compare(cost, cost+3,
+					m_best_cost, m_best_cost+3))
+			return;
+		m_found = true;
+		std::copy(cost, cost+3, m_best_cost);
+		m_best = m_items;
+	}
+
+	// Grow the smallest regions, one level at a time, while everything
+	// still fits.  When not all of the smallest regions can grow, grow
+	// as many of them as will still fit, and stop.
+	void	grow(unsigned lgsize) {
+		while(true) {
+			std::vector<unsigned>	level;
+			unsigned	lvl = lgsize, lo, hi;
+
+			for(unsigned k=0; k<m_movable.size(); k++)
+				if (m_region[m_movable[k]] < lvl)
+					lvl = m_region[m_movable[k]];
+			if (lvl >= lgsize)
+				return;
+			for(unsigned k=0; k<m_movable.size(); k++)
+				if (m_region[m_movable[k]] == lvl)
+					level.push_back(m_movable[k]);
+
+			for(unsigned k=0; k<level.size(); k++)
+				m_region[level[k]]++;
+			if (place(lgsize)) {
+				consider();
+				continue;
+			}
+
+			for(unsigned k=0; k<level.size(); k++)
+				m_region[level[k]]--;
+
+			// Raising the first lo fits, raising the first hi
+			// does not
+			lo = 0; hi = level.size();
+			while(hi - lo > 1) {
+				unsigned	mid = (lo + hi) / 2;
+				bool		fits;
+
+				for(unsigned k=0; k<mid; k++)
+					m_region[level[k]]++;
+				fits = place(lgsize);
+				for(unsigned k=0; k<mid; k++)
+					m_region[level[k]]--;
+				if (fits)
+					lo = mid;
+				else
+					hi = mid;
+			}
+
+			if (lo > 0) {
+				for(unsigned k=0; k<lo; k++)
+					m_region[level[k]]++;
+				place(lgsize);
+				consider();
+			} return;
+		}
+	}
+public:
+	PACKER(std::vector<PACKITEM> &items, unsigned long nullsz,
+			unsigned min_width, bool widen, PACKOBJ obj)
+		: m_items(items), m_region(items.size()), m_nullsz(nullsz),
+		m_min_width(min_width), m_widen(widen), m_obj(obj),
+		m_found(false) {
+		for(unsigned k=0; k<m_items.size(); k++) {
+			PACKITEM	&item = m_items[k];
+
+			item.m_lgregion = item.m_lgsize;
+			if (item.m_fixed)
+				m_fixed.push_back(std::make_pair(item.m_base,
+					item.m_base + (1ul << item.m_lgsize)));
+			else
+				m_movable.push_back(k);
+		} std::sort(m_fixed.begin(), m_fixed.end());
+	}
+
+	bool	pack(unsigned &width) {
+		unsigned long	total = m_nullsz;
+		unsigned	lgmin, lglast = MAX_PACK_WIDTH;
+
+		// No address width smaller than the sum of all of the sizes,
+		// nor smaller than the largest (or last fixed) peripheral,
+		// will ever fit
+		lgmin = 0;
+		for(unsigned k=0; k<m_items.size(); k++) {
+			unsigned	lg;
+
+			total += (1ul << m_items[k].m_lgsize);
+			if (m_items[k].m_fixed)
+				lg = nextlg(m_items[k].m_base
+					+ (1ul << m_items[k].m_lgsize));
+			else
+				lg = m_items[k].m_lgsize;
+			if (lg > lgmin)
+				lgmin = lg;
+		} if (nextlg(total) > lgmin)
+			lgmin = nextlg(total);
+
+		for(unsigned lg=lgmin; lg <= lglast; lg++) {
+			for(unsigned k=0; k<m_movable.size(); k++)
+				m_region[m_movable[k]]
+					= m_items[m_movable[k]].m_lgsize;
+			if (!place(lg))
+				continue;
+
+			if (!m_found) {
+				// Only the bus width matters when minimizing
+				// it, so there's no point looking any wider.
+				// Otherwise, a few more bits is enough to
+				// let every region grow to the same size--if
+				// we're allowed to make the bus that wide.
+				if ((PACK_AWID == m_obj)
+						||(PACK_SEQUENTIAL == m_obj)
+						||(!m_widen))
+					lglast = (lg < m_min_width)
+							? m_min_width : lg;
+				else
+					lglast = lg + nextlg(m_movable.size()+1)+1;
+				if (lglast > MAX_PACK_WIDTH)
+					lglast = MAX_PACK_WIDTH;
+			}
+
+			consider();
+			grow(lg);
+		}
+
+		if (!m_found)
+			return false;
+
+		m_items = m_best;
+		width = nextlg(m_nullsz);
+		for(unsigned k=0; k<m_items.size(); k++) {
+			unsigned	lg = nextlg(m_items[k].m_base
+					+ (1ul << m_items[k].m_lgregion));
+			if (lg > width)
+				width = lg;
+		} return true;
+	}
+};
+// }}}
+
+//
+// pack_addresses
+// {{{
+// Fixed items are expected to be aligned, to lie above nullsz, and not to
+// overlap each other.  The caller checks all of this.
+//
+bool	pack_addresses(std::vector<PACKITEM> &items, unsigned long nullsz,
+		unsigned min_width, bool widen, PACKOBJ obj, unsigned &width) {
+	PACKER	packer(items, nullsz, min_width, widen, obj);
+
+	return packer.pack(width);
+}
+// }}}
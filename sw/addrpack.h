@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/addrpack.h
+//
+// Project:	AutoFPGA, a utility for composing FPGA designs from peripherals
+// {{{
+// Purpose:	Place the peripherals of one bus within its address space,
+//		so as to minimize a user selected cost--either the bus address
+//		width, the number of address bits decoded, or the depth of
+//		the deepest decoder.  Peripherals may also be given fixed
+//		addresses, around which the others are packed.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	ADDRPACK_H
+#define	ADDRPACK_H
+
+#include <vector>
+#include "mapdhash.h"
+
+typedef	enum	{
+	PACK_SEQUENTIAL,	// The original, sorted by size, layout
+	PACK_AWID,		// Minimize the bus address width first
+	PACK_LUTS,		// Reduce the total address bits compared
+	PACK_DEPTH		// Reduce the widest single comparison
+} PACKOBJ;
+
+//
+// PACKITEM
+//
+// One peripheral to be placed.  All sizes and addresses are in octets.
+// m_lgregion is set on return to the log (base two) of the region decoded
+// for this peripheral.  It will never be less than m_lgsize.
+//
+typedef	struct	PACKITEM_S {
+	unsigned	m_lgsize;
+	bool		m_fixed;
+	unsigned long	m_base;
+	unsigned	m_lgregion;
+} PACKITEM;
+
+//
+// packing_objective
+//
+// Look up a packing objective by name, as given by @BUS.PACKING.  Returns
+// false if the name isn't recognized.
+//
+extern	bool	packing_objective(const STRING &name, PACKOBJ &obj);
+
+//
+// pack_addresses
+//
+// Assign an m_base and m_lgregion to every item that isn't fixed, keeping
+// [0,nullsz) unused.  On success, width is set to the log (base two) of the
+// end of the last region.  Returns false if no layout fits in 32 bits.
+//
+// Unless widen is set, the LUTS and DEPTH objectives may only grow regions
+// within the narrowest width that fits, rather than making the bus any wider
+// in order to grow them further.
+//
+extern	bool	pack_addresses(std::vector<PACKITEM> &items,
+			unsigned long nullsz, unsigned min_width, bool widen,
+			PACKOBJ obj, unsigned &width);
+
+#endif	// ADDRPACK_H
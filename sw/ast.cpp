@@ -47,9 +47,8 @@ bool	AST_BRANCH::isdefined(void) {
 			&&(m_right->isdefined()));
 }
 
-long AST_BRANCH::eval(void) {
-	long	lft = m_left->eval(), rht = m_right->eval();
-	switch(m_op) {
+long	ast_binop(int op, long lft, long rht) {
+	switch(op) {
 		case '+':	return lft + rht;	break;
 		case '-':	return lft - rht;	break;
 		case '*':	return lft * rht;	break;
@@ -75,10 +74,14 @@ long AST_BRANCH::eval(void) {
 		case '>':	return (lft >  rht)? 1:0;	break;
 		//
 		//
-		default:	fprintf(stderr, "ERR: AST Unknown operation, %c", m_op);
+		default:	fprintf(stderr, "ERR: AST Unknown operation, %c", op);
 			return lft;
 	}
 }
+
+long AST_BRANCH::eval(void) {
+	return ast_binop(m_op, m_left->eval(), m_right->eval());
+}
 bool	AST_BRANCH::define(MAPSTACK &stack, MAPDHASH &here) {
 	bool	v;
 	v =  m_left->define(stack, here);
@@ -95,6 +98,12 @@ AST	*AST_BRANCH::copy(void) {
 	return new AST_BRANCH(m_op, ::copy(m_left), ::copy(m_right));
 }
 
+void	AST_BRANCH::compile(AST_PROGRAM &prog) {
+	m_left->compile(prog);
+	m_right->compile(prog);
+	prog.add(AST_PROGRAM::OP_BRANCH, m_op);
+}
+
 bool	AST_SINGLEOP::isdefined(void) {
 		return (m_val->isdefined()); }
 long	AST_SINGLEOP::eval(void) {
@@ -115,6 +124,11 @@ AST	*AST_SINGLEOP::copy(void) {
 	return new AST_SINGLEOP(m_op, ::copy(m_val));
 }
 
+void	AST_SINGLEOP::compile(AST_PROGRAM &prog) {
+	m_val->compile(prog);
+	prog.add(AST_PROGRAM::OP_SINGLEOP, m_op);
+}
+
 bool	AST_TRIOP::isdefined(void) {
 	return (m_cond->isdefined())&&(m_left->isdefined())
 			&&(m_right->isdefined());
@@ -140,6 +154,33 @@ AST	*AST_TRIOP::copy(void) {
 	return new AST_TRIOP(::copy(m_cond), ::copy(m_left), ::copy(m_right));
 }
 
+void	AST_TRIOP::compile(AST_PROGRAM &prog) {
+	// Only one side of the condition is ever evaluated, so that (for
+	// example) X/Y need not be defined when Y is zero.
+	//
+	//	cond; JZ L1; left; JMP L2; L1: right; L2: ENDIF jz
+	//
+	// JZ pops the condition and, if it was zero, jumps to the right
+	// hand side.  Otherwise the left hand side is evaluated, and JMP
+	// skips past the right hand side to the ENDIF.  The ENDIF does
+	// nothing when evaluated.  Its argument is the address of the JZ
+	// (not of the start of the condition), from which dump() can find
+	// where the condition and the left hand side end: just before the
+	// JZ, and just before the JMP (JZ's target, less one).
+	unsigned	jz, jmp;
+
+	m_cond->compile(prog);
+	jz = prog.size();
+	prog.add(AST_PROGRAM::OP_JZ);
+	m_left->compile(prog);
+	jmp = prog.size();
+	prog.add(AST_PROGRAM::OP_JMP);
+	prog.m_insn[jz].m_arg = prog.size();
+	m_right->compile(prog);
+	prog.m_insn[jmp].m_arg = prog.size();
+	prog.add(AST_PROGRAM::OP_ENDIF, 0, jz);
+}
+
 
 bool	AST_NUMBER::isdefined(void) { return true; }
 long	AST_NUMBER::eval(void) { return m_val; }
@@ -151,6 +192,10 @@ AST	*AST_NUMBER::copy(void) {
 	return new AST_NUMBER(m_val);
 }
 
+void	AST_NUMBER::compile(AST_PROGRAM &prog) {
+	prog.add(AST_PROGRAM::OP_NUMBER, 0, m_val);
+}
+
 
 bool	AST_IDENTIFIER::isdefined(void) { return m_def; }
 long	AST_IDENTIFIER::eval(void) { return m_v; }
@@ -171,5 +216,210 @@ void	AST_IDENTIFIER::dump(FILE *fp, int offset) {
 		fprintf(fp, "%*s%s (Undefined)\n", offset, "", m_id.c_str());
 }
 AST	*AST_IDENTIFIER::copy(void) {
-	return new AST_IDENTIFIER(m_id.c_str());
+	return new AST_IDENTIFIER(&m_id);
+}
+
+void	AST_IDENTIFIER::compile(AST_PROGRAM &prog) {
+	unsigned	s = prog.slot(m_id);
+
+	if ((m_def)&&(!prog.m_slots[s].m_def)) {
+		prog.m_slots[s].m_def = true;
+		prog.m_slots[s].m_v   = m_v;
+		prog.m_nundef--;
+	}
+	prog.add(AST_PROGRAM::OP_SLOT, 0, s);
+}
+
+//
+// AST_PROGRAM
+// {{{
+AST_PROGRAM::AST_PROGRAM(AST *tree) : m_nundef(0), m_depth(0) {
+	unsigned	sp = 0;
+
+	m_node_type = 'P';
+	tree->compile(*this);
+
+	// Work out how deep the evaluation stack can get, so eval() never
+	// needs to grow it
+	for(unsigned k=0; k<m_insn.size(); k++) {
+		switch(m_insn[k].m_code) {
+		case OP_NUMBER: case OP_SLOT:	sp++; break;
+		case OP_BRANCH: case OP_JZ:
+		case OP_JMP:			sp--; break;
+		default: break;
+		} if (sp > m_depth)
+			m_depth = sp;
+	}
+	m_stack.resize(m_depth);
+}
+
+void	AST_PROGRAM::add(int code, int op, long arg) {
+	INSN	insn;
+
+	insn.m_code = code;
+	insn.m_op   = op;
+	insn.m_arg  = arg;
+	m_insn.push_back(insn);
+}
+
+unsigned	AST_PROGRAM::slot(const STRING &id) {
+	// Parse the name now, so define() needn't do so every time it's called
+	SLOT	s = { &id, KVNAME(id), false, 0 };
+
+	for(unsigned k=0; k<m_slots.size(); k++)
+		if (m_slots[k].m_id == &id)
+			return k;
+
+	m_slots.push_back(s);
+	m_nundef++;
+	return m_slots.size()-1;
+}
+
+bool	AST_PROGRAM::isdefined(void) {
+	return (m_nundef == 0);
 }
+
+long	AST_PROGRAM::eval(void) {
+	long	*sp = m_stack.data();
+	const INSN *insn = m_insn.data(), *end = insn + m_insn.size();
+
+	while(insn < end) {
+		switch(insn->m_code) {
+		case OP_NUMBER:	*sp++ = insn->m_arg; break;
+		case OP_SLOT:	*sp++ = m_slots[insn->m_arg].m_v; break;
+		case OP_BRANCH:
+			sp--;
+			sp[-1] = ast_binop(insn->m_op, sp[-1], sp[0]);
+			break;
+		case OP_SINGLEOP:
+			if (insn->m_op == '~')
+				sp[-1] = ~sp[-1];
+			else
+				sp[-1] = (sp[-1]) ? 0:1;
+			break;
+		case OP_JZ:
+			if (*--sp == 0) {
+				insn = m_insn.data() + insn->m_arg;
+				continue;
+			} break;
+		case OP_JMP:
+			insn = m_insn.data() + insn->m_arg;
+			continue;
+		default: break;
+		} insn++;
+	}
+
+	return sp[-1];
+}
+
+bool	AST_PROGRAM::define(MAPSTACK &stack, MAPDHASH &here) {
+	bool	changed = false;
+
+	if (m_nundef == 0)
+		return false;
+	for(unsigned k=0; k<m_slots.size(); k++) {
+		SLOT	&s = m_slots[k];
+
+		if ((!s.m_def)&&(get_named_value(stack, here, s.m_name, s.m_v))) {
+			s.m_def = true;
+			m_nundef--;
+			changed = true;
+		}
+	} return changed;
+}
+
+//
+// start
+//
+// Return the address of the first instruction of the subexpression ending
+// with the instruction at pc
+unsigned	AST_PROGRAM::start(unsigned pc) {
+	switch(m_insn[pc].m_code) {
+	case OP_BRANCH:		return start(start(pc-1)-1);
+	case OP_SINGLEOP:	return start(pc-1);
+	case OP_ENDIF:		return start(m_insn[pc].m_arg-1);
+	default:		return pc;
+	}
+}
+
+//
+// dump_aux
+//
+// Dump the subexpression ending at pc, in the same form the tree it was
+// compiled from would've used
+void	AST_PROGRAM::dump_aux(FILE *fp, int offset, unsigned pc) {
+	const INSN	&insn = m_insn[pc];
+
+	switch(insn.m_code) {
+	case OP_NUMBER:
+		fprintf(fp, "%*s%ld\n", offset, "", insn.m_arg);
+		break;
+	case OP_SLOT: {
+		const SLOT &s = m_slots[insn.m_arg];
+		if (s.m_def)
+			fprintf(fp, "%*s%s (= %d)\n", offset, "",
+				s.m_id->c_str(), s.m_v);
+		else
+			fprintf(fp, "%*s%s (Undefined)\n", offset, "",
+				s.m_id->c_str());
+		} break;
+	case OP_BRANCH:
+		fprintf(fp, "%*s%c\n", offset, "", insn.m_op);
+		dump_aux(fp, offset+2, start(pc-1)-1);
+		dump_aux(fp, offset+2, pc-1);
+		break;
+	case OP_SINGLEOP:
+		fprintf(fp, "%*s%c\n", offset, "", insn.m_op);
+		dump_aux(fp, offset+2, pc-1);
+		break;
+	case OP_ENDIF: {
+		unsigned jz = insn.m_arg, jmp = m_insn[jz].m_arg-1;
+		fprintf(fp, "%*sTRIPL:\n", offset, "");
+		dump_aux(fp, offset+2, jz-1);
+		dump_aux(fp, offset+2, jmp-1);
+		dump_aux(fp, offset+2, pc-1);
+		} break;
+	default: break;
+	}
+}
+
+void	AST_PROGRAM::dump(FILE *fp, int offset) {
+	if (m_insn.size() > 0)
+		dump_aux(fp, offset, m_insn.size()-1);
+}
+
+AST	*AST_PROGRAM::copy(void) {
+	AST_PROGRAM	*p = new AST_PROGRAM();
+
+	p->m_insn   = m_insn;
+	p->m_slots  = m_slots;
+	p->m_nundef = m_nundef;
+	p->m_depth  = m_depth;
+	p->m_stack.resize(m_depth);
+	return p;
+}
+
+void	AST_PROGRAM::compile(AST_PROGRAM &prog) {
+	// Inline this program into the other, renumbering both our slots
+	// and our jump targets
+	unsigned	base = prog.size();
+
+	for(unsigned k=0; k<m_insn.size(); k++) {
+		INSN	insn = m_insn[k];
+
+		if (insn.m_code == OP_SLOT) {
+			const SLOT	&s = m_slots[insn.m_arg];
+			unsigned	ps = prog.slot(*s.m_id);
+
+			if ((s.m_def)&&(!prog.m_slots[ps].m_def)) {
+				prog.m_slots[ps].m_def = true;
+				prog.m_slots[ps].m_v   = s.m_v;
+				prog.m_nundef--;
+			} insn.m_arg = ps;
+		} else if ((insn.m_code == OP_JZ)||(insn.m_code == OP_JMP)
+				||(insn.m_code == OP_ENDIF))
+			insn.m_arg += base;
+		prog.m_insn.push_back(insn);
+	}
+}
+// }}}
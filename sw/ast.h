@@ -43,17 +43,27 @@
 #include <stdlib.h>
 #include <string.h>
 #include "parser.h"
+#include <vector>
 #include "kveval.h"
+#include "region.h"
+
+class	AST_PROGRAM;
 
 class AST {
 public:
 	virtual ~AST(void) {}
+	// Expression trees live within the global region, and are released
+	// with it rather than one node at a time.
+	static	void	*operator new(size_t sz) { return gbl_region.alloc(sz); }
+	static	void	operator delete(void *p) {}
 	char	m_node_type;
 	virtual bool	isdefined(void) = 0;
 	virtual long	eval(void) = 0;
 	virtual bool	define(MAPSTACK &stack, MAPDHASH &comp) = 0;
 	virtual void	dump(FILE *fp, int offset) = 0;
 	virtual	AST	*copy(void) = 0;
+	// Append this (sub)tree, in postfix order, to the given program
+	virtual	void	compile(AST_PROGRAM &prog) = 0;
 };
 
 class AST_BRANCH : public AST {
@@ -75,6 +85,7 @@ public:
 	virtual	bool	define(MAPSTACK &stack, MAPDHASH &here);
 	virtual	void	dump(FILE *fp, int offset);
 	virtual	AST	*copy(void);
+	virtual	void	compile(AST_PROGRAM &prog);
 };
 
 class	AST_SINGLEOP : public AST {
@@ -90,6 +101,7 @@ class	AST_SINGLEOP : public AST {
 	virtual	bool	define(MAPSTACK &stack, MAPDHASH &here);
 	virtual	void	dump(FILE *fp, int offset);
 	virtual	AST	*copy(void);
+	virtual	void	compile(AST_PROGRAM &prog);
 };
 
 class	AST_TRIOP : public AST {
@@ -108,6 +120,7 @@ public:
 	virtual	bool	define(MAPSTACK &stack, MAPDHASH &here);
 	virtual	void	dump(FILE *fp, int offset);
 	virtual	AST	*copy(void);
+	virtual	void	compile(AST_PROGRAM &prog);
 };
 
 class	AST_NUMBER : public AST {
@@ -120,14 +133,16 @@ public:
 	virtual	bool	define(MAPSTACK &stack, MAPDHASH &here);
 	virtual	void	dump(FILE *fp, int offset);
 	virtual	AST	*copy(void);
+	virtual	void	compile(AST_PROGRAM &prog);
 };
 
 class	AST_IDENTIFIER : public AST {
 public:
-	STRING	m_id;
+	const STRING	&m_id;	// Interned, so never freed with the tree
 	bool	m_def;
 	int	m_v;
-	AST_IDENTIFIER(const char *id) : m_id(id) {
+	// The id given must already be interned, as by kvintern()
+	AST_IDENTIFIER(const STRING *id) : m_id(*id) {
 		m_node_type = 'I';
 		m_def=false;
 		m_v = 0;
@@ -138,8 +153,62 @@ public:
 	virtual	bool	define(MAPSTACK &stack, MAPDHASH &here);
 	virtual	void	dump(FILE *fp, int offset);
 	virtual	AST	*copy(void);
+	virtual	void	compile(AST_PROGRAM &prog);
+};
+
+// class AST_PROGRAM
+// {{{
+// An expression tree, compiled into a flat postfix program.  Every
+// identifier the expression references becomes a single slot, no matter how
+// many times it appears within the expression.  Each slot's name is parsed
+// into a KVNAME when it is compiled, so define() only needs to search for
+// it--and stops searching once it has been found.
+// Evaluation is then a single loop over the program, rather than a walk
+// across the tree.
+//
+class	AST_PROGRAM : public AST {
+public:
+	enum	{ OP_NUMBER, OP_SLOT, OP_BRANCH, OP_SINGLEOP,
+			OP_JZ, OP_JMP, OP_ENDIF };
+
+	typedef	struct	{
+		int	m_code, m_op;	// m_op is the operator, if any
+		long	m_arg;		// Value, slot number, or jump target
+	} INSN;
+
+	typedef	struct	{
+		const STRING	*m_id;	// Interned
+		KVNAME		m_name;	// m_id, parsed
+		bool		m_def;
+		int		m_v;
+	} SLOT;
+
+	std::vector<INSN>	m_insn;
+	std::vector<SLOT>	m_slots;
+	std::vector<long>	m_stack;
+	unsigned		m_nundef, m_depth;
+
+	AST_PROGRAM(void) : m_nundef(0), m_depth(0) { m_node_type = 'P'; }
+	AST_PROGRAM(AST *tree);
+
+	// Used by compile() to build the program
+	void	add(int code, int op = 0, long arg = 0);
+	unsigned	slot(const STRING &id);
+	unsigned	size(void) const { return m_insn.size(); }
+
+	virtual	bool	isdefined(void);
+	virtual	long	eval(void);
+	virtual	bool	define(MAPSTACK &stack, MAPDHASH &here);
+	virtual	void	dump(FILE *fp, int offset);
+	virtual	AST	*copy(void);
+	virtual	void	compile(AST_PROGRAM &prog);
+private:
+	unsigned	start(unsigned pc);
+	void		dump_aux(FILE *fp, int offset, unsigned pc);
 };
+// }}}
 
+extern	long	ast_binop(int op, long lft, long rht);
 extern AST	*parse_ast(const STRING &str);
 inline	AST *copy(AST *a) { return a->copy(); }
 
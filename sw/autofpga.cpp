@@ -70,8 +70,22 @@
 #include <sys/types.h>
 #include <limits.h>
 #include <ctype.h>
+#include <sys/wait.h>
+
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <thread>
 
 #include "parser.h"
+#include "pcache.h"
+#include "outfile.h"
+#include "gather.h"
+#include "watch.h"
+#include "patch.h"
+#include "region.h"
+#include "stats.h"
 #include "keys.h"
 #include "kveval.h"
 #include "legalnotice.h"
@@ -281,6 +295,8 @@ typedef	std::vector<PICP>	PICLIST;
 
 // A list of all of our interrupt controllers
 PICLIST	piclist;
+// The same controllers, by (interned) name
+std::unordered_map<const STRING *, PICP>	picindex;
 unsigned	unusedmsk;
 // }}}
 
@@ -321,16 +337,15 @@ void	assign_int_to_pics(const STRING &iname, MAPDHASH &ihash) {
 	cpy = strdup(picname->c_str());
 	tok = strtok_r(cpy, ", \t\n", &sr);
 	while(tok) {
-		unsigned pid;
-		for(pid = 0; pid<piclist.size(); pid++)
-			if (piclist[pid]->i_name->compare(tok)==0)
-				break;
-		if (pid >= piclist.size()) {
+		std::unordered_map<const STRING *, PICP>::iterator pic;
+
+		pic = picindex.find(kvintern(STRING(tok)));
+		if (pic == picindex.end()) {
 			gbl_msg.error("PIC NOT FOUND: %s\n", tok);
 		} else if (getvalue(ihash, KY_ID, inum)) {
-			piclist[pid]->add((unsigned)inum, ihash, (STRINGP)&iname);
+			pic->second->add((unsigned)inum, ihash, (STRINGP)&iname);
 		} else {
-			piclist[pid]->add(ihash, (STRINGP)&iname);
+			pic->second->add(ihash, (STRINGP)&iname);
 		}
 		tok = strtok_r(NULL, ", \t\n", &sr);
 	} free(cpy);
@@ -347,20 +362,30 @@ void	assign_int_to_pics(const STRING &iname, MAPDHASH &ihash) {
 void	assign_interrupts(MAPDHASH &master) {
 	// {{{
 	MAPDHASH::iterator	kvpair, kvint, kvline;
+	std::vector<MAPDHASH::iterator>	order, intorder;
 	MAPDHASH	*submap, *intmap;
 	STRINGP		sintlist;
 
+	// Interrupt numbers are handed out in the order interrupts are found.
+	// Visit components, and their interrupts, in the same (legacy) order
+	// as always, so that interrupts keep the numbers they've always had.
+	master.legacy_order(order);
+
 	// First step, gather all of our PIC's together
-	for(kvpair=master.begin(); kvpair != master.end(); kvpair++) {
+	for(unsigned k=0; k<order.size(); k++) {
+		kvpair = order[k];
 		if (ispic(kvpair->second)) {
 			PICP npic = new PICI(*kvpair->second.u.m_m);
 			piclist.push_back(npic);
+			picindex.insert(std::make_pair(kvintern(*npic->i_name),
+					npic));
 		}
 	}
 
 	// Okay, now we need to gather all of our interrupts together and to
 	// assign them to PICs.
-	for(kvpair=master.begin(); kvpair != master.end(); kvpair++) {
+	for(unsigned k=0; k<order.size(); k++) {
+		kvpair = order[k];
 		if (kvpair->second.m_typ != MAPT_MAP)
 			continue;
 
@@ -400,8 +425,9 @@ void	assign_interrupts(MAPDHASH &master) {
 			// Hence the component has one (or more) interrupts.
 			// Let's loop over those interrupts
 			intmap = kvint->second.u.m_m;
-			for(kvline=intmap->begin(); kvline != intmap->end();
-						kvline++) {
+			intmap->legacy_order(intorder);
+			for(unsigned j=0; j<intorder.size(); j++) {
+				kvline = intorder[j];
 				if (kvline->second.m_typ != MAPT_MAP)
 					continue;
 				assign_int_to_pics(kvline->first,
@@ -1195,13 +1221,14 @@ void	build_outfile_aux(MAPDHASH &info, STRINGP fname, STRINGP data) {
 
 	FILE	*fp;
 	str = subd->c_str(); str += "/"+(*fname);
-	fp = fopen(str.c_str(), "w");
+	fp = ofopen(str.c_str());
 	if (NULL == fp)
 		gbl_msg.fatal("Cannot write %s\n", str.c_str());
 
 	unsigned nw = fwrite(data->c_str(), 1, data->size(), fp);
 	if (nw != data->size())
 		gbl_msg.fatal("%s data not fully written\n", str.c_str());
+	ofclose(fp);
 }
 
 
@@ -1249,142 +1276,240 @@ FILE	*open_in(MAPDHASH &info, const STRING &fname) {
 }
 
 
-typedef	std::vector<STRINGP>	PORTLIST;
-void	get_portlist(MAPDHASH &master, PORTLIST &ports) {
+// Top-level ports, for uncommenting lines in the constraint files
+// {{{
+// The set of ports is gathered once, from every @TOP.PORTLIST (or
+// @MAIN.PORTLIST) and @CLOCK.TOP key, and then shared by all of the
+// constraint file builders below.  It's built before the output jobs are
+// forked off, so each builder just inherits a copy.
+typedef	std::unordered_set<STRING>	PORTSET;
+static	PORTSET	*gbl_portset = NULL;
+
+static	void	add_ports(PORTSET &ports, STRINGP str) {
+	const	char	*DELIMITERS = ", \t\n";
+	STRINGP		stripped;
+	char		*pptr;
+
+	stripped = remove_comments(str);
+
+	pptr = strtok((char *)stripped->c_str(), DELIMITERS);
+	while(pptr) {
+		if (ports.insert(STRING(pptr)).second)
+			gbl_msg.info("\t%s\n", pptr);
+		pptr = strtok(NULL, DELIMITERS);
+	} delete stripped;
+}
+
+static const PORTSET &get_portset(MAPDHASH &master) {
 	MAPDHASH::iterator	kvpair;
-	STRINGP			str, stripped;
-	char			*pptr;
+	STRINGP			str;
+
+	if (gbl_portset)
+		return *gbl_portset;
 
+	gbl_msg.info("\nTop-level ports:\n");
+	gbl_portset = new PORTSET();
 	for(kvpair = master.begin(); kvpair != master.end(); kvpair++) {
-		const	char	*DELIMITERS = ", \t\n";
 		if (kvpair->second.m_typ != MAPT_MAP)
 			continue;
 		str = getstring(kvpair->second, KYTOP_PORTLIST);
 		if (str == NULL)
 			str = getstring(kvpair->second, KYMAIN_PORTLIST);
-		if (str == NULL)
-			continue;
-		stripped = remove_comments(str);
-
-		pptr = strtok((char *)stripped->c_str(), DELIMITERS);
-		while(pptr) {
-			ports.push_back(new STRING(pptr));
-			gbl_msg.info("\t%s\n", pptr);
-			pptr = strtok(NULL, DELIMITERS);
-		} delete stripped;
+		if (str != NULL)
+			add_ports(*gbl_portset, str);
 	}
 
 	// Check any CLOCK.TOP keys
 	for(kvpair = master.begin(); kvpair != master.end(); kvpair++) {
-		const	char	*DELIMITERS = ", \t\n";
 		if (kvpair->second.m_typ != MAPT_MAP)
 			continue;
 		str = getstring(kvpair->second, KYCLOCK_TOP);
-		if (str == NULL)
-			continue;
-		stripped = remove_comments(str);
+		if (str != NULL)
+			add_ports(*gbl_portset, str);
+	}
 
-		pptr = strtok((char *)stripped->c_str(), DELIMITERS);
-		while(pptr) {
-			ports.push_back(new STRING(pptr));
-			gbl_msg.info("\t%s\n", pptr);
-			pptr = strtok(NULL, DELIMITERS);
-		} delete stripped;
+	return *gbl_portset;
+}
+// }}}
+
+// Port name extractors
+// {{{
+// Each of these looks for a port reference within a commented constraint
+// line, and copies the port's name into name.  They return false if the line
+// doesn't reference any port.
+//
+typedef	bool	(*PORTNAMEFN)(const char *line, STRING &name);
+
+static	void	copyname(const char *cptr, const char *stops, STRING &name) {
+	const	char	*ptr = cptr;
+
+	while((*ptr)&&(!isspace(*ptr))&&(NULL == strchr(stops, *ptr)))
+		ptr++;
+	name.assign(cptr, ptr-cptr);
+}
+
+static	bool	xdc_portname(const char *line, STRING &name) {
+	const char	*GET_PORTS_KEY = "get_ports",
+			*SET_PROPERTY_KEY = "set_property";
+	const	char	*cptr;
+
+	if (NULL == (cptr = strstr(line, SET_PROPERTY_KEY)))
+		return false;
+	if (NULL == (cptr = strstr(cptr, GET_PORTS_KEY)))
+		return false;
+
+	cptr += strlen(GET_PORTS_KEY);
+	while((*cptr)&&(*cptr != '{')&&(isspace(*cptr)))
+		cptr++;
+	if (*cptr == '{')
+		cptr++;
+	if (!(*cptr))
+		return false;
+
+	while((*cptr)&&(isspace(*cptr)))
+		cptr++;
+
+	copyname(cptr, "[}]", name);
+	return true;
+}
+
+static	bool	pcf_portname(const char *line, STRING &name) {
+	const char	*SET_IO_KEY = "set_io";
+	const	char	*cptr;
+
+	if (NULL == (cptr = strstr(line, SET_IO_KEY)))
+		return false;
+
+	cptr += strlen(SET_IO_KEY);
+	while((*cptr == ' ')||(*cptr == '\t'))
+		cptr++;
+	if (!(*cptr))
+		return false;
+
+	copyname(cptr, "[}]", name);
+	return true;
+}
+
+static	bool	lpf_portname(const char *line, STRING &name) {
+	const char	*LOC_KEY = "LOCATE COMP",
+			*BUF_KEY = "IOBUF PORT";
+	const	char	*cptr, *keyp;
+
+	keyp = LOC_KEY;
+	if (NULL == (cptr = strcasestr(line, LOC_KEY))) {
+		keyp = BUF_KEY;
+		if (NULL == (cptr = strcasestr(line, BUF_KEY)))
+			return false;
 	}
+
+	cptr += strlen(keyp);
+	if (strncmp(cptr, " \"", 2)==0)
+		cptr += 2;
+	while((*cptr == ' ')||(*cptr == '\t'))
+		cptr++;
+	if (!(*cptr))
+		return false;
+
+	copyname(cptr, "[}]\"", name);
+	return true;
 }
 
-void	build_xdc(MAPDHASH &master, FILE *fp, STRING &fname) {
-	MAPDHASH::iterator	kvpair;
-	STRINGP			str;
-	PORTLIST		ports;
-	FILE			*fpsrc;
-	char	line[512];
+static	bool	ucf_portname(const char *line, STRING &name) {
+	const char	*NET_KEY = "NET";
+	const char	*cptr;
 
-	gbl_msg.info("\n\nBUILD-XDC\nLooking for ports:\n");
-	gbl_msg.flush();
+	if (NULL == (cptr = strstr(line, NET_KEY)))
+		return false;
 
-	get_portlist(master, ports);
+	cptr += strlen(NET_KEY);
+	if (!isspace(*cptr))
+		return false;
 
-	str = getstring(master, KYXDC_FILE);
-	fpsrc = open_in(master, *str);
+	// Skip white space
+	while((*cptr)&&(isspace(*cptr)))
+		cptr++;
+
+	// On a broken file, just continue
+	if (!(*cptr))
+		return false;
+
+	// Skip the opening quote
+	copyname(cptr+1, ";", name);
+	return true;
+}
+// }}}
 
+// uncomment_ports
+// {{{
+// Copy a constraint file from its source to fp, uncommenting any lines that
+// reference one of our top-level ports.  Lines are read through getline(),
+// so there's no limit on how long they may be.  If trimmed is set, lines are
+// trimmed of white space, and those beginning with "##" are left alone.
+//
+static	void	uncomment_ports(MAPDHASH &master, FILE *fp, STRINGP fname,
+			const char *fmt, PORTNAMEFN portname, bool trimmed) {
+	const PORTSET	&ports = get_portset(master);
+	FILE		*fpsrc;
+	char		*buf = NULL;
+	size_t		bufsz = 0;
+	ssize_t		nr;
+	STRING		line, name;
+
+	fpsrc = open_in(master, *fname);
 	if (!fpsrc) {
-		gbl_msg.fatal("Could not find or open %s\n", str->c_str());
+		gbl_msg.fatal("Could not find or open %s\n", fname->c_str());
 	}
 
-	// Uncomment any lines referencing top-level ports
-	// {{{
-	while(fgets(line, sizeof(line), fpsrc)) {
-		const char	*GET_PORTS_KEY = "get_ports",
-				*SET_PROPERTY_KEY = "set_property";
-		const	char	*cptr;
-
-		STRINGP	tmp = trim(STRING(line));
-		strcpy(line, tmp->c_str());
-		delete	tmp;
+	while((nr = getline(&buf, &bufsz, fpsrc)) > 0) {
+		const char	*a = buf, *b = buf + nr;
+		const char	*eol = "";
 
+		if (trimmed) {
+			while((a < b)&&(isspace(*a)))
+				a++;
+			while((b > a)&&(isspace(b[-1])))
+				b--;
+			eol = "\n";
+		} line.assign(a, b-a);
 
 		// Ignore any lines that don't begin with #,
-		// Ignore any lines that start with two ##'s,
-		// Ignore any lines that don't have set_property within them
-		if ((line[0] != '#')||(line[1] == '#')
-			||(NULL == (cptr= strstr(line, SET_PROPERTY_KEY)))) {
-			fprintf(fp, "%s\n", line);
+		// Ignore any (trimmed) lines that start with two ##'s,
+		// Ignore any lines that don't reference a port
+		if ((line[0] != '#')||((trimmed)&&(line[1] == '#'))
+				||(!portname(line.c_str(), name))) {
+			fprintf(fp, "%s%s", line.c_str(), eol);
 			continue;
 		}
 
-		if (NULL != (cptr = strstr(cptr, GET_PORTS_KEY))) {
-			bool	found = false;
-
-			cptr += strlen(GET_PORTS_KEY);
-			while((*cptr)&&(*cptr != '{')&&(isspace(*cptr)))
-				cptr++;
-			if (*cptr == '{')
-				cptr++;
-			if (!(*cptr)) {
-				fprintf(fp, "%s\n", line);
-				continue;
-			}
+		gbl_msg.info("Found %s port: %s\n", fmt, name.c_str());
 
-			while((*cptr)&&(isspace(*cptr)))
-				cptr++;
-
-			char		*ptr, *name;
-			name = strdup(cptr);
-			ptr = name;
-			while((*ptr)
-				&&(*ptr != '[')
-				&&(*ptr != '}')
-				&&(*ptr != ']')
-				&&(!isspace(*ptr)))
-				ptr++;
-			*ptr = '\0';
-
-			gbl_msg.info("Found XDC port: %s\n", name);
-
-			// Now, let's check to see if this is in our set
-			for(unsigned k=0; k<ports.size(); k++) {
-				if (strcmp(ports[k]->c_str(), name)==0) {
-					found = true;
-					break;
-				}
-			} free(name);
-
-			if (found) {
-				int start = 0;
-				while((line[start])&&(
-						(line[start]=='#')
-						||(isspace(line[start]))))
-					start++;
-				fprintf(fp, "%s\n", &line[start]);
-			} else
-				fprintf(fp, "%s\n", line);
+		// Now, let's check to see if this is in our set
+		if (ports.count(name) > 0) {
+			unsigned start = 0;
+			while((line[start])&&(
+					(line[start]=='#')
+					||(isspace(line[start]))))
+				start++;
+			fprintf(fp, "%s%s", &line[start], eol);
 		} else
-			fprintf(fp, "%s\n", line);
+			fprintf(fp, "%s%s", line.c_str(), eol);
 	}
-	// }}}
 
+	free(buf);
 	fclose(fpsrc);
+}
+// }}}
+
+void	build_xdc(MAPDHASH &master, FILE *fp, STRING &fname) {
+	MAPDHASH::iterator	kvpair;
+	STRINGP			str;
+
+	gbl_msg.info("\n\nBUILD-XDC\n");
+	gbl_msg.flush();
+
+	// Uncomment any lines referencing top-level ports
+	str = getstring(master, KYXDC_FILE);
+	uncomment_ports(master, fp, str, "XDC", xdc_portname, true);
 
 	fprintf(fp, "\n## Adding in any XDC_INSERT tags\n\n");
 	// {{{
@@ -1412,78 +1537,13 @@ void	build_xdc(MAPDHASH &master, FILE *fp, STRING &fname) {
 void	build_pcf(MAPDHASH &master, FILE *fp, STRING &fname) {
 	MAPDHASH::iterator	kvpair;
 	STRINGP			str;
-	PORTLIST		ports;
-	FILE			*fpsrc;
-	char	line[512];
 
-	gbl_msg.info("\n\nBUILD-PCF\nLooking for ports:\n");
+	gbl_msg.info("\n\nBUILD-PCF\n");
 	gbl_msg.flush();
 
-	get_portlist(master, ports);
-
-	str = getstring(master, KYPCF_FILE);
-	fpsrc = open_in(master, *str);
-
-	if (!fpsrc) {
-		gbl_msg.fatal("Could not find or open %s\n", str->c_str());
-	}
-
 	// Uncomment any lines referencing top-level ports
-	// {{{
-	while(fgets(line, sizeof(line), fpsrc)) {
-		const char	*SET_IO_KEY = "set_io";
-		const	char	*cptr;
-
-		STRINGP	tmp = trim(STRING(line));
-		strcpy(line, tmp->c_str());
-		delete	tmp;
-
-
-		// Ignore any lines that don't begin with #,
-		// Ignore any lines that start with two ##'s,
-		// Ignore any lines that don't have the SET_IO_KEY within them
-		if ((line[0] != '#')||(line[1] == '#')
-			||(NULL == (cptr= strstr(line, SET_IO_KEY)))) {
-			fprintf(fp, "%s\n", line);
-			continue;
-		}
-
-		bool	found = false;
-		char	*cpy = strdup(cptr + strlen(SET_IO_KEY));
-		char		*ptr, *name;
-
-		name = strtok(cpy, " \t");
-
-		ptr = name;
-		while((*ptr)
-			&&(*ptr != '[')
-			&&(*ptr != '}')
-			&&(*ptr != ']')
-			&&(!isspace(*ptr)))
-			ptr++;
-		*ptr = '\0';
-
-		gbl_msg.info("Found PCF port: %s\n", name);
-
-		// Now, let's check to see if this is in our set
-		for(unsigned k=0; k<ports.size(); k++) {
-			if (strcmp(ports[k]->c_str(), name)==0) {
-				found = true;
-				break;
-			}
-		} free(cpy);
-
-		if (found) {
-			int start = 0;
-			while((line[start])&&(
-					(line[start]=='#')
-					||(isspace(line[start]))))
-				start++;
-			fprintf(fp, "%s\n", &line[start]);
-		} else
-			fprintf(fp, "%s\n", line);
-	} fclose(fpsrc);
-	// }}}
+	str = getstring(master, KYPCF_FILE);
+	uncomment_ports(master, fp, str, "PCF", pcf_portname, true);
 
 	fprintf(fp, "\n## Adding in any PCF_INSERT tags\n\n");
 	// {{{
@@ -1511,89 +1571,13 @@ void	build_pcf(MAPDHASH &master, FILE *fp, STRING &fname) {
 void	build_lpf(MAPDHASH &master, FILE *fp, STRING &fname) {
 	MAPDHASH::iterator	kvpair;
 	STRINGP			str;
-	PORTLIST		ports;
-	FILE			*fpsrc;
-	char	line[512];
 
-	gbl_msg.info("\n\nBUILD-LPF\nLooking for ports:\n");
+	gbl_msg.info("\n\nBUILD-LPF\n");
 	gbl_msg.flush();
 
-	get_portlist(master, ports);
-
 	// Uncomment any lines referencing top-level ports
-	// {{{
 	str = getstring(master, KYLPF_FILE);
-	fpsrc = open_in(master, *str);
-
-	if (!fpsrc) {
-		gbl_msg.fatal("Could not find or open %s\n", str->c_str());
-	}
-
-	while(fgets(line, sizeof(line), fpsrc)) {
-		const char	*LOC_KEY = "LOCATE COMP",
-				*BUF_KEY = "IOBUF PORT";
-		const	char	*locp, *bufp, *keyp;
-
-		STRINGP	tmp = trim(STRING(line));
-		strcpy(line, tmp->c_str());
-		delete	tmp;
-
-
-		// Ignore any lines that don't begin with #,
-		// Ignore any lines that start with two ##'s,
-		// Ignore any lines that don't have either key within them
-		if ((line[0] != '#')||(line[1] == '#')
-			||((NULL == (locp= strcasestr(line, LOC_KEY)))
-			&&(NULL == (bufp= strcasestr(line, BUF_KEY))))) {
-			fprintf(fp, "%s\n", line);
-			continue;
-		}
-
-		bool	found = false;
-		keyp = LOC_KEY;
-		if (!locp) {
-			locp = bufp;
-			keyp = BUF_KEY;
-		}
-
-		if (strncmp(locp+strlen(keyp), " \"", 2)==0)
-			locp += 2;
-		char	*cpy = strdup(locp + strlen(keyp));
-		char		*ptr, *name;
-
-		name = strtok(cpy, " \t");
-
-		ptr = name;
-		while((*ptr)
-			&&(*ptr != '[')
-			&&(*ptr != '}')
-			&&(*ptr != ']')
-			&&(*ptr != '\"')
-			&&(!isspace(*ptr)))
-			ptr++;
-		*ptr = '\0';
-
-		gbl_msg.info("Found LOC port: %s\n", name);
-
-		// Now, let's check to see if this is in our set
-		for(unsigned k=0; k<ports.size(); k++) {
-			if (strcmp(ports[k]->c_str(), name)==0) {
-				found = true;
-				break;
-			}
-		} free(cpy);
-
-		if (found) {
-			int start = 0;
-			while((line[start])&&(
-					(line[start]=='#')
-					||(isspace(line[start]))))
-				start++;
-			fprintf(fp, "%s\n", &line[start]);
-		} else
-			fprintf(fp, "%s\n", line);
-	} fclose(fpsrc);
-	// }}}
+	uncomment_ports(master, fp, str, "LOC", lpf_portname, true);
 
 	fprintf(fp, "\n## Adding in any LPF_INSERT tags\n\n");
 	// {{{
@@ -1618,81 +1602,13 @@ void	build_lpf(MAPDHASH &master, FILE *fp, STRING &fname) {
 void	build_ucf(MAPDHASH &master, FILE *fp, STRING &fname) {
 	MAPDHASH::iterator	kvpair;
 	STRINGP			str;
-	FILE			*fpsrc;
-	PORTLIST		ports;
-	char	line[512];
 
-	gbl_msg.info("\n\nBUILD-UCF\nLooking for ports:\n");
+	gbl_msg.info("\n\nBUILD-UCF\n");
 	gbl_msg.flush();
 
-	get_portlist(master, ports);
-
 	// Uncomment any lines referencing top-level ports
-	// {{{
 	str = getstring(master, KYUCF_FILE);
-	fpsrc = open_in(master, *str);
-
-	if (!fpsrc) {
-		gbl_msg.fatal("Could not find or open %s\n", str->c_str());
-	}
-
-	while(fgets(line, sizeof(line), fpsrc)) {
-		const char	*NET_KEY = "NET";
-		const char	*cptr;
-
-		if ((line[0] == '#')&&(cptr = strstr(line, NET_KEY))) {
-			bool	found = false;
-
-
-			cptr += strlen(NET_KEY);
-			if (!isspace(*cptr)) {
-				fprintf(fp, "%s", line);
-				continue;
-			}
-
-			// Skip white space
-			while((*cptr)&&(isspace(*cptr)))
-				cptr++;
-
-			// On a broken file, just continue
-			if (!(*cptr)) {
-				fprintf(fp, "%s", line);
-				continue;
-			}
-
-
-			char	*ptr, *name;
-			name = strdup(cptr+1);
-
-			ptr = name;
-			while((*ptr)&&(!isspace(*ptr))&&(*ptr != ';'))
-				ptr++;
-			*ptr = '\0';
-
-			gbl_msg.info("Found UCF port: %s", name);
-			gbl_msg.flush();
-
-			// Now, let's check to see if this is in our set
-			for(unsigned k=0; k<ports.size(); k++) {
-				if (strcmp(ports[k]->c_str(), name)==0) {
-					found = true;
-					break;
-				}
-			} free(name);
-
-			if (found) {
-				unsigned start = 0;
-				while((line[start])&&(
-						(line[start]=='#')
-						||(isspace(line[start]))))
-					start++;
-				fprintf(fp, "%s", &line[start]);
-			} else
-				fprintf(fp, "%s", line);
-		} else
-			fprintf(fp, "%s", line);
-	} fclose(fpsrc);
-	// }}}
+	uncomment_ports(master, fp, str, "UCF", ucf_portname, false);
 
 	fprintf(fp, "\n## Adding in any UCF_INSERT tags\n\n");
 	// {{{
@@ -1713,79 +1629,203 @@ void	build_ucf(MAPDHASH &master, FILE *fp, STRING &fname) {
 	// }}}
 }
 
-int	main(int argc, char **argv) {
-	int		argn, nhash = 0;
-	MAPDHASH	master;
-	FILE		*fp;
-	STRING		str, cmdline, searchstr = ".";
-	const char	*subdir = NULL;
+typedef	void	(*FILEBUILDER)(MAPDHASH &, FILE *, STRING &);
+typedef	std::function<void(void)>	OUTJOB;
 
+void	build_file(MAPDHASH &master, STRINGP subd, const char *name,
+		FILEBUILDER builder, bool complain = false) {
+	// {{{
+	STRING	str;
+	FILE	*fp;
 
-	// gbl_msg.open("autofpga.dbg", "w");
+	STATPHASE	phase("build", name);
 
-	if (argc > 0) {
-		cmdline = STRING(argv[0]);
-		for(argn=1; argn<argc; argn++) {
-			cmdline = cmdline + " " + STRING(argv[argn]);
-		}
+	str = subd->c_str(); str += "/"; str += name;
+	fp = ofopen(str.c_str());
+	if (fp) { builder(master, fp, str); ofclose(fp); }
+	else if (complain)
+		gbl_msg.error("Cannot open %s !\n", str.c_str());
+}
+// }}}
 
-		setstring(master, KYCMDLINE, new STRING(cmdline));
+//
+// run_outjobs
+//
+// Run each of the output builders, several at a time.  The builders are
+// not thread safe: they use strtok(), and reading a value may replace an
+// expression with its result.  Each therefore runs in a child process of
+// its own, with a (copy on write) copy of the finished design.  Anything a
+// builder changes within that design is thrown away with the child.  A
+// child reports the number of errors it found through its exit status, and
+// (with --stats) what it measured through a pipe.  Any (-d) debug log a
+// child writes goes to a temporary file of its own.  These are copied into
+// the log, in builder order, once every child has finished, so that the log
+// reads the same no matter how the children were scheduled.
+//
+static	void	outjob_done(pid_t pid, int status, std::map<pid_t, int> &pipes){
+	// {{{
+	std::map<pid_t, int>::iterator	p;
+
+	if (!WIFEXITED(status))
+		gbl_msg.adderrors(1);
+	else
+		gbl_msg.adderrors(WEXITSTATUS(status));
+
+	if (pipes.end() != (p = pipes.find(pid))) {
+		stats_receive(p->second);
+		close(p->second);
+		pipes.erase(p);
 	}
+}
+// }}}
 
-	for(argn=1; argn<argc; argn++) {
-		if (argv[argn][0] == '-') {
-			for(int j=1; ((j<2000)&&(argv[argn][j])); j++) {
-				switch(argv[argn][j]) {
-				case 'd':
-					if (argv[argn][j+1]) {
-						gbl_msg.open("autofpga.dbg");
-						gbl_msg.userinfo("Opened %s\n", "autofpga.dbg");
-					} else if (argv[argn+1][0] == '-') {
-						gbl_msg.open("autofpga.dbg");
-						gbl_msg.userinfo("Opened %s\n", "autofpga.dbg");
-					} else {
-						gbl_msg.open(argv[++argn]);
-						gbl_msg.userinfo("Opened %s\n", argv[argn]);
-					}
-					j+=5000;
-					break;
-				case 'o': subdir = argv[++argn];
-					j+=5000;
-					break;
-				case 'I':
-					searchstr = searchstr + ":" + argv[++argn];
-					setstring(master, KYPATH, new STRING(searchstr));
-					j+=5000;
-					break;
-				case 'V':
-#ifdef	BUILDDATE
-					printf("autofpga\nbuilt on %08x\n", BUILDDATE);
-#else
-					printf("autofpga [data-file-list]*\n");
-#endif
-					exit(EXIT_SUCCESS);
-				default:
-					fprintf(stderr, "Unknown argument, -%c\n", argv[argn][j]);
-				}
+void	run_outjobs(std::vector<OUTJOB> &jobs) {
+	// {{{
+	unsigned	maxkids = std::thread::hardware_concurrency(), nkids = 0;
+	int		nerr = gbl_msg.errcount(), status;
+	pid_t		pid;
+	std::map<pid_t, int>	pipes;
+	std::vector<FILE *>	logs(jobs.size(), (FILE *)NULL);
+
+	if (maxkids < 1)
+		maxkids = 1;
+
+	for(unsigned k=0; k<jobs.size(); k++) {
+		int	fd[2] = { -1, -1 };
+
+		if (nkids >= maxkids) {
+			if ((pid = wait(&status)) > 0) {
+				nkids--;
+				outjob_done(pid, status, pipes);
 			}
+		}
+
+		// Don't let the children inherit (and repeat) anything still
+		// waiting to be written
+		gbl_msg.flush();
+		fflush(stdout);
+		fflush(stderr);
+
+		if ((stats_enabled())&&(0 != pipe(fd)))
+			fd[0] = fd[1] = -1;
+
+		// If tmpfile() fails, the child will just write to the log
+		// directly
+		if (gbl_msg.logging())
+			logs[k] = tmpfile();
+
+		if ((pid = fork()) == 0) {
+			int	n;
+
+			if (fd[0] >= 0) {
+				close(fd[0]);
+				stats_reset();
+			}
+			if (logs[k])
+				gbl_msg.redirect(logs[k]);
+
+			jobs[k]();
+
+			if (fd[1] >= 0)
+				stats_send(fd[1]);
+			n = gbl_msg.errcount() - nerr;
+			exit((n > 127) ? 127 : n);
+		} else if (pid < 0) {
+			FILE	*log = NULL;
+
+			// Couldn't fork.  Do it ourselves.
+			if (fd[0] >= 0) {
+				close(fd[0]);
+				close(fd[1]);
+			}
+			if (logs[k])
+				log = gbl_msg.redirect(logs[k]);
+			jobs[k]();
+			if (logs[k])
+				gbl_msg.redirect(log);
 		} else {
-			MAPDHASH	*fhash;
-			STRINGP		path;
-
-			path = getstring(master, KYPATH);
-			if (NULL == path) {
-				path = new STRING(".");
-				setstring(master, KYPATH, path);
-			} fhash = parsefile(argv[argn], *path);
-			if (fhash) {
-				mergemaps(master, *fhash);
-				delete fhash;
-
-				nhash++;
+			nkids++;
+			if (fd[0] >= 0) {
+				close(fd[1]);
+				pipes[pid] = fd[0];
 			}
 		}
 	}
 
+	for(; nkids > 0; nkids--) {
+		if ((pid = wait(&status)) <= 0)
+			break;
+		outjob_done(pid, status, pipes);
+	}
+
+	for(unsigned k=0; k<logs.size(); k++) {
+		if (!logs[k])
+			continue;
+		gbl_msg.append(logs[k]);
+		fclose(logs[k]);
+	}
+}
+// }}}
+
+//
+// resolve_design
+//
+// Merge the parsed input files together into the master hash, and resolve
+// the design they describe.  mergemaps() moves everything within each file's
+// hash into the master.  If keep is set, a copy of each is merged instead,
+// leaving jobs[k].m_hash as it was parsed, so that later versions of the file
+// can be compared against it.
+//
+void	resolve_design(MAPDHASH &master, std::vector<PARSEJOB> &jobs,
+		const std::vector<bool> &newpath, bool pathchange,
+		const STRING &searchstr, const char *subdir, bool keep) {
+	// {{{
+	int	nhash = 0;
+
+	// Now merge them in command line order, exactly as though they had
+	// been parsed one at a time.
+	for(unsigned k=0; k<jobs.size(); k++) {
+		STRINGP		path;
+
+		if (newpath[k])
+			setstring(master, KYPATH, new STRING(jobs[k].m_search));
+		path = getstring(master, KYPATH);
+		if (NULL == path) {
+			path = new STRING(".");
+			setstring(master, KYPATH, path);
+		}
+
+		// If an earlier file has since extended the PATH, then this
+		// file may be found elsewhere.  Parse it again, along the path
+		// it would have been searched for along.
+		if (*path != jobs[k].m_search) {
+			STATPHASE	parse("parse");
+
+			if (jobs[k].m_hash)
+				delete jobs[k].m_hash;
+			jobs[k].m_search = *path;
+			jobs[k].m_hash = parsefile(jobs[k].m_fname, *path,
+							jobs[k].m_deps);
+		}
+
+		if (jobs[k].m_hash) {
+			STATPHASE	merge("mergemaps");
+
+			if (keep) {
+				MAPDHASH	*cp = copy(jobs[k].m_hash);
+				mergemaps(master, *cp);
+				delete cp;
+			} else {
+				mergemaps(master, *jobs[k].m_hash);
+				delete jobs[k].m_hash;
+				jobs[k].m_hash = NULL;
+			}
+
+			nhash++;
+		}
+	} if (pathchange)
+		setstring(master, KYPATH, new STRING(searchstr));
+
 	if (nhash == 0)
 		gbl_msg.fatal("No files given, no files written\n");
 
@@ -1832,94 +1872,110 @@ int	main(int argc, char **argv) {
 		setstring(master, KYLEGAL, legal);
 	}
 
-	flatten(master);
+	{ STATPHASE p("flatten"); flatten(master); }
 
 	// trimbykeylist(master, KYKEYS_TRIMLIST);
-	cvtintbykeylist(master, KYKEYS_INTLIST);
+	{ STATPHASE p("cvtintbykeylist");
+	cvtintbykeylist(master, KYKEYS_INTLIST); }
 
 	reeval(master);
-	assign_interrupts(master);
+	{ STATPHASE p("assign_interrupts"); assign_interrupts(master); }
 	reeval(master);
-	find_clocks(master);
+	{ STATPHASE p("find_clocks"); find_clocks(master); }
 	// assign_scopes(    master);
-	build_bus_list(master);
+	{ STATPHASE p("build_bus_list"); build_bus_list(master); }
 	// assign_addresses( master);
 	// get_address_width(master);
 
 	reeval(master);
 
-	str = subd->c_str(); str += "/regdefs.h";
-	fp = fopen(str.c_str(), "w");
-	if (fp) { build_regdefs_h(  master, fp, str); fclose(fp); }
-
-	str = subd->c_str(); str += "/regdefs.cpp";
-	fp = fopen(str.c_str(), "w");
-	if (fp) { build_regdefs_cpp(  master, fp, str); fclose(fp); }
-
-	str = subd->c_str(); str += "/board.h";
-	fp = fopen(str.c_str(), "w");
-	if (fp) { build_board_h(  master, fp, str); fclose(fp); }
-
-	build_ld_files(master, subd);
-
-	build_latex_tbls( master);
-
-	str = subd->c_str(); str += "/toplevel.v";
-	fp = fopen(str.c_str(), "w");
-	if (fp) { build_toplevel_v(  master, fp, str); fclose(fp); }
-
-	str = subd->c_str(); str += "/main.v";
-	fp = fopen(str.c_str(), "w");
-	if (fp) { build_main_v(  master, fp, str);
-		// fprintf(fp, "//\n//\n//\n//\n//\n//\n");
-		// writeout_bus_defns_v(fp);
-		// writeout_bus_logic_v(fp);
-		fclose(fp); }
-	build_cachable_v(master, subd);
-
-	str = subd->c_str(); str += "/rtl.make.inc";
-	fp = fopen(str.c_str(), "w");
-	if (fp) { build_rtl_make_inc(  master, fp, str); fclose(fp); }
-
-	str = subd->c_str(); str += "/testb.h";
-	fp = fopen(str.c_str(), "w");
-	if (fp) { build_testb_h(  master, fp, str); fclose(fp); }
-
-	if (NULL != getstring(master, KYXDC_FILE)) {
-		str = subd->c_str(); str += "/build.xdc";
-		fp = fopen(str.c_str(), "w");
-		if (fp) { build_xdc(  master, fp, str); fclose(fp); }
-		else
-			gbl_msg.error("Cannot open %s !\n", str.c_str());
-	}
-
-	if (NULL != getstring(master, KYPCF_FILE)) {
-		str = subd->c_str(); str += "/build.pcf";
-		fp = fopen(str.c_str(), "w");
-		if (fp) { build_pcf(  master, fp, str); fclose(fp); }
-		else
-			gbl_msg.error("Cannot open %s !\n", str.c_str());
+	// Gathering the register list assigns every peripheral its register
+	// address.  Do that now, so that every builder below is only a reader
+	// of the design.
+	{
+		STATPHASE	p("full_gather");
+		APLIST	*alist = full_gather();
+		if (alist)
+			delete alist;
 	}
 
-	if (NULL != getstring(master, KYLPF_FILE)) {
-		str = subd->c_str(); str += "/build.lpf";
-		fp = fopen(str.c_str(), "w");
-		if (fp) { build_lpf(  master, fp, str); fclose(fp); }
-		else
-			gbl_msg.error("Cannot open %s !\n", str.c_str());
-	}
+	{ STATPHASE p("build_latex_tbls"); build_latex_tbls( master); }
+}
+// }}}
 
-	if (NULL != getstring(master, KYUCF_FILE)) {
-		str = subd->c_str(); str += "/build.ucf";
-		fp = fopen(str.c_str(), "w");
-		if (fp) { build_ucf(  master, fp, str); fclose(fp); }
+//
+// write_design
+//
+// Write out all of the output files for a resolved design.  Returns the exit
+// status.
+//
+int	write_design(MAPDHASH &master) {
+	// {{{
+	STRINGP			subd = getstring(master, KYSUBD);
+	std::vector<OUTJOB>	outjobs;
+
+	// Any ports gathered the last time the design was written may since
+	// have changed
+	if (gbl_portset) {
+		delete gbl_portset;
+		gbl_portset = NULL;
 	}
 
-	str = subd->c_str(); str += "/main_tb.cpp";
-	fp = fopen(str.c_str(), "w");
-	if (fp) { build_main_tb_cpp(  master, fp, str); fclose(fp); }
-
-	build_other_files(master);
+	outjobs.push_back([&](void) {
+		build_file(master, subd, "regdefs.h", build_regdefs_h); });
+	outjobs.push_back([&](void) {
+		build_file(master, subd, "regdefs.cpp", build_regdefs_cpp); });
+	outjobs.push_back([&](void) {
+		build_file(master, subd, "board.h", build_board_h); });
+	outjobs.push_back([&](void) {
+		STATPHASE p("build", "*.ld"); build_ld_files(master, subd);
+	});
+	outjobs.push_back([&](void) {
+		build_file(master, subd, "toplevel.v", build_toplevel_v); });
+	outjobs.push_back([&](void) {
+		build_file(master, subd, "main.v", build_main_v); });
+	outjobs.push_back([&](void) {
+		STATPHASE p("build", "iscachable.v");
+		build_cachable_v(master, subd); });
+	outjobs.push_back([&](void) {
+		build_file(master, subd, "rtl.make.inc", build_rtl_make_inc); });
+	outjobs.push_back([&](void) {
+		build_file(master, subd, "testb.h", build_testb_h); });
+
+	// Gather the top-level ports once, before forking, so every constraint
+	// file builder can share them
+	if ((NULL != getstring(master, KYXDC_FILE))
+			||(NULL != getstring(master, KYPCF_FILE))
+			||(NULL != getstring(master, KYLPF_FILE))
+			||(NULL != getstring(master, KYUCF_FILE)))
+		get_portset(master);
+
+	if (NULL != getstring(master, KYXDC_FILE))
+		outjobs.push_back([&](void) {
+			build_file(master, subd, "build.xdc", build_xdc, true);
+		});
+
+	if (NULL != getstring(master, KYPCF_FILE))
+		outjobs.push_back([&](void) {
+			build_file(master, subd, "build.pcf", build_pcf, true);
+		});
+
+	if (NULL != getstring(master, KYLPF_FILE))
+		outjobs.push_back([&](void) {
+			build_file(master, subd, "build.lpf", build_lpf, true);
+		});
+
+	if (NULL != getstring(master, KYUCF_FILE))
+		outjobs.push_back([&](void) {
+			build_file(master, subd, "build.ucf", build_ucf); });
+
+	outjobs.push_back([&](void) {
+		build_file(master, subd, "main_tb.cpp", build_main_tb_cpp); });
+	outjobs.push_back([&](void) {
+		STATPHASE p("build", "other files"); build_other_files(master);
+	});
+
+	{ STATPHASE p("outputs"); run_outjobs(outjobs); }
 
 	if (0 != gbl_msg.status())
 		gbl_msg.error("ERR: Errors present\n");
@@ -1927,3 +1983,345 @@ int	main(int argc, char **argv) {
 	gbl_msg.dump(master);
 	return gbl_msg.status();
 }
+// }}}
+
+//
+// build_design
+//
+// Merge the parsed input files together into the master hash, resolve the
+// design they describe, and write out all of the output files.  Returns the
+// exit status.
+//
+int	build_design(MAPDHASH &master, std::vector<PARSEJOB> &jobs,
+		const std::vector<bool> &newpath, bool pathchange,
+		const STRING &searchstr, const char *subdir) {
+	// {{{
+	STATPHASE	phase("build_design");
+
+	resolve_design(master, jobs, newpath, pathchange, searchstr, subdir,
+			false);
+	return write_design(master);
+}
+// }}}
+
+// Where to write the --stats-json report, if anywhere
+static	const char	*s_statsfile = NULL;
+
+void	write_stats(void) {
+	// {{{
+	if (!stats_enabled())
+		return;
+
+	stats_report(stderr);
+	if (s_statsfile) {
+		FILE	*fp = fopen(s_statsfile, "w");
+		if (fp) {
+			stats_json(fp);
+			fclose(fp);
+		} else
+			gbl_msg.error("Cannot open %s\n", s_statsfile);
+	}
+}
+// }}}
+
+// The exit status of a watch_design() child that needs a new design built
+// from the start
+#define	WATCH_RESTART	3
+
+//
+// watch_inputs
+//
+// Watch every file any of the input files read--or, for any file that
+// couldn't be found, everywhere it was looked for.
+//
+static	void	watch_inputs(WATCHER &watcher, std::vector<PARSEJOB> &jobs) {
+	// {{{
+	for(unsigned k=0; k<jobs.size(); k++) {
+		for(unsigned d=0; d<jobs[k].m_deps.size(); d++)
+			watcher.add(jobs[k].m_deps[d].m_path);
+		if (jobs[k].m_deps.size() == 0) {
+			STRING	copy = jobs[k].m_search;
+			char	*save, *dir;
+
+			watcher.add(jobs[k].m_fname);
+			dir = strtok_r((char *)copy.c_str(), ", \t\n:", &save);
+			for(; dir; dir = strtok_r(NULL, ", \t\n:", &save))
+				watcher.add(STRING(dir) + "/" + jobs[k].m_fname);
+		}
+	}
+}
+// }}}
+
+//
+// changed_inputs
+//
+// Return the index of every input file that needs to be parsed again: any
+// that read a file that's changed, together with any that couldn't be found.
+// Changes to any other file (an output, say) are ignored.
+//
+static	std::vector<unsigned>	changed_inputs(std::vector<PARSEJOB> &jobs,
+		const std::vector<STRING> &changed) {
+	// {{{
+	std::vector<unsigned>	result;
+
+	for(unsigned k=0; k<jobs.size(); k++) {
+		bool	reparse = (jobs[k].m_deps.size() == 0);
+
+		for(unsigned d=0; (!reparse)&&(d<jobs[k].m_deps.size()); d++)
+			reparse = (std::find(changed.begin(), changed.end(),
+					jobs[k].m_deps[d].m_path) != changed.end());
+		if (reparse)
+			result.push_back(k);
+	}
+
+	return result;
+}
+// }}}
+
+static	void	report_build(int status) {
+	// {{{
+	if (status == 0)
+		gbl_msg.userinfo("Design built, waiting for changes\n");
+	else
+		gbl_msg.userinfo("Design built with errors, "
+			"waiting for changes\n");
+	fflush(stdout);
+}
+// }}}
+
+//
+// watch_design
+//
+// Build the design, and then keep it resident, bringing it up to date as the
+// input files change.  Most edits only touch the text destined for the
+// output files.  patch_design() can place those directly into the design,
+// so that only that text needs evaluating again before the outputs are
+// rewritten--the merge, the bus, interrupt, and clock passes, and address
+// assignment are all skipped.  Returns WATCH_RESTART for anything else.
+//
+static	int	watch_design(MAPDHASH &master, std::vector<PARSEJOB> &jobs,
+		const std::vector<bool> &newpath, bool pathchange,
+		const STRING &searchstr, const char *subdir,
+		WATCHER &watcher) {
+	// {{{
+	size_t	resident;
+	int	nerr, status;
+
+	{
+		STATPHASE	phase("build_design");
+
+		resolve_design(master, jobs, newpath, pathchange, searchstr,
+				subdir, true);
+		nerr = gbl_msg.errcount();
+		report_build(write_design(master));
+	}
+	write_stats();
+	resident = gbl_region.used();
+
+	while(true) {
+		std::vector<STRING>	changed;
+		std::vector<unsigned>	redo;
+		std::vector<MAPDHASH *>	fresh;
+		int	npatched = 0;
+
+		watcher.wait(changed);
+		redo = changed_inputs(jobs, changed);
+		if (redo.size() == 0)
+			continue;
+
+		stats_reset();
+		{
+			STATPHASE	phase("update_design");
+
+			// Errors found while resolving the design remain, since
+			// the design they were found in does.  Any found while
+			// writing it out will be found again.
+			gbl_msg.rewind(nerr);
+
+			for(unsigned r=0; r<redo.size(); r++) {
+				PARSEJOB	&job = jobs[redo[r]];
+				STATPHASE	p("parse");
+
+				gbl_msg.userinfo("Reading %s\n", job.m_fname);
+				fresh.push_back(parsefile(job.m_fname,
+						job.m_search, job.m_deps));
+			} watch_inputs(watcher, jobs);
+
+			for(unsigned r=0; r<redo.size(); r++) {
+				int	n = patch_design(master, jobs, redo[r],
+						fresh[r]);
+
+				if (n < 0) {
+					gbl_msg.userinfo("%s changed more than "
+						"its output text, rebuilding\n",
+						jobs[redo[r]].m_fname);
+					fflush(stdout);
+					return WATCH_RESTART;
+				} npatched += n;
+			}
+
+			if (npatched == 0)
+				continue;
+
+			// Everything patched in has been allocated on top of
+			// the design itself.  Once that's doubled the memory
+			// the design was built in, start over afresh.
+			if (gbl_region.used() > 2 * resident)
+				return WATCH_RESTART;
+
+			status = write_design(master);
+		}
+
+		report_build(status);
+		write_stats();
+	}
+}
+// }}}
+
+int	main(int argc, char **argv) {
+	int		argn;
+	MAPDHASH	master;
+	STRING		cmdline, searchstr = ".";
+	const char	*subdir = NULL;
+	std::vector<PARSEJOB>	jobs;
+	// Which jobs follow a -I, and so must first set KYPATH
+	std::vector<bool>	newpath;
+	bool		pathchange = false, watch = false;
+
+
+	// gbl_msg.open("autofpga.dbg", "w");
+
+	if (argc > 0) {
+		cmdline = STRING(argv[0]);
+		for(argn=1; argn<argc; argn++) {
+			cmdline = cmdline + " " + STRING(argv[argn]);
+		}
+
+		setstring(master, KYCMDLINE, new STRING(cmdline));
+	}
+
+	for(argn=1; argn<argc; argn++) {
+		if (strcmp(argv[argn], "--watch") == 0) {
+			watch = true;
+		} else if (strcmp(argv[argn], "--stats") == 0) {
+			stats_enable();
+		} else if ((strcmp(argv[argn], "--stats-json") == 0)
+				&&(argn+1 < argc)) {
+			stats_enable();
+			s_statsfile = argv[++argn];
+		} else if (argv[argn][0] == '-') {
+			for(int j=1; ((j<2000)&&(argv[argn][j])); j++) {
+				switch(argv[argn][j]) {
+				case 'd':
+					if (argv[argn][j+1]) {
+						gbl_msg.open("autofpga.dbg");
+						gbl_msg.userinfo("Opened %s\n", "autofpga.dbg");
+					} else if (argv[argn+1][0] == '-') {
+						gbl_msg.open("autofpga.dbg");
+						gbl_msg.userinfo("Opened %s\n", "autofpga.dbg");
+					} else {
+						gbl_msg.open(argv[++argn]);
+						gbl_msg.userinfo("Opened %s\n", argv[argn]);
+					}
+					j+=5000;
+					break;
+				case 'o': subdir = argv[++argn];
+					j+=5000;
+					break;
+				case 'w':
+					watch = true;
+					break;
+				case 'C':
+					pcache_open(argv[++argn]);
+					j+=5000;
+					break;
+				case 'I':
+					searchstr = searchstr + ":" + argv[++argn];
+					pathchange = true;
+					j+=5000;
+					break;
+				case 'V':
+#ifdef	BUILDDATE
+					printf("autofpga\nbuilt on %08x\n", BUILDDATE);
+#else
+					printf("autofpga [data-file-list]*\n");
+#endif
+					exit(EXIT_SUCCESS);
+				default:
+					fprintf(stderr, "Unknown argument, -%c\n", argv[argn][j]);
+				}
+			}
+		} else {
+			PARSEJOB	job;
+
+			job.m_fname  = argv[argn];
+			job.m_search = searchstr;
+			job.m_hash   = NULL;
+			jobs.push_back(job);
+			newpath.push_back(pathchange);
+			pathchange = false;
+		}
+	}
+
+	// Parse all of the files at once, each into its own hash, assuming
+	// each will be searched for along the path given by the -I options
+	// before it.
+	{ STATPHASE p("parse"); parsefiles(jobs); }
+
+	if (!watch) {
+		int	status = build_design(master, jobs, newpath,
+					pathchange, searchstr, subdir);
+		write_stats();
+		return status;
+	}
+
+	WATCHER	watcher;
+	if (!watcher.open())
+		gbl_msg.fatal("Cannot watch the input files\n");
+
+	while(true) {
+		pid_t	pid;
+		int	status;
+
+		watch_inputs(watcher, jobs);
+
+		// The design itself is built, and then kept up to date, by a
+		// child process.  When it can't keep up (something other than
+		// output text has changed), it exits, and a new child starts
+		// over from the beginning.  Nothing one design does (to the
+		// bus, PIC, and clock lists, say) then lingers on into the
+		// next.
+		gbl_msg.flush();
+		fflush(stdout);
+		fflush(stderr);
+		if ((pid = fork()) == 0) {
+			exit(watch_design(master, jobs, newpath, pathchange,
+					searchstr, subdir, watcher));
+		} else if (pid < 0)
+			gbl_msg.fatal("Could not fork\n");
+		waitpid(pid, &status, 0);
+		stats_reset();
+
+		if ((!WIFEXITED(status))||(WEXITSTATUS(status) != WATCH_RESTART)) {
+			std::vector<STRING>	changed;
+
+			gbl_msg.userinfo("Design failed to build, "
+				"waiting for changes\n");
+			fflush(stdout);
+			do {
+				watcher.wait(changed);
+			} while(0 == changed_inputs(jobs, changed).size());
+		}
+
+		// Parse every file again.  Nothing will then be left of the
+		// last parse, and everything allocated from the region for it
+		// can be released first.
+		for(unsigned k=0; k<jobs.size(); k++) {
+			if (jobs[k].m_hash)
+				freemap(jobs[k].m_hash);
+			jobs[k].m_hash = NULL;
+		}
+		gbl_region.release();
+		{ STATPHASE p("parse"); parsefiles(jobs); }
+	}
+}
@@ -0,0 +1,90 @@
+#!/bin/bash
+################################################################################
+##
+## Filename:	sw/bench.sh
+##
+## Project:	AutoFPGA, a utility for composing FPGA designs from peripherals
+## {{{
+## Purpose:	Benchmarks autofpga against synthetic designs of several sizes,
+##		as generated by benchgen.  For each size, the time spent in
+##	each phase is reported (from autofpga --stats), followed by a summary
+##	of the total time, the throughput in peripherals per second, and the
+##	peak memory used.  Each run's JSON statistics are left behind in
+##	$BENCHDIR/n<size>/stats.json, for comparison from one version to the
+##	next.
+##
+##	Usage:	bash bench.sh [nperipherals]*
+##
+##	Setting FANIN passes it on to benchgen as the BUS.OPT_FANIN of every
+##	wishbone bus, so that (when small enough) the benchmark also covers
+##	the registered return mux trees.  Likewise, setting PACKING to AWID,
+##	LUTS, or DEPTH sets the BUS.PACKING of every bus.
+##
+## Creator:	Dan Gisselquist, Ph.D.
+##		Gisselquist Technology, LLC
+##
+################################################################################
+## }}}
+## Copyright (C) 2017-2024, Gisselquist Technology, LLC
+## {{{
+## This program is free software (firmware): you can redistribute it and/or
+## modify it under the terms of the GNU General Public License as published
+## by the Free Software Foundation, either version 3 of the License, or (at
+## your option) any later version.
+##
+## This program is distributed in the hope that it will be useful, but WITHOUT
+## ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+## FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+## for more details.
+##
+## You should have received a copy of the GNU General Public License along
+## with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+## target there if the PDF file isn't present.)  If not, see
+## <http://www.gnu.org/licenses/> for a copy.
+## }}}
+## License:	GPL, v3, as defined and found on www.gnu.org,
+## {{{
+##		http://www.gnu.org/licenses/gpl.html
+##
+##
+################################################################################
+##
+## }}}
+BENCHDIR=${BENCHDIR:-bench-out}
+SIZES=${*:-100 1000 10000}
+FANIN=${FANIN:-}
+PACKING=${PACKING:-}
+SUMMARY=""
+STATUS=0
+
+for N in $SIZES; do
+	DIR=$BENCHDIR/n$N
+	rm -rf $DIR
+	mkdir -p $DIR
+	FILES=$(./benchgen -n $N ${FANIN:+-f $FANIN} ${PACKING:+-p $PACKING} -o $DIR) || exit 1
+
+	START=$(date +%s%N)
+	./autofpga --stats-json $DIR/stats.json -o $DIR/out -I $DIR $FILES \
+		> $DIR/autofpga.log 2> $DIR/stats.txt
+	EXITCODE=$?
+	END=$(date +%s%N)
+	if [ $EXITCODE -ne 0 ]; then
+		echo "autofpga failed on $N peripherals, see $DIR/autofpga.log"
+		STATUS=1
+	fi
+
+	echo "==== $N peripherals ===="
+	cat $DIR/stats.txt
+	echo
+
+	MSEC=$(( (END - START) / 1000000 ))
+	RSS=$(sed -n 's/^Peak RSS: \([0-9]*\) kB.*/\1/p' $DIR/stats.txt)
+	SUMMARY="$SUMMARY$(awk -v n=$N -v ms=$MSEC -v rss=$RSS 'BEGIN {
+		printf("%10d %12d %14.1f %12d", n, ms,
+			(ms > 0) ? n * 1000.0 / ms : 0, rss) }')
+"
+done
+
+printf "%10s %12s %14s %12s\n" "PERIPHS" "WALL(ms)" "PERIPHS/s" "PEAK RSS(kB)"
+printf "%s" "$SUMMARY"
+exit $STATUS
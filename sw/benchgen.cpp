@@ -0,0 +1,433 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/benchgen.cpp
+//
+// Project:	AutoFPGA, a utility for composing FPGA designs from peripherals
+// {{{
+// Purpose:	To generate synthetic designs, of any size, for benchmarking
+//		AutoFPGA.  A design has the requested number of peripherals,
+//	spread across a tree of WB, AXI, and AXI-lite buses below a single
+//	host.  It also has a cascade of interrupt controllers, several clocks,
+//	and, within every peripheral, a chain of @$(...) substitutions of the
+//	requested depth.  The same arguments always produce the same design.
+//
+//	Usage:	benchgen [-n nperipherals] [-d depth] [-c nclocks] -o dir
+//
+//	The names of the files written into dir are listed on stdout, in the
+//	order they should be given to autofpga.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <string>
+#include <vector>
+
+// Peripherals per leaf bus, buses below any one bus, interrupts per PIC
+#define	LEAFSZ		32
+#define	FANOUT		8
+#define	PICINTS		15
+#define	PERFILE		100
+
+typedef	struct	BENCHBUS_S {
+	std::string	m_name, m_type, m_parent;
+	int		m_width, m_clock;
+} BENCHBUS;
+
+// AXI (full) buses have no logic for SINGLE slaves, so those on an AXI bus
+// are made DOUBLE slaves instead
+const char	*slavetype(const BENCHBUS &bus, const char *typ) {
+	if ((bus.m_type == "axi")&&(strcmp(typ, "SINGLE") == 0))
+		return "DOUBLE";
+	return typ;
+}
+
+static	const	char	*s_dir = NULL;
+static	std::vector<std::string>	s_files;
+
+//
+// Create a new file within the output directory, starting it with a header
+// comment.  The legal notice is copied to the top of every generated file, so
+// it needs a C (//) style comment rather than the ## of a data file.
+static	FILE	*newfile(const std::string &name, const char *cmt = "##") {
+	// {{{
+	std::string	path = std::string(s_dir) + "/" + name,
+			rule(80, cmt[0]);
+	FILE	*fp;
+
+	if (NULL == (fp = fopen(path.c_str(), "w"))) {
+		fprintf(stderr, "ERR: Cannot open %s\n", path.c_str());
+		exit(EXIT_FAILURE);
+	}
+
+	fprintf(fp, "%s\n"
+		"%s\n"
+		"%s Filename:\t%s\n"
+		"%s\n"
+		"%s Purpose:\tPart of a synthetic design, generated by benchgen\n"
+		"%s\n"
+		"%s\n",
+		rule.c_str(), cmt, cmt, name.c_str(), cmt, cmt, cmt,
+		rule.c_str());
+	return fp;
+}
+// }}}
+
+//
+// Build the bus tree, top down.  Every bus at the bottom level is a leaf,
+// holding up to LEAFSZ peripherals.  Every other bus holds only the bridges
+// to the (up to FANOUT) buses below it.
+// {{{
+void	addbuses(std::vector<BENCHBUS> &buses, std::vector<int> &leaves,
+		int parent, int depth, int maxdepth, int nleaves, int nclocks) {
+	static	const char *types[] = { "wb", "axi", "axil" };
+	int	below = 1;
+
+	if (depth >= maxdepth) {
+		leaves.push_back(parent);
+		return;
+	}
+
+	for(int k=depth+1; k<maxdepth; k++)
+		below *= FANOUT;
+
+	for(int k=0; nleaves > 0; k++) {
+		BENCHBUS	bus;
+		int		n = (nleaves > below) ? below : nleaves;
+		char		name[64];
+
+		snprintf(name, sizeof(name), "%s_%d", buses[parent].m_name.c_str(), k);
+		bus.m_name   = name;
+		bus.m_type   = types[(depth + 1 + k) % 3];
+		bus.m_parent = buses[parent].m_name;
+		bus.m_width  = (bus.m_type == "axi") ? 64 : 32;
+		bus.m_clock  = buses.size() % nclocks;
+		buses.push_back(bus);
+
+		addbuses(buses, leaves, buses.size()-1, depth+1, maxdepth, n,
+			nclocks);
+		nleaves -= n;
+	}
+}
+// }}}
+
+void	clockname(char *buf, int k) {
+	if (k == 0)
+		strcpy(buf, "clk");
+	else
+		sprintf(buf, "clk%d", k);
+}
+
+void	usage(void) {
+	fprintf(stderr, "Usage: benchgen [-n nperipherals] [-d depth] [-c nclocks] [-f fanin]\n"
+"\t\t[-p packing] -o dir\n"
+"\n"
+"\t-n <n>\tThe number of peripherals in the design (default 100)\n"
+"\t-d <n>\tThe depth of the @$(...) chain in each peripheral (default 8)\n"
+"\t-c <n>\tThe number of clocks (default 4)\n"
+"\t-f <n>\tThe BUS.OPT_FANIN of every wishbone bus.  Set this below the\n"
+"\t\tnumber of SINGLE or DOUBLE slaves on a bus (about %d) to have\n"
+"\t\ttheir return data selected through a tree of muxes.\n"
+"\t-p <obj>\tThe BUS.PACKING of every bus: AWID, LUTS, or DEPTH.  By\n"
+"\t\tdefault, addresses are assigned sequentially.\n"
+"\t-o <dir>\tThe directory to write the design into\n", LEAFSZ/3);
+}
+
+int	main(int argc, char **argv) {
+	int	nperiph = 100, depth = 8, nclocks = 4, fanin = 0, opt;
+	const char	*packing = NULL;
+
+	while(-1 != (opt = getopt(argc, argv, "n:d:c:f:p:o:h"))) {
+		switch(opt) {
+		case 'n': nperiph = atoi(optarg); break;
+		case 'd': depth   = atoi(optarg); break;
+		case 'c': nclocks = atoi(optarg); break;
+		case 'f': fanin   = atoi(optarg); break;
+		case 'p': packing = optarg; break;
+		case 'o': s_dir   = optarg; break;
+		case 'h': usage(); exit(EXIT_SUCCESS);
+		default: usage(); exit(EXIT_FAILURE);
+		}
+	}
+
+	if ((!s_dir)||(nperiph < 1)||(depth < 1)||(nclocks < 1)||(fanin < 0)) {
+		usage();
+		exit(EXIT_FAILURE);
+	}
+
+	mkdir(s_dir, 0777);
+
+	FILE	*fp;
+	char	clk[32];
+
+	// The global settings, and the legal notice to place at the top of
+	// every file
+	// {{{
+	fp = newfile("legal.txt", "//");
+	fprintf(fp, "//\n// Project:\n// CmdLine:\n//\n");
+	fclose(fp);
+
+	fp = newfile("global.txt");
+	fprintf(fp, "@LEGAL=%s/legal.txt\n"
+		"@PROJECT=AutoFPGA synthetic benchmark, %d peripherals\n"
+		"@KEYS.INTLIST= BUS_ADDRESS_WIDTH NADDR NPIC NSCOPES PIC.MAX REGS.N ID\n"
+		"@DEFAULT.BUS=wbmain\n"
+		"@REGISTER.BUS=wbmain\n"
+		"@REGDEFS.H.INSERT=\n"
+		"typedef\tstruct {\n"
+		"\tunsigned\tm_addr;\n"
+		"\tconst char\t*m_name;\n"
+		"} REGNAME;\n", s_dir, nperiph);
+	fclose(fp);
+	s_files.push_back("global.txt");
+	// }}}
+
+	// Clocks
+	// {{{
+	fp = newfile("clocks.txt");
+	for(int k=0; k<nclocks; k++) {
+		clockname(clk, k);
+		fprintf(fp, "@PREFIX=i%s\n"
+			"@CLOCK.NAME=%s\n"
+			"@CLOCK.WIRE=i_%s\n"
+			"@CLOCK.FREQUENCY=%d\n"
+			"@CLOCK.TOP=i_%s\n", clk, clk, clk,
+			100000000 - 5000000 * (k % 10), clk);
+	}
+	fclose(fp);
+	s_files.push_back("clocks.txt");
+	// }}}
+
+	// The bus tree, and the host that masters it
+	// {{{
+	std::vector<BENCHBUS>	buses;
+	std::vector<int>	leaves;
+	int	nleaves = (nperiph + LEAFSZ - 1) / LEAFSZ, maxdepth = 0;
+
+	for(int n=1; n < nleaves; n *= FANOUT)
+		maxdepth++;
+
+	{
+		BENCHBUS	root;
+		root.m_name  = "wbmain";
+		root.m_type  = "wb";
+		root.m_width = 32;
+		root.m_clock = 0;
+		buses.push_back(root);
+	}
+	addbuses(buses, leaves, 0, 0, maxdepth, nleaves, nclocks);
+
+	// Only the wishbone buses build their own return muxes
+	std::string	optfanin, optpacking;
+	if (fanin > 0)
+		optfanin = "@BUS.OPT_FANIN=" + std::to_string(fanin) + "\n";
+	if (packing)
+		optpacking = std::string("@BUS.PACKING=") + packing + "\n";
+
+	fp = newfile("buses.txt");
+	fprintf(fp, "@PREFIX=host\n"
+		"@DEVID=HOST\n"
+		"@ACCESS=HOST_ACCESS\n"
+		"@MASTER.BUS=wbmain\n"
+		"@MASTER.TYPE=HOST\n"
+		"@MASTER.PREFIX=@$(PREFIX)\n"
+		"@BUS.NAME=wbmain\n"
+		"@BUS.CLOCK=clk\n"
+		"@BUS.WIDTH=32\n"
+		"@BUS.TYPE=wb\n"
+		"@BUS.RESET=i_reset\n"
+		"%s%s"
+		"@$BUS_ADDRESS_WIDTH=@$(MASTER.BUS.AWID)\n"
+		"@MAIN.PORTLIST=\n"
+		"\t\ti_@$(PREFIX)_rx, o_@$(PREFIX)_tx\n"
+		"@MAIN.IODECL=\n"
+		"\tinput\twire\ti_@$(PREFIX)_rx;\n"
+		"\toutput\twire\to_@$(PREFIX)_tx;\n"
+		"@MAIN.INSERT=\n"
+		"\thostbus u_@$(PREFIX) (\n"
+		"\t\t.i_clk(@$(MASTER.BUS.CLOCK.WIRE)),\n"
+		"\t\t.i_rx(i_@$(PREFIX)_rx), .o_tx(o_@$(PREFIX)_tx),\n"
+		"\t\t@$(MASTER.ANSIPORTLIST)\n"
+		"\t);\n", optfanin.c_str(), optpacking.c_str());
+
+	for(unsigned k=1; k<buses.size(); k++) {
+		clockname(clk, buses[k].m_clock);
+		fprintf(fp, "@PREFIX=br_%s\n"
+			"@SLAVE.TYPE=BUS\n"
+			"@SLAVE.BUS=%s\n"
+			"@MASTER.TYPE=SUBBUS\n"
+			"@MASTER.BUS=%s\n"
+			"@BUS.NAME=%s\n"
+			"@BUS.TYPE=%s\n"
+			"@BUS.WIDTH=%d\n"
+			"@BUS.CLOCK=%s\n"
+			"@BUS.RESET=i_reset\n"
+			"%s%s%s"
+			"@MAIN.INSERT=\n"
+			"\t// Bridge from @$(SLAVE.BUS.NAME) (@$(SLAVE.BUS.TYPE))"
+				" to @$(MASTER.BUS.NAME) (@$(MASTER.BUS.TYPE))\n"
+			"\tbridge #(\n"
+			"\t\t.SLAVE_AW(@$(SLAVE.AWID)),\n"
+			"\t\t.MASTER_AW(@$(MASTER.BUS.AWID))\n"
+			"\t) u_@$(PREFIX) (\n"
+			"\t\t.i_clk(@$(SLAVE.BUS.CLOCK.WIRE)),\n"
+			"\t\t@$(SLAVE.ANSIPORTLIST),\n"
+			"\t\t@$(MASTER.ANSIPORTLIST)\n"
+			"\t);\n",
+			buses[k].m_name.c_str(), buses[k].m_parent.c_str(),
+			buses[k].m_name.c_str(), buses[k].m_name.c_str(),
+			buses[k].m_type.c_str(), buses[k].m_width, clk,
+			(buses[k].m_type == "axi") ? "@BUS.IDWIDTH=4\n" : "",
+			(buses[k].m_type == "wb") ? optfanin.c_str() : "",
+			optpacking.c_str());
+	}
+	fclose(fp);
+	s_files.push_back("buses.txt");
+	// }}}
+
+	// Interrupt controllers.  Every third peripheral has an interrupt.
+	// Each controller takes PICINTS of those, and every controller after
+	// the first also feeds one of those before it.
+	// {{{
+	int	nints = (nperiph + 2) / 3,
+		npics = (nints + PICINTS - 1) / PICINTS;
+
+	fp = newfile("pics.txt");
+	for(int k=0; k<npics; k++) {
+		fprintf(fp, "@PREFIX=pic%d\n"
+			"@DEVID=PIC%d\n"
+			"@NADDR=1\n"
+			"@ACCESS=@$(DEVID)_ACCESS\n"
+			"@SLAVE.TYPE=%s\n"
+			"@SLAVE.BUS=%s\n"
+			"@PIC.BUS=@$(PREFIX)_vector\n"
+			"@PIC.MAX=%d\n", k, k,
+			slavetype(buses[leaves[k % leaves.size()]], "SINGLE"),
+			buses[leaves[k % leaves.size()]].m_name.c_str(),
+			PICINTS + FANOUT * 2);
+		if (k > 0)
+			fprintf(fp, "@INT.PIC%d.WIRE=@$(PREFIX)_int\n"
+				"@INT.PIC%d.PIC=pic%d\n", k, k, (k-1)/(FANOUT*2));
+		fprintf(fp, "@MAIN.INSERT=\n"
+			"\ticontrol #(@$(PIC.MAX))\n"
+			"\tu_@$(PREFIX) (\n"
+			"\t\t.i_clk(@$(SLAVE.BUS.CLOCK.WIRE)), .i_reset(1'b0),\n"
+			"\t\t@$(SLAVE.ANSIPORTLIST),\n"
+			"\t\t.i_brd_ints(@$(PIC.BUS)),\n"
+			"\t\t.o_interrupt(@$(PREFIX)_int)\n"
+			"\t);\n"
+			"@REGS.N=1\n"
+			"@REGS.0= 0 R_@$(DEVID) @$(DEVID)\n"
+			"@RTL.MAKE.GROUP=@$(DEVID)\n"
+			"@RTL.MAKE.FILES=icontrol.v\n");
+	}
+	fclose(fp);
+	s_files.push_back("pics.txt");
+	// }}}
+
+	// The peripherals themselves, PERFILE to a file
+	// {{{
+	fp = NULL;
+	for(int k=0; k<nperiph; k++) {
+		static	const char *types[] = { "SINGLE", "DOUBLE", "OTHER" };
+		int	naddr = (k%3 == 0) ? 1 : (k%3 == 1) ? 2 : (4 << (k % 5)),
+			nregs = (naddr > 4) ? 4 : naddr;
+		const BENCHBUS	&bus = buses[leaves[k / LEAFSZ]];
+
+		if (k % PERFILE == 0) {
+			char	name[64];
+
+			if (fp)
+				fclose(fp);
+			snprintf(name, sizeof(name), "periph%04d.txt",
+				k / PERFILE);
+			fp = newfile(name);
+			s_files.push_back(name);
+		}
+
+		fprintf(fp, "@PREFIX=p%d\n"
+			"@DEVID=P%d\n"
+			"@NADDR=%d\n"
+			"@ACCESS=@$(DEVID)_ACCESS\n"
+			"@SLAVE.TYPE=%s\n"
+			"@SLAVE.BUS=%s\n", k, k, naddr,
+			slavetype(bus, types[k%3]), bus.m_name.c_str());
+
+		// A chain of expressions, each depending on the one before,
+		// and a chain of strings built the same way
+		fprintf(fp, "@$C0=%d\n@S0=@$(PREFIX)\n", k % 97);
+		for(int d=1; d<=depth; d++)
+			fprintf(fp, "@$C%d=@$C%d+%d\n@S%d=@$(S%d)_%d\n",
+				d, d-1, d, d, d-1, d);
+
+		if (k % 3 == 0)
+			fprintf(fp, "@INT.P%d.WIRE=@$(PREFIX)_int\n"
+				"@INT.P%d.PIC=pic%d\n", k, k,
+				(k / 3) / PICINTS);
+
+		fprintf(fp, "@MAIN.INSERT=\n"
+			"\t// @$(DEVID): @$(S%d) = @$(C%d)\n"
+			"\tperiph #(\n"
+			"\t\t.NADDR(@$(NADDR)), .CHAIN(@$(C%d))\n"
+			"\t) u_@$(PREFIX) (\n"
+			"\t\t.i_clk(@$(SLAVE.BUS.CLOCK.WIRE)),\n"
+			"\t\t@$(SLAVE.ANSIPORTLIST)%s\n"
+			"\t);\n", depth, depth, depth,
+			(k % 3 == 0) ? ",\n\t\t.o_int(@$(PREFIX)_int)" : "");
+
+		fprintf(fp, "@REGS.N=%d\n", nregs);
+		for(int r=0; r<nregs; r++)
+			fprintf(fp, "@REGS.%d= %d R_@$(DEVID)_R%d @$(DEVID)R%d\n",
+				r, r, r, r);
+		fprintf(fp, "@BDEF.DEFN=\n"
+			"#define\t@$(DEVID)_CHAIN\t@$(C%d)\n"
+			"@BDEF.IONAME=\t_@$(PREFIX)\n"
+			"@BDEF.IOTYPE=\tunsigned\n"
+			"@BDEF.OSDEF=\t_BOARD_HAS_@$(DEVID)\n"
+			"@BDEF.OSVAL=\tstatic volatile @$(BDEF.IOTYPE) *const"
+				" _@$(PREFIX) = ((@$(BDEF.IOTYPE) *)"
+				"@$[0x%%08x](REGBASE));\n"
+			"@RTL.MAKE.GROUP=@$(DEVID)\n"
+			"@RTL.MAKE.FILES=periph.v\n", depth);
+	}
+	if (fp)
+		fclose(fp);
+	// }}}
+
+	for(unsigned k=0; k<s_files.size(); k++)
+		printf("%s\n", s_files[k].c_str());
+
+	return EXIT_SUCCESS;
+}
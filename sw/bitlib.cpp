@@ -60,7 +60,7 @@ unsigned	nextlg(const unsigned long vl) {
 // Return the number of non-zero bits in a given value
 unsigned	popc(const unsigned vl) {
 	unsigned	r;
-	r = ((vl & 0xaaaaaa)>>1)+(vl & 0x55555555);
+	r = ((vl & 0xaaaaaaaa)>>1)+(vl & 0x55555555);
 	r = (r & 0x33333333)+((r>> 2)&0x33333333);
 	r = (r +(r>> 4))&0x0f0f0f0f;
 	r = (r +(r>> 8))&0x001f001f;
@@ -65,6 +65,7 @@
 #include "globals.h"
 #include "gather.h"
 #include "msgs.h"
+#include "outfile.h"
 
 static void	build_script_ld(MAPDHASH &master, MAPDHASH &busmaster, FILE *fp, STRING &fname) {
 	MAPDHASH::iterator	kvpair;
@@ -92,7 +93,7 @@ static void	build_script_ld(MAPDHASH &master, MAPDHASH &busmaster, FILE *fp, STR
 
 	bi = find_bus(bimap);
 	alist = gather_peripherals(bi);
-	sort(alist->begin(), alist->end(), compare_regaddr);
+	stable_sort(alist->begin(), alist->end(), compare_regaddr);
 
 	fprintf(fp, "MEMORY\n{\n"
 "\t/* To be listed here, a slave must be of type MEMORY.  If the slave\n"
@@ -366,14 +367,14 @@ void	build_ld_files(MAPDHASH &master, STRINGP subd) {
 		STRING	fname = (*subd) + "/" + (*fnamep);
 		if (strcmp(&fname.c_str()[fname.size()-3],".ld")!=0)
 			fname += ".ld";
-		fp = fopen(fname.c_str(), "w");
+		fp = ofopen(fname.c_str());
 		if (fp == NULL)
 			gbl_msg.error("Could not write linker script, %s\n",
 				fname.c_str());
 		else {
 			build_script_ld(master, *kvpair->second.u.m_m,
 				fp, *fnamep);
-			fclose(fp);
+			ofclose(fp);
 		}
 	}
 }
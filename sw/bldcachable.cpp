@@ -52,31 +52,42 @@
 #include "bitlib.h"
 #include "predicates.h"
 #include "msgs.h"
+#include "outfile.h"
 
 
-static void	print_cachable(FILE *fp, BUSINFO *bi,
-		unsigned dw,
-		unsigned mask_8,
-		unsigned addr_8) {
-	unsigned	pbits;
+//
+// CACHECUBE
+// {{{
+// One product term of the cachable decoder: an address matches if
+// (i_addr & m_mask) == m_addr.  While gathering, each cube describes one
+// peripheral.  After minimization, each describes one term of the output,
+// and m_names lists every memory that term covers.
+typedef	struct {
+	unsigned	m_mask, m_addr;
+	STRING		m_names;
+} CACHECUBE;
+
+typedef	std::vector<CACHECUBE>	CUBELIST;
+// }}}
+
+//
+// gather_cachable
+// {{{
+// Walks the bus tree beneath bi, sorting every peripheral found into either
+// the list of memories (cachable), or the list of everything else.  Any
+// address in neither list isn't mapped, and so may be decoded either way.
+static void	gather_cachable(BUSINFO *bi, unsigned mask_8, unsigned addr_8,
+		CUBELIST &memories, CUBELIST &others) {
 	unsigned	submask = 0, subaddr = 0;
 	unsigned	lgdw = nextlg(bi->data_width()), bbits=lgdw-3;
 	PLIST		*pl;
 
-
 	pl = bi->m_plist;
-	fprintf(fp, "\t\t// Bus master: %s\n", bi->name()->c_str());
-	submask = mask_8; // Octets
-	for(unsigned i=0; i<pl->size(); i++)
-		submask |= (*pl)[i]->p_mask << bbits;	// bytes
-
 	for(unsigned i=0; i<pl->size(); i++) {
-		if (!(*pl)[i]->p_name) {
-			continue;
-		} if (((0)&&(*pl)[i]->p_mask == 0)) {
-			continue;//
-		}
+		CACHECUBE	cube;
 
+		if (!(*pl)[i]->p_name)
+			continue;
 
 		// Octets
 		if (bi->word_addressing())
@@ -84,29 +95,147 @@ static void	print_cachable(FILE *fp, BUSINFO *bi,
 		else
 			submask = ((*pl)[i]->p_mask) | mask_8;
 		subaddr = ((*pl)[i]->p_base | addr_8) & submask;
-		pbits = nextlg(submask);
-		if ((1ul<<pbits) <= submask)
-			pbits++;	// log_2 Octets
 
 		if ((*pl)[i]->p_master_bus) {
-			print_cachable(fp, (*pl)[i]->p_master_bus,
-				dw, submask, subaddr);
-			continue;
-		} else if ((!(*pl)[i]->ismemory())
-			&&(!issubbus(*(*pl)[i]->p_phash))) {
-			// fprintf(fp, "\t\t// %s: Not a memory\n", (*pl)[i]->p_name->c_str());
+			gather_cachable((*pl)[i]->p_master_bus,
+				submask, subaddr, memories, others);
 			continue;
 		}
 
-		// pbits -= dw;
-		fprintf(fp, "\t\t// %s\n"
-		"\t\tif ((i_addr[%d:0] & %d'h%0*x) == %d'h%0*x)\n"
-				"\t\t\to_cachable = 1'b1;\n",
-			(*pl)[i]->p_name->c_str(), pbits - 1,
-			pbits, (pbits+3)/4, submask,
-			pbits, (pbits+3)/4, subaddr);
+		cube.m_mask  = submask;
+		cube.m_addr  = subaddr;
+		cube.m_names = *(*pl)[i]->p_name;
+
+		if (((*pl)[i]->ismemory())||(issubbus(*(*pl)[i]->p_phash)))
+			memories.push_back(cube);
+		else
+			others.push_back(cube);
 	}
 }
+// }}}
+
+//
+// Cube helpers
+// {{{
+static bool	cube_intersects(const CACHECUBE &a, const CACHECUBE &b) {
+	return (((a.m_addr ^ b.m_addr) & a.m_mask & b.m_mask) == 0);
+}
+
+// True if every address matching b also matches a
+static bool	cube_contains(const CACHECUBE &a, const CACHECUBE &b) {
+	return ((a.m_mask & ~b.m_mask) == 0)
+		&&(((a.m_addr ^ b.m_addr) & a.m_mask) == 0);
+}
+
+static bool	cube_allowed(const CACHECUBE &c, const CUBELIST &others) {
+	for(unsigned k=0; k<others.size(); k++)
+		if (cube_intersects(c, others[k]))
+			return false;
+	return true;
+}
+
+static void	cube_merge_names(CACHECUBE &a, const CACHECUBE &b) {
+	a.m_names += STRING(", ") + b.m_names;
+}
+// }}}
+
+//
+// minimize_cachable
+// {{{
+// A (heuristic) two-level minimization of the cachable decoder, in the manner
+// of espresso.  The memories are the on-set, all other peripherals the
+// off-set, and any unmapped address a don't care.  We repeat until nothing
+// changes:
+//	1. Merge any two terms whose smallest enclosing cube matches no
+//		non-memory peripheral.
+//	2. Expand each term, by dropping address bits from its mask, for as
+//		long as it continues to match no non-memory peripheral.
+//	3. Remove any term contained within another.
+// Since terms only ever grow, every memory remains covered, and since no
+// term is ever allowed to touch the off-set, no other peripheral is.
+static void	minimize_cachable(CUBELIST &terms, const CUBELIST &others) {
+	bool	changed = true;
+
+	while(changed) {
+		changed = false;
+
+		// 1. Merge pairs of terms
+		for(unsigned i=0; i<terms.size(); i++) {
+			for(unsigned j=i+1; j<terms.size(); j++) {
+				CACHECUBE	sup = terms[i];
+
+				sup.m_mask &= terms[j].m_mask
+					& ~(terms[i].m_addr ^ terms[j].m_addr);
+				sup.m_addr &= sup.m_mask;
+				if (!cube_allowed(sup, others))
+					continue;
+
+				cube_merge_names(sup, terms[j]);
+				terms[i] = sup;
+				terms.erase(terms.begin()+j);
+				j = i;	// Start over with the new, larger term
+				changed = true;
+			}
+		}
+
+		// 2. Expand each term, starting from the top address bit
+		for(unsigned i=0; i<terms.size(); i++) {
+			for(int b=31; b>=0; b--) {
+				CACHECUBE	exp = terms[i];
+
+				if (0 == (exp.m_mask & (1u << b)))
+					continue;
+				exp.m_mask &= ~(1u << b);
+				exp.m_addr &= exp.m_mask;
+				if (cube_allowed(exp, others))
+					terms[i] = exp;
+			}
+		}
+
+		// 3. Remove any redundant terms
+		for(unsigned i=0; i<terms.size(); i++) {
+			for(unsigned j=0; j<terms.size(); j++) {
+				if ((i == j)||(!cube_contains(terms[i], terms[j])))
+					continue;
+				cube_merge_names(terms[i], terms[j]);
+				terms.erase(terms.begin()+j);
+				if (j < i)
+					i--;
+				j--;
+				changed = true;
+			}
+		}
+	}
+}
+// }}}
+
+//
+// print_cachable
+// {{{
+// Writes out one if() statement per term
+static void	print_cachable(FILE *fp, const CUBELIST &terms,
+		const char *target) {
+	for(unsigned i=0; i<terms.size(); i++) {
+		unsigned	pbits;
+
+		pbits = nextlg(terms[i].m_mask);
+		if ((1ul<<pbits) <= terms[i].m_mask)
+			pbits++;	// log_2 Octets
+
+		fprintf(fp, "\t\t// %s\n", terms[i].m_names.c_str());
+		if (pbits == 0) {
+			// Everything mapped is a memory
+			fprintf(fp, "\t\t%s = 1'b1;\n", target);
+			continue;
+		}
+		fprintf(fp, "\t\tif ((i_addr[%d:0] & %d'h%0*x) == %d'h%0*x)\n"
+				"\t\t\t%s = 1'b1;\n",
+			pbits - 1,
+			pbits, (pbits+3)/4, terms[i].m_mask,
+			pbits, (pbits+3)/4, terms[i].m_addr, target);
+	}
+}
+// }}}
 
 void build_cachable_core_v(MAPDHASH &master, MAPDHASH &busmaster,
 		FILE *fp, STRING &fname) {
@@ -114,7 +243,6 @@ void build_cachable_core_v(MAPDHASH &master, MAPDHASH &busmaster,
 	char	*modulename;
 	const char *ptr;
 	BUSINFO	*bi;
-	int	dw;
 	MAPDHASH	*bimap;
 
 	bimap = getmap(busmaster, KYMASTER_BUS);
@@ -135,30 +263,76 @@ void build_cachable_core_v(MAPDHASH &master, MAPDHASH &busmaster,
 
 	modulename[strlen(modulename)-2] = '\0';
 
+	// Gather up all of the memories, and minimize the logic required
+	// to recognize them
+	CUBELIST	memories, others, terms;
+	unsigned	nbits_before = 0, nbits_after = 0;
+	int		registered = 0;
+
+	gather_cachable(bi, 0, 0, memories, others);
+	terms = memories;
+	minimize_cachable(terms, others);
+
+	for(unsigned i=0; i<memories.size(); i++)
+		nbits_before += popc(memories[i].m_mask);
+	for(unsigned i=0; i<terms.size(); i++)
+		nbits_after += popc(terms[i].m_mask);
+	gbl_msg.info("CACHABLE: %s, %d memories (%d address bits) reduced to %d terms (%d address bits)\n",
+		fname.c_str(), (int)memories.size(), nbits_before,
+		(int)terms.size(), nbits_after);
+
+	// CACHABLE.REGISTERED adds a clock to the module, and returns the
+	// result one clock later
+	if (!getvalue(busmaster, KYCACHABLE_REGISTERED, registered))
+		registered = 0;
+
 	legal_notice(master, fp, fname);
 	fprintf(fp,
 "`default_nettype none\n"
 "//\n"
 "module %s(\n"
-	"\t\t// {{{\n"
+	"\t\t// {{{\n", modulename);
+	if (registered)
+		fprintf(fp, "\t\tinput\twire\t\t\ti_clk,\n");
+	fprintf(fp,
 	"\t\tinput\twire\t[%d-1:0]\ti_addr,\n"
 	"\t\toutput\treg\t\t\to_cachable\n"
 	"\t\t// }}}\n"
 	"\t);\n"
-	"\n", modulename, bi->byte_address_width());
+	"\n", bi->byte_address_width());
 	free(modulename);
 
 	fprintf(fp,
-	"\talways @(*)\n"
-	"\tbegin\n"
-	"\t\to_cachable = 1'b0;\n");
+	"\t// %d memories, decoded using %d address bits, have been\n"
+	"\t// minimized to %d product term%s using %d address bits.  Addresses\n"
+	"\t// belonging to no peripheral may be reported either way.\n",
+		(int)memories.size(), nbits_before,
+		(int)terms.size(), (terms.size() == 1) ? "" : "s",
+		nbits_after);
 
-	dw = bi->data_width();
-	dw = nextlg(dw)-3;
-	print_cachable(fp, bi, dw, 0, 0);
+	if (registered) {
+		fprintf(fp,
+		"\treg\tw_cachable;\n\n"
+		"\talways @(*)\n"
+		"\tbegin\n"
+		"\t\tw_cachable = 1'b0;\n");
+		print_cachable(fp, terms, "w_cachable");
+		fprintf(fp,
+		"\tend\n"
+		"\n"
+		"\tinitial\to_cachable = 1'b0;\n"
+		"\talways @(posedge i_clk)\n"
+		"\t\to_cachable <= w_cachable;\n");
+	} else {
+		fprintf(fp,
+		"\talways @(*)\n"
+		"\tbegin\n"
+		"\t\to_cachable = 1'b0;\n");
+		print_cachable(fp, terms, "o_cachable");
+		fprintf(fp, "\tend\n");
+	}
 
 	fprintf(fp,
-	"\tend\n"
 "\n"
 "endmodule\n");
 }
@@ -191,13 +365,13 @@ void build_cachable_v(MAPDHASH &master, STRINGP subd) {
 		STRING	fname = (*subd) + "/" + (*fnamep);
 		if (strcmp(&fname.c_str()[fname.size()-2],".v") != 0)
 			fname += ".v";
-		fp = fopen(fname.c_str(), "w");
+		fp = ofopen(fname.c_str());
 		if (fp == NULL)
 			gbl_msg.error("Could not write cachable file: %s\n", fname.c_str());
 		else {
 			build_cachable_core_v(master, *kvpair->second.u.m_m,
 				fp, fname);
-			fclose(fp);
+			ofclose(fp);
 		}
 	}
 }
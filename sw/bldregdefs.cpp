@@ -40,6 +40,7 @@
 #include <stdlib.h>
 #include <string>
 #include <vector>
+#include <unordered_set>
 #include <algorithm>
 #include <string.h>
 #include <unistd.h>
@@ -340,6 +341,11 @@ void	build_regdefs_h(  MAPDHASH &master, FILE *fp, STRING &fname) {
 		fputs(strp->c_str(), fp);
 	fprintf(fp, "// End of definitions from REGDEFS.H.INSERT\n");
 
+	fprintf(fp, "\n");
+	fprintf(fp, "//\n// Register lookup, by name or address, from regdefs.cpp.  Each\n"
+		"// returns an index into raw_bregs[], or -1 if not found.\n//\n");
+	fprintf(fp, "extern\tint\tregdefs_find_name(const char *v);\n");
+	fprintf(fp, "extern\tint\tregdefs_find_addr(unsigned v);\n");
 	fprintf(fp, "\n\n");
 
 	fprintf(fp, "#endif\t// REGDEFS_H\n");
@@ -454,6 +460,385 @@ void write_regnames(FILE *fp, APLIST *alist,
 }
 // }}}
 
+//
+// gather_regnames
+// {{{
+// Collects every user register name, together with its address, in the same
+// order write_regnames() writes them into raw_bregs[]
+//
+typedef	struct {
+	STRING		m_name;
+	unsigned	m_addr;
+} REGLIST_ENTRY;
+
+static	void	gather_regnames(APLIST *alist,
+			std::vector<REGLIST_ENTRY> &names) {
+	const char DELIMITERS[] = ", \t\n";
+	STRING	str;
+	STRINGP	strp;
+
+	for(unsigned i=0; i<alist->size(); i++) {
+		int nregs = 0;
+		MAPDHASH	*ph;
+
+		ph = (*alist)[i]->p_phash;
+
+		if (!getvalue(*ph, KYREGS_N, nregs))
+			continue;
+
+		for(int j=0; j<nregs; j++) {
+			char	nstr[32];
+			sprintf(nstr, "%d", j);
+			strp = getstring(*ph,str=STRING("REGS.")+nstr);
+			if (!strp)
+				continue;
+			STRING	scpy = *strp;
+			char	*nxtp, *rv;
+
+			// 1. Read the number
+			int roff = strtoul(scpy.c_str(), &nxtp, 0);
+			if ((nxtp==NULL)||(nxtp == scpy.c_str()))
+				continue;
+
+			// 2. Skip the C name
+			strtok(nxtp, DELIMITERS);
+
+			// 3. Record each user name
+			while(NULL != (rv = strtok(NULL, DELIMITERS))) {
+				REGLIST_ENTRY	entry;
+
+				entry.m_name = STRING(rv);
+				entry.m_addr = (unsigned)((roff<<2)
+						+ (*alist)[i]->p_regbase);
+				names.push_back(entry);
+			}
+		}
+	}
+}
+// }}}
+
+//
+// regname_hash
+// {{{
+// The hash used by the generated regdefs_find_name(): FNV-1a across the
+// name, folded to lower case, followed by (when given a seed) the MurmurHash3
+// finalizer.  write_regname_lookup() writes the same function out into
+// regdefs.cpp, so the two must be kept in step.
+//
+static	unsigned	regname_fold_hash(const STRING &name, unsigned basis) {
+	unsigned	h = basis;
+
+	for(unsigned k=0; k<name.size(); k++) {
+		unsigned	c = (unsigned char)name[k];
+
+		if ((c >= 'A')&&(c <= 'Z'))
+			c += 'a'-'A';
+		h ^= c;
+		h *= 16777619u;
+	} return h & 0x0ffffffffu;
+}
+
+static	unsigned	regname_mix(unsigned h) {
+	h &= 0x0ffffffffu;
+	h ^= h >> 16;
+	h = (h * 0x85ebca6bu) & 0x0ffffffffu;
+	h ^= h >> 13;
+	h = (h * 0xc2b2ae35u) & 0x0ffffffffu;
+	h ^= h >> 16;
+	return h;
+}
+
+static	STRING	regname_fold(const STRING &name) {
+	STRING	r = name;
+
+	for(unsigned k=0; k<r.size(); k++)
+		r[k] = tolower(r[k]);
+	return r;
+}
+// }}}
+
+//
+// build_name_hash
+// {{{
+// Builds a perfect hash over the (unique, case folded) register names, using
+// the hash and displace approach: names are first spread across a small
+// number of buckets, and then each bucket, largest first, is given a seed
+// that places all of its names into slots nothing else is using.  A lookup
+// therefore costs one pass across the name, two table reads, and one string
+// compare to reject names that aren't in the table.
+//
+static	void	build_name_hash(const std::vector<REGLIST_ENTRY> &names,
+			const std::vector<int> &keys, unsigned &basis,
+			std::vector<unsigned> &seeds, std::vector<int> &slots) {
+	unsigned	nkeys = keys.size(), nbuckets, nslots;
+	std::vector<unsigned>	khash(nkeys);
+
+	// Pick an FNV basis that gives every name its own 32-bit hash.
+	// Otherwise, no choice of seed could ever separate two names
+	basis = 0x811c9dc5u;
+	for(bool unique=false; !unique; ) {
+		std::vector<unsigned>	sorted;
+
+		for(unsigned k=0; k<nkeys; k++)
+			khash[k] = regname_fold_hash(names[keys[k]].m_name, basis);
+		sorted = khash;
+		std::sort(sorted.begin(), sorted.end());
+		unique = (std::adjacent_find(sorted.begin(), sorted.end())
+				== sorted.end());
+		if (!unique)
+			basis = regname_mix(basis + 0x9e3779b9u);
+	}
+
+	nbuckets = nkeys / 4 + 1;
+	nslots   = nkeys + nkeys / 4 + 1;
+
+	for(bool placed=false; !placed; ) {
+		std::vector<std::vector<unsigned> >	buckets(nbuckets);
+		std::vector<unsigned>	order(nbuckets);
+
+		for(unsigned k=0; k<nkeys; k++)
+			buckets[khash[k] % nbuckets].push_back(k);
+		for(unsigned b=0; b<nbuckets; b++)
+			order[b] = b;
+		std::stable_sort(order.begin(), order.end(),
+			[&buckets](unsigned a, unsigned b) {
+				return buckets[a].size() > buckets[b].size();
+			});
+
+		seeds.assign(nbuckets, 0);
+		slots.assign(nslots, -1);
+		placed = true;
+		for(unsigned ob=0; placed && ob<nbuckets; ob++) {
+			const std::vector<unsigned>	&bk = buckets[order[ob]];
+			std::vector<unsigned>	trial(bk.size());
+			bool	found = false;
+
+			if (bk.size() == 0)
+				break;
+
+			for(unsigned seed=1; !found && seed < (1u<<20); seed++) {
+				found = true;
+				for(unsigned k=0; found && k<bk.size(); k++) {
+					unsigned s;
+					s = regname_mix(khash[bk[k]] ^ seed)
+						% nslots;
+					if (slots[s] >= 0)
+						found = false;
+					for(unsigned j=0; found && j<k; j++)
+						if (trial[j] == s)
+							found = false;
+					trial[k] = s;
+				}
+
+				if (found) {
+					seeds[order[ob]] = seed;
+					for(unsigned k=0; k<bk.size(); k++)
+						slots[trial[k]] = keys[bk[k]];
+				}
+			}
+
+			if (!found)
+				placed = false;
+		}
+
+		// Should we ever fail to place a bucket, loosen the table
+		// and try again
+		if (!placed)
+			nslots += nslots / 8 + 1;
+	}
+}
+// }}}
+
+//
+// write_regname_lookup
+// {{{
+// Writes the tables and functions the REGDEFS.CPP.INSERT tag may use to
+// look up a register by name or address, rather than searching raw_bregs[]
+// one entry at a time.  Both functions return the index of the first entry
+// within raw_bregs[] that matches, or -1 if nothing does:
+//
+//	int	regdefs_find_name(const char *name);  // Case insensitive
+//	int	regdefs_find_addr(unsigned addr);
+//
+void	write_regname_lookup(FILE *fp, APLIST *alist) {
+	std::vector<REGLIST_ENTRY>	names;
+	std::vector<int>	keys;
+	std::vector<unsigned>	seeds;
+	std::vector<int>	slots;
+	unsigned	basis;
+
+	gather_regnames(alist, names);
+
+	// Only the first entry of any name can ever be found by a linear
+	// search, so only that one goes into the hash
+	{
+		std::unordered_set<STRING>	folded;
+
+		for(unsigned k=0; k<names.size(); k++) {
+			if (folded.insert(regname_fold(names[k].m_name)).second)
+				keys.push_back(k);
+		}
+	}
+
+	build_name_hash(names, keys, basis, seeds, slots);
+
+	fprintf(fp, "//\n// Register lookup tables, from @REGS.#d\n//\n");
+	fprintf(fp, "// regdefs_find_name() is based upon a perfect hash of the (case folded)\n"
+		"// register names, regdefs_find_addr() upon a table of addresses.  Both\n"
+		"// return an index into raw_bregs[], or -1 if the register isn\'t found.\n"
+		"//\n");
+
+	// The name hash
+	// {{{
+	fprintf(fp, "static const unsigned\tregdefs_name_seeds[%d] = {",
+		(int)seeds.size());
+	for(unsigned k=0; k<seeds.size(); k++)
+		fprintf(fp, "%s0x%05x%s", ((k%8)==0) ? "\n\t" : " ",
+			seeds[k], (k+1<seeds.size()) ? ",":"");
+	fprintf(fp, "\n};\n\n");
+
+	fprintf(fp, "static const int\tregdefs_name_slots[%d] = {",
+		(int)slots.size());
+	for(unsigned k=0; k<slots.size(); k++)
+		fprintf(fp, "%s%4d%s", ((k%12)==0) ? "\n\t" : " ",
+			slots[k], (k+1<slots.size()) ? ",":"");
+	fprintf(fp, "\n};\n\n");
+
+	fprintf(fp,
+"static unsigned\tregdefs_hash(const char *v) {\n"
+"\tunsigned\th = 0x%08xu;\n"
+"\n"
+"\tfor(; *v; v++) {\n"
+"\t\tunsigned\tc = (unsigned char)*v;\n"
+"\n"
+"\t\tif ((c >= \'A\')&&(c <= \'Z\'))\n"
+"\t\t\tc += \'a\'-\'A\';\n"
+"\t\th ^= c;\n"
+"\t\th *= 16777619u;\n"
+"\t} return h & 0x0ffffffffu;\n"
+"}\n"
+"\n"
+"static unsigned\tregdefs_mix(unsigned h) {\n"
+"\th &= 0x0ffffffffu;\n"
+"\th ^= h >> 16;\n"
+"\th = (h * 0x85ebca6bu) & 0x0ffffffffu;\n"
+"\th ^= h >> 13;\n"
+"\th = (h * 0xc2b2ae35u) & 0x0ffffffffu;\n"
+"\th ^= h >> 16;\n"
+"\treturn h;\n"
+"}\n"
+"\n"
+"static bool\tregdefs_same_name(const char *a, const char *b) {\n"
+"\tfor(; *a && *b; a++, b++) {\n"
+"\t\tunsigned\tca = (unsigned char)*a, cb = (unsigned char)*b;\n"
+"\n"
+"\t\tif ((ca >= \'A\')&&(ca <= \'Z\'))\n"
+"\t\t\tca += \'a\'-\'A\';\n"
+"\t\tif ((cb >= \'A\')&&(cb <= \'Z\'))\n"
+"\t\t\tcb += \'a\'-\'A\';\n"
+"\t\tif (ca != cb)\n"
+"\t\t\treturn false;\n"
+"\t} return (*a == *b);\n"
+"}\n"
+"\n"
+"int\tregdefs_find_name(const char *v) {\n"
+"\tunsigned\th = regdefs_hash(v);\n"
+"\tint\tidx;\n"
+"\n"
+"\tidx = regdefs_name_slots[regdefs_mix(h ^ regdefs_name_seeds[h %% %du]) %% %du];\n"
+"\tif ((idx >= 0)&&(regdefs_same_name(v, raw_bregs[idx].m_name)))\n"
+"\t\treturn idx;\n"
+"\treturn -1;\n"
+"}\n\n", basis, (int)seeds.size(), (int)slots.size());
+	// }}}
+
+	// The address table
+	// {{{
+	// Sort the entries by address, keeping only the first of any entries
+	// sharing an address--just as a linear search would've found
+	std::vector<int>	byaddr;
+	unsigned		span = 0;
+	bool			dense;
+
+	for(unsigned k=0; k<names.size(); k++)
+		byaddr.push_back(k);
+	std::stable_sort(byaddr.begin(), byaddr.end(),
+		[&names](int a, int b) {
+			return names[a].m_addr < names[b].m_addr;
+		});
+	byaddr.erase(std::unique(byaddr.begin(), byaddr.end(),
+		[&names](int a, int b) {
+			return names[a].m_addr == names[b].m_addr;
+		}), byaddr.end());
+
+	// When the registers are packed closely enough, a direct table
+	// indexed by word address beats a binary search
+	dense = true;
+	if (byaddr.size() > 0) {
+		unsigned	base = names[byaddr[0]].m_addr;
+
+		for(unsigned k=0; dense && k<byaddr.size(); k++)
+			if ((names[byaddr[k]].m_addr - base) & 3)
+				dense = false;
+		span = ((names[byaddr.back()].m_addr - base) >> 2) + 1;
+		if (span > 2 * byaddr.size() + 16)
+			dense = false;
+	}
+
+	if (dense) {
+		unsigned	base = 0;
+		std::vector<int>	table(span > 0 ? span : 1, -1);
+
+		if (byaddr.size() > 0)
+			base = names[byaddr[0]].m_addr;
+		for(unsigned k=0; k<byaddr.size(); k++)
+			table[(names[byaddr[k]].m_addr - base) >> 2] = byaddr[k];
+
+		fprintf(fp, "static const int\tregdefs_addr_words[%d] = {",
+			(int)table.size());
+		for(unsigned k=0; k<table.size(); k++)
+			fprintf(fp, "%s%4d%s", ((k%12)==0) ? "\n\t" : " ",
+				table[k], (k+1<table.size()) ? ",":"");
+		fprintf(fp, "\n};\n\n");
+
+		fprintf(fp,
+"int\tregdefs_find_addr(unsigned v) {\n"
+"\t// Addresses below the table wrap around to large offsets\n"
+"\tunsigned\toffset = v - 0x%08xu;\n"
+"\n"
+"\tif ((offset & 3)||((offset >> 2) >= %du))\n"
+"\t\treturn -1;\n"
+"\treturn regdefs_addr_words[offset >> 2];\n"
+"}\n\n", base, (int)table.size());
+	} else {
+		fprintf(fp, "static const int\tregdefs_addr_sorted[%d] = {",
+			(int)byaddr.size());
+		for(unsigned k=0; k<byaddr.size(); k++)
+			fprintf(fp, "%s%4d%s", ((k%12)==0) ? "\n\t" : " ",
+				byaddr[k], (k+1<byaddr.size()) ? ",":"");
+		fprintf(fp, "\n};\n\n");
+
+		fprintf(fp,
+"int\tregdefs_find_addr(unsigned v) {\n"
+"\tint\tlo = 0, hi = %d;\n"
+"\n"
+"\twhile(lo < hi) {\n"
+"\t\tint\tmid = lo + (hi-lo)/2;\n"
+"\t\tunsigned\ta = raw_bregs[regdefs_addr_sorted[mid]].m_addr;\n"
+"\n"
+"\t\tif (a == v)\n"
+"\t\t\treturn regdefs_addr_sorted[mid];\n"
+"\t\telse if (a < v)\n"
+"\t\t\tlo = mid+1;\n"
+"\t\telse\n"
+"\t\t\thi = mid;\n"
+"\t} return -1;\n"
+"}\n\n", (int)byaddr.size());
+	}
+	// }}}
+}
+// }}}
+
 //
 // build_regdefs_cpp
 // {{{
@@ -495,6 +880,8 @@ void	build_regdefs_cpp(MAPDHASH &master, FILE *fp, STRING &fname) {
 
 	fprintf(fp, "\n};\n\n");
 
+	write_regname_lookup(fp, alist);
+
 	fprintf(fp, "// REGSDEFS.CPP.INSERT for any bus masters\n");
 	for(MAPDHASH::iterator kvpair=master.begin(); kvpair != master.end(); kvpair++) {
 		if (kvpair->second.m_typ != MAPT_MAP)
@@ -43,6 +43,7 @@
 
 #include "mapdhash.h"
 #include "plist.h"
+#include "gather.h"
 
 extern	int	get_longest_defname(PLIST &plist);
 
@@ -81,6 +82,14 @@ extern	unsigned	get_longest_uname(PLIST &plist);
 extern	void write_regnames(FILE *fp, PLIST &plist,
 		unsigned longest_defname, unsigned longest_uname);
 
+//
+// write_regname_lookup
+//
+// Writes regdefs_find_name() and regdefs_find_addr() into regdefs.cpp, based
+// upon a perfect hash of the register names and a table of their addresses,
+// for use by the @REGDEFS.CPP.INSERT tag.
+//
+extern	void	write_regname_lookup(FILE *fp, APLIST *alist);
 
 //
 // build_regdefs_cpp
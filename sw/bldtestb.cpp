@@ -40,6 +40,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <vector>
+#include <algorithm>
 #include "parser.h"
 #include "mapdhash.h"
 #include "keys.h"
@@ -47,8 +48,207 @@
 #include "legalnotice.h"
 #include "clockinfo.h"
 
+// The largest number of clock edges, across one hyperperiod of all of the
+// clocks, that we'll unroll into tick().  Designs with more than this will
+// use a heap of pending edges instead.
+#define	MAX_SCHEDULE_STEPS	256
+
+// The scheduled tick() reports falling edges using one bit per clock
+#define	MAX_SCHEDULED_CLOCKS	32
+
+typedef	struct {
+	unsigned long		m_time_ps;	// Offset into the hyperperiod
+	std::vector<unsigned>	m_clocks;	// Clocks with an edge here
+	unsigned		m_falling;	// Bit mask of falling edges
+} CLOCKSTEP;
+
+//
+// half_period_ps
+// {{{
+// The clocks toggle every half period.  As with TBCLOCK, an odd period is
+// rounded down to an even one.
+static	unsigned long	half_period_ps(unsigned ck) {
+	return cklist[ck].interval_ps() / 2;
+}
+// }}}
+
+//
+// can_schedule_clocks
+// {{{
+// We can only build a schedule for the clocks if we know how they behave.
+// Any clock with its own simulation class (CLOCK.CLASS) keeps the generic
+// TBCLOCK interface, as does any clock whose frequency is unknown.
+static	bool	can_schedule_clocks(void) {
+	if (cklist.size() > MAX_SCHEDULED_CLOCKS)
+		return false;
+	for(unsigned i=0; i<cklist.size(); i++) {
+		if (cklist[i].m_simclass != NULL)
+			return false;
+		if (half_period_ps(i) < 2)
+			return false;
+	} return true;
+}
+// }}}
+
+//
+// build_clock_table
+// {{{
+// Lists every clock edge within one hyperperiod of all of the clocks--the
+// least common multiple of all of their periods, after which the pattern of
+// edges repeats.  Clock i has its edges at k*half_period-1 for k=1,2,...,
+// rising on the odd edges and falling on the even ones, matching the edges
+// of a freshly initialized TBCLOCK.  Returns false, leaving the table empty,
+// if this would take more than MAX_SCHEDULE_STEPS steps.
+static	bool	build_clock_table(std::vector<CLOCKSTEP> &steps,
+			unsigned long &hyper_ps) {
+	unsigned long	nedges = 0;
+
+	steps.clear();
+	hyper_ps = 1;
+	for(unsigned i=0; i<cklist.size(); i++) {
+		unsigned long	period = 2 * half_period_ps(i), a, b;
+
+		// hyper_ps = lcm(hyper_ps, period)
+		a = hyper_ps; b = period;
+		while(b != 0) {
+			unsigned long t = a % b;
+			a = b; b = t;
+		}
+
+		if (hyper_ps / a > (unsigned long)MAX_SCHEDULE_STEPS * period)
+			return false;
+		hyper_ps = (hyper_ps / a) * period;
+	}
+
+	for(unsigned i=0; i<cklist.size(); i++) {
+		nedges += hyper_ps / half_period_ps(i);
+		if (nedges > (unsigned long)MAX_SCHEDULE_STEPS * cklist.size())
+			return false;
+	}
+
+	// Walk forward from one edge time to the next, merging edges that
+	// take place at the same time
+	std::vector<unsigned long>	next(cklist.size());
+	std::vector<unsigned long>	count(cklist.size(), 1);
+
+	for(unsigned i=0; i<cklist.size(); i++)
+		next[i] = half_period_ps(i) - 1;
+
+	while(true) {
+		CLOCKSTEP	step;
+
+		step.m_time_ps = next[0];
+		for(unsigned i=1; i<cklist.size(); i++)
+			if (next[i] < step.m_time_ps)
+				step.m_time_ps = next[i];
+		if (step.m_time_ps >= hyper_ps)
+			break;
+		if (steps.size() >= MAX_SCHEDULE_STEPS) {
+			steps.clear();
+			return false;
+		}
+
+		step.m_falling = 0;
+		for(unsigned i=0; i<cklist.size(); i++) {
+			if (next[i] != step.m_time_ps)
+				continue;
+			step.m_clocks.push_back(i);
+			if ((count[i] & 1) == 0)
+				step.m_falling |= (1u << i);
+			count[i]++;
+			next[i] += half_period_ps(i);
+		}
+
+		steps.push_back(step);
+	}
+
+	return true;
+}
+// }}}
+
+//
+// write_falling_edges
+// {{{
+// Calls the simulation tick function of every clock with a falling edge in
+// the given mask, in clock order
+static	void	write_falling_edges(FILE *fp) {
+	fprintf(fp, "		// Call to see if any simulation components need\n"
+		"		// to advance their inputs based upon these clocks\n");
+	for(unsigned i=0; i<cklist.size(); i++)
+		fprintf(fp, "		if (falling & 0x%x) {\n"
+			"			m_changed = true;\n"
+			"			sim_%s_tick();\n"
+			"		}\n",
+			1u << i, cklist[i].m_name->c_str());
+}
+// }}}
+
+//
+// write_schedclock_class
+// {{{
+// Defines the clock class used by a scheduled tick().  Unlike TBCLOCK, which
+// must be advanced on every step, a TBSCHEDCLOCK is only updated when it
+// toggles.  Its edge indicators compare the time of its last edge against
+// the current simulation time, so they clear themselves on any step where
+// the clock doesn't toggle.
+static	void	write_schedclock_class(FILE *fp) {
+	fprintf(fp, "\n"
+	"\t//\n"
+	"\t// TBSCHEDCLOCK is a minimal clock class, whose edges are scheduled by\n"
+	"\t// TESTB::tick() below.  It is only touched when it toggles, yet still\n"
+	"\t// provides the time_to_edge(), rising_edge(), and falling_edge()\n"
+	"\t// indicators of a TBCLOCK.\n"
+	"\t//\n"
+"class	TBSCHEDCLOCK {\n"
+"public:\n"
+"	const uint64_t	*m_now_ps;\n"
+"	uint64_t	m_edge_ps;\n"
+"	unsigned long	m_increment_ps;\n"
+"	int		m_level;\n"
+"\n"
+"	void	init(const uint64_t *now_ps, unsigned long increment_ps) {\n"
+"		m_now_ps = now_ps;\n"
+"		m_increment_ps = increment_ps;\n"
+"		// The first edge, a rising edge, is at increment_ps-1\n"
+"		m_edge_ps = (uint64_t)-1;\n"
+"		m_level = 0;\n"
+"	}\n"
+"\n"
+"	int	toggle(void) {\n"
+"		m_edge_ps = *m_now_ps;\n"
+"		m_level = !m_level;\n"
+"		return m_level;\n"
+"	}\n"
+"\n"
+"	unsigned long	time_to_edge(void) const {\n"
+"		return (unsigned long)(m_edge_ps + m_increment_ps - *m_now_ps);\n"
+"	}\n"
+"\n"
+"	bool	rising_edge(void) const {\n"
+"		return (m_level)&&(m_edge_ps == *m_now_ps);\n"
+"	}\n"
+"\n"
+"	bool	falling_edge(void) const {\n"
+"		return (!m_level)&&(m_edge_ps == *m_now_ps);\n"
+"	}\n"
+"};\n");
+}
+// }}}
+
 void	build_testb_h(MAPDHASH &master, FILE *fp, STRING &fname) {
-	bool	multiclock = false;
+	bool	multiclock = false, scheduled = false;
+	std::vector<CLOCKSTEP>	steps;
+	unsigned long	hyper_ps = 0;
+	int	flush_ticks;
+
+	// How often, in ticks, should the trace be flushed?  Flushing on
+	// every tick (the default) keeps the trace file current should the
+	// simulation crash, at the cost of I/O bounding any long trace.  Zero
+	// leaves any flushing to the trace class itself.
+	if (!getvalue(master, KYSIM_TRACE_FLUSH, flush_ticks)
+			|| (flush_ticks < 0))
+		flush_ticks = 1;
+
 	// Find all the clocks in the design, and categorize them
 	find_clocks(master);
 
@@ -81,8 +281,19 @@ void	build_testb_h(MAPDHASH &master, FILE *fp, STRING &fname) {
 		multiclock = true;
 	else
 		multiclock = false;
+	// With only TBCLOCKs, the clock edges can be scheduled here, rather
+	// than searched for on every tick
+	if (multiclock && can_schedule_clocks()) {
+		scheduled = true;
+		build_clock_table(steps, hyper_ps);
+	}
+
+	// Sim sources may still use TBCLOCK through this file, even if the
+	// TESTB class itself no longer does
 	if (multiclock)
 		fprintf(fp, "#include <tbclock.h>\n");
+	if (scheduled)
+		write_schedclock_class(fp);
 
 	fprintf(fp, "\n"
 	"\t//\n"
@@ -98,9 +309,27 @@ void	build_testb_h(MAPDHASH &master, FILE *fp, STRING &fname) {
 "	bool		m_changed;\n"
 "	TRACECLASS*	m_trace;\n"
 "	bool		m_done, m_paused_trace;\n"
+"	uint64_t	m_trace_start_ps, m_trace_stop_ps;\n"
+"	unsigned	m_trace_flush_ticks, m_trace_flush_count;\n"
 "	uint64_t	m_time_ps;\n");
 
-	if (multiclock) {
+	if (scheduled) {
+		fprintf(fp, "\t// TBSCHEDCLOCK is a clock support class, enabling"
+				" multiclock simulation\n\t// operation.\n");
+		for(unsigned i=0; i<cklist.size(); i++)
+			fprintf(fp, "\tTBSCHEDCLOCK\tm_%s;\n",
+				cklist[i].m_name->c_str());
+		if (steps.size() > 0)
+			fprintf(fp, "\t// Clock edge schedule, one step per edge\n"
+				"\tunsigned\tm_clock_step;\n"
+				"\tuint64_t\tm_clock_base_ps;\n");
+		else
+			fprintf(fp, "\t// Pending clock edges, as a heap sorted"
+					" by time\n"
+				"\tuint64_t\tm_clock_next_ps[%d];\n"
+				"\tunsigned\tm_clock_heap[%d];\n",
+				(int)cklist.size(), (int)cklist.size());
+	} else if (multiclock) {
 		fprintf(fp, "\t// TBCLOCK is a clock support class, enabling"
 				" multiclock simulation\n\t// operation.\n");
 		for(unsigned i=0; i<cklist.size(); i++)
@@ -125,9 +354,45 @@ void	build_testb_h(MAPDHASH &master, FILE *fp, STRING &fname) {
 "		m_trace    = NULL;\n"
 "		m_done     = false;\n"
 "		m_paused_trace = false;\n"
-"		Verilated::traceEverOn(true);\n");
+"		m_trace_start_ps = 0;\n"
+"		m_trace_stop_ps  = ~(uint64_t)0;\n"
+"		m_trace_flush_ticks = %d;\n"
+"		m_trace_flush_count = 0;\n"
+"		Verilated::traceEverOn(true);\n", flush_ticks);
+
+	if (scheduled) {
+		std::vector<unsigned>	order;
 
-	if (multiclock) {
+		fprintf(fp, "// Set the initial clock periods\n");
+		for(unsigned i=0; i<cklist.size(); i++) {
+			double	freq;
+			fprintf(fp, "\t\tm_%s.init(&m_time_ps, %ld);",
+				cklist[i].m_name->c_str(),
+				half_period_ps(i));
+			freq = 1e6 / cklist[i].interval_ps();
+			fprintf(fp, "\t//%8.2f MHz\n", freq);
+		}
+
+		if (steps.size() > 0) {
+			fprintf(fp, "\t\tm_clock_step = 0;\n"
+				"\t\tm_clock_base_ps = 0;\n");
+		} else {
+			// Any list sorted by time is also a valid heap
+			for(unsigned i=0; i<cklist.size(); i++)
+				order.push_back(i);
+			std::stable_sort(order.begin(), order.end(),
+				[](unsigned a, unsigned b) {
+					return half_period_ps(a)
+						< half_period_ps(b);
+				});
+			for(unsigned i=0; i<cklist.size(); i++)
+				fprintf(fp, "\t\tm_clock_next_ps[%d] = %ld;\n",
+					i, half_period_ps(i)-1);
+			for(unsigned i=0; i<cklist.size(); i++)
+				fprintf(fp, "\t\tm_clock_heap[%d] = %d;\n",
+					i, order[i]);
+		}
+	} else if (multiclock) {
 		fprintf(fp, "// Set the initial clock periods\n");
 		for(unsigned i=0; i<cklist.size(); i++) {
 			double	freq;
@@ -217,6 +482,48 @@ void	build_testb_h(MAPDHASH &master, FILE *fp, STRING &fname) {
 "			delete m_trace;\n"
 "			m_trace = NULL;\n"
 "		}\n"
+"	}\n"
+	"\t// }}}\n"
+"\n"
+	"\t//\n"
+	"\t// tracewindow(start_ps, stop_ps)\n"
+	"\t// {{{\n"
+	"\t// Limits the trace to simulation times from start_ps up to, but not\n"
+	"\t// including, stop_ps.  Outside of this window nothing is written to\n"
+	"\t// the trace, so a long simulation need only pay for tracing where\n"
+	"\t// it's needed.  tracewindow(0) traces everything again.\n"
+	"\t//\n"
+"	virtual	void	tracewindow(uint64_t start_ps,\n"
+"			uint64_t stop_ps = ~(uint64_t)0) {\n"
+"		m_trace_start_ps = start_ps;\n"
+"		m_trace_stop_ps  = stop_ps;\n"
+"	}\n"
+	"\t// }}}\n"
+"\n"
+	"\t//\n"
+	"\t// tracing()\n"
+	"\t// {{{\n"
+	"\t// Returns true if the current time step is to be written to the\n"
+	"\t// trace: the trace is open, isn't paused, and we are within the\n"
+	"\t// trace window.\n"
+	"\t//\n"
+"	bool	tracing(void) const {\n"
+"		return (m_trace)&&(!m_paused_trace)\n"
+"			&&(m_time_ps >= m_trace_start_ps)\n"
+"			&&(m_time_ps <  m_trace_stop_ps);\n"
+"	}\n"
+	"\t// }}}\n"
+"\n"
+	"\t//\n"
+	"\t// flushinterval(ticks)\n"
+	"\t// {{{\n"
+	"\t// Sets how often, in calls to tick(), the trace is flushed to its\n"
+	"\t// file.  The default is set by the @SIM.TRACE.FLUSH tag.  Zero will\n"
+	"\t// leave flushing to the trace class, such as when it is closed.\n"
+	"\t//\n"
+"	virtual	void	flushinterval(unsigned ticks) {\n"
+"		m_trace_flush_ticks = ticks;\n"
+"		m_trace_flush_count = 0;\n"
 "	}\n"
 	"\t// }}}\n"
 "\n"
@@ -243,7 +550,68 @@ void	build_testb_h(MAPDHASH &master, FILE *fp, STRING &fname) {
 	"\t// transition.\n"
 "	virtual	void	tick(void) {\n");
 
-	if (multiclock) {
+	if (scheduled) {
+		fprintf(fp, "\t\tunsigned	falling = 0;\n\n");
+
+		fprintf(fp, "\t\t// Pre-evaluate, to give verilator a chance"
+			" to settle any\n\t\t// combinatorial logic that"
+			" may have changed since the\n\t\t// last clock"
+			" evaluation, and then record that in the trace.\n");
+		fprintf(fp, "\t\teval();\n"
+			"\t\tif (tracing()) m_trace->dump(m_time_ps+1);\n\n");
+
+		if (steps.size() > 0) {
+			fprintf(fp, "\t\t// Advance to the next clock edge,"
+				" toggling only those clocks\n"
+				"\t\t// with an edge at that time.  The edges"
+				" repeat every %ld ps.\n", hyper_ps);
+			fprintf(fp, "\t\tswitch(m_clock_step++) {\n");
+			for(unsigned k=0; k<steps.size(); k++) {
+				const CLOCKSTEP	&st = steps[k];
+
+				fprintf(fp, "\t\tcase %d:\n"
+					"\t\t\tm_time_ps = m_clock_base_ps + %ld;\n",
+					k, st.m_time_ps);
+				for(unsigned j=0; j<st.m_clocks.size(); j++)
+					fprintf(fp, "\t\t\tm_core->%s = m_%s.toggle();\n",
+						cklist[st.m_clocks[j]].m_wire->c_str(),
+						cklist[st.m_clocks[j]].m_name->c_str());
+				if (st.m_falling)
+					fprintf(fp, "\t\t\tfalling = 0x%x;\n",
+						st.m_falling);
+				if (k+1 == steps.size())
+					fprintf(fp, "\t\t\tm_clock_base_ps += %ld;\n"
+						"\t\t\tm_clock_step = 0;\n",
+						hyper_ps);
+				fprintf(fp, "\t\t\tbreak;\n");
+			}
+			fprintf(fp, "\t\t}\n\n");
+		} else {
+			fprintf(fp, "\t\t// Advance to the earliest pending"
+				" clock edge, toggling\n"
+				"\t\t// every clock with an edge at that"
+				" time\n");
+			fprintf(fp, "\t\tm_time_ps = m_clock_next_ps[m_clock_heap[0]];\n"
+				"\t\tdo {\n"
+				"\t\t\tunsigned\tck = m_clock_heap[0];\n\n"
+				"\t\t\tswitch(ck) {\n");
+			for(unsigned i=0; i<cklist.size(); i++)
+				fprintf(fp, "\t\t\tcase %d:\n"
+					"\t\t\t\tm_core->%s = m_%s.toggle();\n"
+					"\t\t\t\tif (m_%s.falling_edge())\n"
+					"\t\t\t\t\tfalling |= 0x%x;\n"
+					"\t\t\t\tm_clock_next_ps[%d] += %ld;\n"
+					"\t\t\t\tbreak;\n",
+					i, cklist[i].m_wire->c_str(),
+					cklist[i].m_name->c_str(),
+					cklist[i].m_name->c_str(), 1u << i,
+					i, half_period_ps(i));
+			fprintf(fp, "\t\t\t}\n\n"
+				"\t\t\tclock_sift_down();\n"
+				"\t\t} while(m_clock_next_ps[m_clock_heap[0]] == m_time_ps);\n\n");
+		}
+
+	} else if (multiclock) {
 		fprintf(fp, ""
 			"\t\tunsigned	mintime = m_%s.time_to_edge();\n\n",
 				cklist[0].m_name->c_str());
@@ -262,7 +630,7 @@ void	build_testb_h(MAPDHASH &master, FILE *fp, STRING &fname) {
 			"that may have changed since the\n\t\t// last clock"
 			"evaluation, and then record that in the trace.\n");
 		fprintf(fp, "\t\teval();\n"
-			"\t\tif (m_trace && !m_paused_trace) m_trace->dump(m_time_ps+1);\n\n");
+			"\t\tif (tracing()) m_trace->dump(m_time_ps+1);\n\n");
 
 		fprintf(fp, "\t\t// Advance each clock\n");
 		for(unsigned i=0; i<cklist.size(); i++)
@@ -285,7 +653,7 @@ void	build_testb_h(MAPDHASH &master, FILE *fp, STRING &fname) {
 			"\t\t// evaluation, and then record that in the\n"
 			"\t\t// trace.\n");
 		fprintf(fp, "\t\teval();\n"
-			"\t\tif (m_trace && !m_paused_trace) m_trace->dump(m_time_ps+%ld);\n\n",
+			"\t\tif (tracing()) m_trace->dump(m_time_ps+%ld);\n\n",
 			quarter_tick);
 
 		fprintf(fp, "\t\t// Advance the one simulation clock, %s\n",
@@ -298,13 +666,19 @@ void	build_testb_h(MAPDHASH &master, FILE *fp, STRING &fname) {
 	fprintf(fp, "\t\teval();\n"
 		"\t\t// If we are keeping a trace, dump the current state to "
 		"that\n\t\t// trace now\n"
-		"\t\tif (m_trace && !m_paused_trace) {\n"
+		"\t\tif (tracing()) {\n"
 			"\t\t\tm_trace->dump(m_time_ps);\n"
-			"\t\t\tm_trace->flush();\n"
+			"\t\t\tif ((m_trace_flush_ticks)&&(++m_trace_flush_count\n"
+			"\t\t\t\t\t>= m_trace_flush_ticks)) {\n"
+				"\t\t\t\tm_trace->flush();\n"
+				"\t\t\t\tm_trace_flush_count = 0;\n"
+			"\t\t\t}\n"
 		"\t\t}\n\n");
 
 
-	if (multiclock) {
+	if (scheduled) {
+		write_falling_edges(fp);
+	} else if (multiclock) {
 		for(unsigned i=0; i<cklist.size(); i++)
 			fprintf(fp, "\t\tif (m_%s.falling_edge()) {\n"
 				"\t\t\tm_changed = true;\n"
@@ -325,7 +699,7 @@ void	build_testb_h(MAPDHASH &master, FILE *fp, STRING &fname) {
 		fprintf(fp, "\t\tm_core->%s = 0;\n"
 			"\t\tm_time_ps+= %ld;\n"
 			"\t\teval();\n"
-			"\t\tif (m_trace && !m_paused_trace) m_trace->dump(m_time_ps);\n\n",
+			"\t\tif (tracing()) m_trace->dump(m_time_ps);\n\n",
 				cklist[0].m_wire->c_str(),
 				clock_duration_ps-previous);
 
@@ -340,6 +714,33 @@ void	build_testb_h(MAPDHASH &master, FILE *fp, STRING &fname) {
 	"\t// }}}\n"
 	"\n");
 
+	if (scheduled && steps.size() == 0) {
+		fprintf(fp,
+	"\t//\n"
+	"\t// clock_sift_down()\n"
+	"\t// {{{\n"
+	"\t// Restores the heap of pending clock edges, once the edge at the\n"
+	"\t// top of the heap has been moved forward in time\n"
+	"\t//\n"
+"	void	clock_sift_down(void) {\n"
+"		unsigned	k = 0, ck = m_clock_heap[0];\n"
+"		uint64_t	t = m_clock_next_ps[ck];\n"
+"\n"
+"		while(2*k+1 < %d) {\n"
+"			unsigned	c = 2*k+1;\n"
+"\n"
+"			if ((c+1 < %d)&&(m_clock_next_ps[m_clock_heap[c+1]]\n"
+"					< m_clock_next_ps[m_clock_heap[c]]))\n"
+"				c++;\n"
+"			if (t <= m_clock_next_ps[m_clock_heap[c]])\n"
+"				break;\n"
+"			m_clock_heap[k] = m_clock_heap[c];\n"
+"			k = c;\n"
+"		} m_clock_heap[k] = ck;\n"
+"	}\n"
+	"\t// }}}\n"
+	"\n", (int)cklist.size(), (int)cklist.size());
+	}
 
 	for(unsigned i=0; i<cklist.size(); i++) {
 		fprintf(fp, "\tvirtual	void	sim_%s_tick(void) {\n"
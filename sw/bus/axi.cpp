@@ -132,6 +132,9 @@
 
 extern	AXIBUSCLASS	axiclass;
 const	unsigned	AXI_MIN_ADDRESS_WIDTH = 12;
+// The most SINGLE or DOUBLE slaves one SIO or DIO may hold.  Unlike the
+// wishbone bus, nothing here splits a larger group across several muxes.
+const	unsigned	AXI_MAX_SIO_SLAVES = 49;
 
 AXIBUS::AXIBUS(BUSINFO *bi) : AXILBUS(bi) {
 	// {{{
@@ -145,6 +148,7 @@ AXIBUS::AXIBUS(BUSINFO *bi) : AXILBUS(bi) {
 	m_num_single = 0;
 	m_num_double = 0;
 	m_num_total = 0;
+	m_id_width = 0;
 }
 // }}}
 
@@ -179,8 +183,16 @@ void	AXIBUS::allocate_subbus(void) {
 	}
 
 	assert(!m_is_single || !m_is_double);
-	assert(m_num_single < 50);
-	assert(m_num_double < 50);
+	if (m_num_single > AXI_MAX_SIO_SLAVES)
+		gbl_msg.error("Bus %s has %d SINGLE slaves, but an AXI4 bus "
+			"supports no more than %d\n",
+			(name()) ? name()->c_str() : "(No-name)",
+			m_num_single, AXI_MAX_SIO_SLAVES);
+	if (m_num_double > AXI_MAX_SIO_SLAVES)
+		gbl_msg.error("Bus %s has %d DOUBLE slaves, but an AXI4 bus "
+			"supports no more than %d\n",
+			(name()) ? name()->c_str() : "(No-name)",
+			m_num_double, AXI_MAX_SIO_SLAVES);
 	assert(m_num_total >= m_num_single + m_num_double);
 
 	//
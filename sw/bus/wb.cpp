@@ -43,6 +43,10 @@
 //	BUS.OPT_DBLBUFFER
 //		If set, uses an extra clock on the return--for better clock
 //		speed performance
+//	BUS.OPT_FANIN
+//		The most SINGLE or DOUBLE slaves any one return mux may select
+//		between, rounded down to a power of two.  Larger groups use a
+//		registered tree of muxes.
 //	BUS.OPT_LGMAXBURST
 //		Log_2 of the maximum number of transactions "in-flight" at any
 //		given time.  This sets the bit-width of the internal transaction
@@ -141,6 +145,9 @@
 
 #define	PREFIX
 
+// The default maximum number of slaves in any one SIO or DIO return mux
+#define	DEFAULT_FANIN	32
+
 extern	WBBUSCLASS	wbclass;
 
 WBBUS::WBBUS(BUSINFO *bi) {
@@ -187,8 +194,6 @@ void	WBBUS::allocate_subbus(void) {
 		m_num_double = 0;
 
 	assert(!m_is_single || !m_is_double);
-	assert(m_num_single < 50);
-	assert(m_num_double < 50);
 	assert(m_num_total >= m_num_single + m_num_double);
 
 	//
@@ -308,7 +313,13 @@ BUSINFO *WBBUS::create_sio(void) {
 	bushash = new MAPDHASH();
 	shash   = new MAPDHASH();
 	setstring(*shash, KYPREFIX, sioname);
-	setstring(*shash, KYSLAVE_TYPE, new STRING(KYDOUBLE));
+	// The SIO returns its results on the next clock, and so can sit on the
+	// DIO with the other DOUBLE slaves--unless it has so many slaves that
+	// their results need more than one clock to return.
+	if (m_num_single > mux_fanin())
+		setstring(*shash, KYSLAVE_TYPE, new STRING(KYOTHER));
+	else
+		setstring(*shash, KYSLAVE_TYPE, new STRING(KYDOUBLE));
 	setstring(*shash, KYSLAVE_PREFIX, sioname);
 
 	elm.m_typ = MAPT_MAP;
@@ -416,6 +427,217 @@ void	WBBUS::countsio(void) {
 }
 // }}}
 
+//
+// mux_fanin
+// {{{
+// The largest number of slaves any one SIO or DIO return mux may select
+// among, as set by @BUS.OPT_FANIN.  Larger sets of slaves are split across
+// a tree of registered muxes.  Rounded down to a power of two, so that each
+// level of the tree selects using its own bits of the slave's index, and so
+// that no mux ever selects among more than @BUS.OPT_FANIN slaves.
+//
+unsigned	WBBUS::mux_fanin(void) {
+	int	fanin;
+
+	if (!getvalue(*m_info->m_hash, KY_OPT_FANIN, fanin))
+		fanin = DEFAULT_FANIN;
+	if (fanin < 2)
+		fanin = 2;
+	return 1u << (nextlg(fanin+1)-1);
+}
+// }}}
+
+//
+// mux_levels
+// {{{
+// The number of registered levels, and hence clocks, required to return one
+// of nslaves values
+//
+unsigned	WBBUS::mux_levels(unsigned nslaves) {
+	unsigned	fanin = mux_fanin(), levels = 1;
+
+	while(nslaves > fanin) {
+		nslaves = (nslaves + fanin-1) / fanin;
+		levels++;
+	} return levels;
+}
+// }}}
+
+//
+// writeout_mux_tree
+// {{{
+// Select one of the leaves through a tree of registered muxes, given a
+// register, sel, holding the index of the leaf to select.  Each level uses
+// the bottom bits of the index to choose among its inputs, and passes the
+// rest on to the next level.  The last level writes r_<pfx>_data.  Returns
+// the number of levels, and hence clocks, used.
+//
+unsigned	WBBUS::writeout_mux_tree(FILE *fp, const STRING &pfx,
+		std::vector<STRING> &leaves, unsigned level, STRING sel) {
+	CLOCKINFO	*c = m_info->m_clock;
+	unsigned	lgfanin = nextlg(mux_fanin()),
+			selw = nextlg(leaves.size()), nlevels = 0;
+
+	while(leaves.size() > 1) {
+		std::vector<STRING>	nodes;
+		unsigned	fanin, nnodes, digit;
+		STRING		nxtsel;
+
+		digit  = (selw < lgfanin) ? selw : lgfanin;
+		fanin  = 1u << digit;
+		nnodes = (leaves.size() + fanin-1) / fanin;
+
+		fprintf(fp, "\t// Level %d: %d values, in %d group%s of up to %d\n",
+			level, (int)leaves.size(), nnodes,
+			(nnodes > 1) ? "s" : "", fanin);
+		for(unsigned k=0; k<nnodes; k++) {
+			if (nnodes == 1) {
+				nodes.push_back(STRING(PREFIX "r_") + pfx
+					+ "_data");
+				continue;
+			}
+
+			nodes.push_back(STRING(PREFIX "r_") + pfx + "_l"
+				+ std::to_string(level) + "_"
+				+ std::to_string(k));
+			fprintf(fp, "\treg\t[%d:0]\t%s;\n",
+				m_info->data_width()-1, nodes[k].c_str());
+		} if (nnodes > 1) {
+			nxtsel = STRING(PREFIX "r_") + pfx + "_sel"
+				+ std::to_string(level);
+			fprintf(fp, "\treg\t[%d:0]\t%s;\n\n"
+				"\talways\t@(posedge %s)\n"
+				"\t\t%s <= %s[%d:%d];\n",
+				selw-digit-1, nxtsel.c_str(),
+				c->m_wire->c_str(),
+				nxtsel.c_str(), sel.c_str(), selw-1, digit);
+		} fprintf(fp, "\n");
+
+		for(unsigned k=0; k<nnodes; k++) {
+			unsigned	first = k * fanin, last;
+
+			last = first + fanin;
+			if (last > leaves.size())
+				last = leaves.size();
+
+			fprintf(fp, "\talways\t@(posedge %s)\n"
+				"\tcasez(%s[%d:0])\n",
+				c->m_wire->c_str(), sel.c_str(), digit-1);
+			for(unsigned j=first; j<last; j++)
+				fprintf(fp, "\t%d'd%d: %s <= %s;\n",
+					digit, j-first, nodes[k].c_str(),
+					leaves[j].c_str());
+			if (last - first != fanin) {
+				if (bus_option(KY_OPT_LOWPOWER))
+					fprintf(fp, "\tdefault: %s <= 0;\n",
+						nodes[k].c_str());
+				else
+					fprintf(fp, "\tdefault: %s <= %s;\n",
+						nodes[k].c_str(),
+						leaves[last-1].c_str());
+			} fprintf(fp, "\tendcase\n\n");
+		}
+
+		leaves = nodes;
+		sel    = nxtsel;
+		selw  -= digit;
+		level++;
+		nlevels++;
+	} return nlevels;
+}
+// }}}
+
+//
+// writeout_sio_tree
+// {{{
+// SINGLE slaves, when there are too many for one return mux.  On the first
+// clock, the slaves are split into groups of at most mux_fanin(), and each
+// group registers the value of its selected slave.  At the same time, the
+// index of the group selected is registered, and used to pick among the
+// groups on the next clock--and so on up the tree.  The acknowledgment is
+// delayed to match.
+//
+void	WBBUS::writeout_sio_tree(FILE *fp, const STRING &slp,
+		unsigned unused_lsbs, unsigned lgdw, unsigned mask) {
+	CLOCKINFO	*c = m_info->m_clock;
+	STRINGP		rst = m_info->reset_wire();
+	unsigned	fanin = mux_fanin(), nslaves = m_slist->size(),
+			ngroups = (nslaves + fanin-1) / fanin,
+			levels = mux_levels(nslaves),
+			abits = nextlg(mask)-unused_lsbs;
+	std::vector<STRING>	groups;
+	STRING		sel = STRING(PREFIX "r_") + slp + "_sel0";
+
+	fprintf(fp, "\t// %d SINGLE slaves, returned through %d levels\n",
+		nslaves, levels);
+	fprintf(fp, "\treg\t[%d:0]\t" PREFIX "r_%s_ack;\n",
+		levels-1, slp.c_str());
+	fprintf(fp, "\treg\t[%d:0]\t" PREFIX "r_%s_data;\n",
+		m_info->data_width()-1, slp.c_str());
+	fprintf(fp, "\treg\t[%d:0]\t%s;\n",
+		nextlg(ngroups)-1, sel.c_str());
+	for(unsigned g=0; g<ngroups; g++) {
+		groups.push_back(STRING(PREFIX "r_") + slp + "_l0_"
+			+ std::to_string(g));
+		fprintf(fp, "\treg\t[%d:0]\t%s;\n",
+			m_info->data_width()-1, groups[g].c_str());
+	} fprintf(fp, "\n");
+
+	fprintf(fp, "\tassign\t" PREFIX "%s_stall = 1\'b0;\n\n", slp.c_str());
+	fprintf(fp, "\tinitial " PREFIX "r_%s_ack = 0;\n"
+		"\talways\t@(posedge %s)\n"
+		"\tif (%s || !%s_cyc)\n"
+		"\t\t" PREFIX "r_%s_ack <= 0;\n"
+		"\telse\n"
+		"\t\t" PREFIX "r_%s_ack <= { " PREFIX "r_%s_ack[%d:0], (%s_stb) };\n",
+		slp.c_str(), c->m_wire->c_str(),
+		(rst) ? rst->c_str() : "i_reset", slp.c_str(),
+		slp.c_str(), slp.c_str(), slp.c_str(), levels-2, slp.c_str());
+	fprintf(fp, "\tassign\t" PREFIX "%s_ack = " PREFIX "r_%s_ack[%d];\n\n",
+		slp.c_str(), slp.c_str(), levels-1);
+
+	// The group each address belongs to
+	fprintf(fp, "\talways\t@(posedge %s)\n"
+		"\tcasez( %s_addr[%d:%d] )\n",
+		c->m_wire->c_str(), slp.c_str(),
+		nextlg(mask)-1, unused_lsbs);
+	for(unsigned j=0; j<nslaves; j++)
+		fprintf(fp, "\t%d'h%lx: %s <= %d;\n", abits,
+			((*m_slist)[j]->p_base) >> (unused_lsbs + lgdw),
+			sel.c_str(), j / fanin);
+	fprintf(fp, "\tdefault: %s <= 0;\n"
+		"\tendcase\n\n", sel.c_str());
+
+	// The first level, selecting by address within each group
+	for(unsigned g=0; g<ngroups; g++) {
+		unsigned	first = g * fanin, last = first + fanin;
+
+		if (last > nslaves)
+			last = nslaves;
+		fprintf(fp, "\talways\t@(posedge %s)\n"
+			"\tcasez( %s_addr[%d:%d] )\n",
+			c->m_wire->c_str(), slp.c_str(),
+			nextlg(mask)-1, unused_lsbs);
+		for(unsigned j=first; j<last; j++)
+			fprintf(fp, "\t%d'h%lx: %s <= %s_idata;\n", abits,
+				((*m_slist)[j]->p_base) >> (unused_lsbs + lgdw),
+				groups[g].c_str(),
+				(*m_slist)[j]->bus_prefix()->c_str());
+		if (bus_option(KY_OPT_LOWPOWER))
+			fprintf(fp, "\tdefault: %s <= 0;\n", groups[g].c_str());
+		else
+			fprintf(fp, "\tdefault: %s <= %s_idata;\n",
+				groups[g].c_str(),
+				(*m_slist)[last-1]->bus_prefix()->c_str());
+		fprintf(fp, "\tendcase\n\n");
+	}
+
+	writeout_mux_tree(fp, slp, groups, 1, sel);
+	fprintf(fp, "\tassign\t" PREFIX "%s_idata = " PREFIX "r_%s_data;\n\n",
+		slp.c_str(), slp.c_str());
+}
+// }}}
+
 void	WBBUS::integrity_check(void) {
 	// {{{
 	// GENBUS::integrity_check();
@@ -882,19 +1104,6 @@ void	WBBUS::writeout_bus_logic_v(FILE *fp) {
 			"\t// %s Bus logic to handle SINGLE slaves\n"
 			"\t//\n", n->c_str());
 
-		fprintf(fp, "\treg\t\t" PREFIX "r_%s_ack;\n", slp->c_str());
-		fprintf(fp, "\treg\t[%d:0]\t" PREFIX "r_%s_data;\n\n",
-			m_info->data_width()-1, slp->c_str());
-
-		fprintf(fp, "\tassign\t" PREFIX "%s_stall = 1\'b0;\n\n", slp->c_str());
-		fprintf(fp, "\tinitial " PREFIX "r_%s_ack = 1\'b0;\n"
-			"\talways\t@(posedge %s)\n"
-			"\t\t" PREFIX "r_%s_ack <= (%s_stb);\n",
-				slp->c_str(), c->m_wire->c_str(),
-				slp->c_str(), slp->c_str());
-		fprintf(fp, "\tassign\t" PREFIX "%s_ack = " PREFIX "r_%s_ack;\n\n",
-				slp->c_str(), slp->c_str());
-
 		unsigned mask = 0, lgdw;
 		unused_lsbs = 0;
 
@@ -904,53 +1113,70 @@ void	WBBUS::writeout_bus_logic_v(FILE *fp) {
 			unused_lsbs++;
 		lgdw = nextlg(m_info->data_width())-3;
 
-		fprintf(fp, "\talways\t@(posedge %s)\n", c->m_wire->c_str());
-			// "\t\t// mask        = %08x\n"
-			// "\t\t// lgdw        = %d\n"
-			// "\t\t// unused_lsbs = %d\n"
-		fprintf(fp, "\tcasez( %s_addr[%d:%d] )\n",
-				// mask, lgdw, unused_lsbs,
-				slp->c_str(),
-				nextlg(mask)-1, unused_lsbs);
-		for(unsigned j=0; j<m_slist->size(); j++) {
-			fprintf(fp, "\t%d'h%lx: " PREFIX "r_%s_data <= %s_idata;\n",
-				nextlg(mask)-unused_lsbs,
-				((*m_slist)[j]->p_base) >> (unused_lsbs + lgdw),
-				slp->c_str(),
-				(*m_slist)[j]->bus_prefix()->c_str());
-		}
-
-		if (m_slist->size() != (1u<<nextlg(m_slist->size()))) {
-			// We need a default option
-		if (bus_option(KY_OPT_LOWPOWER)) {
-			int	v;
-			STRINGP str;
-			if (getvalue(*m_info->m_hash, KY_OPT_LOWPOWER, v))
-				fprintf(fp,
-				"\tdefault: " PREFIX
-					"r_%s_data <= (%d) ? 0 : %s_idata;\n",
-				slp->c_str(), v,
-				(*m_slist)[m_slist->size()-1]->bus_prefix()->c_str());
-			else {
-				str = getstring(*m_info->m_hash, KY_OPT_LOWPOWER);
-				fprintf(fp, "\tdefault: " PREFIX "r_%s_data <= (%s) ? 0 : %s_idata;\n",
-				slp->c_str(), (str) ? str->c_str() : "1\'b0",
-				(*m_slist)[m_slist->size()-1]->bus_prefix()->c_str());
+		if (m_slist->size() > mux_fanin()) {
+			writeout_sio_tree(fp, *slp, unused_lsbs, lgdw, mask);
+		} else {
+			fprintf(fp, "\treg\t\t" PREFIX "r_%s_ack;\n", slp->c_str());
+			fprintf(fp, "\treg\t[%d:0]\t" PREFIX "r_%s_data;\n\n",
+				m_info->data_width()-1, slp->c_str());
+
+			fprintf(fp, "\tassign\t" PREFIX "%s_stall = 1\'b0;\n\n", slp->c_str());
+			fprintf(fp, "\tinitial " PREFIX "r_%s_ack = 1\'b0;\n"
+				"\talways\t@(posedge %s)\n"
+				"\t\t" PREFIX "r_%s_ack <= (%s_stb);\n",
+					slp->c_str(), c->m_wire->c_str(),
+					slp->c_str(), slp->c_str());
+			fprintf(fp, "\tassign\t" PREFIX "%s_ack = " PREFIX "r_%s_ack;\n\n",
+					slp->c_str(), slp->c_str());
+
+			fprintf(fp, "\talways\t@(posedge %s)\n", c->m_wire->c_str());
+				// "\t\t// mask        = %08x\n"
+				// "\t\t// lgdw        = %d\n"
+				// "\t\t// unused_lsbs = %d\n"
+			fprintf(fp, "\tcasez( %s_addr[%d:%d] )\n",
+					// mask, lgdw, unused_lsbs,
+					slp->c_str(),
+					nextlg(mask)-1, unused_lsbs);
+			for(unsigned j=0; j<m_slist->size(); j++) {
+				fprintf(fp, "\t%d'h%lx: " PREFIX "r_%s_data <= %s_idata;\n",
+					nextlg(mask)-unused_lsbs,
+					((*m_slist)[j]->p_base) >> (unused_lsbs + lgdw),
+					slp->c_str(),
+					(*m_slist)[j]->bus_prefix()->c_str());
 			}
 
-		} else {
-			fprintf(fp, "\tdefault: " PREFIX "r_%s_data <= %s_idata;\n",
-				slp->c_str(),
-				(*m_slist)[m_slist->size()-1]->bus_prefix()->c_str());
-		}} else {
-			fprintf(fp, "\t// No default: SIZE = %d, [Guru meditation: %d != %d]\n",
-				(int)m_slist->size(),
-				(int)nextlg(m_slist->size()-1),
-				(int)nextlg(m_slist->size()));
+			if (m_slist->size() != (1u<<nextlg(m_slist->size()))) {
+				// We need a default option
+			if (bus_option(KY_OPT_LOWPOWER)) {
+				int	v;
+				STRINGP str;
+				if (getvalue(*m_info->m_hash, KY_OPT_LOWPOWER, v))
+					fprintf(fp,
+					"\tdefault: " PREFIX
+						"r_%s_data <= (%d) ? 0 : %s_idata;\n",
+					slp->c_str(), v,
+					(*m_slist)[m_slist->size()-1]->bus_prefix()->c_str());
+				else {
+					str = getstring(*m_info->m_hash, KY_OPT_LOWPOWER);
+					fprintf(fp, "\tdefault: " PREFIX "r_%s_data <= (%s) ? 0 : %s_idata;\n",
+					slp->c_str(), (str) ? str->c_str() : "1\'b0",
+					(*m_slist)[m_slist->size()-1]->bus_prefix()->c_str());
+				}
+
+			} else {
+				fprintf(fp, "\tdefault: " PREFIX "r_%s_data <= %s_idata;\n",
+					slp->c_str(),
+					(*m_slist)[m_slist->size()-1]->bus_prefix()->c_str());
+			}} else {
+				fprintf(fp, "\t// No default: SIZE = %d, [Guru meditation: %d != %d]\n",
+					(int)m_slist->size(),
+					(int)nextlg(m_slist->size()-1),
+					(int)nextlg(m_slist->size()));
+			}
+			fprintf(fp, "\tendcase\n");
+			fprintf(fp, "\tassign\t" PREFIX "%s_idata = " PREFIX "r_%s_data;\n\n",
+				slp->c_str(), slp->c_str());
 		}
-		fprintf(fp, "\tendcase\n");
-		fprintf(fp, "\tassign\t" PREFIX "%s_idata = " PREFIX "r_%s_data;\n\n",
-			slp->c_str(), slp->c_str());
 
 		fprintf(fp, "\n\t//\n"
 			"\t// Now to translate this logic to the various SIO slaves\n\t//\n"
@@ -1025,9 +1251,14 @@ void	WBBUS::writeout_bus_logic_v(FILE *fp) {
 		// within them
 		lgdw = nextlg(m_info->data_width())-3;
 
+		// Too many slaves for one return mux are split across several
+		// registered levels, each adding a clock to the acknowledgment
+		unsigned levels = 1;
+		if (m_dlist->size() > mux_fanin())
+			levels = mux_levels(m_dlist->size());
 
-		fprintf(fp, "\treg\t[1:0]\t" PREFIX "r_%s_ack;\n",
-				dlp->c_str());
+		fprintf(fp, "\treg\t[%d:0]\t" PREFIX "r_%s_ack;\n",
+				levels, dlp->c_str());
 		fprintf(fp, "\t// # dlist = %d, nextlg(#dlist) = %d\n",
 			(int)m_dlist->size(),
 			nextlg(m_dlist->size()));
@@ -1044,13 +1275,24 @@ void	WBBUS::writeout_bus_logic_v(FILE *fp) {
 			dlp->c_str());
 		//
 		// The ACK line
+		if (levels > 1)
+			fprintf(fp,
+			"\t// DOUBLE peripherals return their acknowledgments in %d\n"
+			"\t// clocks--always, allowing us to collect this logic together\n"
+			"\t// in a slave independent manner.  Here, the acknowledgment\n"
+			"\t// is treated as a %d stage shift register, cleared on any\n"
+			"\t// reset, or any time the cycle line drops.  (Dropping the\n"
+			"\t// cycle line aborts the transaction.)\n",
+				levels+1, levels+1);
+		else
+			fprintf(fp,
+			"\t// DOUBLE peripherals return their acknowledgments in two\n"
+			"\t// clocks--always, allowing us to collect this logic together\n"
+			"\t// in a slave independent manner.  Here, the acknowledgment\n"
+			"\t// is treated as a two stage shift register, cleared on any\n"
+			"\t// reset, or any time the cycle line drops.  (Dropping the\n"
+			"\t// cycle line aborts the transaction.)\n");
 		fprintf(fp,
-		"\t// DOUBLE peripherals return their acknowledgments in two\n"
-		"\t// clocks--always, allowing us to collect this logic together\n"
-		"\t// in a slave independent manner.  Here, the acknowledgment\n"
-		"\t// is treated as a two stage shift register, cleared on any\n"
-		"\t// reset, or any time the cycle line drops.  (Dropping the\n"
-		"\t// cycle line aborts the transaction.)\n"
 		"\tinitial\t" PREFIX "r_%s_ack = 0;\n"
 		"\talways\t@(posedge %s)\n"
 			"\tif (%s || !%s_cyc)\n",
@@ -1058,24 +1300,40 @@ void	WBBUS::writeout_bus_logic_v(FILE *fp) {
 				rst->c_str(), dlp->c_str());
 		fprintf(fp,
 			"\t\t" PREFIX "r_%s_ack <= 0;\n"
-			"\telse\n"
-			"\t\t" PREFIX "r_%s_ack <= { " PREFIX "r_%s_ack[0], (%s_stb) };\n",
-				dlp->c_str(), dlp->c_str(),
-				dlp->c_str(), dlp->c_str());
+			"\telse\n", dlp->c_str());
+		if (levels > 1)
+			fprintf(fp, "\t\t" PREFIX "r_%s_ack <= { " PREFIX
+				"r_%s_ack[%d:0], (%s_stb) };\n",
+				dlp->c_str(), dlp->c_str(), levels-1,
+				dlp->c_str());
+		else
+			fprintf(fp, "\t\t" PREFIX "r_%s_ack <= { " PREFIX
+				"r_%s_ack[0], (%s_stb) };\n",
+				dlp->c_str(), dlp->c_str(), dlp->c_str());
 		fprintf(fp, "\tassign\t" PREFIX "%s_ack = "
-			PREFIX "r_%s_ack[1];\n",
-			dlp->c_str(), dlp->c_str());
+			PREFIX "r_%s_ack[%d];\n",
+			dlp->c_str(), dlp->c_str(), levels);
 		fprintf(fp, "\n");
 
 		//
 		// The data return lines
 		//
-		fprintf(fp,
+		if (levels > 1)
+			fprintf(fp,
+			"\t// Since it costs us %d clocks to go through this\n"
+			"\t// logic, we'll take one of those clocks here to set\n"
+			"\t// a selection index, and then use this index over the\n"
+			"\t// next %d clocks to select, one level at a time, from\n"
+			"\t// among the various possible bus return values\n",
+				levels+1, levels);
+		else
+			fprintf(fp,
 			"\t// Since it costs us two clocks to go through this\n"
 			"\t// logic, we'll take one of those clocks here to set\n"
 			"\t// a selection index, and then on the next clock we'll\n"
 			"\t// use this index to select from among the vaious\n"
-			"\t// possible bus return values\n"
+			"\t// possible bus return values\n");
+		fprintf(fp,
 			"\talways @(posedge %s)\n"
 			"\tcasez(%s_addr[%d:%d])\n",
 				c->m_wire->c_str(),
@@ -1103,29 +1361,39 @@ void	WBBUS::writeout_bus_logic_v(FILE *fp) {
 			dlp->c_str());
 		fprintf(fp, "\tendcase\n\n");
 
-		fprintf(fp, "\talways\t@(posedge %s)\n"
-			"\tcasez(" PREFIX "r_%s_bus_select)\n",
-			c->m_wire->c_str(), dlp->c_str());
+		if (levels > 1) {
+			std::vector<STRING>	leaves;
 
-		for(unsigned k=0; k<m_dlist->size(); k++) {
-			fprintf(fp, "\t%d'd%d", nextlg(m_dlist->size()), k);
-			fprintf(fp, ": " PREFIX "r_%s_data <= %s_idata;\n",
-				dlp->c_str(),
-				(*m_dlist)[k]->bus_prefix()->c_str());
-		}
+			for(unsigned k=0; k<m_dlist->size(); k++)
+				leaves.push_back(*(*m_dlist)[k]->bus_prefix()
+						+ "_idata");
+			writeout_mux_tree(fp, *dlp, leaves, 1,
+				STRING(PREFIX "r_") + (*dlp) + "_bus_select");
+		} else {
+			fprintf(fp, "\talways\t@(posedge %s)\n"
+				"\tcasez(" PREFIX "r_%s_bus_select)\n",
+				c->m_wire->c_str(), dlp->c_str());
+
+			for(unsigned k=0; k<m_dlist->size(); k++) {
+				fprintf(fp, "\t%d'd%d", nextlg(m_dlist->size()), k);
+				fprintf(fp, ": " PREFIX "r_%s_data <= %s_idata;\n",
+					dlp->c_str(),
+					(*m_dlist)[k]->bus_prefix()->c_str());
+			}
 
-		if ((1u<<nextlg(m_dlist->size())) != m_dlist->size()) {
-			// Only place the default value into the case if there
-			// are empty values there.
-			if (bus_option(KY_OPT_LOWPOWER)) {
+			if ((1u<<nextlg(m_dlist->size())) != m_dlist->size()) {
+				// Only place the default value into the case if there
+				// are empty values there.
+				if (bus_option(KY_OPT_LOWPOWER)) {
+					fprintf(fp, "\tdefault: "
+						PREFIX "r_%s_data <= 0;\n", dlp->c_str());
+				} else
 				fprintf(fp, "\tdefault: "
-					PREFIX "r_%s_data <= 0;\n", dlp->c_str());
-			} else
-			fprintf(fp, "\tdefault: "
-				PREFIX "r_%s_data <= %s_idata;\n", dlp->c_str(),
-			(*m_dlist)[m_dlist->size()-1]->bus_prefix()->c_str());
+					PREFIX "r_%s_data <= %s_idata;\n", dlp->c_str(),
+				(*m_dlist)[m_dlist->size()-1]->bus_prefix()->c_str());
+			}
+			fprintf(fp, "\tendcase\n\n");
 		}
-		fprintf(fp, "\tendcase\n\n");
 		fprintf(fp, "\tassign\t" PREFIX "%s_idata = " PREFIX "r_%s_data;\n\n",
 			dlp->c_str(), dlp->c_str());
 
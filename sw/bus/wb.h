@@ -55,6 +55,15 @@ class	WBBUS : public GENBUS {
 	BUSINFO *create_sio(void);
 	BUSINFO *create_dio(void);
 	void	countsio(void);
+
+	unsigned	mux_fanin(void);
+	unsigned	mux_levels(unsigned nslaves);
+	unsigned	writeout_mux_tree(FILE *fp, const STRING &pfx,
+				std::vector<STRING> &leaves, unsigned level,
+				STRING sel);
+	void	writeout_sio_tree(FILE *fp, const STRING &slp,
+				unsigned unused_lsbs, unsigned lgdw,
+				unsigned mask);
 public:
 	WBBUS(BUSINFO *bi);
 	~WBBUS() {};
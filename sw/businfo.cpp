@@ -67,6 +67,7 @@
 #include "subbus.h"
 #include "msgs.h"
 #include "clockinfo.h"
+#include "stats.h"
 
 BUSLIST	*gbl_blist;
 
@@ -97,11 +98,16 @@ int	BUSINFO::data_width(void) {
 STRINGP	BUSINFO::name(void) {
 	STRINGP	str;
 	str = getstring(m_hash, KY_NAME);
-	if (!m_name)
-		m_name = str;
-	else if (str->compare(*m_name) != 0) {
+	if (!m_name) {
+		if ((NULL != (m_name = str))&&(gbl_blist))
+			gbl_blist->rename(this, NULL);
+	} else if (str->compare(*m_name) != 0) {
+		STRINGP	oldname = m_name;
+
 		gbl_msg.error("Bus name %s has changed to %s\n", m_name->c_str(), str->c_str());
 		m_name = str;
+		if (gbl_blist)
+			gbl_blist->rename(this, oldname);
 	}
 	return	str;
 }
@@ -157,6 +163,8 @@ bool	BUSINFO::get_base_address(MAPDHASH *phash, unsigned &base) {
 }
 
 void	BUSINFO::assign_addresses(void) {
+	STATPHASE	phase("assign_addresses", m_name->c_str());
+
 	if (!generator())
 		gbl_msg.fatal("Bus %s has no generator type defined\n",
 			m_name->c_str());
@@ -336,6 +344,8 @@ void	BUSINFO::merge(STRINGP component, MAPDHASH *bp) {
 					elm.m_typ = MAPT_INT;
 					elm.u.m_v = (value+7)/8;
 					m_hash->insert(KEYVALUE(KY_NSELECT, elm));
+					kvnotify(KY_WIDTH);
+					kvnotify(KY_NSELECT);
 					REHASH;
 					kvpair = bp->begin();
 				} else if (m_data_width != value) {
@@ -353,6 +363,7 @@ void	BUSINFO::merge(STRINGP component, MAPDHASH *bp) {
 				elm.m_typ = MAPT_INT;
 				elm.u.m_v = value;
 				m_hash->insert(KEYVALUE(KY_NULLSZ, elm));
+				kvnotify(KY_NULLSZ);
 
 				REHASH;
 				kvpair = bp->begin();
@@ -368,6 +379,7 @@ void	BUSINFO::merge(STRINGP component, MAPDHASH *bp) {
 					elm.m_typ = MAPT_INT;
 					elm.u.m_v = value;
 					m_hash->insert(KEYVALUE(KY_IDWIDTH, elm));
+					kvnotify(KY_IDWIDTH);
 
 					REHASH;
 					kvpair = bp->begin();
@@ -396,6 +408,7 @@ void	BUSINFO::merge(STRINGP component, MAPDHASH *bp) {
 							component->c_str());
 					} else
 						m_hash->insert(KEYVALUE(KY_TYPE, elm));
+					kvnotify(KY_TYPE);
 
 					REHASH;
 					kvpair = bp->begin();
@@ -412,6 +425,7 @@ void	BUSINFO::merge(STRINGP component, MAPDHASH *bp) {
 					elm.m_typ = MAPT_STRING;
 					elm.u.m_s = strp;
 					m_hash->insert(KEYVALUE(KY_RESET, elm));
+					kvnotify(KY_RESET);
 
 					REHASH;
 					kvpair = bp->begin();
@@ -420,6 +434,19 @@ void	BUSINFO::merge(STRINGP component, MAPDHASH *bp) {
 						"for %s\n",m_name->c_str());
 				}
 				continue;
+			} else if (0 == KY_PACKING.compare(kvpair->first)) {
+				STRINGP	packing = getstring(m_hash, KY_PACKING);
+				if (packing == NULL) {
+					elm.m_typ = MAPT_STRING;
+					elm.u.m_s = strp;
+					m_hash->insert(KEYVALUE(KY_PACKING, elm));
+					kvnotify(KY_PACKING);
+				} else if (packing->compare(*strp) != 0) {
+					gbl_msg.error("Conflicting address packing "
+						"for %s: %s != %s\n", m_name->c_str(),
+						packing->c_str(), strp->c_str());
+				}
+				continue;
 			} else if ((0 == KY_CLOCK.compare(kvpair->first))
 					&&(NULL == m_clock)) {
 				gbl_msg.info("BUSINFO::INIT(%s)."
@@ -443,6 +470,7 @@ void	BUSINFO::merge(STRINGP component, MAPDHASH *bp) {
 					m_hash->insert(KEYVALUE(KY_CLOCK, elm));
 				kvpair->second.m_typ = MAPT_MAP;
 				kvpair->second.u.m_m = m_clock->m_hash;
+				kvinvalidate();
 				REHASH;
 				kvpair = bp->begin();
 				continue;
@@ -460,10 +488,50 @@ void	BUSINFO::merge(STRINGP component, MAPDHASH *bp) {
 		}
 		*/
 
+		// Bus options may be given by any component on the bus,
+		// not just the first one to name it--so long as no two
+		// components disagree
+		if ((bp != m_hash)&&(0 == kvpair->first.compare(0, 4, "OPT_"))) {
+			MAPDHASH::iterator	opt;
+			bool	differ = false;
+
+			opt = findkey(*m_hash, kvpair->first);
+			if (m_hash->end() == opt) {
+				m_hash->insert(*kvpair);
+				kvinvalidate();
+				continue;
+			}
+
+			// Options not yet evaluated can't be compared
+			if ((opt->second.m_typ == MAPT_STRING)
+				&&(kvpair->second.m_typ == MAPT_STRING))
+				differ = (opt->second.u.m_s->compare(
+						*kvpair->second.u.m_s) != 0);
+			else if ((opt->second.m_typ == MAPT_INT)
+					&&(kvpair->second.m_typ == MAPT_INT))
+				differ = (opt->second.u.m_v
+						!= kvpair->second.u.m_v);
+			else if ((opt->second.m_typ == MAPT_INT)
+					&&(kvpair->second.m_typ == MAPT_STRING))
+				differ = (opt->second.u.m_v != (int)strtol(
+					kvpair->second.u.m_s->c_str(), NULL, 0));
+			else if ((opt->second.m_typ == MAPT_STRING)
+					&&(kvpair->second.m_typ == MAPT_INT))
+				differ = (kvpair->second.u.m_v != (int)strtol(
+					opt->second.u.m_s->c_str(), NULL, 0));
+
+			if (differ)
+				gbl_msg.error("Conflicting values of %s "
+					"for bus %s\n", kvpair->first.c_str(),
+					m_name->c_str());
+			continue;
+		}
+
 		// Anything else, we copy into our defining hash
 		if ((bp != m_hash)&&(m_hash->end()
 				!= findkey(*m_hash, kvpair->first))) {
 			m_hash->insert(*kvpair);
+			kvinvalidate();
 			// REHASH;
 		}
 	}
@@ -553,17 +621,48 @@ BUSINFO *find_bus_of_peripheral(MAPDHASH *phash) {
 	return gbl_blist->find_bus_of_peripheral(phash);
 }
 
+// Index a bus by its hash and name.  Should two buses share a name (or hash),
+// the first one wins.
+void	BUSLIST::index(BUSINFO *bi) {
+	STRINGP	name;
+
+	if (bi->m_hash)
+		m_byhash.insert(std::make_pair(bi->m_hash, bi));
+	if (NULL != (name = bi->name()))
+		m_byname.insert(std::make_pair(kvintern(*name), bi));
+}
+
+// A bus within the list has just been named, or renamed
+void	BUSLIST::rename(BUSINFO *bi, STRINGP oldname) {
+	std::unordered_map<MAPDHASH *, BUSINFO *>::iterator	bh;
+	std::unordered_map<const STRING *, BUSINFO *>::iterator	bn;
+	STRINGP	name;
+
+	bh = m_byhash.find(bi->m_hash);
+	if ((bh == m_byhash.end())||(bh->second != bi))
+		return;
+
+	if ((oldname)&&(m_byname.end()
+			!= (bn = m_byname.find(kvintern(*oldname))))
+			&&(bn->second == bi))
+		m_byname.erase(bn);
+	if (NULL != (name = getstring(bi->m_hash, KY_NAME)))
+		m_byname.insert(std::make_pair(kvintern(*name), bi));
+}
+
 BUSINFO *BUSLIST::find_bus(MAPDHASH *hash) {
+	std::unordered_map<MAPDHASH *, BUSINFO *>::iterator	bp;
+
 	if (!hash) {
 		if ((*this)[0])
 			return ((*this)[0]);
 		return NULL;
 	}
-	for(unsigned k=0; k<size(); k++) {
-		if (((*this)[k]->m_hash)&&(hash == (*this)[k]->m_hash)) {
-			return (*this)[k];
-		}
-	} return NULL;
+
+	bp = m_byhash.find(hash);
+	if (bp == m_byhash.end())
+		return NULL;
+	return bp->second;
 }
 
 BUSINFO *find_bus(MAPDHASH *hash) {
@@ -577,12 +676,18 @@ BUSINFO *BUSLIST::find_bus(STRINGP name) {
 			return ((*this)[0]);
 		return NULL;
 	}
-	for(unsigned k=0; k<size(); k++) {
-		if (((*this)[k]->name())
-			&&((*this)[k]->name()->compare(*name)==0)) {
-			return (*this)[k];
-		}
-	} return NULL;
+	std::unordered_map<const STRING *, BUSINFO *>::iterator	bp;
+	STRINGP	bname;
+
+	bp = m_byname.find(kvintern(*name));
+	if (bp == m_byname.end())
+		return NULL;
+
+	// Check the name, should the bus have been renamed since
+	if ((NULL != (bname = bp->second->name()))
+			&&(bname->compare(*name)==0))
+		return bp->second;
+	return NULL;
 }
 
 BUSINFO *find_bus(STRINGP name) {
@@ -729,9 +834,11 @@ void	BUSLIST::adddefault(MAPDHASH &master, STRINGP defname) {
 	if (size() == 0) {
 		// If there are no elements (yet) in our BUSLIST, then create
 		// a first one, and call it our default.
-		push_back(bi = new BUSINFO());
+		bi = new BUSINFO();
 		bi->m_hash = new MAPDHASH();
 		setstring(*bi->m_hash, KY_NAME, defname);
+		push_back(bi);
+		index(bi);
 	} else { // if (size() > 0)
 		//
 		// If there are already busses in our bus list, shuffle them
@@ -763,12 +870,14 @@ void	BUSLIST::adddefault(MAPDHASH &master, STRINGP defname) {
 				(*this)[0] = bi = new BUSINFO();
 				bi->m_hash = new MAPDHASH();
 				setstring(*bi->m_hash, KY_NAME, defname);
+				index(bi);
 			}
 			// else this is already the default
 		} else {
 			// First spot exists, but has no name
 			bi = (*this)[0];
 			setstring(*bi->m_hash, KY_NAME, defname);
+			rename(bi, NULL);
 		}
 	}
 }
@@ -789,6 +898,7 @@ BUSINFO *BUSLIST::newbus_aux(STRINGP component, MAPDHASH *bp) {
 			bi = new BUSINFO();
 			push_back(bi);
 			bi->init(bp);
+			index(bi);
 			gbl_msg.userinfo("Bus: %s\n", str->c_str());
 		} else {
 			// We need to merge the BUS-MAP into the existing
@@ -805,6 +915,7 @@ BUSINFO *BUSLIST::newbus_aux(STRINGP component, MAPDHASH *bp) {
 		bi = new BUSINFO();
 		push_back(bi);
 		bi->init(bp);
+		index(bi);
 	}
 
 	return bi;
@@ -823,6 +934,7 @@ BUSINFO *BUSLIST::newbus_aux(STRINGP component, STRINGP bn) {
 		bi = new BUSINFO();
 		push_back(bi);
 		bi->init(bn);
+		index(bi);
 		gbl_msg.userinfo("BUS: %s (from %s)\n", bn->c_str(),
 			(component) ?  component->c_str() : "(Unnamed component)");
 	}
@@ -976,6 +1088,7 @@ void	assign_bus_slave(MAPDHASH &master, MAPDHASH *bus_slave) {
 				// Replace the bus name with the bus map
 				sbus->second.m_typ = MAPT_MAP;
 				sbus->second.u.m_m = bi->m_hash;
+				kvinvalidate();
 			}
 		} else
 			gbl_msg.error("TAG %s does not specify a bus name\n",
@@ -997,6 +1110,7 @@ void	assign_bus_slave(MAPDHASH &master, MAPDHASH *bus_slave) {
 					&&(strp->compare(*bi->name())==0)) {
 			bi->merge(pname, sbus->second.u.m_m);
 			sbus->second.u.m_m = bi->m_hash;
+			kvinvalidate();
 		}
 	} else {
 		gbl_msg.error("%s SLAVE.BUS exists, but isn't a string!\n",
@@ -1047,6 +1161,7 @@ void	assign_bus_master(MAPDHASH &master, MAPDHASH *bus_master) {
 				// Replace the bus name with the bus hash
 				mbus->second.m_typ = MAPT_MAP;
 				mbus->second.u.m_m = bi->m_hash;
+				kvinvalidate();
 			}
 			reeval(master);
 		} free(cstr);
@@ -1065,6 +1180,7 @@ void	assign_bus_master(MAPDHASH &master, MAPDHASH *bus_master) {
 					&&(strp->compare(*bi->name())==0)) {
 			bi->merge(pname, mbus->second.u.m_m);
 			mbus->second.u.m_m = bi->m_hash;
+			kvinvalidate();
 		}
 	} else {
 		gbl_msg.error("%s MASTER.BUS exists, but isn't a string!\n",
@@ -1132,11 +1248,13 @@ void	BUSLIST::checkforbusdefns(STRINGP prefix, MAPDHASH *map, const STRING &key)
 					bname->c_str());
 			}
 			busp->second.u.m_m = bi->m_hash;
+			kvinvalidate();
 		} else if (busp->second.m_typ == MAPT_STRING) {
 			addbus(prefix, busp->second.u.m_s);
 			busp->second.m_typ = MAPT_MAP;
 			busp->second.u.m_m = find_bus(busp->second.u.m_s)->m_hash;
 			assert(busp->second.u.m_m);
+			kvinvalidate();
 		}
 	}
 }
@@ -1144,6 +1262,7 @@ void	BUSLIST::checkforbusdefns(STRINGP prefix, MAPDHASH *map, const STRING &key)
 bool	gbl_ready_for_address_assignment = false;
 void	build_bus_list(MAPDHASH &master) {
 	MAPDHASH::iterator	kvpair, kvaccess, kvsearch;
+	std::vector<MAPDHASH::iterator>	order;
 	BUSLIST	*bl = new BUSLIST;
 	STRINGP	str;
 
@@ -1209,6 +1328,7 @@ void	build_bus_list(MAPDHASH &master) {
 				assert((*bp)->m_hash->end() != kvclock);
 				kvclock->second.m_typ = MAPT_MAP;
 				kvclock->second.u.m_m = (*bp)->m_clock->m_hash;
+				kvinvalidate();
 			} else if (NULL != (map = getmap((*bp)->m_hash, KYCLOCK))) {
 				(*bp)->m_clock = getclockinfo(getstring(map, KY_NAME));
 				MAPDHASH::iterator kvclock;
@@ -1216,6 +1336,7 @@ void	build_bus_list(MAPDHASH &master) {
 				assert((*bp)->m_hash->end() != kvclock);
 				kvclock->second.m_typ = MAPT_MAP;
 				kvclock->second.u.m_m = (*bp)->m_clock->m_hash;
+				kvinvalidate();
 			} else {
 				gbl_msg.fatal("Bus %s has no defined clock\n",
 					(*bp)->name()->c_str());
@@ -1230,8 +1351,12 @@ void	build_bus_list(MAPDHASH &master) {
 		(*bp)->integrity_check();
 
 	//
-	//
-	for(kvpair=master.begin(); kvpair != master.end(); kvpair++) {
+	// The order slaves are added to each bus breaks any ties when
+	// assigning addresses.  Add them in the same (legacy) order as always,
+	// so that designs keep the addresses they've always had.
+	master.legacy_order(order);
+	for(unsigned k=0; k<order.size(); k++) {
+		kvpair = order[k];
 		if (isperipheral(kvpair->second))
 			bl->addperipheral(kvpair->second);
 		if (isbusmaster(kvpair->second))
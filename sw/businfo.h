@@ -44,6 +44,7 @@
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <unordered_map>
 
 class	BUSINFO;
 class	GENBUS;
@@ -167,7 +168,15 @@ public:
 };
 
 class	BUSLIST : public std::vector<BUSINFO *>	{
+	// Indexes into the list, by (interned) bus name and by bus hash.
+	// Every bus is indexed as it's added to the list, and again should
+	// it ever be renamed, so a bus the indexes don't know of isn't there.
+	std::unordered_map<const STRING *, BUSINFO *>	m_byname;
+	std::unordered_map<MAPDHASH *, BUSINFO *>	m_byhash;
+
+	void	index(BUSINFO *bi);
 public:
+	void	rename(BUSINFO *bi, STRINGP oldname);
 	BUSINFO *find_bus(STRINGP name);
 	BUSINFO *find_bus(MAPDHASH *hash);
 	unsigned	get_base_address(MAPDHASH *phash);
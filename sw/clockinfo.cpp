@@ -40,9 +40,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <vector>
+#include <unordered_map>
 #include "parser.h"
 #include "mapdhash.h"
 #include "keys.h"
+#include "kveval.h"
 #include "bldtestb.h"
 #include "legalnotice.h"
 #include "clockinfo.h"
@@ -54,6 +56,10 @@ const	unsigned long	CLOCKINFO::PICOSECONDS_PER_SECOND = 1000000000000ul;
 
 CLKLIST	cklist;
 
+// The position of each clock within cklist, by (interned) name.  Positions,
+// rather than pointers, since cklist may move as it grows.
+static	std::unordered_map<const STRING *, unsigned>	s_ckindex;
+
 CLOCKINFO::CLOCKINFO(void) {
 	m_hash  = new MAPDHASH();
 	m_name  = NULL;
@@ -64,17 +70,23 @@ CLOCKINFO::CLOCKINFO(void) {
 	m_interval_ps = UNKNOWN_PS;
 }
 
+// Add a new clock, with the given name, to the end of cklist
+static	CLOCKINFO *addclock(STRINGP name) {
+	unsigned	id = cklist.size();
+
+	cklist.push_back(CLOCKINFO());
+	cklist[id].setname(name);
+	s_ckindex.insert(std::make_pair(kvintern(*cklist[id].m_name), id));
+
+	return &cklist[id];
+}
+
 CLOCKINFO *CLOCKINFO::new_clock(STRINGP name) {
 	CLOCKINFO *ci;
 	if (NULL != (ci = getclockinfo(name)))
 		return ci;
 
-	unsigned	id = cklist.size();
-	cklist.push_back(CLOCKINFO());
-	ci = &cklist[id];
-	ci->setname(new STRING(*name));
-
-	return	ci;
+	return	addclock(new STRING(*name));
 }
 
 unsigned long CLOCKINFO::setfrequency(unsigned long frequency_hz) {
@@ -274,9 +286,10 @@ void	add_to_clklist(MAPDHASH *ckmap) {
 		// fprintf(stderr, "ERR: CLOCK has no frequency\n");
 
 	while(pname) {
-		unsigned	id = cklist.size();
 		unsigned long	clocks_per_second;
 		STRINGP		wname;
+		STRING		stok(pname);
+		CLOCKINFO	*known;
 		bool		already_defined = false;
 
 		gbl_msg.info("Examining clock: %s %s %s %s\n",
@@ -284,83 +297,79 @@ void	add_to_clklist(MAPDHASH *ckmap) {
 				(pfreq)?pfreq:"(Unspec)",
 				(ptop)?ptop:"(Unspec)");
 
-		for(unsigned i=0; i<id; i++) {
-			if (cklist[i].m_name->compare(pname)==0) {
-				//
-				// Update an existing clocks information
-				//
-				already_defined = true;
-				gbl_msg.info("Clock %s is already defined: %s %ld\n",
-						cklist[i].m_name->c_str(),
-						(cklist[i].m_wire)
-						  ? cklist[i].m_wire->c_str()
-						  : "(Unspec)",
-						cklist[i].m_interval_ps);
-
-				//
-				// Clock's wire name, such as i_clk
-				//
-				if ((pwire)&&(cklist[i].m_wire == NULL)) {
-					cklist[i].m_wire = new STRING(pwire);
-					gbl_msg.info("Clock %s\'s wire set to %s\n", pname, pwire);
-				} else if ((pwire)&&(cklist[i].m_wire->compare(pwire) != 0)) {
-					gbl_msg.error("Clock %s has a conflicting wire definition: %s and %s\n", pname, pwire, cklist[i].m_wire->c_str());
-				}
-
-				//
-				// Name of the top level incoming port, if
-				// present
-				//
-				if ((ptop)&&(cklist[i].m_top == NULL)) {
-					cklist[i].settop(new STRING(ptop));
-					gbl_msg.info("Clock\'s %s top-level wire set to %s\n", pname, ptop);
-				} else if ((ptop)&&(cklist[i].m_top->compare(ptop) != 0)) {
-					gbl_msg.error("Clock %s has a conflicting toplevel wire definition: %s and %s\n", pname, ptop, cklist[i].m_top->c_str());
-				}
+		if (NULL != (known = getclockinfo(stok))) {
+			unsigned	i = known - cklist.data();
+
+			//
+			// Update an existing clocks information
+			//
+			already_defined = true;
+			gbl_msg.info("Clock %s is already defined: %s %ld\n",
+					cklist[i].m_name->c_str(),
+					(cklist[i].m_wire)
+					  ? cklist[i].m_wire->c_str()
+					  : "(Unspec)",
+					cklist[i].m_interval_ps);
+
+			//
+			// Clock's wire name, such as i_clk
+			//
+			if ((pwire)&&(cklist[i].m_wire == NULL)) {
+				cklist[i].m_wire = new STRING(pwire);
+				gbl_msg.info("Clock %s\'s wire set to %s\n", pname, pwire);
+			} else if ((pwire)&&(cklist[i].m_wire->compare(pwire) != 0)) {
+				gbl_msg.error("Clock %s has a conflicting wire definition: %s and %s\n", pname, pwire, cklist[i].m_wire->c_str());
+			}
 
+			//
+			// Name of the top level incoming port, if
+			// present
+			//
+			if ((ptop)&&(cklist[i].m_top == NULL)) {
+				cklist[i].settop(new STRING(ptop));
+				gbl_msg.info("Clock\'s %s top-level wire set to %s\n", pname, ptop);
+			} else if ((ptop)&&(cklist[i].m_top->compare(ptop) != 0)) {
+				gbl_msg.error("Clock %s has a conflicting toplevel wire definition: %s and %s\n", pname, ptop, cklist[i].m_top->c_str());
+			}
 
-				//
-				// Name of the simulation class, if present
-				//
-				if ((psimclass)&&(cklist[i].m_simclass == NULL)) {
-					cklist[i].setclass(new STRING(psimclass));
-					gbl_msg.info("Clock %s\'s simulation class set to %s\n", pname, psimclass);
-				} else if ((psimclass)&&(cklist[i].m_simclass->compare(psimclass) != 0)) {
-					gbl_msg.error("Clock %s has a conflicting simulation class definition: %s and %s\n", pname, psimclass, cklist[i].m_simclass->c_str());
-				}
 
-				//
-				// Name of the associated reset wire, if any
-				//
-				if (preset) {
-					cklist[i].setreset(new STRING(preset));
-					gbl_msg.info("Clock %s\'s associated reset wire set to %s\n", pname, preset);
-				}
+			//
+			// Name of the simulation class, if present
+			//
+			if ((psimclass)&&(cklist[i].m_simclass == NULL)) {
+				cklist[i].setclass(new STRING(psimclass));
+				gbl_msg.info("Clock %s\'s simulation class set to %s\n", pname, psimclass);
+			} else if ((psimclass)&&(cklist[i].m_simclass->compare(psimclass) != 0)) {
+				gbl_msg.error("Clock %s has a conflicting simulation class definition: %s and %s\n", pname, psimclass, cklist[i].m_simclass->c_str());
+			}
 
+			//
+			// Name of the associated reset wire, if any
+			//
+			if (preset) {
+				cklist[i].setreset(new STRING(preset));
+				gbl_msg.info("Clock %s\'s associated reset wire set to %s\n", pname, preset);
+			}
 
-				//
-				// Set the clocks frequency
-				//
-				if ((pfreq)&&(cklist[i].interval_ps()==CLOCKINFO::UNKNOWN_PS)) {
-					clocks_per_second = strtoul(pfreq, NULL, 0);
-					gbl_msg.info("Setting %s clock frequency to %ld\n", pname, clocks_per_second);
-					cklist[i].setfrequency(
-							clocks_per_second);
-				} else if ((ifreq)&&(cklist[i].interval_ps() == CLOCKINFO::UNKNOWN_PS)) {
-					gbl_msg.info("Setting %s clock frequency to %u\n", pname, ifreq);
-					cklist[i].setfrequency(
-							(unsigned long)
-							((unsigned)ifreq));
-				}
 
-				break;
+			//
+			// Set the clocks frequency
+			//
+			if ((pfreq)&&(cklist[i].interval_ps()==CLOCKINFO::UNKNOWN_PS)) {
+				clocks_per_second = strtoul(pfreq, NULL, 0);
+				gbl_msg.info("Setting %s clock frequency to %ld\n", pname, clocks_per_second);
+				cklist[i].setfrequency(
+						clocks_per_second);
+			} else if ((ifreq)&&(cklist[i].interval_ps() == CLOCKINFO::UNKNOWN_PS)) {
+				gbl_msg.info("Setting %s clock frequency to %u\n", pname, ifreq);
+				cklist[i].setfrequency(
+						(unsigned long)
+						((unsigned)ifreq));
 			}
 		} if (!already_defined) {
 			CLOCKINFO	*cki;
 
-			cklist.push_back(CLOCKINFO());
-			cki = &cklist[id];
-			cki->setname(new STRING(pname));
+			cki = addclock(new STRING(pname));
 			if (pwire)
 				wname = new STRING(pwire);
 			else
@@ -419,15 +428,12 @@ fprintf(stderr, "preset != NULL\n");
 }
 
 CLOCKINFO	*getclockinfo(STRING &clock_name) {
-	CLKLIST::iterator	ckp;
+	std::unordered_map<const STRING *, unsigned>::iterator	ckp;
 
-	for(ckp = cklist.begin(); ckp != cklist.end(); ckp++) {
-		if (ckp->m_name->compare(clock_name)==0) {
-			CLOCKINFO	*ckresult;
-			ckresult = &(*ckp);
-			return ckresult;
-		}
-	} return NULL;
+	ckp = s_ckindex.find(kvintern(clock_name));
+	if (ckp == s_ckindex.end())
+		return NULL;
+	return &cklist[ckp->second];
 }
 
 CLOCKINFO	*getclockinfo(STRINGP clock_name) {
@@ -476,8 +482,10 @@ void	expand_clock(MAPDHASH &info) {
 	cki = getclockinfo(sname);
 
 	if (cki) {
-		if (cki->m_hash != kyclock->second.u.m_m)
+		if (cki->m_hash != kyclock->second.u.m_m) {
 			kyclock->second.u.m_m = cki->m_hash;
+			kvinvalidate();
+		}
 	}
 }
 
@@ -516,10 +524,11 @@ void	find_clocks(MAPDHASH &master) {
 	STRINGP		sclk;
 
 	sclk = new STRING("clk");
-	if (NULL == (cki = getclockinfo(new STRING("clk")))) {
-		cklist.push_back(CLOCKINFO());
+	if (NULL == (cki = getclockinfo(sclk))) {
 		// Default clock, if not given, is 100MHz
-		cklist[0].set(sclk, new STRING("i_clk"), 100000000ul);
+		cki = addclock(sclk);
+		cki->setwire(new STRING("i_clk"));
+		cki->setfrequency(100000000ul);
 	} else
 		delete sclk;
 
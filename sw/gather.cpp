@@ -76,10 +76,8 @@ void	gather_peripherals(APLIST *alist, BUSINFO *bus, PLIST *plist, unsigned base
 		if (!bus->get_base_address(ph, addr))
 			addr = 0;
 		alist->push_back((*plist)[k]);
-		if (addr+base != 0) {
+		if (addr+base != 0)
 			setvalue(*ph, KYREGBASE, addr+base);
-			reeval(gbl_hash);
-		}
 		(*plist)[k]->p_regbase = addr+base;
 		if (isarbiter(*ph)) {
 			BUSINFO	*subbus;
@@ -91,6 +89,10 @@ void	gather_peripherals(APLIST *alist, BUSINFO *bus, PLIST *plist, unsigned base
 		}
 	}
 
+	// Evaluate anything depending upon the register addresses just set,
+	// once for the whole bus rather than once per peripheral
+	reeval(gbl_hash);
+
 	// It's possible for things to move slightly.  Let's make sure their
 	//   base register address copy continues to match.
 	for(unsigned k=0; k<plist->size(); k++) {
@@ -139,6 +141,6 @@ APLIST *full_gather(void) {
 
         // Get the list of peripherals
         alist = gather_peripherals(bi);
-	sort(alist->begin(), alist->end(), compare_regaddr);
+	stable_sort(alist->begin(), alist->end(), compare_regaddr);
         return alist;
 }
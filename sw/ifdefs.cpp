@@ -51,6 +51,9 @@
 #include <stdlib.h>
 #include <string>
 #include <vector>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
 #include <algorithm>
 #include <string.h>
 #include <unistd.h>
@@ -63,15 +66,156 @@
 #include "keys.h"
 #include "kveval.h"
 #include "legalnotice.h"
+#include "msgs.h"
 
 extern	bool	isperipheral(MAPT &pmap);
 extern	bool	isperipheral(MAPDHASH &phash);
 
-void	build_access_ifdefs_v(MAPDHASH &master, FILE *fp) {
+typedef	std::unordered_set<STRING>	MACROSET;
+
+// A component having both @ACCESS and @DEPENDS tags
+typedef	struct	DEPNODE_S {
+	STRING			m_name;
+	// The macros this component defines (from @ACCESS), and the
+	// dependencies (from @DEPENDS) that must be known first, as given,
+	// with any leading '!'
+	std::vector<STRING>	m_access, m_deps;
+	// The number of distinct dependencies not yet known
+	unsigned		m_pending;
+	bool			m_done;
+} DEPNODE;
+
+// Split a list of macros, separated by commas or white space
+static	void	macrolist(const STRING &str, std::vector<STRING> &list) {
+	// {{{
 	const	char	DELIMITERS[] = ", \t\n";
+	char	*dup = strdup(str.c_str()), *tok, *save;
+
+	for(tok = strtok_r(dup, DELIMITERS, &save); tok;
+			tok = strtok_r(NULL, DELIMITERS, &save))
+		list.push_back(STRING(tok));
+	free(dup);
+}
+// }}}
+
+// Strip any leading '!' from a macro name
+static	STRING	baremacro(const STRING &macro) {
+	return (macro[0] == '!') ? macro.substr(1) : macro;
+}
+
+//
+// Define every macro in an @ACCESS list not already defined, noting any
+// newly defined in added.
+//
+static	void	define_access(FILE *fp, const std::vector<STRING> &access,
+		MACROSET &defined, std::vector<STRING> *added = NULL) {
+	// {{{
+	for(unsigned k=0; k<access.size(); k++) {
+		STRING	tok = baremacro(access[k]);
+
+		if (!defined.insert(tok).second)
+			continue;
+		fprintf(fp, "`define\t%s\n", tok.c_str());
+		if (added)
+			added->push_back(tok);
+	}
+}
+// }}}
+
+//
+// report_cycles
+// {{{
+// Any component left once every dependency that can be met has been met
+// either depends on a macro no component defines, or lies on a cycle of
+// components, each waiting on the next.  Walk the components left over, and
+// warn of every such cycle found.  Components found on a cycle are marked in
+// oncycle.
+//
+static	void	report_cycles(std::vector<DEPNODE> &nodes,
+		const MACROSET &defined,
+		std::unordered_map<STRING, std::vector<unsigned> > &providers,
+		std::vector<bool> &oncycle) {
+	// Color: 0, not yet visited; 1, on the current path; 2, finished
+	std::vector<int>	color(nodes.size(), 0);
+	std::vector<unsigned>	path;
+
+	oncycle.assign(nodes.size(), false);
+
+	// The components a left over component is waiting on
+	auto	waiting_on = [&](unsigned n, std::vector<unsigned> &succ) {
+		succ.clear();
+		for(unsigned d=0; d<nodes[n].m_deps.size(); d++) {
+			STRING	bare = baremacro(nodes[n].m_deps[d]);
+
+			if (defined.count(bare))
+				continue;
+			std::unordered_map<STRING, std::vector<unsigned> >
+				::iterator	p = providers.find(bare);
+			if (p == providers.end())
+				continue;
+			for(unsigned k=0; k<p->second.size(); k++)
+				if (!nodes[p->second[k]].m_done)
+					succ.push_back(p->second[k]);
+		}
+	};
+
+	for(unsigned root=0; root<nodes.size(); root++) {
+		// Each entry of the stack is a component, together with those
+		// components it is waiting on not yet searched
+		std::vector<std::pair<unsigned, std::vector<unsigned> > > stack;
+
+		if ((nodes[root].m_done)||(color[root] != 0))
+			continue;
+
+		stack.push_back(std::make_pair(root, std::vector<unsigned>()));
+		waiting_on(root, stack.back().second);
+		color[root] = 1;
+		path.push_back(root);
+
+		while(!stack.empty()) {
+			std::vector<unsigned>	&succ = stack.back().second;
+
+			if (succ.empty()) {
+				color[stack.back().first] = 2;
+				stack.pop_back();
+				path.pop_back();
+				continue;
+			}
+
+			unsigned	next = succ.back();
+			succ.pop_back();
+
+			if (color[next] == 1) {
+				// Found a cycle: from next, along the path, and
+				// back to next again
+				STRING	msg;
+				unsigned	k = path.size();
+
+				while(path[k-1] != next)
+					k--;
+				for(k=k-1; k<path.size(); k++) {
+					oncycle[path[k]] = true;
+					msg += nodes[path[k]].m_name + " -> ";
+				}
+				msg += nodes[next].m_name;
+				gbl_msg.warning("Circular @DEPENDS: %s\n",
+					msg.c_str());
+			} else if (color[next] == 0) {
+				color[next] = 1;
+				path.push_back(next);
+				stack.push_back(std::make_pair(next,
+						std::vector<unsigned>()));
+				waiting_on(next, stack.back().second);
+			}
+		}
+	}
+}
+// }}}
+
+void	build_access_ifdefs_v(MAPDHASH &master, FILE *fp) {
 	MAPDHASH::iterator	kvpair;
-	STRING		already_defined;
-	MAPDHASH	dephash;
+	MACROSET		defined;
+	std::vector<DEPNODE>	nodes;
 
 	fprintf(fp,
 "//\n"
@@ -85,67 +229,47 @@ void	build_access_ifdefs_v(MAPDHASH &master, FILE *fp) {
 "// components.  If a component doesn\'t have an @ACCESS tag, it will not\n"
 "// be listed here.\n"
 "//\n");
-	fprintf(fp, "// First, the independent access fields for any bus masters\n");
-	// {{{
-	for(kvpair=master.begin(); kvpair != master.end(); kvpair++) {
-		if (kvpair->second.m_typ != MAPT_MAP)
-			continue;
-		if (isperipheral(kvpair->second))
-			continue;
-		STRINGP	dep, accessp;
-		dep = getstring(*kvpair->second.u.m_m, KYDEPENDS);
-		accessp = getstring(*kvpair->second.u.m_m, KYACCESS);
-		if (NULL == accessp)
-			continue;
-		if (NULL != dep) {
-			dephash.insert(*kvpair);
-		} else {
-			char *dup = strdup(accessp->c_str());
-			char *tok = strtok(dup, DELIMITERS);
-
-			while(tok != NULL) {
-				if (tok[0] == '!')
-					tok++;
-				fprintf(fp, "`define\t%s\n", tok);
-				already_defined = already_defined
-							+ " " + STRING(tok);
-				tok = strtok(NULL, DELIMITERS);
-			} free(dup);
-		}
-	}
-	// }}}
 
-	fprintf(fp, "// And then for the independent peripherals\n");
-	// {{{
-	for(kvpair=master.begin(); kvpair != master.end(); kvpair++) {
-		if (kvpair->second.m_typ != MAPT_MAP)
-			continue;
-		if (!isperipheral(kvpair->second))
-			continue;
-		STRINGP	dep, accessp;
-		dep = getstring(kvpair->second, KYDEPENDS);
-		accessp = getstring(kvpair->second, KYACCESS);
-		if (NULL == accessp)
-			continue;
-		else if (NULL != dep) {
-			dephash.insert(*kvpair);
-		} else {
-			char *dup = strdup(accessp->c_str());
-			char *tok = strtok(dup, DELIMITERS);
-
-			while(tok != NULL) {
-				if (tok[0] == '!')
-					tok++;
-				fprintf(fp, "`define\t%s\n", tok);
-				already_defined = already_defined
-							+ " " + STRING(tok);
-				tok = strtok(NULL, DELIMITERS);
-			} free(dup);
+	// Every component with an @ACCESS tag either defines its macros
+	// outright, or (with a @DEPENDS tag) becomes a node in our dependency
+	// graph.  Bus masters first, then peripherals.
+	for(int pass=0; pass<2; pass++) {
+		// {{{
+		if (pass == 0)
+			fprintf(fp, "// First, the independent access fields for any bus masters\n");
+		else
+			fprintf(fp, "// And then for the independent peripherals\n");
+
+		for(kvpair=master.begin(); kvpair != master.end(); kvpair++) {
+			if (kvpair->second.m_typ != MAPT_MAP)
+				continue;
+			if (isperipheral(kvpair->second) != (pass != 0))
+				continue;
+			STRINGP	dep, accessp;
+			dep = getstring(*kvpair->second.u.m_m, KYDEPENDS);
+			accessp = getstring(*kvpair->second.u.m_m, KYACCESS);
+			if (NULL == accessp)
+				continue;
+
+			DEPNODE	node;
+			node.m_name = kvpair->first;
+			node.m_pending = 0;
+			node.m_done = false;
+			macrolist(*accessp, node.m_access);
+
+			if (NULL != dep) {
+				macrolist(*dep, node.m_deps);
+				nodes.push_back(node);
+			} else
+				define_access(fp, node.m_access, defined);
 		}
+		// }}}
 	}
-	// }}}
 
-	if (dephash.begin() != dephash.end()) {
+	// Which components define each macro, and which are waiting on it
+	std::unordered_map<STRING, std::vector<unsigned> > providers, waiters;
+
+	if (nodes.size() > 0) {
 		fprintf(fp, "//\n//\n// The list of those things that have @DEPENDS tags\n//\n//\n");
 		fprintf(fp,
 "//\n"
@@ -155,167 +279,119 @@ void	build_access_ifdefs_v(MAPDHASH &master, FILE *fp) {
 "// being defined only if all of the ifdef\'s are true"
 "//\n");
 		// {{{
+		// Components whose every dependency is known, by position,
+		// so that the first (in design order) is always defined first
+		std::set<unsigned>	ready;
 
-		bool	done;
-		do {
-			done = true;
-			STRING	depstr, endstr;
+		for(unsigned n=0; n<nodes.size(); n++) {
+			MACROSET	seen;
 
-			for(kvpair=dephash.begin(); kvpair != dephash.end(); kvpair++) {
-				// {{{
-				if (kvpair->second.m_typ != MAPT_MAP)
-					continue;
-				STRINGP	dep, accessp;
-				dep = getstring(kvpair->second, KYDEPENDS);
-				accessp = getstring(kvpair->second, KYACCESS);
-
-
-				bool	depsmet = true;
-				char	*deplist, *dependency;
-				deplist = strdup(dep->c_str());
-
-				depstr = "";
-				endstr = "";
-				fprintf(fp, "// Deplist for @$(PREFIX)=%s\n", kvpair->first.c_str());
-				dependency = strtok(deplist, DELIMITERS);
-				while(dependency) {
-					char	*rawdep, *baredep;
-
-					rawdep = dependency;
-					baredep = rawdep;
-					if (rawdep[0] == '!')
-						baredep = rawdep+1;
-					STRING	mstr = STRING(" ")+STRING(baredep)
-						+STRING(" ");
-					if (NULL == strstr(already_defined.c_str(),
-							baredep)) {
-						// fprintf(fp, "// -- Dependency not met: %s\n", baredep);
-						depsmet = false;
-						break;
-					}
-
-					if (rawdep[0] == '!') {
-						depstr += STRING("`ifndef\t")
-							+ STRING(baredep)
-							+ STRING("\n");
-					} else {
-						depstr += STRING("`ifdef\t")
-							+ STRING(rawdep)
-							+ STRING("\n");
-					}
-					endstr = STRING("`endif\t// ")
-						+ STRING(rawdep)
-						+ STRING("\n")
-						+ endstr;
-					dependency = strtok(NULL, DELIMITERS);
-				}
+			for(unsigned k=0; k<nodes[n].m_access.size(); k++)
+				providers[baremacro(nodes[n].m_access[k])]
+					.push_back(n);
+			for(unsigned k=0; k<nodes[n].m_deps.size(); k++) {
+				STRING	bare = baremacro(nodes[n].m_deps[k]);
 
+				if ((defined.count(bare))
+						||(!seen.insert(bare).second))
+					continue;
+				waiters[bare].push_back(n);
+				nodes[n].m_pending++;
+			}
 
-				if (depsmet) {
-					char *dup = strdup(accessp->c_str());
-					char *tok = strtok(dup, DELIMITERS);
-
-					fprintf(fp, "%s", depstr.c_str());
-					while(tok != NULL) {
-						if (tok[0] == '!')
-							tok++;
-						if (NULL == strstr(already_defined.c_str(), tok)) {
-							fprintf(fp, "`define\t%s\n", tok);
-							already_defined = already_defined
-								+ " " + STRING(tok);
+			if (nodes[n].m_pending == 0)
+				ready.insert(n);
+		}
 
-							// We changed something, so ...
-							done = false;
-						}
-						tok = strtok(NULL, DELIMITERS);
-					} free(dup);
+		while(!ready.empty()) {
+			unsigned	n = *ready.begin();
+			DEPNODE		&node = nodes[n];
+			STRING		endstr;
+			std::vector<STRING>	added;
+
+			ready.erase(ready.begin());
+			node.m_done = true;
+
+			fprintf(fp, "// Deplist for @$(PREFIX)=%s\n",
+				node.m_name.c_str());
+			for(unsigned k=0; k<node.m_deps.size(); k++) {
+				const STRING	&rawdep = node.m_deps[k];
+
+				if (rawdep[0] == '!')
+					fprintf(fp, "`ifndef\t%s\n",
+						rawdep.c_str()+1);
+				else
+					fprintf(fp, "`ifdef\t%s\n",
+						rawdep.c_str());
+				endstr = STRING("`endif\t// ") + rawdep
+						+ STRING("\n") + endstr;
+			}
 
-					fprintf(fp, "%s", endstr.c_str());
+			define_access(fp, node.m_access, defined, &added);
+			fprintf(fp, "%s", endstr.c_str());
 
-					dephash.erase(kvpair);
-					kvpair = dephash.begin();
-					if (kvpair == dephash.end())
-						break;
+			// Anything waiting on a macro just defined is now one
+			// step closer to being defined itself
+			for(unsigned k=0; k<added.size(); k++) {
+				std::unordered_map<STRING, std::vector<unsigned> >
+					::iterator	w = waiters.find(added[k]);
+				if (w == waiters.end())
+					continue;
+				for(unsigned j=0; j<w->second.size(); j++) {
+					if (0 == --nodes[w->second[j]].m_pending)
+						ready.insert(w->second[j]);
 				}
-				// }}}
 			}
-
-			if (dephash.begin() == dephash.end())
-				done = true;
-		} while(!done);
+		}
 		// }}}
 	}
 
-	if (dephash.begin() != dephash.end()) {
+	std::vector<bool>	oncycle;
+	bool			unmet = false;
+
+	for(unsigned n=0; n<nodes.size(); n++)
+		if (!nodes[n].m_done)
+			unmet = true;
+
+	if (unmet) {
+		report_cycles(nodes, defined, providers, oncycle);
+
 		fprintf(fp,
 "//\n"
 "// The following macros have unmet dependencies.  They are listed\n"
 "// here for reference, but their dependencies cannot be met.\n");
 		// {{{
-
-		for(kvpair=dephash.begin(); kvpair != dephash.end(); kvpair++) {
-			const char	DELIMITERS[] = ", \t\n";
-			if (kvpair->second.m_typ != MAPT_MAP)
-				continue;
-			STRINGP	dep, accessp;
-			dep = getstring(kvpair->second, KYDEPENDS);
-			accessp = getstring(kvpair->second, KYACCESS);
-
-
-			char	*deplist, *dependency;
-			deplist = strdup(dep->c_str());
-
+		for(unsigned n=0; n<nodes.size(); n++) {
+			const DEPNODE	&node = nodes[n];
 			STRING	depstr, endstr;
 
-			depstr = "";
-			endstr = "";
+			if (node.m_done)
+				continue;
 
 			fprintf(fp,
 				"// Unmet Dependency list for @$(PREFIX)=%s\n",
-				kvpair->first.c_str());
-
-			dependency = strtok(deplist, DELIMITERS);
-			while(dependency) {
-				const char *baredep = dependency;
-				bool		defined = false;
-
-				if (baredep[0] == '!')
-					baredep++;
-
-				if (NULL != strstr(already_defined.c_str(), baredep))
-					defined = true;
-
-				if (dependency[0] == '!') {
-					depstr += STRING("`ifndef\t")
-						+STRING(baredep);
-					if (!defined)
-						depstr += " // This value is unknown";
-					depstr += STRING("\n");
-				} else {
-					depstr += STRING("`ifdef\t")
-						+STRING(baredep);
-					if (!defined)
-						depstr += " // This value is unknown";
-					depstr += STRING("\n");
-				}
+				node.m_name.c_str());
+			if (oncycle[n])
+				fprintf(fp, "// (%s depends upon itself, through a circular chain of @DEPENDS)\n",
+					node.m_name.c_str());
+
+			for(unsigned k=0; k<node.m_deps.size(); k++) {
+				STRING	bare = baremacro(node.m_deps[k]);
+
+				if (node.m_deps[k][0] == '!')
+					depstr += STRING("`ifndef\t") + bare;
+				else
+					depstr += STRING("`ifdef\t") + bare;
+				if (!defined.count(bare))
+					depstr += " // This value is unknown";
+				depstr += STRING("\n");
 				endstr += STRING("`endif\n");
-				dependency = strtok(NULL, DELIMITERS);
 			}
 
 			fprintf(fp, "%s", depstr.c_str());
-
-			{
-				char *dup = strdup(accessp->c_str());
-				char *tok = strtok(dup, DELIMITERS);
-
-				while(tok != NULL) {
-					if (tok[0] == '!')
-						tok++;
-					fprintf(fp, "`define\t%s\n", tok);
-					tok = strtok(NULL, DELIMITERS);
-				} free(dup);
-			}
-
+			for(unsigned k=0; k<node.m_access.size(); k++)
+				fprintf(fp, "`define\t%s\n",
+					baremacro(node.m_access[k]).c_str());
 			fprintf(fp, "%s\n", endstr.c_str());
 		}
 		// }}}
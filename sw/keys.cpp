@@ -42,34 +42,34 @@
 // }}}
 #include "keys.h"
 
-const	STRING	KYLEGAL=	"LEGAL";
-const	STRING	KYCOPYRIGHT=	"COPYRIGHT";	// Another name for LEGAL
-const	STRING	KYCMDLINE=	"CMDLINE";
-const	STRING	KYSUBD=		"SUBD";
-const	STRING	KYPATH=		"PATH";
-// const	STRING	KYBUS_ADDRESS_WIDTH="BUS_ADDRESS_WIDTH";
-const	STRING	KYRESET_ADDRESS	="RESET_ADDRESS";
+const	KEYPATH	KYLEGAL=	"LEGAL";
+const	KEYPATH	KYCOPYRIGHT=	"COPYRIGHT";	// Another name for LEGAL
+const	KEYPATH	KYCMDLINE=	"CMDLINE";
+const	KEYPATH	KYSUBD=		"SUBD";
+const	KEYPATH	KYPATH=		"PATH";
+// const	KEYPATH	KYBUS_ADDRESS_WIDTH="BUS_ADDRESS_WIDTH";
+const	KEYPATH	KYRESET_ADDRESS	="RESET_ADDRESS";
 // For subclassing
-const	STRING	KYPLUSDOT	="+";
-const	STRING	KYINCLUDE	="INCLUDE";
-const	STRING	KYINCLUDEFILE	="INCLUDEFILE";
+const	KEYPATH	KYPLUSDOT	="+";
+const	KEYPATH	KYINCLUDE	="INCLUDE";
+const	KEYPATH	KYINCLUDEFILE	="INCLUDEFILE";
 // Other global keys
-const	STRING	KYREGDEFS_CPP_INCLUDE	="REGDEFS.CPP.INCLUDE";
-const	STRING	KYREGDEFS_CPP_INSERT	="REGDEFS.CPP.INSERT";
-const	STRING	KYKEYS_TRIMLIST	="KEYS.TRIMLIST";
-const	STRING	KYKEYS_INTLIST	="KEYS.INTLIST";
-const	STRING	KYPROJECT	="PROJECT";
-//
-const	STRING	KYSIO=		"sio";
-const	STRING	KYDIO=		"dio";
-const	STRING	KYSIO_SEL=	"sio_sel";
-const	STRING	KYDIO_SEL=	"dio_sel";
-//
-const	STRING	KYPREFIX=	"PREFIX";
-const	STRING	KYACCESS=	"ACCESS";
-const	STRING	KYDEPENDS=	"DEPENDS";
-const	STRING	KYERROR_WIRE=	"ERROR.WIRE";
-const	STRING	KYSLAVE=		"SLAVE",
+const	KEYPATH	KYREGDEFS_CPP_INCLUDE	="REGDEFS.CPP.INCLUDE";
+const	KEYPATH	KYREGDEFS_CPP_INSERT	="REGDEFS.CPP.INSERT";
+const	KEYPATH	KYKEYS_TRIMLIST	="KEYS.TRIMLIST";
+const	KEYPATH	KYKEYS_INTLIST	="KEYS.INTLIST";
+const	KEYPATH	KYPROJECT	="PROJECT";
+//
+const	KEYPATH	KYSIO=		"sio";
+const	KEYPATH	KYDIO=		"dio";
+const	KEYPATH	KYSIO_SEL=	"sio_sel";
+const	KEYPATH	KYDIO_SEL=	"dio_sel";
+//
+const	KEYPATH	KYPREFIX=	"PREFIX";
+const	KEYPATH	KYACCESS=	"ACCESS";
+const	KEYPATH	KYDEPENDS=	"DEPENDS";
+const	KEYPATH	KYERROR_WIRE=	"ERROR.WIRE";
+const	KEYPATH	KYSLAVE=		"SLAVE",
 		KYSLAVE_TYPE=		"SLAVE.TYPE",
 		KYSLAVE_BUS=		"SLAVE.BUS",
 		KYSLAVE_BUS_NAME=	"SLAVE.BUS.NAME",
@@ -81,8 +81,9 @@ const	STRING	KYSLAVE=		"SLAVE",
 		KYSLAVE_ANSIPORTLIST=	"SLAVE.ANSIPORTLIST",
 		KYSLAVE_IANSI=		"SLAVE.IANSI",
 		KYSLAVE_OANSI=		"SLAVE.OANSI",
-		KYSLAVE_ANSPREFIX=	"SLAVE.ANSPREFIX";
-const	STRING	KYMASTER=	"MASTER",
+		KYSLAVE_ANSPREFIX=	"SLAVE.ANSPREFIX",
+		KYSLAVE_BASE=		"SLAVE.BASE";
+const	KEYPATH	KYMASTER=	"MASTER",
 		KYMASTER_TYPE=	"MASTER.TYPE",
 		KYMASTER_BUS=	"MASTER.BUS",
 		KYMASTER_BUS_NAME=	"MASTER.BUS.NAME",
@@ -97,134 +98,136 @@ const	STRING	KYMASTER=	"MASTER",
 		KYMASTER_ANSPREFIX=     "MASTER.ANSPREFIX";
 // Types of bus masters
 // KYBUS, and ...
-const	STRING	KYSUBBUS=	"SUBBUS",
+const	KEYPATH	KYSUBBUS=	"SUBBUS",
 		KYARBITER=	"ARBITER",
 		KYXCLOCK=	"XCLOCK",
 		KYHOST=		"HOST",
 		KYCPU=		"CPU";
 //
-const	STRING	KYBASE=		"BASE";
-const	STRING	KYREGBASE=	"REGBASE";
-const	STRING	KYNADDR=	"NADDR";
-const	STRING	KYMASK=		"MASK";
-//
-const	STRING	KYEXPR=		"EXPR";
-const	STRING	KYVAL=		"VAL";
-const	STRING	KYFORMAT=	"FORMAT";
-const	STRING	KYSTR=		"STR";
-//
-const	STRING	KYSCOPE=	"SCOPE";
-const	STRING	KYMEMORY=	"MEMORY";
-const	STRING	KYSINGLE=	"SINGLE";
-const	STRING	KYDOUBLE=	"DOUBLE";
-const	STRING	KYOTHER=	"OTHER";
+const	KEYPATH	KYBASE=		"BASE";
+const	KEYPATH	KYREGBASE=	"REGBASE";
+const	KEYPATH	KYNADDR=	"NADDR";
+const	KEYPATH	KYMASK=		"MASK";
+//
+const	KEYPATH	KYEXPR=		"EXPR";
+const	KEYPATH	KYVAL=		"VAL";
+const	KEYPATH	KYFORMAT=	"FORMAT";
+const	KEYPATH	KYSTR=		"STR";
+//
+const	KEYPATH	KYSCOPE=	"SCOPE";
+const	KEYPATH	KYMEMORY=	"MEMORY";
+const	KEYPATH	KYSINGLE=	"SINGLE";
+const	KEYPATH	KYDOUBLE=	"DOUBLE";
+const	KEYPATH	KYOTHER=	"OTHER";
 // Numbers of things
-const	STRING	KYNP=		"NP";
-const	STRING	KYNPIC=		"NPIC";
-const	STRING	KYNPSINGLE=	"NPSINGLE";
-const	STRING	KYNPDOUBLE=	"NPDOUBLE";
-const	STRING	KYNPMEMORY=	"NPMEMORY";
-const	STRING	KYNSCOPES=	"NSCOPES";
+const	KEYPATH	KYNP=		"NP";
+const	KEYPATH	KYNPIC=		"NPIC";
+const	KEYPATH	KYNPSINGLE=	"NPSINGLE";
+const	KEYPATH	KYNPDOUBLE=	"NPDOUBLE";
+const	KEYPATH	KYNPMEMORY=	"NPMEMORY";
+const	KEYPATH	KYNSCOPES=	"NSCOPES";
 // Regs definitions
-const	STRING	KYREGS_N=	"REGS.N";
-const	STRING	KYREGS_NOTE=	"REGS.NOTE";
-const	STRING	KYREGDEFS_H_INCLUDE="REGDEFS.H.INCLUDE";
-const	STRING	KYREGDEFS_H_DEFNS="REGDEFS.H.DEFNS";
-const	STRING	KYREGDEFS_H_INSERT="REGDEFS.H.INSERT";
+const	KEYPATH	KYREGS_N=	"REGS.N";
+const	KEYPATH	KYREGS_NOTE=	"REGS.NOTE";
+const	KEYPATH	KYREGDEFS_H_INCLUDE="REGDEFS.H.INCLUDE";
+const	KEYPATH	KYREGDEFS_H_DEFNS="REGDEFS.H.DEFNS";
+const	KEYPATH	KYREGDEFS_H_INSERT="REGDEFS.H.INSERT";
 // Board defintions for C/C++
-const	STRING	KYBDEF_INCLUDE=	"BDEF.INCLUDE";
-const	STRING	KYBDEF_DEFN=	"BDEF.DEFN";
-const	STRING	KYBDEF_IOTYPE=	"BDEF.IOTYPE";
-const	STRING	KYBDEF_OSDEF=	"BDEF.OSDEF";
-const	STRING	KYBDEF_OSVAL=	"BDEF.OSVAL";
-const	STRING	KYBDEF_INSERT=	"BDEF.INSERT";
+const	KEYPATH	KYBDEF_INCLUDE=	"BDEF.INCLUDE";
+const	KEYPATH	KYBDEF_DEFN=	"BDEF.DEFN";
+const	KEYPATH	KYBDEF_IOTYPE=	"BDEF.IOTYPE";
+const	KEYPATH	KYBDEF_OSDEF=	"BDEF.OSDEF";
+const	KEYPATH	KYBDEF_OSVAL=	"BDEF.OSVAL";
+const	KEYPATH	KYBDEF_INSERT=	"BDEF.INSERT";
 // Top definitions
-const	STRING	KYTOP_PORTLIST=	"TOP.PORTLIST";
-const	STRING	KYTOP_IODECL=	"TOP.IODECL";
-const	STRING	KYTOP_PARAM=	"TOP.PARAM";
-const	STRING	KYTOP_DEFNS=	"TOP.DEFNS";
-const	STRING	KYTOP_MAIN=	"TOP.MAIN";
-const	STRING	KYTOP_INSERT=	"TOP.INSERT";
+const	KEYPATH	KYTOP_PORTLIST=	"TOP.PORTLIST";
+const	KEYPATH	KYTOP_IODECL=	"TOP.IODECL";
+const	KEYPATH	KYTOP_PARAM=	"TOP.PARAM";
+const	KEYPATH	KYTOP_DEFNS=	"TOP.DEFNS";
+const	KEYPATH	KYTOP_MAIN=	"TOP.MAIN";
+const	KEYPATH	KYTOP_INSERT=	"TOP.INSERT";
 // Main definitions
-const	STRING	KYMAIN_INCLUDE= "MAIN.INCLUDE";
-const	STRING	KYMAIN_PORTLIST="MAIN.PORTLIST";
-const	STRING	KYMAIN_IODECL=	"MAIN.IODECL";
-const	STRING	KYMAIN_PARAM=	"MAIN.PARAM";
-const	STRING	KYMAIN_DEFNS=	"MAIN.DEFNS";
-const	STRING	KYMAIN_INSERT=	"MAIN.INSERT";
-const	STRING	KYMAIN_ALT=	"MAIN.ALT";
+const	KEYPATH	KYMAIN_INCLUDE= "MAIN.INCLUDE";
+const	KEYPATH	KYMAIN_PORTLIST="MAIN.PORTLIST";
+const	KEYPATH	KYMAIN_IODECL=	"MAIN.IODECL";
+const	KEYPATH	KYMAIN_PARAM=	"MAIN.PARAM";
+const	KEYPATH	KYMAIN_DEFNS=	"MAIN.DEFNS";
+const	KEYPATH	KYMAIN_INSERT=	"MAIN.INSERT";
+const	KEYPATH	KYMAIN_ALT=	"MAIN.ALT";
 // LD definitions
-const	STRING	KYLD_FILE=	"LD.FILE";
-const	STRING	KYLD_SCRIPT=	"LD.SCRIPT";
-const	STRING	KYLD_ENTRY=	"LD.ENTRY";
-const	STRING	KYLD_NAME=	"LD.NAME";
-const	STRING	KYLD_PERM=	"LD.PERM";
-const	STRING	KYLD_DEFNS=	"LD.DEFNS";
-const	STRING	KYSCRIPT=	"SCRIPT";
-const	STRING	KYFLASH=	"flash";
+const	KEYPATH	KYLD_FILE=	"LD.FILE";
+const	KEYPATH	KYLD_SCRIPT=	"LD.SCRIPT";
+const	KEYPATH	KYLD_ENTRY=	"LD.ENTRY";
+const	KEYPATH	KYLD_NAME=	"LD.NAME";
+const	KEYPATH	KYLD_PERM=	"LD.PERM";
+const	KEYPATH	KYLD_DEFNS=	"LD.DEFNS";
+const	KEYPATH	KYSCRIPT=	"SCRIPT";
+const	KEYPATH	KYFLASH=	"flash";
 // XDC/UCF definitions
-const	STRING	KYXDC_FILE=	"XDC.FILE";
-const	STRING	KYXDC_INSERT=	"XDC.INSERT";
-const	STRING	KYPCF_FILE=	"PCF.FILE";
-const	STRING	KYPCF_INSERT=	"PCF.INSERT";
-const	STRING	KYLPF_FILE=	"LPF.FILE";
-const	STRING	KYLPF_INSERT=	"LPF.INSERT";
-const	STRING	KYUCF_FILE=	"UCF.FILE";
-const	STRING	KYUCF_INSERT=	"UCF.INSERT";
+const	KEYPATH	KYXDC_FILE=	"XDC.FILE";
+const	KEYPATH	KYXDC_INSERT=	"XDC.INSERT";
+const	KEYPATH	KYPCF_FILE=	"PCF.FILE";
+const	KEYPATH	KYPCF_INSERT=	"PCF.INSERT";
+const	KEYPATH	KYLPF_FILE=	"LPF.FILE";
+const	KEYPATH	KYLPF_INSERT=	"LPF.INSERT";
+const	KEYPATH	KYUCF_FILE=	"UCF.FILE";
+const	KEYPATH	KYUCF_INSERT=	"UCF.INSERT";
 // INT definitions
-const	STRING	KY_INT=		"INT";
-const	STRING	KYINTLIST=	"INTLIST";
-const	STRING	KY_WIRE=	"WIRE";
-const	STRING	KY_DOTWIRE=	".WIRE";
-const	STRING	KY_ID=		"ID";
+const	KEYPATH	KY_INT=		"INT";
+const	KEYPATH	KYINTLIST=	"INTLIST";
+const	KEYPATH	KY_WIRE=	"WIRE";
+const	KEYPATH	KY_DOTWIRE=	".WIRE";
+const	KEYPATH	KY_ID=		"ID";
 // Arbitrary output data files
-const	STRING	KYOUT_FILE=	"OUT.FILE";
-const	STRING	KYOUT_DATA=	"OUT.DATA";
+const	KEYPATH	KYOUT_FILE=	"OUT.FILE";
+const	KEYPATH	KYOUT_DATA=	"OUT.DATA";
 // RTL/Makefile definitions
-const	STRING	KYRTL_MAKE_GROUP= "RTL.MAKE.GROUP";
-const	STRING	KYRTL_MAKE_SUBD=  "RTL.MAKE.SUBD";
-const	STRING	KYVFLIST=	  "VFLIST";
-const	STRING	KYRTL_MAKE_VDIRS= "RTL.MAKE.VDIRS";
-const	STRING	KYRTL_MAKE_FILES= "RTL.MAKE.FILES";
-const	STRING	KYAUTOVDIRS=	  "AUTOVDIRS";
+const	KEYPATH	KYRTL_MAKE_GROUP= "RTL.MAKE.GROUP";
+const	KEYPATH	KYRTL_MAKE_SUBD=  "RTL.MAKE.SUBD";
+const	KEYPATH	KYVFLIST=	  "VFLIST";
+const	KEYPATH	KYRTL_MAKE_VDIRS= "RTL.MAKE.VDIRS";
+const	KEYPATH	KYRTL_MAKE_FILES= "RTL.MAKE.FILES";
+const	KEYPATH	KYAUTOVDIRS=	  "AUTOVDIRS";
 // PIC definitions
-const	STRING	KYPIC=		"PIC";
-const	STRING	KYPIC_BUS=	"PIC.BUS";
-const	STRING	KYPIC_MAX=	"PIC.MAX";
+const	KEYPATH	KYPIC=		"PIC";
+const	KEYPATH	KYPIC_BUS=	"PIC.BUS";
+const	KEYPATH	KYPIC_MAX=	"PIC.MAX";
 // Cache information
-const	STRING	KYCACHABLE_FILE="CACHABLE.FILE";
+const	KEYPATH	KYCACHABLE_FILE="CACHABLE.FILE";
+const	KEYPATH	KYCACHABLE_REGISTERED="CACHABLE.REGISTERED";
 // SIM definitions
-const	STRING	KYSIM_INCLUDE=	"SIM.INCLUDE";
-const	STRING	KYSIM_DEFINES=	"SIM.DEFINES";
-const	STRING	KYSIM_DEFNS=	"SIM.DEFNS";
-const	STRING	KYSIM_PREINITIAL="SIM.PREINITIAL";
-const	STRING	KYSIM_INIT=	"SIM.INIT";
-const	STRING	KYSIM_CLOCK=	"SIM.CLOCK";
-const	STRING	KYSIM_TICK=	"SIM.TICK";
-const	STRING	KYSIM_SETRESET=	"SIM.SETRESET";
-const	STRING	KYSIM_CLRRESET=	"SIM.CLRRESET";
-const	STRING	KYSIM_DBGCONDITION=	"SIM.DBGCONDITION";
-const	STRING	KYSIM_DEBUG=	"SIM.DEBUG";
-const	STRING	KYSIM_LOAD=	"SIM.LOAD";
-const	STRING	KYSIM_METHODS=	"SIM.METHODS";
+const	KEYPATH	KYSIM_INCLUDE=	"SIM.INCLUDE";
+const	KEYPATH	KYSIM_DEFINES=	"SIM.DEFINES";
+const	KEYPATH	KYSIM_DEFNS=	"SIM.DEFNS";
+const	KEYPATH	KYSIM_PREINITIAL="SIM.PREINITIAL";
+const	KEYPATH	KYSIM_INIT=	"SIM.INIT";
+const	KEYPATH	KYSIM_CLOCK=	"SIM.CLOCK";
+const	KEYPATH	KYSIM_TICK=	"SIM.TICK";
+const	KEYPATH	KYSIM_SETRESET=	"SIM.SETRESET";
+const	KEYPATH	KYSIM_CLRRESET=	"SIM.CLRRESET";
+const	KEYPATH	KYSIM_DBGCONDITION=	"SIM.DBGCONDITION";
+const	KEYPATH	KYSIM_DEBUG=	"SIM.DEBUG";
+const	KEYPATH	KYSIM_LOAD=	"SIM.LOAD";
+const	KEYPATH	KYSIM_METHODS=	"SIM.METHODS";
+const	KEYPATH	KYSIM_TRACE_FLUSH=	"SIM.TRACE.FLUSH";
 // SIM/Makefile definitions
-// const	STRING	KYSIM_MAKE_GROUP= "SIM.MAKE.GROUP";
-// const	STRING	KYSIM_MAKE_FILES= "SIM.MAKE.FILES";
-// const	STRING	KYSIM_MAKE_SUBD=  "SIM.MAKE.SUBD";
-// const	STRING	KYSIM_MAKE_VDIRS= "SIM.MAKE.VDIRS";
+// const	KEYPATH	KYSIM_MAKE_GROUP= "SIM.MAKE.GROUP";
+// const	KEYPATH	KYSIM_MAKE_FILES= "SIM.MAKE.FILES";
+// const	KEYPATH	KYSIM_MAKE_SUBD=  "SIM.MAKE.SUBD";
+// const	KEYPATH	KYSIM_MAKE_VDIRS= "SIM.MAKE.VDIRS";
 //
-const	STRING	KYTHIS="THIS";
-const	STRING	KYTHISDOT="THIS.";
+const	KEYPATH	KYTHIS="THIS";
+const	KEYPATH	KYTHISDOT="THIS.";
 // CLOCKS
-const	STRING	KYCLOCK="CLOCK";
-const	STRING	KYCLOCK_NAME="CLOCK.NAME";
-const	STRING	KYCLOCK_TOP="CLOCK.TOP";
-const	STRING	KY_NAME="NAME";
-const	STRING	KY_TOP="TOP";
-const	STRING	KY_FREQUENCY="FREQUENCY";
-const	STRING	KY_CLASS="CLASS";
+const	KEYPATH	KYCLOCK="CLOCK";
+const	KEYPATH	KYCLOCK_NAME="CLOCK.NAME";
+const	KEYPATH	KYCLOCK_TOP="CLOCK.TOP";
+const	KEYPATH	KY_NAME="NAME";
+const	KEYPATH	KY_TOP="TOP";
+const	KEYPATH	KY_FREQUENCY="FREQUENCY";
+const	KEYPATH	KY_CLASS="CLASS";
 // BUS definitions
-const	STRING	KYBUS = "BUS",
+const	KEYPATH	KYBUS = "BUS",
 		KYBUS_NAME = "BUS.NAME",
 		KYBUS_PREFIX = "BUS.PREFIX",
 		KYBUS_TYPE   = "BUS.TYPE",
@@ -232,6 +235,7 @@ const	STRING	KYBUS = "BUS",
 		KYBUS_IDWIDTH= "BUS.IDWIDTH",
 		KYBUS_CLOCK  = "BUS.CLOCK",
 		KYBUS_NULLSZ = "BUS.NULLSZ",
+		KYBUS_PACKING= "BUS.PACKING",
 		KY_TYPE      = "TYPE",
 		KY_WIDTH     = "WIDTH",
 		KY_IDWIDTH   = "IDWIDTH",
@@ -240,16 +244,18 @@ const	STRING	KYBUS = "BUS",
 		KY_RESET     = "RESET",
 		KY_NULLSZ    = "NULLSZ",
 		KY_NSELECT   = "NSELECT",
+		KY_PACKING   = "PACKING",
 		KYDEFAULT_BUS= "DEFAULT.BUS",
 		KYREGISTER_BUS= "REGISTER.BUS",
 		KYREGISTER_BUS_NAME= "REGISTER.BUS.NAME";
 
-const	STRING	KY_OPT_LOWPOWER   = "OPT_LOWPOWER",
+const	KEYPATH	KY_OPT_LOWPOWER   = "OPT_LOWPOWER",
 		KY_OPT_LINGER     = "OPT_LINGER",
 		KY_OPT_LGMAXBURST = "OPT_LGMAXBURST",
 		KY_OPT_TIMEOUT    = "OPT_TIMEOUT",
 		KY_OPT_STARVATION_TIMEOUT = "OPT_STARVATION_TIMEOUT",
-		KY_OPT_DBLBUFFER  = "OPT_DBLBUFFER";
+		KY_OPT_DBLBUFFER  = "OPT_DBLBUFFER",
+		KY_OPT_FANIN      = "OPT_FANIN";
 //
 //
 
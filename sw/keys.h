@@ -45,35 +45,35 @@
 #include "mapdhash.h"
 
 //
-extern const	STRING	KYLEGAL;
-extern const	STRING	KYCOPYRIGHT;
-extern const	STRING	KYCMDLINE;
-extern const	STRING	KYSUBD;	// Output subdirectory
-extern const	STRING	KYPATH;
-extern const	STRING	KYSUBD;
-// extern const	STRING	KYBUS_ADDRESS_WIDTH;
-extern const	STRING	KYSKIPADDR;
-extern const	STRING	KYRESET_ADDRESS;
+extern const	KEYPATH	KYLEGAL;
+extern const	KEYPATH	KYCOPYRIGHT;
+extern const	KEYPATH	KYCMDLINE;
+extern const	KEYPATH	KYSUBD;	// Output subdirectory
+extern const	KEYPATH	KYPATH;
+extern const	KEYPATH	KYSUBD;
+// extern const	KEYPATH	KYBUS_ADDRESS_WIDTH;
+extern const	KEYPATH	KYSKIPADDR;
+extern const	KEYPATH	KYRESET_ADDRESS;
 // For subclassing
-extern const	STRING	KYPLUSDOT;
-extern const	STRING	KYINCLUDEFILE;
+extern const	KEYPATH	KYPLUSDOT;
+extern const	KEYPATH	KYINCLUDEFILE;
 // Other global keys
-extern const	STRING	KYREGDEFS_CPP_INCLUDE;
-extern const	STRING	KYREGDEFS_CPP_INSERT;
-extern const	STRING	KYKEYS_TRIMLIST;
-extern const	STRING	KYKEYS_INTLIST;
-extern const	STRING	KYPROJECT;
-//
-extern const	STRING	KYSIO;
-extern const	STRING	KYDIO;
-extern const	STRING	KYSIO_SEL;
-extern const	STRING	KYDIO_SEL;
-//
-extern const	STRING	KYPREFIX;
-extern const	STRING	KYACCESS;
-extern const	STRING	KYDEPENDS;
-extern const	STRING	KYERROR_WIRE;
-extern const	STRING	KYSLAVE,
+extern const	KEYPATH	KYREGDEFS_CPP_INCLUDE;
+extern const	KEYPATH	KYREGDEFS_CPP_INSERT;
+extern const	KEYPATH	KYKEYS_TRIMLIST;
+extern const	KEYPATH	KYKEYS_INTLIST;
+extern const	KEYPATH	KYPROJECT;
+//
+extern const	KEYPATH	KYSIO;
+extern const	KEYPATH	KYDIO;
+extern const	KEYPATH	KYSIO_SEL;
+extern const	KEYPATH	KYDIO_SEL;
+//
+extern const	KEYPATH	KYPREFIX;
+extern const	KEYPATH	KYACCESS;
+extern const	KEYPATH	KYDEPENDS;
+extern const	KEYPATH	KYERROR_WIRE;
+extern const	KEYPATH	KYSLAVE,
 			KYSLAVE_TYPE,
 			KYSLAVE_BUS,
 			KYSLAVE_BUS_NAME,
@@ -85,8 +85,9 @@ extern const	STRING	KYSLAVE,
 			KYSLAVE_ANSIPORTLIST,
 			KYSLAVE_IANSI,
 			KYSLAVE_OANSI,
-			KYSLAVE_ANSPREFIX;
-extern const	STRING	KYMASTER,
+			KYSLAVE_ANSPREFIX,
+			KYSLAVE_BASE;
+extern const	KEYPATH	KYMASTER,
 			KYMASTER_TYPE,
 			KYMASTER_BUS,
 			KYMASTER_BUS_NAME,
@@ -101,104 +102,105 @@ extern const	STRING	KYMASTER,
 			KYMASTER_ANSPREFIX;
 // Types of bus masters.
 // KYBUS, (HOST), (VIDEO), (XCLOCK), and ...
-extern	const	STRING	KYSUBBUS,
+extern	const	KEYPATH	KYSUBBUS,
 			KYARBITER,
 			KYXCLOCK,
 			KYHOST,
 			KYCPU;
 //
-extern const	STRING	KYBASE;
-extern const	STRING	KYREGBASE;
-extern const	STRING	KYMASK;
-extern const	STRING	KYNADDR;
-//
-extern const	STRING	KYEXPR;
-extern const	STRING	KYVAL;
-extern const	STRING	KYFORMAT;
-extern const	STRING	KYSTR;
-//
-extern const	STRING	KYSCOPE;
-extern const	STRING	KYMEMORY;
-extern const	STRING	KYSINGLE;
-extern const	STRING	KYDOUBLE;
-extern const	STRING	KYOTHER;
-//
-extern const	STRING	KYNP;
-extern const	STRING	KYNPIC;
-extern const	STRING	KYNPSINGLE;
-extern const	STRING	KYNPDOUBLE;
-extern const	STRING	KYNPMEMORY;
-extern const	STRING	KYNSCOPES;
+extern const	KEYPATH	KYBASE;
+extern const	KEYPATH	KYREGBASE;
+extern const	KEYPATH	KYMASK;
+extern const	KEYPATH	KYNADDR;
+//
+extern const	KEYPATH	KYEXPR;
+extern const	KEYPATH	KYVAL;
+extern const	KEYPATH	KYFORMAT;
+extern const	KEYPATH	KYSTR;
+//
+extern const	KEYPATH	KYSCOPE;
+extern const	KEYPATH	KYMEMORY;
+extern const	KEYPATH	KYSINGLE;
+extern const	KEYPATH	KYDOUBLE;
+extern const	KEYPATH	KYOTHER;
+//
+extern const	KEYPATH	KYNP;
+extern const	KEYPATH	KYNPIC;
+extern const	KEYPATH	KYNPSINGLE;
+extern const	KEYPATH	KYNPDOUBLE;
+extern const	KEYPATH	KYNPMEMORY;
+extern const	KEYPATH	KYNSCOPES;
 // Regs definition(s)
-extern const	STRING	KYREGS_N;
-extern const	STRING	KYREGS_NOTE;
-extern const	STRING	KYREGDEFS_H_INCLUDE;
-extern const	STRING	KYREGDEFS_H_DEFNS;
-extern const	STRING	KYREGDEFS_H_INSERT;
+extern const	KEYPATH	KYREGS_N;
+extern const	KEYPATH	KYREGS_NOTE;
+extern const	KEYPATH	KYREGDEFS_H_INCLUDE;
+extern const	KEYPATH	KYREGDEFS_H_DEFNS;
+extern const	KEYPATH	KYREGDEFS_H_INSERT;
 // Board definitions for C/C++
-extern const	STRING	KYBDEF_INCLUDE;
-extern const	STRING	KYBDEF_DEFN;
-extern const	STRING	KYBDEF_IOTYPE;
-extern const	STRING	KYBDEF_OSDEF;
-extern const	STRING	KYBDEF_OSVAL;
-extern const	STRING	KYBDEF_INSERT;
+extern const	KEYPATH	KYBDEF_INCLUDE;
+extern const	KEYPATH	KYBDEF_DEFN;
+extern const	KEYPATH	KYBDEF_IOTYPE;
+extern const	KEYPATH	KYBDEF_OSDEF;
+extern const	KEYPATH	KYBDEF_OSVAL;
+extern const	KEYPATH	KYBDEF_INSERT;
 // Top definitions
-extern const	STRING	KYTOP_PORTLIST;
-extern const	STRING	KYTOP_IODECL;
-extern const	STRING	KYTOP_PARAM;
-extern const	STRING	KYTOP_DEFNS;
-extern const	STRING	KYTOP_MAIN;
-extern const	STRING	KYTOP_INSERT;
+extern const	KEYPATH	KYTOP_PORTLIST;
+extern const	KEYPATH	KYTOP_IODECL;
+extern const	KEYPATH	KYTOP_PARAM;
+extern const	KEYPATH	KYTOP_DEFNS;
+extern const	KEYPATH	KYTOP_MAIN;
+extern const	KEYPATH	KYTOP_INSERT;
 // Main definitions
-extern const	STRING	KYMAIN_INCLUDE;
-extern const	STRING	KYMAIN_PORTLIST;
-extern const	STRING	KYMAIN_IODECL;
-extern const	STRING	KYMAIN_PARAM;
-extern const	STRING	KYMAIN_DEFNS;
-extern const	STRING	KYMAIN_INSERT;
-extern const	STRING	KYMAIN_ALT;
+extern const	KEYPATH	KYMAIN_INCLUDE;
+extern const	KEYPATH	KYMAIN_PORTLIST;
+extern const	KEYPATH	KYMAIN_IODECL;
+extern const	KEYPATH	KYMAIN_PARAM;
+extern const	KEYPATH	KYMAIN_DEFNS;
+extern const	KEYPATH	KYMAIN_INSERT;
+extern const	KEYPATH	KYMAIN_ALT;
 // Definitions for the .ld file(s)
-extern const	STRING	KYLD_FILE;
-extern const	STRING	KYLD_SCRIPT;
-extern const	STRING	KYLD_ENTRY;
-extern const	STRING	KYLD_NAME;
-extern const	STRING	KYLD_PERM;
-extern const	STRING	KYLD_DEFNS;
-extern const	STRING	KYFLASH;
-extern const	STRING	KYSCRIPT;
+extern const	KEYPATH	KYLD_FILE;
+extern const	KEYPATH	KYLD_SCRIPT;
+extern const	KEYPATH	KYLD_ENTRY;
+extern const	KEYPATH	KYLD_NAME;
+extern const	KEYPATH	KYLD_PERM;
+extern const	KEYPATH	KYLD_DEFNS;
+extern const	KEYPATH	KYFLASH;
+extern const	KEYPATH	KYSCRIPT;
 // XDC/UCF definitions
-extern	const	STRING	KYXDC_FILE;
-extern	const	STRING	KYXDC_INSERT;
-extern	const	STRING	KYPCF_FILE;
-extern	const	STRING	KYPCF_INSERT;
-extern	const	STRING	KYLPF_FILE;
-extern	const	STRING	KYLPF_INSERT;
-extern	const	STRING	KYUCF_FILE;
-extern	const	STRING	KYUCF_INSERT;
+extern	const	KEYPATH	KYXDC_FILE;
+extern	const	KEYPATH	KYXDC_INSERT;
+extern	const	KEYPATH	KYPCF_FILE;
+extern	const	KEYPATH	KYPCF_INSERT;
+extern	const	KEYPATH	KYLPF_FILE;
+extern	const	KEYPATH	KYLPF_INSERT;
+extern	const	KEYPATH	KYUCF_FILE;
+extern	const	KEYPATH	KYUCF_INSERT;
 // Arbitrary output data files
-extern	const	STRING	KYOUT_FILE;
-extern	const	STRING	KYOUT_DATA;
+extern	const	KEYPATH	KYOUT_FILE;
+extern	const	KEYPATH	KYOUT_DATA;
 // rtl/Makefile include file
-extern	const	STRING	KYRTL_MAKE_GROUP;
-extern	const	STRING	KYRTL_MAKE_SUBD;
-extern	const	STRING	KYRTL_MAKE_VDIRS;
-extern	const	STRING	KYRTL_MAKE_FILES;
-extern	const	STRING	KYVFLIST;
-extern	const	STRING	KYAUTOVDIRS;
+extern	const	KEYPATH	KYRTL_MAKE_GROUP;
+extern	const	KEYPATH	KYRTL_MAKE_SUBD;
+extern	const	KEYPATH	KYRTL_MAKE_VDIRS;
+extern	const	KEYPATH	KYRTL_MAKE_FILES;
+extern	const	KEYPATH	KYVFLIST;
+extern	const	KEYPATH	KYAUTOVDIRS;
 // PIC definitions
-extern	const	STRING	KYPIC, KYPIC_BUS, KYPIC_MAX;
+extern	const	KEYPATH	KYPIC, KYPIC_BUS, KYPIC_MAX;
 // Cache information
-extern	const	STRING	KYCACHABLE_FILE;
+extern	const	KEYPATH	KYCACHABLE_FILE, KYCACHABLE_REGISTERED;
 // Interrupt definitions
-extern	const	STRING	KY_INT, KYINTLIST, KY_WIRE, KY_DOTWIRE, KY_ID;
+extern	const	KEYPATH	KY_INT, KYINTLIST, KY_WIRE, KY_DOTWIRE, KY_ID;
 // SIM definitions
-extern	const	STRING	KYSIM_INCLUDE, KYSIM_DEFINES, KYSIM_DEFNS,
+extern	const	KEYPATH	KYSIM_INCLUDE, KYSIM_DEFINES, KYSIM_DEFNS,
 			KYSIM_PREINITIAL, KYSIM_INIT, KYSIM_TICK,
 			KYSIM_SETRESET, KYSIM_CLRRESET,
 			KYSIM_DBGCONDITION, KYSIM_DEBUG,
-			KYSIM_LOAD, KYSIM_METHODS, KYSIM_CLOCK;
+			KYSIM_LOAD, KYSIM_METHODS, KYSIM_CLOCK,
+			KYSIM_TRACE_FLUSH;
 // CLOCK definitions
-extern	const	STRING	KYCLOCK,
+extern	const	KEYPATH	KYCLOCK,
 			KYCLOCK_NAME,
 			KYCLOCK_TOP,
 			KY_NAME,
@@ -206,7 +208,7 @@ extern	const	STRING	KYCLOCK,
 			KY_CLASS,
 			KY_FREQUENCY;
 // BUS definitions
-extern	const	STRING	KYBUS,
+extern	const	KEYPATH	KYBUS,
 			KYBUS_NAME,
 			KYBUS_PREFIX,
 			KYBUS_TYPE,
@@ -215,6 +217,7 @@ extern	const	STRING	KYBUS,
 			KYBUS_AWID,
 			KYBUS_CLOCK,
 			KYBUS_NULLSZ,
+			KYBUS_PACKING,
 			KY_TYPE,
 			KY_WIDTH,
 			KY_IDWIDTH,
@@ -223,18 +226,20 @@ extern	const	STRING	KYBUS,
 			KY_RESET,
 			KY_NULLSZ,
 			KY_NSELECT,
+			KY_PACKING,
 			KYDEFAULT_BUS,
 			KYREGISTER_BUS,
 			KYREGISTER_BUS_NAME;
 // Bus options
-extern	const	STRING	KY_OPT_LOWPOWER,
+extern	const	KEYPATH	KY_OPT_LOWPOWER,
 			KY_OPT_LINGER,
 			KY_OPT_LGMAXBURST,
 			KY_OPT_TIMEOUT,
 			KY_OPT_STARVATION_TIMEOUT,
-			KY_OPT_DBLBUFFER;
+			KY_OPT_DBLBUFFER,
+			KY_OPT_FANIN;
 //
-extern const	STRING	KYSTHIS;
-extern const	STRING	KYTHISDOT;
+extern const	KEYPATH	KYSTHIS;
+extern const	KEYPATH	KYTHISDOT;
 
 #endif
@@ -37,19 +37,30 @@
 //
 // }}}
 #include <vector>
+#include <set>
+#include <algorithm>
+#include <unordered_map>
 #include "mapdhash.h"
 #include "kveval.h"
 #include "keys.h"
 #include "ast.h"
 #include "msgs.h"
+#include "stats.h"
 
 
 typedef	std::vector<MAPDHASH *>	MAPSTACK;
 
-bool	get_named_kvpair(MAPSTACK &stack, MAPDHASH &here, STRING &key,
+// If non-NULL, every key looked up by name is recorded here, so that the
+// evaluator can learn what any pending expression or substitution depends upon
+static	KVDEPS	*s_kvdeps = NULL;
+
+bool	get_named_kvpair(MAPSTACK &stack, MAPDHASH &here, const STRING &key,
 		MAPDHASH::iterator &pair) {
 	MAPDHASH::iterator	kvpair, kvsub;
 
+	if (s_kvdeps)
+		s_kvdeps->push_back(kvtoken(key));
+
 	if ((key[0]=='.')||(strncmp(key.c_str(), KYTHISDOT.c_str(), KYTHISDOT.size())==0)) {
 		STRING	subkey = (key[0]=='.')?key.substr(1)
 			: key.substr(KYTHISDOT.size(),
@@ -105,7 +116,85 @@ else
 	} return false;
 }
 
-bool	get_named_value(MAPSTACK &stack, MAPDHASH &here, STRING &key,
+//
+// kvname_path
+//
+// Work out where get_named_kvpair() would look for key, and what it would
+// look for there
+static	STRING	kvname_path(const STRING &key, int &where) {
+	if (key[0] == '.') {
+		where = KVNAME::KVN_HERE;
+		return key.substr(1);
+	} else if (strncmp(key.c_str(), KYTHISDOT.c_str(), KYTHISDOT.size())==0) {
+		where = KVNAME::KVN_HERE;
+		return key.substr(KYTHISDOT.size());
+	} else if (key[0] == '+') {
+		where = KVNAME::KVN_SUPER;
+		return key.substr(2);
+	} else if (key[0] == '/') {
+		where = KVNAME::KVN_ROOT;
+		return key.substr(1);
+	} where = KVNAME::KVN_SEARCH;
+	return key;
+}
+
+KVNAME::KVNAME(const STRING &key)
+		: m_path(kvname_path(key, m_where)), m_token(kvtoken(key)) {}
+
+//
+// The same search as above, only with the name already picked apart
+bool	get_named_kvpair(MAPSTACK &stack, MAPDHASH &here, const KVNAME &key,
+		MAPDHASH::iterator &pair) {
+	MAPDHASH::iterator	kvpair, kvsub;
+
+	if (s_kvdeps)
+		s_kvdeps->push_back(key.m_token);
+
+	switch(key.m_where) {
+	case KVNAME::KVN_HERE:
+		pair = findkey(here, key.m_path);
+		return (pair != here.end());
+	case KVNAME::KVN_SUPER:
+		kvpair = findkey(here, KYPLUSDOT);
+		if (kvpair == here.end())
+			return false;
+		if (kvpair->second.m_typ != MAPT_MAP)
+			return false;
+		kvsub = kvpair->second.u.m_m->begin();
+		assert(kvsub->second.m_typ == MAPT_MAP);
+
+		pair = findkey(*kvsub->second.u.m_m, key.m_path);
+		return (pair != kvpair->second.u.m_m->end());
+	case KVNAME::KVN_ROOT:
+		pair = findkey(*stack[0], key.m_path);
+		return (pair != stack[0]->end());
+	default:
+		if (here.end() != (pair = findkey(here, key.m_path)))
+			return true;
+		for(int posn = (int)stack.size()-1; posn>= 0; posn--) {
+			pair = findkey(*stack[posn], key.m_path);
+			if (pair != stack[posn]->end())
+				return true;
+		} return false;
+	}
+}
+
+bool	get_named_value(MAPSTACK &stack, MAPDHASH &here, const KVNAME &key,
+		int &value) {
+	MAPDHASH::iterator	kvpair;
+
+	if (get_named_kvpair(stack, here, key, kvpair)) {
+		if (kvpair->second.m_typ == MAPT_INT) {
+			value = kvpair->second.u.m_v;
+			return true;
+		} else if (kvpair->second.m_typ == MAPT_MAP) {
+			if (getvalue(*kvpair->second.u.m_m, value))
+				return true;
+		}
+	} return false;
+}
+
+bool	get_named_value(MAPSTACK &stack, MAPDHASH &here, const STRING &key,
 		int &value) {
 	MAPDHASH::iterator	kvpair;
 
@@ -120,7 +209,8 @@ bool	get_named_value(MAPSTACK &stack, MAPDHASH &here, STRING &key,
 	} return false;
 }
 
-STRINGP	get_named_string(MAPSTACK &stack, MAPDHASH &here, STRING &key) {
+STRINGP	get_named_string(MAPSTACK &stack, MAPDHASH &here,
+		const STRING &key) {
 	MAPDHASH::iterator	kvpair;
 
 	if (get_named_kvpair(stack, here, key, kvpair)) {
@@ -139,7 +229,8 @@ STRINGP	get_named_string(MAPSTACK &stack, MAPDHASH &here, STRING &key) {
 void	expr_eval(MAPSTACK &stack, MAPDHASH &here, MAPDHASH &sub, MAPT &expr) {
 	AST	*ast;
 	if (expr.m_typ == MAPT_STRING) {
-		ast = parse_ast(*expr.u.m_s);
+		if (NULL == (ast = parse_ast(*expr.u.m_s)))
+			return;
 		ast->define(stack, here);
 		if (ast->isdefined()) {
 			expr.m_typ = MAPT_INT;
@@ -161,73 +252,6 @@ void	expr_eval(MAPSTACK &stack, MAPDHASH &here, MAPDHASH &sub, MAPT &expr) {
 	}
 }
 
-bool	find_any_unevaluated_sub(MAPSTACK &stack, MAPDHASH *here,
-		MAPDHASH &sub) {
-	bool	changed = false;
-	MAPDHASH::iterator	pfx = sub.end(), subi;
-	MAPDHASH	*component;
-
-	pfx = sub.find(KYPREFIX);
-	if (pfx != sub.end())
-		component = &sub;
-	else
-		component = here;
-
-	for(subi=sub.begin(); subi != sub.end(); subi++) {
-		if (subi->second.m_typ == MAPT_MAP) {
-			if (KYPLUSDOT.compare(subi->first) != 0) {
-				// Don't recurse below any +. keys
-				stack.push_back(subi->second.u.m_m);
-				changed = find_any_unevaluated_sub(stack,
-					component, *subi->second.u.m_m)
-					|| (changed);
-				stack.pop_back();
-			}
-		} else if (subi->first == KYEXPR) {
-			if (subi->second.m_typ == MAPT_STRING) {
-				expr_eval(stack, *component, sub, subi->second);
-				if (subi->second.m_typ != MAPT_STRING)
-					changed = true;
-			} else if (subi->second.m_typ == MAPT_AST) {
-				AST	*ast = subi->second.u.m_a;
-				ast->define(stack, *component);
-				if (ast->isdefined()) {
-					subi->second.m_typ = MAPT_INT;
-					subi->second.u.m_v = ast->eval();
-					delete ast;
-					changed = true;
-				}
-			}
-		} else if (subi->second.m_typ == MAPT_AST) {
-			AST	*ast = subi->second.u.m_a;
-			ast->define(stack, *component);
-			if (ast->isdefined()) {
-				int	val = ast->eval();
-				subi->second.m_typ = MAPT_INT;
-				subi->second.u.m_v = val;
-				delete ast;
-				changed = true;
-			}
-		}
-	} return changed;
-}
-
-void	find_any_unevaluated(MAPDHASH &info) {
-	MAPDHASH::iterator	topi;
-	bool	changed = false;
-	MAPSTACK	stack;
-	stack.push_back(&info);
-
-	do {
-		for(topi=info.begin(); topi != info.end(); topi++) {
-			if (topi->second.m_typ != MAPT_MAP)
-				continue;
-			changed = find_any_unevaluated_sub(stack, &info,
-					*topi->second.u.m_m);
-		}
-	} while(changed);
-}
-
 bool	subresults_into(MAPSTACK stack, MAPDHASH *here, STRINGP &sval) {
 	bool	changed = false, everchanged = false;;
 
@@ -301,7 +325,7 @@ bool	subresults_into(MAPSTACK stack, MAPDHASH *here, STRINGP &sval) {
 					sprintf(tbuf, fcpy, value);
 					tmp = tbuf;
 					sval->replace(sloc, endpos, tmp);
-					delete[] fcpy;
+					free(fcpy);
 					delete[] tbuf;
 				} else if (NULL != (vstr = get_named_string(
 							stack, *here, key))) {
@@ -369,6 +393,8 @@ bool	resolve_ast_expressions(MAPDHASH &exmap) {
 
 	if ((kvexpr != exmap.end())&&(kvexpr->second.m_typ == MAPT_STRING)) {
 		AST *ast = parse_ast(*kvexpr->second.u.m_s);
+		if (NULL == ast)
+			return false;
 		kvexpr->second.m_typ = MAPT_AST;
 		kvexpr->second.u.m_a = ast;
 	}
@@ -396,55 +422,530 @@ bool	resolve_ast_expressions(MAPDHASH &exmap) {
 	return false;
 }
 
-bool	substitute_any_results_sub(MAPSTACK &stack, MAPDHASH *here,
-		MAPDHASH &sub) {
-	MAPDHASH::iterator	pfx = sub.end(), subi, kvelm, kvstr, kvfmt;
-	MAPDHASH	*component;
-	bool		v = false;
+////////////////////////////////////////////////////////////////////////////////
+//
+// Dependency tracked (re)evaluation
+// {{{
+// Rather than sweeping across the entire hash until nothing changes any more,
+// we keep track of every location (site) within the hash that still needs
+// evaluation: expressions that haven't been evaluated, strings with @$
+// substitutions still pending, and maps with an EXPR but no STR.  As each
+// site is evaluated, we record the names of all of the keys it looks up.
+// Later, when any of those keys changes, either by setvalue(), setstring(),
+// or by the evaluation of some other site, only those sites depending upon
+// it are evaluated again.
+//
+// Keys are tracked by their last component name alone, so "SLAVE.BASE"
+// depends upon any "BASE" key changing.  This may evaluate a site more often
+// than necessary, but never less often.
+//
+// When something new is added to the hash that might need evaluating, the
+// sites must be collected again.  If we know which top level component the
+// change was made within, only that component's sites are collected again,
+// and that only once the next reeval() comes along.  Changes to maps we've
+// never walked through are ignored: such maps aren't a part of this hash.
+// (Those that are new are placed into it by setvalue() or setstring(), which
+// invalidate the map they're placed into.)  Changes to the root itself force
+// a fresh collection of everything.
+//
+#define	KVSITE_EXPR	'A'	// An AST, or an EXPR string yet to be parsed
+#define	KVSITE_STRING	'S'	// A string with @$ substitutions pending
+#define	KVSITE_MAP	'M'	// A map with an EXPR, but no VAL or STR (yet)
+
+typedef	struct	KVSITE_S {
+	char		m_kind;
+	bool		m_dirty, m_done;	// m_dirty if within m_work
+	MAPDHASH	*m_owner,	// The map containing the value
+			*m_here;	// The component to evaluate it within
+	STRING		m_key,		// The value's key within m_owner
+			m_name;		// m_owner's key within its own parent
+	MAPSTACK	m_stack;
+	KVDEPS		m_deps;
+} KVSITE;
+
+// The sites found within one top level component of the hash
+typedef	struct	KVTOP_S {
+	STRING			m_name;		// The component's key
+	bool			m_pending;	// Needs to be collected again
+	std::vector<unsigned>	m_sites;
+} KVTOP;
+
+class	KVREGISTRY {
+	MAPDHASH	*m_root,
+			*m_top;		// The component being collected, if any
+	unsigned	m_ndead;	// Sites dropped by a partial collection
+	std::vector<KVSITE>	m_sites;
+	std::unordered_map<STRING, std::vector<unsigned> >	m_index;
+	// Sites that need evaluating, in the order they were found
+	std::set<unsigned>	m_work;
+	// The top level component every map we've walked through is found in
+	std::unordered_map<MAPDHASH *, MAPDHASH *>	m_topof;
+	std::unordered_map<MAPDHASH *, KVTOP>		m_tops;
+	std::vector<MAPDHASH *>				m_pending;
+
+	void	add(char kind, MAPSTACK &stack, MAPDHASH *here,
+			MAPDHASH *owner, const STRING &key,
+			const STRING &name);
+	void	depends(unsigned id, const STRING &token);
+	void	collect_exprs(MAPSTACK &stack, MAPDHASH *here,
+			MAPDHASH &sub, const STRING &name);
+	void	collect_strings(MAPSTACK &stack, MAPDHASH *here,
+			MAPDHASH &sub, const STRING &name);
+	void	recollect(MAPDHASH *top);
+	bool	evaluate(KVSITE &site);
+public:
+	bool	m_stale;
+
+	KVREGISTRY(MAPDHASH *root) : m_root(root), m_top(NULL), m_ndead(0),
+			m_stale(true) {}
+
+	void	collect(void);
+	void	invalidate(MAPDHASH *where);
+	void	refresh(void);
+	bool	contains(MAPDHASH *m) { return m_topof.count(m) > 0; }
+	void	notify(const STRING &token);
+	unsigned	process(void);
+};
+
+// The registry for gbl_hash persists from one reeval() to the next.  Any other
+// (temporary) registries are only live while their reeval() is running.
+static	KVREGISTRY			*s_kvreg = NULL;
+static	std::vector<KVREGISTRY *>	s_kvlive;
+// Components waiting on the next reeval(gbl_hash)
+static	std::vector<MAPDHASH *>		s_kvqueue;
+
+STRING	kvtoken(const STRING &key) {
+	size_t		pos = key.find_last_of('.');
+	const char	*ptr = key.c_str();
+
+	if (pos != STRING::npos)
+		ptr += pos+1;
+	while((*ptr == '/')||(*ptr == '+')||(*ptr == '!')
+			||(*ptr == '@')||(*ptr == '$'))
+		ptr++;
+	return STRING(ptr);
+}
+
+void	kvnotify(const STRING &key) {
+	size_t	start = 0, pos;
+
+	if (s_kvlive.size() == 0)
+		return;
+
+	do {
+		pos = key.find('.', start);
+		STRING	token = kvtoken(key.substr(start,
+			(pos == STRING::npos) ? STRING::npos : pos-start));
+		if (token.size() > 0) {
+			for(unsigned k=0; k<s_kvlive.size(); k++)
+				s_kvlive[k]->notify(token);
+		}
+		start = pos+1;
+	} while(pos != STRING::npos);
+}
+
+void	kvinvalidate(void) {
+	for(unsigned k=0; k<s_kvlive.size(); k++)
+		s_kvlive[k]->m_stale = true;
+}
+
+void	kvqueue(MAPDHASH &component) {
+	s_kvqueue.push_back(&component);
+}
+
+void	kvinvalidate(MAPDHASH &where) {
+	for(unsigned k=0; k<s_kvlive.size(); k++)
+		s_kvlive[k]->invalidate(&where);
+}
+
+void	KVREGISTRY::add(char kind, MAPSTACK &stack, MAPDHASH *here,
+		MAPDHASH *owner, const STRING &key, const STRING &name) {
+	KVSITE	site;
+
+	site.m_kind  = kind;
+	site.m_dirty = true;
+	site.m_done  = false;
+	site.m_owner = owner;
+	site.m_here  = here;
+	site.m_key   = key;
+	site.m_name  = name;
+	site.m_stack = stack;
+	m_sites.push_back(site);
+	m_work.insert(m_sites.size()-1);
+	if (m_top)
+		m_tops[m_top].m_sites.push_back(m_sites.size()-1);
+
+	if (kind == KVSITE_MAP)
+		// A map can only be resolved once its EXPR has been.  That
+		// EXPR will report a change of its parent's name, our key.
+		depends(m_sites.size()-1, key);
+}
+
+void	KVREGISTRY::depends(unsigned id, const STRING &token) {
+	KVDEPS	&deps = m_sites[id].m_deps;
 
-	pfx = sub.find(KYPREFIX);
-	if (pfx != sub.end())
+	for(unsigned k=0; k<deps.size(); k++)
+		if (deps[k] == token)
+			return;
+	deps.push_back(token);
+	m_index[token].push_back(id);
+}
+
+void	KVREGISTRY::notify(const STRING &token) {
+	std::unordered_map<STRING, std::vector<unsigned> >::iterator	kvidx;
+
+	if (m_stale)
+		return;
+	kvidx = m_index.find(token);
+	if (kvidx == m_index.end())
+		return;
+	for(unsigned k=0; k<kvidx->second.size(); k++) {
+		KVSITE	&site = m_sites[kvidx->second[k]];
+		if ((!site.m_done)&&(!site.m_dirty)) {
+			site.m_dirty = true;
+			m_work.insert(kvidx->second[k]);
+		}
+	}
+}
+
+//
+// collect_exprs
+//
+// Find any expressions needing evaluation.  This follows the same path through
+// the hash, and evaluates expressions within the same contexts, as the sweep
+// in find_any_unevaluated() used to.
+void	KVREGISTRY::collect_exprs(MAPSTACK &stack, MAPDHASH *here,
+		MAPDHASH &sub, const STRING &name) {
+	MAPDHASH::iterator	subi;
+	MAPDHASH		*component;
+
+	if (sub.end() != sub.find(KYPREFIX))
 		component = &sub;
 	else
 		component = here;
 
 	for(subi=sub.begin(); subi != sub.end(); subi++) {
 		if (subi->second.m_typ == MAPT_MAP) {
-			if ((KYPLUSDOT.compare(subi->first)!=0)
-				&&(subi->first.size()>0)) {
-			stack.push_back(subi->second.u.m_m);
-			substitute_any_results_sub(stack, component,
-				*subi->second.u.m_m);
-			stack.pop_back();
-			kvelm = subi->second.u.m_m->find(KYEXPR);
-			kvstr  = subi->second.u.m_m->find(KYSTR);
-			kvfmt  = subi->second.u.m_m->find(KYFORMAT);
-			if ((kvstr == subi->second.u.m_m->end())
-				&&(kvelm != subi->second.u.m_m->end())) {
-				v = resolve_ast_expressions(*subi->second.u.m_m) || v;
-			}
+			if (KYPLUSDOT.compare(subi->first) != 0) {
+				// Don't recurse below any +. keys
+				m_topof[subi->second.u.m_m] = m_top;
+				stack.push_back(subi->second.u.m_m);
+				collect_exprs(stack, component,
+					*subi->second.u.m_m, subi->first);
+				stack.pop_back();
 			}
-		} else if (subi->second.m_typ == MAPT_STRING) {
-			v = subresults_into(stack, here, subi->second.u.m_s) ||v;
+		} else if (subi->second.m_typ == MAPT_AST) {
+			add(KVSITE_EXPR, stack, component, &sub,
+				subi->first, name);
+		} else if ((subi->second.m_typ == MAPT_STRING)
+				&&(subi->first == KYEXPR)) {
+			add(KVSITE_EXPR, stack, component, &sub,
+				subi->first, name);
 		}
-	} return v;
+	}
 }
 
-bool	substitute_any_results(MAPDHASH &info) {
+//
+// collect_strings
+//
+// Find any strings needing @$ substitutions, and any maps needing their
+// VAL and STR keys created--following the path substitute_any_results()
+// used to take.
+void	KVREGISTRY::collect_strings(MAPSTACK &stack, MAPDHASH *here,
+		MAPDHASH &sub, const STRING &name) {
+	MAPDHASH::iterator	subi;
+	MAPDHASH		*component;
+
+	if (sub.end() != sub.find(KYPREFIX))
+		component = &sub;
+	else
+		component = here;
+
+	for(subi=sub.begin(); subi != sub.end(); subi++) {
+		if (subi->second.m_typ == MAPT_MAP) {
+			MAPDHASH	*m = subi->second.u.m_m;
+
+			if ((KYPLUSDOT.compare(subi->first)==0)
+					||(subi->first.size() == 0))
+				continue;
+
+			if (&sub == m_root)
+				m_top = m;
+			m_topof[m] = m_top;
+
+			stack.push_back(m);
+			collect_strings(stack, component, *m, subi->first);
+			stack.pop_back();
+
+			if ((m->end() == m->find(KYSTR))
+					&&(m->end() != m->find(KYEXPR)))
+				add(KVSITE_MAP, stack, component, &sub,
+					subi->first, name);
+
+			if (&sub == m_root)
+				m_top = NULL;
+		} else if ((subi->second.m_typ == MAPT_STRING)
+				&&(STRING::npos != subi->second.u.m_s->find("@$"))) {
+			add(KVSITE_STRING, stack, here, &sub,
+				subi->first, name);
+		}
+	}
+}
+
+void	KVREGISTRY::collect(void) {
+	MAPDHASH::iterator	topi;
+	MAPSTACK		stack;
+
+	m_sites.clear();
+	m_index.clear();
+	m_work.clear();
+	m_topof.clear();
+	m_tops.clear();
+	m_pending.clear();
+	m_ndead = 0;
+
+	stack.push_back(m_root);
+	for(topi=m_root->begin(); topi != m_root->end(); topi++) {
+		if (topi->second.m_typ != MAPT_MAP)
+			continue;
+		m_top = topi->second.u.m_m;
+		m_topof[m_top] = m_top;
+		m_tops[m_top].m_name = topi->first;
+		m_tops[m_top].m_pending = false;
+		collect_exprs(stack, m_root, *m_top, topi->first);
+	} m_top = NULL;
+
+	collect_strings(stack, m_root, *m_root, STRING(""));
+	m_stale = false;
+}
+
+//
+// recollect
+//
+// Drop every site found within one top level component, and then look
+// through it again, just as collect() would have.
+void	KVREGISTRY::recollect(MAPDHASH *top) {
+	KVTOP		&tp = m_tops[top];
 	MAPSTACK	stack;
-	stack.push_back(&info);
-	return substitute_any_results_sub(stack, &info, info);
+
+	for(unsigned k=0; k<tp.m_sites.size(); k++) {
+		unsigned	id = tp.m_sites[k];
+
+		if (m_sites[id].m_dirty)
+			m_work.erase(id);
+		m_sites[id].m_dirty = false;
+		m_sites[id].m_done  = true;
+		m_ndead++;
+	} tp.m_sites.clear();
+	tp.m_pending = false;
+
+	m_top = top;
+	stack.push_back(m_root);
+	collect_exprs(stack, m_root, *top, tp.m_name);
+	if ((KYPLUSDOT.compare(tp.m_name)!=0)&&(tp.m_name.size() > 0)) {
+		stack.push_back(top);
+		collect_strings(stack, m_root, *top, tp.m_name);
+		stack.pop_back();
+
+		if ((top->end() == top->find(KYSTR))
+				&&(top->end() != top->find(KYEXPR)))
+			add(KVSITE_MAP, stack, m_root, m_root, tp.m_name,
+				STRING(""));
+	} m_top = NULL;
 }
 
-void	reeval(MAPDHASH &info) {
-	do {
-		// First, find expressions that need evalution
-		find_any_unevaluated(info);
-		// Then, substitute their results back in as necessary
-	} while(substitute_any_results(info));
+// Something new has been placed into the map at where
+void	KVREGISTRY::invalidate(MAPDHASH *where) {
+	std::unordered_map<MAPDHASH *, MAPDHASH *>::iterator	kvtop;
+
+	if (m_stale)
+		return;
+	if (where == m_root) {
+		m_stale = true;
+		return;
+	}
+
+	kvtop = m_topof.find(where);
+	if (kvtop == m_topof.end())
+		return;
+
+	KVTOP	&tp = m_tops[kvtop->second];
+	if (!tp.m_pending) {
+		tp.m_pending = true;
+		m_pending.push_back(kvtop->second);
+	}
 }
 
-void	reeval(MAPDHASH *info) {
+// Bring the list of sites up to date before evaluating any of them
+void	KVREGISTRY::refresh(void) {
+	// Once half of the sites have been dropped, start over
+	if (2*m_ndead > m_sites.size())
+		m_stale = true;
+
+	for(unsigned k=0; (!m_stale)&&(k<m_pending.size()); k++) {
+		MAPDHASH		*top = m_pending[k];
+		MAPDHASH::iterator	kvpair;
+
+		// Make certain the component is still where we left it
+		kvpair = m_root->find(m_tops[top].m_name);
+		if ((kvpair == m_root->end())
+				||(kvpair->second.m_typ != MAPT_MAP)
+				||(kvpair->second.u.m_m != top))
+			m_stale = true;
+		else
+			recollect(top);
+	} m_pending.clear();
+
+	if (m_stale)
+		collect();
+}
+
+// Evaluate a single site, returning true if anything changed
+bool	KVREGISTRY::evaluate(KVSITE &site) {
+	MAPDHASH::iterator	kvpair;
+	bool			changed = false;
+
+	kvpair = site.m_owner->find(site.m_key);
+	if (kvpair == site.m_owner->end()) {
+		site.m_done = true;
+		return false;
+	}
+
+	MAPT	&elm = kvpair->second;
+	switch(site.m_kind) {
+	case KVSITE_EXPR:
+		if ((elm.m_typ == MAPT_STRING)&&(site.m_key == KYEXPR)) {
+			expr_eval(site.m_stack, *site.m_here, *site.m_owner,
+				elm);
+			changed = (elm.m_typ != MAPT_STRING);
+		} else if (elm.m_typ == MAPT_AST) {
+			AST	*ast = elm.u.m_a;
+			ast->define(site.m_stack, *site.m_here);
+			if (ast->isdefined()) {
+				int	val = ast->eval();
+				elm.m_typ = MAPT_INT;
+				elm.u.m_v = val;
+				delete ast;
+				changed = true;
+			}
+		}
+		site.m_done = (elm.m_typ != MAPT_AST)
+			&&((elm.m_typ != MAPT_STRING)||(site.m_key != KYEXPR));
+		break;
+	case KVSITE_STRING:
+		if (elm.m_typ != MAPT_STRING) {
+			site.m_done = true;
+			break;
+		}
+		changed = subresults_into(site.m_stack, site.m_here,
+			elm.u.m_s);
+		site.m_done = (STRING::npos == elm.u.m_s->find("@$"));
+		break;
+	case KVSITE_MAP: {
+		MAPDHASH	*m;
+
+		if (elm.m_typ != MAPT_MAP) {
+			site.m_done = true;
+			break;
+		}
+
+		m = elm.u.m_m;
+		if ((m->end() == m->find(KYSTR))
+				&&(m->end() != m->find(KYEXPR)))
+			changed = resolve_ast_expressions(*m);
+		site.m_done = (m->end() != m->find(KYSTR))
+				||(m->end() == m->find(KYEXPR));
+		} break;
+	default:
+		site.m_done = true;
+	}
+
+	return changed;
+}
+
+// Evaluate dirty sites, in the order they were found, until nothing is left
+// that might yet change.  Returns the number of passes this took.
+unsigned	KVREGISTRY::process(void) {
+	unsigned	passes = 0;
+
+	while(!m_work.empty()) {
+		std::set<unsigned>::iterator	kvwork;
+		unsigned	k = 0;
+
+		passes++;
+		for(; m_work.end() != (kvwork = m_work.lower_bound(k)); k++) {
+			KVDEPS	deps, *olddeps;
+			bool	changed;
+
+			k = *kvwork;
+			m_work.erase(kvwork);
+			m_sites[k].m_dirty = false;
+			if (m_sites[k].m_done)
+				continue;
+
+			olddeps = s_kvdeps;
+			s_kvdeps = &deps;
+			changed = evaluate(m_sites[k]);
+			s_kvdeps = olddeps;
+
+			if (!m_sites[k].m_done) {
+				for(unsigned d=0; d<deps.size(); d++)
+					depends(k, deps[d]);
+			}
+
+			if (changed) {
+				kvnotify(m_sites[k].m_key);
+				if (m_sites[k].m_name.size() > 0)
+					kvnotify(m_sites[k].m_name);
+			}
+		}
+	}
+
+	return passes;
+}
+
+void	reeval(MAPDHASH &info, const char *file, int line) {
+	STATPHASE	phase("reeval", file, line);
+
+	if (&info == gbl_hash) {
+		if (NULL == s_kvreg) {
+			s_kvreg = new KVREGISTRY(&info);
+			s_kvlive.insert(s_kvlive.begin(), s_kvreg);
+		}
+
+		s_kvreg->refresh();
+
+		// Anything queued within gbl_hash is now evaluated along with
+		// the rest of it.  Anything else is evaluated on its own, as
+		// reeval() would've done at the time.
+		std::vector<MAPDHASH *>	queue;
+		queue.swap(s_kvqueue);
+		for(unsigned k=0; k<queue.size(); k++) {
+			if ((s_kvreg->contains(queue[k]))
+				||(std::find(queue.begin(), queue.begin()+k,
+					queue[k]) != queue.begin()+k))
+				continue;
+			KVREGISTRY	reg(queue[k]);
+
+			s_kvlive.push_back(&reg);
+			reg.collect();
+			reg.process();
+			s_kvlive.pop_back();
+		}
+
+		phase.iterations(s_kvreg->process());
+	} else {
+		KVREGISTRY	reg(&info);
+
+		s_kvlive.push_back(&reg);
+		reg.collect();
+		phase.iterations(reg.process());
+		s_kvlive.pop_back();
+	}
+}
+
+void	reeval(MAPDHASH *info, const char *file, int line) {
 	assert(info);
-	reeval(*info);
+	reeval(*info, file, line);
 }
+// }}}
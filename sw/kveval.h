@@ -46,15 +46,55 @@
 
 #define	REHASH	do { gbl_msg.info("REEVAL %s:%d\n", __FILE__, __LINE__); reeval(gbl_hash); gbl_msg.dump(*gbl_hash); } while(0)
 typedef	std::vector<MAPDHASH *>	MAPSTACK;
+typedef	std::vector<STRING>	KVDEPS;
 
-bool	get_named_kvpair(MAPSTACK &stack, MAPDHASH &here, STRING &key,
+// class KVNAME
+// {{{
+// A name, as an expression refers to it, parsed once into where to look for
+// it and the (pre-split) path to look for there.  get_named_kvpair() given a
+// KVNAME finds the same value it would for the original string, but without
+// picking the string apart again on every call.
+//
+class	KVNAME {
+public:
+	enum	{ KVN_HERE, KVN_SUPER, KVN_ROOT, KVN_SEARCH };
+	int	m_where;
+	KEYPATH	m_path;
+	STRING	m_token;	// As kvtoken() would return for the name
+
+	KVNAME(const STRING &key);
+};
+// }}}
+
+bool	get_named_kvpair(MAPSTACK &stack, MAPDHASH &here, const STRING &key,
+		MAPDHASH::iterator &pair);
+bool	get_named_kvpair(MAPSTACK &stack, MAPDHASH &here, const KVNAME &key,
 		MAPDHASH::iterator &pair);
-bool	get_named_value(MAPSTACK &stack, MAPDHASH &here, STRING &key,
+bool	get_named_value(MAPSTACK &stack, MAPDHASH &here, const STRING &key,
+		int &value);
+bool	get_named_value(MAPSTACK &stack, MAPDHASH &here, const KVNAME &key,
 		int &value);
-STRINGP	get_named_string(MAPSTACK &stack, MAPDHASH &here, STRING &key);
+STRINGP	get_named_string(MAPSTACK &stack, MAPDHASH &here,
+		const STRING &key);
 
 extern	bool	resolve_ast_expressions(MAPDHASH &info);
-extern	void	reeval(MAPDHASH &info);
-extern	void	reeval(MAPDHASH *info);
+extern	STRING	kvtoken(const STRING &key);
+// Let any pending evaluations know the value at the given key has changed
+extern	void	kvnotify(const STRING &key);
+// The structure of the hash has changed, so pending evaluations must be
+// searched for again
+extern	void	kvinvalidate(void);
+// As above, but only the top level component containing where has changed.
+// Only that component will be searched again, at the next reeval()
+extern	void	kvinvalidate(MAPDHASH &where);
+// Queue a component whose keys have changed, to be evaluated at the next
+// reeval(gbl_hash) rather than immediately
+extern	void	kvqueue(MAPDHASH &component);
+// The file and line default to those of the caller, so that --stats can
+// report each place reeval() is called from on its own
+extern	void	reeval(MAPDHASH &info, const char *file = __builtin_FILE(),
+			int line = __builtin_LINE());
+extern	void	reeval(MAPDHASH *info, const char *file = __builtin_FILE(),
+			int line = __builtin_LINE());
 
 #endif
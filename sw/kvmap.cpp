@@ -0,0 +1,326 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/kvmap.cpp
+//
+// Project:	AutoFPGA, a utility for composing FPGA designs from peripherals
+// {{{
+// Purpose:	Implements the compact KVMAP backing store used by MAPDHASH,
+//		together with the node arena and key interning pool it
+//	depends upon.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdlib.h>
+#include <assert.h>
+#include <new>
+#include <mutex>
+#include <unordered_set>
+#include <unordered_map>
+#include <algorithm>
+
+#include "mapdhash.h"
+
+// kvintern
+// {{{
+// Return a pointer to the one (shared) copy of this key.  Elements of an
+// unordered_set never move, so these pointers remain valid forever.
+//
+// Files are parsed in parallel, and every identifier the parser sees is
+// interned, so the pool is split into shards, each with its own lock.  Each
+// thread also remembers the keys it has already interned, so that looking up
+// any key a second time takes no lock at all.
+//
+#define	KVSHARDS	16
+
+struct	KVPHASH {
+	size_t	operator()(const STRING *s) const {
+		return std::hash<STRING>()(*s); }
+};
+
+struct	KVPEQUAL {
+	bool	operator()(const STRING *a, const STRING *b) const {
+		return *a == *b; }
+};
+
+const STRING	*kvintern(const STRING &s) {
+	static	struct {
+		std::mutex			m_lock;
+		std::unordered_set<STRING>	m_pool;
+	} shard[KVSHARDS];
+	static	thread_local	std::unordered_set<const STRING *,
+					KVPHASH, KVPEQUAL>	known;
+	std::unordered_set<const STRING *, KVPHASH, KVPEQUAL>::iterator	kp;
+	const STRING	*r;
+	unsigned	k;
+
+	if (known.end() != (kp = known.find(&s)))
+		return *kp;
+
+	k = std::hash<STRING>()(s) % KVSHARDS;
+	{
+		std::lock_guard<std::mutex>	guard(shard[k].m_lock);
+		r = &(*shard[k].m_pool.insert(s).first);
+	}
+
+	known.insert(r);
+	return r;
+}
+// }}}
+
+// The node arena
+// {{{
+// Nodes are allocated KVBLOCK at a time, and never returned to the heap.
+// Freed nodes are kept on a free list, and reused before any new block is
+// allocated.  Each thread keeps its own free list, so that files may be
+// parsed in parallel without locking.  A node freed by one thread simply
+// joins the free list of that thread.
+//
+#define	KVBLOCK	1024
+
+typedef	union	KVCELL_U {
+	union KVCELL_U	*m_next;
+	alignas(KVNODE) char	m_node[sizeof(KVNODE)];
+} KVCELL;
+
+static	thread_local	KVCELL	*s_kvfree = NULL;
+
+static	KVNODE	*kvalloc(const STRING &ky, const MAPT &v, size_t h,
+			unsigned lg) {
+	KVCELL	*c;
+
+	if (!s_kvfree) {
+		KVCELL	*blk = (KVCELL *)malloc(KVBLOCK * sizeof(KVCELL));
+
+		if (!blk)
+			throw std::bad_alloc();
+		for(unsigned k=0; k<KVBLOCK; k++) {
+			blk[k].m_next = s_kvfree;
+			s_kvfree = &blk[k];
+		}
+	}
+
+	c = s_kvfree;
+	s_kvfree = c->m_next;
+	return new(c->m_node) KVNODE(*kvintern(ky), v, h, lg);
+}
+
+static	void	kvfree(KVNODE *n) {
+	KVCELL	*c = (KVCELL *)n;
+
+	n->~KVNODE();
+	c->m_next = s_kvfree;
+	s_kvfree = c;
+}
+// }}}
+
+KVMAP::KVMAP(const KVMAP &m) : m_legacy(0) {
+	*this = m;
+}
+
+KVMAP::~KVMAP(void) {
+	clear();
+}
+
+KVMAP	&KVMAP::operator=(const KVMAP &m) {
+	if (&m == this)
+		return *this;
+	clear();
+	m_slot.reserve(m.m_slot.size());
+	for(unsigned k=0; k<m.m_slot.size(); k++) {
+		const KVNODE	*n = m.m_slot[k];
+		m_slot.push_back(kvalloc(n->first, n->second, n->m_hash,
+				n->m_legacy));
+	}
+	m_index = m.m_index;
+	m_legacy = m.m_legacy;
+	return *this;
+}
+
+// lookup
+// {{{
+// Returns the slot containing the given key, or -1 if the key isn't present
+int	KVMAP::lookup(const STRING &ky, size_t h) const {
+	if (m_index.empty()) {
+		// Keys taken from a KEYPATH, or from another map, are already
+		// interned, so check for the interned copy before comparing
+		// any strings.
+		for(unsigned k=0; k<m_slot.size(); k++)
+			if (&m_slot[k]->first == &ky)
+				return k;
+		for(unsigned k=0; k<m_slot.size(); k++)
+			if ((m_slot[k]->m_hash == h)&&(m_slot[k]->first == ky))
+				return k;
+		return -1;
+	}
+
+	unsigned	msk = m_index.size()-1;
+	for(unsigned p = h & msk; m_index[p]; p = (p+1) & msk) {
+		const KVNODE	*n = m_slot[m_index[p]-1];
+		if ((n->m_hash == h)&&((&n->first == &ky)||(n->first == ky)))
+			return m_index[p]-1;
+	} return -1;
+}
+// }}}
+
+// index
+// {{{
+// Add slot k to the hash index, growing the index if necessary
+void	KVMAP::index(unsigned k) {
+	if (m_slot.size() <= KVMAP_SMALL)
+		return;
+	if (2*m_slot.size() > m_index.size()) {
+		reindex();
+		return;
+	}
+
+	unsigned	msk = m_index.size()-1, p;
+	for(p = m_slot[k]->m_hash & msk; m_index[p]; p = (p+1) & msk)
+		;
+	m_index[p] = k+1;
+}
+
+void	KVMAP::reindex(void) {
+	unsigned	sz;
+
+	m_index.clear();
+	if (m_slot.size() <= KVMAP_SMALL)
+		return;
+
+	for(sz = 4*KVMAP_SMALL; sz < 4*m_slot.size(); sz <<= 1)
+		;
+	m_index.assign(sz, 0);
+	for(unsigned k=0; k<m_slot.size(); k++) {
+		unsigned	p;
+		for(p = m_slot[k]->m_hash & (sz-1); m_index[p]; p = (p+1)&(sz-1))
+			;
+		m_index[p] = k+1;
+	}
+}
+// }}}
+
+KVMAP::iterator	KVMAP::find(const STRING &ky) {
+	int	k = lookup(ky, std::hash<STRING>()(ky));
+
+	if (k < 0)
+		return end();
+	return iterator(this, k);
+}
+
+// legacy_order
+// {{{
+// Before it was a KVMAP, a MAPDHASH was a std::unordered_map.  Rebuild such a
+// map, inserting our keys in the order they would've been inserted into the
+// original, and then walk it to recover the order the original would have
+// visited them in.
+//
+void	KVMAP::legacy_order(std::vector<iterator> &order) {
+	std::vector<std::pair<unsigned, unsigned> >	byseq;
+	std::unordered_map<STRING, unsigned>		legacy;
+
+	byseq.reserve(m_slot.size());
+	for(unsigned k=0; k<m_slot.size(); k++)
+		byseq.push_back(std::make_pair(m_slot[k]->m_legacy, k));
+	std::sort(byseq.begin(), byseq.end());
+
+	// Don't reserve() space in the legacy map.  Its order depends upon
+	// growing (and rehashing) one key at a time, as the original did.
+	for(unsigned k=0; k<byseq.size(); k++)
+		legacy.insert(std::make_pair(m_slot[byseq[k].second]->first,
+						byseq[k].second));
+
+	order.clear();
+	order.reserve(m_slot.size());
+	for(std::unordered_map<STRING, unsigned>::iterator kv=legacy.begin();
+			kv != legacy.end(); kv++)
+		order.push_back(iterator(this, kv->second));
+}
+// }}}
+
+// legacy_follow
+// {{{
+// mergemaps() adds keys in the order they are given in each file, where the
+// original added them in the order its sub-map visited them.  Renumber the
+// keys just merged in to match.
+//
+void	KVMAP::legacy_follow(unsigned first, KVMAP &src) {
+	std::vector<iterator>	order;
+
+	if (first == m_legacy)
+		return; // Nothing new
+	src.legacy_order(order);
+	for(unsigned k=0; k<order.size(); k++) {
+		int	s = lookup(order[k]->first, order[k]->m_hash);
+
+		if ((s >= 0)&&(m_slot[s]->m_legacy >= first))
+			m_slot[s]->m_legacy = m_legacy++;
+	}
+}
+// }}}
+
+std::pair<unsigned,bool>	KVMAP::add(const STRING &ky, const MAPT &v) {
+	size_t	h = std::hash<STRING>()(ky);
+	int	k = lookup(ky, h);
+
+	if (k >= 0)
+		return std::pair<unsigned,bool>(k, false);
+
+	m_slot.push_back(kvalloc(ky, v, h, m_legacy++));
+	index(m_slot.size()-1);
+	return std::pair<unsigned,bool>(m_slot.size()-1, true);
+}
+
+KVMAP::iterator	KVMAP::erase(iterator it) {
+	assert(it.m_map == this);
+	assert(it.m_k < m_slot.size());
+
+	kvfree(m_slot[it.m_k]);
+	m_slot.erase(m_slot.begin() + it.m_k);
+	if (!m_index.empty())
+		reindex();
+	return it;
+}
+
+size_t	KVMAP::erase(const STRING &ky) {
+	iterator	it = find(ky);
+
+	if (it == end())
+		return 0;
+	erase(it);
+	return 1;
+}
+
+void	KVMAP::clear(void) {
+	for(unsigned k=0; k<m_slot.size(); k++)
+		kvfree(m_slot[k]);
+	m_slot.clear();
+	m_index.clear();
+	m_legacy = 0;
+}
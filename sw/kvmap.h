@@ -0,0 +1,185 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/kvmap.h
+//
+// Project:	AutoFPGA, a utility for composing FPGA designs from peripherals
+// {{{
+// Purpose:	The backing store for a MAPDHASH.  This is a small, compact
+//		replacement for the std::unordered_map the MAPDHASH used to
+//	be, offering the (small) part of the unordered_map interface AutoFPGA
+//	actually uses.
+//
+//	Most component hashes hold only a handful of keys.  Rather than one
+//	heap node per key, a bucket array, and a heap copy of every key string,
+//	each map is just a vector of pointers to nodes.  The nodes themselves
+//	come from a common arena, and reference their keys from a pool of
+//	interned key strings, so a key such as "SLAVE" or "PREFIX" exists only
+//	once no matter how many components use it.  Small maps are searched
+//	linearly--first by the address of the interned key, then by hash.
+//	Only once a map grows beyond KVMAP_SMALL keys is an (open addressed)
+//	hash index built for it.
+//
+//	Iteration order is insertion order, and erasing a key leaves the
+//	order of the others alone.  Since files are merged in command line
+//	order, every walk across the design (and so every generated file)
+//	visits components in command line order, and the keys of each
+//	component in the order they were given.  This order is part of the
+//	interface: identical inputs must give byte-identical outputs, no
+//	matter what other components are present.
+//
+//	The one exception is legacy_order().  Automatically assigned bus
+//	addresses and interrupt numbers were always handed out in the order
+//	the old std::unordered_map happened to visit each component.  So that
+//	existing designs keep their address maps and interrupt numbers, the
+//	walks that assign these use legacy_order() to visit the map in that
+//	same order.  To support this, each node also remembers where it
+//	would have been inserted into the old map, since mergemaps() used to
+//	merge files in hash order rather than command line order.
+//
+//	This file is only meant to be included from mapdhash.h, once the
+//	MAPT type has been defined.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	KVMAP_H
+#define	KVMAP_H
+
+#include <string>
+#include <vector>
+#include <utility>
+
+// Maps with more than this many keys get a hash index
+#define	KVMAP_SMALL	16
+
+// Return the one shared (interned) copy of a given key string
+extern	const STRING	*kvintern(const STRING &s);
+
+// struct KVNODE
+// {{{
+// A single key-value pair.  The names first and second match those of the
+// std::pair the unordered_map used to use, so kvpair->first and
+// kvpair->second continue to work as they always have.
+//
+struct	KVNODE {
+	const STRING	&first;
+	MAPT		second;
+	size_t		m_hash;
+	unsigned	m_legacy; // Insertion order into the old unordered_map
+
+	KVNODE(const STRING &ky, const MAPT &v, size_t h, unsigned lg)
+		: first(ky), second(v), m_hash(h), m_legacy(lg) {}
+};
+// }}}
+
+// class KVMAP
+// {{{
+class	KVMAP {
+	std::vector<KVNODE *>	m_slot;
+	std::vector<unsigned>	m_index; // Slot+1, or zero if empty
+	unsigned		m_legacy; // Next legacy insertion number
+
+	int	lookup(const STRING &ky, size_t h) const;
+	void	index(unsigned k);
+	void	reindex(void);
+	std::pair<unsigned,bool>	add(const STRING &ky, const MAPT &v);
+public:
+	// class iterator
+	// {{{
+	class	iterator {
+		friend	class KVMAP;
+		KVMAP		*m_map;
+		unsigned	m_k;
+
+		iterator(KVMAP *m, unsigned k) : m_map(m), m_k(k) {}
+		bool	atend(void) const {
+			return (!m_map)||(m_k >= m_map->m_slot.size()); }
+	public:
+		iterator(void) : m_map(NULL), m_k(0) {}
+
+		KVNODE	&operator*(void) const { return *m_map->m_slot[m_k]; }
+		KVNODE	*operator->(void) const { return m_map->m_slot[m_k]; }
+		iterator &operator++(void) { m_k++; return *this; }
+		iterator operator++(int) {
+			iterator r(*this); m_k++; return r; }
+
+		// As with the unordered_map before, all end() iterators
+		// compare equal, regardless of which map they came from.
+		bool	operator==(const iterator &b) const {
+			if (atend())
+				return b.atend();
+			return (!b.atend())&&(m_map == b.m_map)&&(m_k == b.m_k);
+		}
+		bool	operator!=(const iterator &b) const {
+			return !(*this == b); }
+	};
+	// }}}
+
+	typedef	iterator	const_iterator;
+	typedef	KVNODE		value_type;
+
+	KVMAP(void) : m_legacy(0) {}
+	KVMAP(const KVMAP &m);
+	~KVMAP(void);
+	KVMAP	&operator=(const KVMAP &m);
+
+	iterator	begin(void) { return iterator(this, 0); }
+	iterator	end(void) { return iterator(this, m_slot.size()); }
+	size_t		size(void) const { return m_slot.size(); }
+	bool		empty(void) const { return m_slot.empty(); }
+
+	iterator	find(const STRING &ky);
+
+	// The order the std::unordered_map this replaced would visit our
+	// keys in
+	void	legacy_order(std::vector<iterator> &order);
+	// Reinsert (in legacy order only) every key added since first, taking
+	// them in the order src would visit them in
+	void	legacy_follow(unsigned first, KVMAP &src);
+	unsigned	legacy_count(void) const { return m_legacy; }
+
+	// Like the unordered_map, insert() never replaces an existing key
+	std::pair<iterator,bool>	insert(const KEYVALUE &kv) {
+		std::pair<unsigned,bool> r = add(kv.first, kv.second);
+		return std::pair<iterator,bool>(iterator(this,r.first),r.second);
+	}
+	std::pair<iterator,bool>	insert(const KVNODE &kv) {
+		std::pair<unsigned,bool> r = add(kv.first, kv.second);
+		return std::pair<iterator,bool>(iterator(this,r.first),r.second);
+	}
+
+	// Returns an iterator to the element following the one erased
+	iterator	erase(iterator it);
+	size_t		erase(const STRING &ky);
+	void		clear(void);
+};
+// }}}
+
+#endif	// KVMAP_H
@@ -51,24 +51,20 @@
 #include "msgs.h"
 
 MAPT	operator+(MAPT a, MAPT b) {
-	char	*sbuf;
-
 	switch(a.m_typ) {
 	case MAPT_STRING:
 		switch(b.m_typ) {
-		case MAPT_STRING:
-			sbuf = new char[a.u.m_s->length()
-					+b.u.m_s->length()+4];
-			sprintf(sbuf, "%s %s", a.u.m_s->c_str(),
-				b.u.m_s->c_str());
-			a.u.m_s = new STRING(sbuf);
-			delete sbuf;
-			break;
+		case MAPT_STRING: {
+			// Build the result in place, rather than sprintf()ing
+			// it into a temporary buffer first
+			STRINGP	s = new STRING;
+			s->reserve(a.u.m_s->length() + 1 + b.u.m_s->length());
+			*s += *a.u.m_s; *s += ' '; *s += *b.u.m_s;
+			a.u.m_s = s;
+			} break;
 		case	MAPT_INT:
-			sbuf = new char[a.u.m_s->length()+32];
-			sprintf(sbuf, "%s + %d", a.u.m_s->c_str(), b.u.m_v);
-			a.u.m_s = new STRING(sbuf);
-			delete sbuf;
+			a.u.m_s = new STRING(*a.u.m_s + " + "
+					+ std::to_string(b.u.m_v));
 			break;
 		case	MAPT_AST:
 			fprintf(stderr, "WARNING: Dont know how to add STRING to AST\n");
@@ -126,16 +122,14 @@ MAPT	operator+(MAPT a, MAPT b) {
 	return a;
 }
 
-MAPT	operator+(MAPT a, const STRING b) {
-	char	*sbuf;
-
+MAPT	operator+(MAPT a, const STRING &b) {
 	switch(a.m_typ) {
-	case MAPT_STRING:
-		sbuf = new char[a.u.m_s->length() +b.length()+4];
-		sprintf(sbuf, "%s %s", a.u.m_s->c_str(), b.c_str());
-		a.u.m_s = new STRING(sbuf);
-		delete sbuf;
-		break;
+	case MAPT_STRING: {
+		STRINGP	s = new STRING;
+		s->reserve(a.u.m_s->length() + 1 + b.length());
+		*s += *a.u.m_s; *s += ' '; *s += b;
+		a.u.m_s = s;
+		} break;
 	case MAPT_INT:
 		a.m_typ = MAPT_AST;
 		a.u.m_a = new AST_BRANCH( '+', new AST_NUMBER(a.u.m_v),
@@ -180,6 +174,21 @@ bool	splitkey(const STRING &ky, STRING &mkey, STRING &subky) {
 	} return false;
 }
 
+//
+// KEYPATH::split
+//
+// Split the key into components, exactly as repeated calls to splitkey()
+// would do.
+void	KEYPATH::split(void) {
+	size_t	start = 0, pos;
+
+	while(((pos = find('.', start)) != STRING::npos)
+			&&(pos != start)&&(pos < length()-1)) {
+		m_path.push_back(kvintern(substr(start, pos-start)));
+		start = pos+1;
+	} m_path.push_back(kvintern(substr(start)));
+}
+
 void	addtomap(MAPDHASH &fm, STRING ky, STRING vl) {
 	STRING	mkey, subky;
 	STRINGP	trimmed;
@@ -187,6 +196,7 @@ void	addtomap(MAPDHASH &fm, STRING ky, STRING vl) {
 	MAPT	subfm;
 	MAPDHASH::iterator	subloc = fm.end();
 
+	kvinvalidate();
 	trimmed = trim(ky);
 	if ((*trimmed)[0] == '@') {
 		STRINGP	tmp = new STRING(trimmed->substr(1));
@@ -384,7 +394,9 @@ void	mapdump(FILE *fp, MAPT &elm) {
 //
 void	mergemaps(MAPDHASH &master, MAPDHASH &sub) {
 	MAPDHASH::iterator	kvmaster, kvsub;
+	unsigned		first = master.legacy_count();
 
+	kvinvalidate();
 	for(kvsub = sub.begin(); kvsub != sub.end(); kvsub++) {
 		bool	pluskey;
 		pluskey = (kvsub->first.c_str()[0] == '+');
@@ -419,6 +431,10 @@ void	mergemaps(MAPDHASH &master, MAPDHASH &sub) {
 		} else
 			master.insert(KEYVALUE(kvsub->first, kvsub->second));
 	}
+
+	// Keys are merged in file order, but they used to be merged in hash
+	// order.  Keep track of the old order for legacy_order().
+	master.legacy_follow(first, sub);
 }
 
 /*
@@ -570,12 +586,13 @@ void	cvtint(MAPDHASH &mp, const STRING &sky) {
 				(*kvpair).second.m_typ = MAPT_INT;
 				(*kvpair).second.u.m_v=strtoul(tmps->c_str(), NULL, 0);
 				delete tmps;
+				kvnotify(sky);
 			}
 		}
 	}
 }
 
-MAPDHASH::iterator findkey_aux(MAPDHASH &master, const STRING &ky, const STRING &pre) {
+MAPDHASH::iterator findkey_aux(MAPDHASH &master, const STRING &ky) {
 	STRING	mkey, subky;
 	MAPDHASH::iterator	result;
 
@@ -585,7 +602,7 @@ MAPDHASH::iterator findkey_aux(MAPDHASH &master, const STRING &ky, const STRING
 			// Check any super classes for a definition of this key
 			if ((master.end() != (subloc = master.find(KYPLUSDOT)))
 					&&(subloc->second.m_typ == MAPT_MAP)) {
-				result = findkey_aux(*subloc->second.u.m_m, ky, pre);
+				result = findkey_aux(*subloc->second.u.m_m, ky);
 				if (result == subloc->second.u.m_m->end())
 					return master.end();
 				return result;
@@ -595,19 +612,12 @@ MAPDHASH::iterator findkey_aux(MAPDHASH &master, const STRING &ky, const STRING
 			subfm = (*subloc).second;
 
 			if (subfm.m_typ != MAPT_MAP) {
-				/*
-				fprintf(stderr, "ERR: MAP[%s.%s] isnt a map\n",
-					pre.c_str(), mkey.c_str());
-				*/
 				// assert(subfm->m_typ == MAPT_MAP)
 				return master.end();
 			}
 
-			// printf("Recursing on %s\n", mkey.c_str());
-			STRING	new_pre_key = pre+"."+mkey;
-			result = findkey_aux(*subfm.u.m_m, subky, new_pre_key);
+			result = findkey_aux(*subfm.u.m_m, subky);
 			if (result == subfm.u.m_m->end()) {
-				// printf("Subkey not found\n");
 				return master.end();
 			}
 			return result;
@@ -618,15 +628,47 @@ MAPDHASH::iterator findkey_aux(MAPDHASH &master, const STRING &ky, const STRING
 	return	result;
 }
 
+//
+// The same search as above, only using the pre-split components of the key
+// path from lvl onwards.
+MAPDHASH::iterator findkey_aux(MAPDHASH &master, const KEYPATH &ky,
+		unsigned lvl) {
+	MAPDHASH::iterator	result;
+
+	if (lvl+1 < ky.depth()) {
+		MAPDHASH::iterator	subloc = master.find(ky.part(lvl));
+		if (subloc == master.end()) {
+			// Check any super classes for a definition of this key
+			if ((master.end() != (subloc = master.find(KYPLUSDOT)))
+					&&(subloc->second.m_typ == MAPT_MAP)) {
+				result = findkey_aux(*subloc->second.u.m_m,
+						ky, lvl);
+				if (result == subloc->second.u.m_m->end())
+					return master.end();
+				return result;
+			} return subloc;
+		} else if (subloc->second.m_typ != MAPT_MAP)
+			return master.end();
+
+		MAPDHASH	*sub = subloc->second.u.m_m;
+		result = findkey_aux(*sub, ky, lvl+1);
+		if (result == sub->end())
+			return master.end();
+		return result;
+	}
+
+	return	master.find(ky.part(lvl));
+}
+
 MAPDHASH::iterator findkey(MAPDHASH &master, const STRING &ky) {
-	STRING	empty("");
-	return findkey_aux(master, ky, empty);
+	return findkey_aux(master, ky);
 }
 
-MAPDHASH *getmap(MAPDHASH &master, const STRING &ky) {
-	MAPDHASH::iterator	r;
+MAPDHASH::iterator findkey(MAPDHASH &master, const KEYPATH &ky) {
+	return findkey_aux(master, ky, 0);
+}
 
-	r = findkey(master, ky);
+static	MAPDHASH *getmap_aux(MAPDHASH &master, MAPDHASH::iterator r) {
 	if (r == master.end())
 		return NULL;
 	else if (r->second.m_typ != MAPT_MAP)
@@ -634,12 +676,26 @@ MAPDHASH *getmap(MAPDHASH &master, const STRING &ky) {
 	return r->second.u.m_m;
 }
 
+MAPDHASH *getmap(MAPDHASH &master, const STRING &ky) {
+	return getmap_aux(master, findkey(master, ky));
+}
+
+MAPDHASH *getmap(MAPDHASH &master, const KEYPATH &ky) {
+	return getmap_aux(master, findkey(master, ky));
+}
+
 MAPDHASH *getmap(MAPDHASH *mp, const STRING &ky) {
 	if (!mp)
 		return NULL;
 	return getmap(*mp, ky);
 }
 
+MAPDHASH *getmap(MAPDHASH *mp, const KEYPATH &ky) {
+	if (!mp)
+		return NULL;
+	return getmap(*mp, ky);
+}
+
 STRINGP getstring(MAPDHASH &m) {
 	MAPDHASH::iterator	r;
 
@@ -653,11 +709,10 @@ STRINGP getstring(MAPDHASH &m) {
 	} return NULL;
 }
 
-STRINGP getstring(MAPDHASH &master, const STRING &ky) {
-	MAPDHASH::iterator	r;
+static	STRINGP getstring_aux(MAPDHASH &master, MAPDHASH::iterator r,
+		const STRING &ky) {
 	STRINGP	prefix;
 
-	r = findkey(master, ky);
 	if (r == master.end())
 		return NULL;
 	else if (r->second.m_typ == MAPT_MAP) {
@@ -694,18 +749,38 @@ STRINGP getstring(MAPDHASH &master, const STRING &ky) {
 	return r->second.u.m_s;
 }
 
+STRINGP getstring(MAPDHASH &master, const STRING &ky) {
+	return getstring_aux(master, findkey(master, ky), ky);
+}
+
+STRINGP getstring(MAPDHASH &master, const KEYPATH &ky) {
+	return getstring_aux(master, findkey(master, ky), ky);
+}
+
 STRINGP getstring(MAPDHASH *m, const STRING &ky) {
 	if (!m)
 		return NULL;
 	return getstring(*m, ky);
 }
 
+STRINGP getstring(MAPDHASH *m, const KEYPATH &ky) {
+	if (!m)
+		return NULL;
+	return getstring(*m, ky);
+}
+
 STRINGP getstring(MAPT &m, const STRING &ky) {
 	if (m.m_typ != MAPT_MAP)
 		return NULL;
 	return getstring(*m.u.m_m, ky);
 }
 
+STRINGP getstring(MAPT &m, const KEYPATH &ky) {
+	if (m.m_typ != MAPT_MAP)
+		return NULL;
+	return getstring(*m.u.m_m, ky);
+}
+
 void setstring(MAPDHASH &master, const STRING &ky, STRINGP strp) {
 	MAPDHASH::iterator	kvpair, kvsub;
 
@@ -714,6 +789,14 @@ void setstring(MAPDHASH &master, const STRING &ky, STRINGP strp) {
 		return;
 	}
 
+	// A string with substitutions pending, or an expression, is something
+	// new the evaluator will need to find.  Anything else may simply be
+	// something a pending evaluation is waiting on.
+	if ((STRING::npos != strp->find("@$"))||(kvtoken(ky) == KYEXPR))
+		kvinvalidate(master);
+	else
+		kvnotify(ky);
+
 	kvpair = findkey(master, ky);
 	if (kvpair == master.end()) {
 		// The given key was not found in the hash
@@ -728,6 +811,7 @@ void setstring(MAPDHASH &master, const STRING &ky, STRINGP strp) {
 				subfm.m_typ = MAPT_MAP;
 				subfm.u.m_m = new MAPDHASH;
 				master.insert(KEYVALUE(mkey, subfm ) );
+				kvinvalidate(master);
 			} else {
 				// The map exists, let's reference it
 				subfm = (*subloc).second;
@@ -814,12 +898,10 @@ bool getvalue(MAPDHASH &map, int &value) {
 	} return false;
 }
 
-bool getvalue(MAPDHASH &master, const STRING &ky, int &value) {
-	MAPDHASH::iterator	r;
-
+static	bool getvalue_aux(MAPDHASH &master, MAPDHASH::iterator r,
+		const STRING &ky, int &value) {
 	value = -1;
 
-	r = findkey(master, ky);
 	if (r == master.end()) {
 		return false;
 	} else if (r->second.m_typ == MAPT_MAP) {
@@ -830,6 +912,7 @@ bool getvalue(MAPDHASH &master, const STRING &ky, int &value) {
 			r->second.m_typ = MAPT_INT;
 			r->second.u.m_v = ast->eval();
 			delete ast;
+			kvnotify(ky);
 		} else
 			return false;
 	} else if (r->second.m_typ == MAPT_STRING) {
@@ -842,16 +925,31 @@ bool getvalue(MAPDHASH &master, const STRING &ky, int &value) {
 	return true;
 }
 
+bool getvalue(MAPDHASH &master, const STRING &ky, int &value) {
+	return getvalue_aux(master, findkey(master, ky), ky, value);
+}
+
+bool getvalue(MAPDHASH &master, const KEYPATH &ky, int &value) {
+	return getvalue_aux(master, findkey(master, ky), ky, value);
+}
+
 bool getvalue(MAPDHASH *mp, const STRING &ky, int &value) {
 	if (!mp)
 		return false;
 	return getvalue(*mp, ky, value);
 }
 
-void	setvalue(MAPDHASH &master, const STRING &ky, int value) {
-	MAPDHASH::iterator	kvpair, kvsub;
+bool getvalue(MAPDHASH *mp, const KEYPATH &ky, int &value) {
+	if (!mp)
+		return false;
+	return getvalue(*mp, ky, value);
+}
 
-	kvpair = findkey(master, ky);
+static	void	setvalue_aux(MAPDHASH &master, MAPDHASH::iterator kvpair,
+		const STRING &ky, int value) {
+	MAPDHASH::iterator	kvsub;
+
+	kvnotify(ky);
 	if (kvpair == master.end()) {
 		STRING	mkey, subky;
 		STRINGP	trimmed;
@@ -876,6 +974,7 @@ void	setvalue(MAPDHASH &master, const STRING &ky, int value) {
 				subfm.m_typ = MAPT_MAP;
 				subfm.u.m_m = new MAPDHASH;
 				master.insert(KEYVALUE(mkey, subfm ) );
+				kvinvalidate(master);
 			} else {
 				// The map exists, let's reference it
 				subfm = (*subloc).second;
@@ -907,6 +1006,14 @@ void	setvalue(MAPDHASH &master, const STRING &ky, int value) {
 	}
 }
 
+void	setvalue(MAPDHASH &master, const STRING &ky, int value) {
+	setvalue_aux(master, findkey(master, ky), ky, value);
+}
+
+void	setvalue(MAPDHASH &master, const KEYPATH &ky, int value) {
+	setvalue_aux(master, findkey(master, ky), ky, value);
+}
+
 MAPDHASH *copy(MAPDHASH *top) {
 	MAPDHASH	*cp = new MAPDHASH();
 	MAPDHASH::iterator	kvpair;
@@ -930,6 +1037,25 @@ MAPDHASH *copy(MAPDHASH *top) {
 	} return cp;
 }
 
+//
+// freemap
+//
+// Delete a map, together with every string and map within it.  This is only
+// safe for a map that owns everything within it, such as one just returned
+// from the parser and never merged into anything else.  Expressions live in
+// gbl_region, and are released along with it instead.
+//
+void	freemap(MAPDHASH *top) {
+	MAPDHASH::iterator	kvpair;
+
+	for(kvpair = top->begin(); kvpair != top->end(); kvpair++) {
+		if (kvpair->second.m_typ == MAPT_STRING)
+			delete kvpair->second.u.m_s;
+		else if (kvpair->second.m_typ == MAPT_MAP)
+			freemap(kvpair->second.u.m_m);
+	} delete top;
+}
+
 void	flatten_maps(MAPDHASH &node, MAPDHASH &sub, STRING &here) {
 	MAPDHASH::iterator	kvpair, nodepair;
 
@@ -1058,6 +1184,7 @@ void	flatten_aux(MAPDHASH &master, MAPDHASH &sub, STRING &here) {
 
 void	flatten(MAPDHASH &master) {
 	STRING	top= STRING("");
+	kvinvalidate();
 	flatten_aux(master, master, top);
 }
 
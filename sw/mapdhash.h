@@ -47,6 +47,7 @@
 #include <assert.h>
 
 #include <string>
+#include <vector>
 #include <unordered_map>
 
 #define	MAPT_INT	0
@@ -57,7 +58,8 @@
 // #define	MAPT_SLINK	3
 
 typedef	std::string *STRINGP, STRING;
-typedef std::unordered_map<STRING,struct MAPT_S> MAPDHASH;
+class	KVMAP;
+typedef	KVMAP	MAPDHASH;
 
 typedef	struct MAPT_S {
 	int	m_typ;
@@ -72,6 +74,31 @@ typedef	struct MAPT_S {
 
 typedef	std::pair<STRING,MAPT>	KEYVALUE;
 
+#include "kvmap.h"
+
+// class KEYPATH
+// {{{
+// A key, such as any of those within keys.h, split into its dotted components
+// once when it is created rather than on every lookup.  The components are
+// interned, so the many keys sharing a component (SLAVE, MASTER, etc.) share
+// the same string for it.  Since a KEYPATH is also a STRING, it may be used
+// anywhere a STRING key can be--the overloads below simply skip splitkey().
+//
+class	KEYPATH : public STRING {
+	std::vector<const STRING *>	m_path;
+	void	split(void);
+public:
+	KEYPATH(const char *ky) : STRING(ky) { split(); }
+	explicit KEYPATH(const STRING &ky) : STRING(ky) { split(); }
+	KEYPATH(const KEYPATH &ky) : STRING(ky), m_path(ky.m_path) {}
+
+	// The number of components within the key
+	unsigned	depth(void) const { return m_path.size(); }
+	// The key's k'th component
+	const STRING	&part(unsigned k) const { return *m_path[k]; }
+};
+// }}}
+
 extern	STRING *trim(const STRING &s);
 extern	bool	splitkey(const STRING &ky, STRING &mkey, STRING &subky);
 extern	void	addtomap(MAPDHASH &fm, const STRING ky, STRING vl);
@@ -79,6 +106,8 @@ extern	void	mapdump(MAPDHASH &fm);
 extern	void	mapdump(FILE *fp, MAPDHASH &fm);
 extern	void	mapdump(FILE *fp, MAPT &elm);
 extern	void	mergemaps(MAPDHASH &master, MAPDHASH &sub);
+extern	MAPDHASH *copy(MAPDHASH *top);
+extern	void	freemap(MAPDHASH *top);
 extern	void	flatten(MAPDHASH &master);
 extern	void	trimall(MAPDHASH &mp, const STRING &sky);
 extern	void	trimbykeylist(MAPDHASH &mp, const STRING &skylist);
@@ -87,12 +116,18 @@ extern	void	cvtint(MAPDHASH &mp, const STRING &sky);
 extern	void	cvtintbykeylist(MAPDHASH &mp, const STRING &skylist);
 extern	void	cvtintbykeylist(MAPT &m, const STRING &skylist);
 extern	MAPDHASH::iterator	findkey(MAPDHASH &mp, const STRING &sky);
+extern	MAPDHASH::iterator	findkey(MAPDHASH &mp, const KEYPATH &sky);
 extern	MAPDHASH *getmap(MAPDHASH &mp, const STRING &ky);
+extern	MAPDHASH *getmap(MAPDHASH &mp, const KEYPATH &ky);
 extern	MAPDHASH *getmap(MAPDHASH *mp, const STRING &ky);
+extern	MAPDHASH *getmap(MAPDHASH *mp, const KEYPATH &ky);
 extern	STRINGP	getstring(MAPDHASH &mp);
 extern	STRINGP	getstring(MAPDHASH &mp, const STRING &sky);
+extern	STRINGP	getstring(MAPDHASH &mp, const KEYPATH &sky);
 extern	STRINGP	getstring(MAPDHASH *mp, const STRING &sky);
+extern	STRINGP	getstring(MAPDHASH *mp, const KEYPATH &sky);
 extern	STRINGP	getstring(MAPT &m, const STRING &sky);
+extern	STRINGP	getstring(MAPT &m, const KEYPATH &sky);
 extern	void	setstring(MAPDHASH &mp, const STRING &sky, STRINGP strp);
 extern	void	setstring(MAPDHASH &mp, const STRING &sky, const STRING &strp);
 extern	void	setstring(MAPDHASH *mp, const STRING &sky, STRINGP strp);
@@ -100,7 +135,10 @@ extern	void	setstring(MAPDHASH *mp, const STRING &sky, const STRING &strp);
 extern	void	setstring(MAPT &m, const STRING &sky, STRINGP strp);
 extern	bool	getvalue(MAPDHASH &mp, int &value);
 extern	bool	getvalue(MAPDHASH &mp, const STRING &sky, int &value);
+extern	bool	getvalue(MAPDHASH &mp, const KEYPATH &sky, int &value);
 extern	bool	getvalue(MAPDHASH *mp, const STRING &sky, int &value);
+extern	bool	getvalue(MAPDHASH *mp, const KEYPATH &sky, int &value);
 extern	void	setvalue(MAPDHASH &mp, const STRING &sky, int value);
+extern	void	setvalue(MAPDHASH &mp, const KEYPATH &sky, int value);
 
 #endif // MAPDHASH
@@ -0,0 +1,138 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/mmfile.cpp
+//
+// Project:	AutoFPGA, a utility for composing FPGA designs from peripherals
+// {{{
+// Purpose:	To map an input file into memory, and to then walk through it
+//		one line at a time.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+#include "mmfile.h"
+
+bool	MMFILE::open(const char *fname) {
+	struct	stat	sb;
+	int		fd;
+
+	close();
+	if ((fd = ::open(fname, O_RDONLY)) < 0)
+		return false;
+	if (fstat(fd, &sb) != 0) {
+		::close(fd);
+		return false;
+	}
+
+	if (sb.st_size > 0) {
+		void	*p = mmap(NULL, sb.st_size, PROT_READ, MAP_PRIVATE,
+					fd, 0);
+		if (p != MAP_FAILED) {
+			::close(fd);
+			m_data   = (const char *)p;
+			m_len    = sb.st_size;
+			m_mapped = true;
+			return true;
+		}
+	}
+
+	// Either the file is empty, or it can't be mapped (a pipe, perhaps).
+	// Fall back to reading it.
+	FILE	*fp = fdopen(fd, "r");
+	bool	r;
+
+	if (!fp) {
+		::close(fd);
+		return false;
+	} r = read(fp);
+	fclose(fp);
+	return r;
+}
+
+bool	MMFILE::read(FILE *fp) {
+	char	buf[4096];
+	size_t	nr;
+
+	close();
+	while((nr = fread(buf, 1, sizeof(buf), fp)) > 0)
+		m_buf.insert(m_buf.end(), buf, buf+nr);
+	if (ferror(fp)) {
+		m_buf.clear();
+		return false;
+	}
+
+	m_data = m_buf.data();
+	m_len  = m_buf.size();
+	return true;
+}
+
+void	MMFILE::close(void) {
+	if (m_mapped)
+		munmap((void *)m_data, m_len);
+	m_buf.clear();
+	m_data   = NULL;
+	m_len    = 0;
+	m_mapped = false;
+	m_pos    = 0;
+}
+
+bool	MMFILE::rawline(LINESPAN &ln) {
+	const char	*nl;
+
+	if (m_pos >= m_len)
+		return false;
+
+	ln.m_ptr = m_data + m_pos;
+	nl = (const char *)memchr(ln.m_ptr, '\n', m_len - m_pos);
+	ln.m_len = (nl) ? (nl + 1 - ln.m_ptr) : (m_len - m_pos);
+	m_pos += ln.m_len;
+
+	return true;
+}
+
+bool	MMFILE::getline(LINESPAN &ln) {
+	while(rawline(ln)) {
+		// Lines beginning with "# " or "##" are comments
+		if ((ln.m_len >= 2)&&(ln.m_ptr[0] == '#')
+				&&((isspace(ln.m_ptr[1]))||(ln.m_ptr[1] == '#')))
+			continue;
+		return true;
+	} return false;
+}
@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/mmfile.h
+//
+// Project:	AutoFPGA, a utility for composing FPGA designs from peripherals
+// {{{
+// Purpose:	A read-only view of a whole input file.  Where possible, the
+//		file is mapped into memory rather than read, so that the parser
+//	can work on spans of the file itself without copying any of it.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	MMFILE_H
+#define	MMFILE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+// struct LINESPAN
+// {{{
+// A span of characters within an MMFILE, such as one line of it.  Spans
+// remain valid for as long as the MMFILE they came from is open.
+//
+typedef	struct	LINESPAN_S {
+	const char	*m_ptr;
+	size_t		m_len;
+
+	const char	*end(void) const { return m_ptr + m_len; }
+} LINESPAN;
+// }}}
+
+class	MMFILE {
+	const char		*m_data;
+	size_t			m_len;
+	bool			m_mapped;
+	std::vector<char>	m_buf;	// Used when the file can't be mapped
+	size_t			m_pos;
+
+	MMFILE(const MMFILE &);
+	MMFILE	&operator=(const MMFILE &);
+public:
+	MMFILE(void) : m_data(NULL), m_len(0), m_mapped(false), m_pos(0) {}
+	~MMFILE(void) { close(); }
+
+	// Map the named file into memory.  Returns false on any failure.
+	bool	open(const char *fname);
+	// Read the rest of an already open file into memory
+	bool	read(FILE *fp);
+	void	close(void);
+
+	const char	*data(void) const { return m_data; }
+	size_t		size(void) const { return m_len; }
+
+	// Return the next line of the file, with its newline, in ln.  Returns
+	// false once the end of the file has been reached.
+	bool	rawline(LINESPAN &ln);
+	// As with rawline(), but skipping any comment lines
+	bool	getline(LINESPAN &ln);
+};
+
+#endif	// MMFILE_H
@@ -53,6 +53,7 @@ void	MSGS::open(const char *fname) {
 
 void	MSGS::info(const char *fmt, ...) {
 	va_list	args;
+	std::lock_guard<std::mutex>	guard(m_lock);
 
 	if (m_dump) {
 		va_start(args, fmt);
@@ -63,6 +64,7 @@ void	MSGS::info(const char *fmt, ...) {
 
 void	MSGS::userinfo(const char *fmt, ...) {
 	va_list	args;
+	std::lock_guard<std::mutex>	guard(m_lock);
 
 	if (m_dump) {
 		va_start(args, fmt);
@@ -78,6 +80,7 @@ void	MSGS::userinfo(const char *fmt, ...) {
 void	MSGS::warning(const char *fmt, ...) {
 	const	char	*prefix = "WARNING: ";
 	va_list	args;
+	std::lock_guard<std::mutex>	guard(m_lock);
 
 	if (m_dump) {
 		va_start(args, fmt);
@@ -95,6 +98,7 @@ void	MSGS::warning(const char *fmt, ...) {
 void	MSGS::error(const char *fmt, ...) {
 	const char	*prefix = "ERR: ";
 	va_list	args;
+	std::lock_guard<std::mutex>	guard(m_lock);
 
 	if (m_dump) {
 		va_start(args, fmt);
@@ -114,6 +118,7 @@ void	MSGS::error(const char *fmt, ...) {
 void	MSGS::fatal(const char *fmt, ...) {
 	const char	*prefix = "FATAL ERR: ";
 	va_list	args;
+	std::lock_guard<std::mutex>	guard(m_lock);
 
 	if (m_dump) {
 		va_start(args, fmt);
@@ -130,6 +135,20 @@ void	MSGS::fatal(const char *fmt, ...) {
 	exit(EXIT_FAILURE);
 }
 
+void	MSGS::append(FILE *fp) {
+	char	buf[4096];
+	size_t	n;
+	std::lock_guard<std::mutex>	guard(m_lock);
+
+	if (!m_dump)
+		return;
+
+	fflush(fp);
+	::rewind(fp);
+	while((n = fread(buf, 1, sizeof(buf), fp)) > 0)
+		fwrite(buf, 1, n, m_dump);
+}
+
 void	MSGS::dump(MAPDHASH &map, const char *msg) {
 	if (!m_dump)
 		return;
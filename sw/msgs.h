@@ -46,16 +46,25 @@
 
 #include <string>
 #include <unordered_map>
+#include <mutex>
 #include "mapdhash.h"
 
 class	MSGS {
 	FILE	*m_dump;
 	int	m_err;
+	// Messages may come from any thread, such as while parsing files
+	std::mutex	m_lock;
 public:
 	MSGS(void) { m_err = 0; }
 	void	open(const char *fname);
 	void	close(void) { if (m_dump) ::fclose(m_dump);  m_dump = NULL; };
 	void	flush(void) { if (m_dump) fflush(m_dump); }
+	bool	logging(void) const { return (m_dump != NULL); }
+	// Send the log to another file, returning the file it used to go to
+	FILE	*redirect(FILE *fp) { flush(); FILE *r = m_dump; m_dump = fp;
+				return r; }
+	// Copy everything written to fp (from the start) into the log
+	void	append(FILE *fp);
 	//
 	void	info(const char *, ...);
 	void	userinfo(const char *, ...);
@@ -65,6 +74,12 @@ public:
 	void	fatal(const char *, ...);
 	void	dump(MAPDHASH &map, const char *msg = NULL);
 	int	status(void) { return (m_err)?EXIT_FAILURE : EXIT_SUCCESS; }
+	// The number of errors so far, and a way to add in errors that
+	// have already been reported elsewhere (by a child process)
+	int	errcount(void) const { return m_err; }
+	void	adderrors(int n) { m_err += n; }
+	// Forget any errors reported since errcount() returned n
+	void	rewind(int n) { m_err = n; }
 };
 
 extern	MSGS	gbl_msg;
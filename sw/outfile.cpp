@@ -0,0 +1,151 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/outfile.cpp
+//
+// Project:	AutoFPGA, a utility for composing FPGA designs from peripherals
+// {{{
+// Purpose:	To write generated files, but only when their contents change.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <string>
+#include <mutex>
+#include <unordered_map>
+
+#include "outfile.h"
+#include "mmfile.h"
+#include "msgs.h"
+
+typedef	struct	OFENTRY_S {
+	std::string	m_name;
+	char		*m_buf;
+	size_t		m_len;
+} OFENTRY;
+
+// Every file currently open, so ofclose() knows where each belongs
+static	std::unordered_map<FILE *, OFENTRY *>	s_open;
+static	std::mutex				s_lock;
+
+FILE	*ofopen(const char *fname) {
+	std::string	dir(fname);
+	size_t		pos;
+	OFENTRY		*e;
+	FILE		*fp;
+
+	// The directory must be writable for the rename, and any file already
+	// there must be writable too, just as fopen(fname, "w") would require
+	pos = dir.rfind('/');
+	dir = (pos == std::string::npos) ? "." : dir.substr(0, pos+1);
+	if ((access(dir.c_str(), W_OK) != 0)
+			||((access(fname, F_OK) == 0)&&(access(fname, W_OK) != 0)))
+		return NULL;
+
+	e = new OFENTRY;
+	e->m_name = fname;
+	e->m_buf  = NULL;
+	e->m_len  = 0;
+	if (NULL == (fp = open_memstream(&e->m_buf, &e->m_len))) {
+		delete e;
+		return NULL;
+	}
+
+	std::lock_guard<std::mutex>	guard(s_lock);
+	s_open[fp] = e;
+	return fp;
+}
+
+// Returns true if the file fname already holds exactly these contents
+static	bool	same(const char *fname, const char *buf, size_t len) {
+	MMFILE	mf;
+
+	if (!mf.open(fname))
+		return false;
+	return (mf.size() == len)&&(memcmp(mf.data(), buf, len) == 0);
+}
+
+// Write the file out under a temporary name, and then rename it into place
+static	bool	replace(const char *fname, const char *buf, size_t len) {
+	std::string	tmpname = std::string(fname) + ".tmp"
+				+ std::to_string(getpid());
+	struct	stat	sb;
+	FILE	*fp;
+	bool	ok;
+
+	if (NULL == (fp = fopen(tmpname.c_str(), "w")))
+		return false;
+	ok = (fwrite(buf, 1, len, fp) == len);
+	// Keep the permissions of any file being replaced
+	if ((ok)&&(stat(fname, &sb) == 0))
+		fchmod(fileno(fp), sb.st_mode & 07777);
+	ok = (fclose(fp) == 0) && ok;
+	if ((ok)&&(rename(tmpname.c_str(), fname) == 0))
+		return true;
+
+	unlink(tmpname.c_str());
+	return false;
+}
+
+int	ofclose(FILE *fp) {
+	OFENTRY	*e;
+	int	r = 0;
+
+	{
+		std::lock_guard<std::mutex>	guard(s_lock);
+		std::unordered_map<FILE *, OFENTRY *>::iterator	it;
+
+		it = s_open.find(fp);
+		if (it == s_open.end())
+			return fclose(fp);
+		e = it->second;
+		s_open.erase(it);
+	}
+
+	if (fclose(fp) != 0) {
+		gbl_msg.error("Could not build %s\n", e->m_name.c_str());
+		r = EOF;
+	} else if (same(e->m_name.c_str(), e->m_buf, e->m_len)) {
+		gbl_msg.info("%s is unchanged\n", e->m_name.c_str());
+	} else if (!replace(e->m_name.c_str(), e->m_buf, e->m_len)) {
+		gbl_msg.error("Could not write %s\n", e->m_name.c_str());
+		r = EOF;
+	}
+
+	free(e->m_buf);
+	delete e;
+	return r;
+}
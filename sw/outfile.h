@@ -0,0 +1,54 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/outfile.h
+//
+// Project:	AutoFPGA, a utility for composing FPGA designs from peripherals
+// {{{
+// Purpose:	Output products are first written into memory, and only then
+//		compared against whatever is already on disk.  Files whose
+//	contents haven't changed are left alone, so their time stamps don't
+//	change either, and make doesn't then rebuild everything that depends
+//	upon them.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	OUTFILE_H
+#define	OUTFILE_H
+
+#include <stdio.h>
+
+// Use these in place of fopen(fname, "w") and fclose() for any generated
+// file.  ofopen() returns NULL if the file could not later be written.
+// ofclose() returns zero on success, EOF otherwise.
+extern	FILE	*ofopen(const char *fname);
+extern	int	ofclose(FILE *fp);
+
+#endif	// OUTFILE_H
@@ -47,8 +47,13 @@
 #include <fcntl.h>
 #include <assert.h>
 
+#include <atomic>
+#include <thread>
+
 #include "mapdhash.h"
 #include "parser.h"
+#include "mmfile.h"
+#include "pcache.h"
 #include "keys.h"
 #include "msgs.h"
 
@@ -92,12 +97,58 @@ STRING	*getline(FILE *fp) {
 	return r;
 }
 
-bool	iskeyline(STRING &s) {
-	if (s.compare(0,3,STRING("@$("))==0)
+static	bool	iskeyline(const LINESPAN &ln) {
+	if ((ln.m_len >= 3)&&(strncmp(ln.m_ptr, "@$(", 3)==0))
 		return false;
-	return ((s[0] == '@')&&(s[1] != '@'));
+	return ((ln.m_len >= 1)&&(ln.m_ptr[0] == '@')
+		&&((ln.m_len < 2)||(ln.m_ptr[1] != '@')));
+}
+
+// Remove any white space from either end of a span, as trim() would
+static	void	trimspan(LINESPAN &s) {
+	while((s.m_len > 0)&&(isspace(s.m_ptr[0]))) {
+		s.m_ptr++;
+		s.m_len--;
+	} while((s.m_len > 0)&&(isspace(s.m_ptr[s.m_len-1])))
+		s.m_len--;
 }
 
+// class VALUEBUF
+// {{{
+// Accumulates a (possibly multi-line) value.  So long as the lines appended
+// follow each other within the file, the value is kept as a single span of
+// the file.  It is only copied into a string when something breaks up that
+// span (a comment line, for example), or once the value is complete.
+//
+class	VALUEBUF {
+	STRING		m_str;
+	LINESPAN	m_span;
+
+	void	flush(void) {
+		if (m_span.m_len > 0)
+			m_str.append(m_span.m_ptr, m_span.m_len);
+		m_span.m_len = 0;
+	}
+public:
+	VALUEBUF(void) { m_span.m_ptr = NULL; m_span.m_len = 0; }
+
+	void	clear(void) { m_str.clear(); m_span.m_len = 0; }
+	void	append(const LINESPAN &ln) {
+		if (ln.m_len == 0)
+			return;
+		if ((m_span.m_len > 0)&&(ln.m_ptr == m_span.end())) {
+			m_span.m_len += ln.m_len;
+			return;
+		}
+
+		flush();
+		m_span = ln;
+	}
+
+	STRING	&str(void) { flush(); return m_str; }
+};
+// }}}
+
 MAPDHASH	*genhash(STRING &prefix) {
 	MAPDHASH	*devm;
 	MAPT	elm;
@@ -179,52 +230,61 @@ void	process_keyvalue_pair(MAPDHASH *parent, const STRING &search, STRING &key,
 }
 
 
-MAPDHASH	*parsefile(FILE *fp, const STRING &search) {
-	STRING		key, value, *ln, prefix;
-	MAPDHASH	*fm = new MAPDHASH, *devm = NULL;
-	size_t		pos;
+// While parsing a file that is to be cached, s_deps collects every file it
+// includes, and s_clean is cleared by anything (an error, a warning) that
+// would not be repeated were the file to be loaded from the cache instead.
+static	thread_local	std::vector<PCDEP>	*s_deps = NULL;
+static	thread_local	bool			s_clean;
 
-	key = ""; value = "";
-	while(NULL != (ln = getline(fp))) {
-		if (iskeyline(*ln)) {
+// Store a completed key-value pair
+static	void	storekey(MAPDHASH *fm, MAPDHASH *&devm, const STRING &search,
+		STRING &key, STRING &value) {
+	MAPDHASH	*parent;
 
-			// We may have a completed key-value pair that needs
-			// to be stored.
-			if (key.length() > 0) {
+	// If it's a PREFIX key, create a sub hash of the FILE's hash
+	if (key == KYPREFIX) {
+		MAPDHASH	*sub;
+		sub = gensubhash(fm, value);
+		if (sub)
+			devm = sub;
+	}
 
-				// A key exists.  Let's store it.
+	if (devm)
+		parent = devm;
+	else
+		parent = fm;
 
-				// If it's a PREFIX key, create a sub hash of
-				// the FILE's hash
-				if (key == KYPREFIX) {
-					MAPDHASH	*sub;
-					sub = gensubhash(fm, value);
-					if (sub)
-						devm = sub;
-				}
+	process_keyvalue_pair(parent, search, key, value);
+}
 
-				MAPDHASH	*parent;
-				if (devm)
-					parent = devm;
-				else
-					parent = fm;
+static	MAPDHASH	*parsemmfile(MMFILE &mf, const STRING &search) {
+	STRING		key;
+	VALUEBUF	value;
+	LINESPAN	ln;
+	MAPDHASH	*fm = new MAPDHASH, *devm = NULL;
+	const char	*eq;
 
+	while(mf.getline(ln)) {
+		if (iskeyline(ln)) {
 
-				// Process the old key
-				process_keyvalue_pair(parent, search, key, value);
-			}
+			// We may have a completed key-value pair that needs
+			// to be stored.
+			if (key.length() > 0)
+				storekey(fm, devm, search, key, value.str());
 
-				//
-			if ((pos = ln->find("="))
-					&&(pos != STRING::npos)) {
+			value.clear();
+			if (NULL != (eq = (const char *)memchr(ln.m_ptr, '=',
+							ln.m_len))) {
+				LINESPAN	vl;
 
 				// Separate the key from its value
-				key   = ln->substr(1, pos-1);
+				key = STRING(ln.m_ptr+1, eq-ln.m_ptr-1);
 
 				// If we have a @KEY += line, then place the
 				// plus in front of the key.  @+KEY is an
 				// invalid key, so ... this should work.
-				if (key.c_str()[(key.size())-1] == '+') {
+				if ((key.size() > 0)
+					&&(key.c_str()[(key.size())-1] == '+')) {
 					// Our key takes the + off the right,
 					// and adds it to the left
 					key = STRING("+")+key.substr(0,key.size()-1);
@@ -238,106 +298,159 @@ MAPDHASH	*parsefile(FILE *fp, const STRING &search) {
 
 				// Trim any whitespace from the value on this
 				// line
-				trimd = trim(ln->substr(pos+1));
-				value = STRING(*trimd);
-				delete	trimd;
+				vl.m_ptr = eq+1;
+				vl.m_len = ln.end() - vl.m_ptr;
+				trimspan(vl);
+				value.append(vl);
 			} else {
 				// If we have a key with no "=" sign,
 				// assume the whole line is the key.
 				// Trim it up.
-				key = ln->substr(1, ln->length()-1);
-				STRINGP	trimd;
-				trimd = trim(key);
-				key   = STRING(*trimd);
-				delete trimd;
+				LINESPAN	ky;
+
+				ky.m_ptr = ln.m_ptr+1;
+				ky.m_len = ln.m_len-1;
+				trimspan(ky);
+				key = STRING(ky.m_ptr, ky.m_len);
 
 				gbl_msg.warning("Key line with no =, key was %s\n", key.c_str());
-				value = "";
+				s_clean = false;
 			}
 
-		} else if (ln->c_str()[0]) {
-			value = value + (*ln);
-		}
-
-		delete ln;
-	} if (key.length()>0) {
-		if (key == KYPREFIX) {
-			MAPDHASH	*sub;
-			sub = gensubhash(fm, value);
-			if (sub)
-				devm = sub;
-		}
-
-
-		MAPDHASH	*parent;
+		} else if (ln.m_ptr[0])
+			value.append(ln);
+	} if (key.length()>0)
+		storekey(fm, devm, search, key, value.str());
 
-		if (devm)
-			parent = devm;
-		else
-			parent = fm;
+	return fm;
+}
 
-		process_keyvalue_pair(parent, search, key, value);
-	}
+MAPDHASH	*parsefile(FILE *fp, const STRING &search) {
+	MMFILE	mf;
 
-	return fm;
+	if (!mf.read(fp))
+		return new MAPDHASH;
+	return parsemmfile(mf, search);
 }
 
-FILE	*open_data_file(const char *fname) {
+static	bool	isdatafile(const char *fname) {
 	struct	stat	sb;
-	if ((access(fname, R_OK)!=0)||(stat(fname, &sb) != 0)) {
-		return NULL;
-	} else {
-		if (sb.st_mode & S_IFREG)
-			return fopen(fname, "r");
-	} return NULL;
+	if ((access(fname, R_OK)!=0)||(stat(fname, &sb) != 0))
+		return false;
+	return (sb.st_mode & S_IFREG) ? true : false;
 }
 
-FILE	*search_and_open(const char *fname, const STRING &search) {
-	FILE	*fp = open_data_file(fname);
-
-	if ((fp == NULL)&&(fname[0] != '/')&&(fname[0] != '.')) {
+// Find a file along the given search path, returning its full name in path
+static	bool	search_for(const char *fname, const STRING &search,
+		STRING &path) {
+	if (isdatafile(fname)) {
+		gbl_msg.info("Directly opened: %s\n", fname);
+		path = fname;
+		return true;
+	} else if ((fname[0] != '/')&&(fname[0] != '.')) {
 		STRING	copy = search;
-		char	*sub = (char *)copy.c_str();
-		char	*dir = strtok(sub, ", \t\n:");
+		char	*sub = (char *)copy.c_str(), *save;
+		char	*dir = strtok_r(sub, ", \t\n:", &save);
 		while(dir != NULL) {
-			char	*full = new char[strlen(fname)+2+strlen(dir)];
-			strcpy(full, dir);
-			strcat(full, "/");
-			strcat(full, fname);
-			if (NULL != (fp=open_data_file(full))) {
-				gbl_msg.info("Opened: %s\n", full);
-				delete[] full;
-				return fp;
-			} delete[] full;
-			dir = strtok(NULL, ", \t\n:");
+			path = STRING(dir) + "/" + fname;
+			if (isdatafile(path.c_str())) {
+				gbl_msg.info("Opened: %s\n", path.c_str());
+				return true;
+			}
+			dir = strtok_r(NULL, ", \t\n:", &save);
 		}
 
 		gbl_msg.error("Could not open %s\nSearched through %s\n",
 			fname, search.c_str());
-		return NULL;
+		return false;
 	}
 
 	gbl_msg.info("Directly opened: %s\n", fname);
-	return fp;
+	return false;
 }
 
-MAPDHASH	*parsefile(const char *fname, const STRING &search) {
+MAPDHASH	*parsefile(const char *fname, const STRING &search,
+		std::vector<PCDEP> &deps) {
+	STRING		path;
+	MMFILE		mf;
 	MAPDHASH	*map;
-	FILE		*fp = search_and_open(fname, search);
+	PCDEP		self;
 
-	if (fp == NULL) {
+	deps.clear();
+	if ((!search_for(fname, search, path))||(!mf.open(path.c_str()))) {
 		gbl_msg.error("PARSE-ERR: Could not open %s\n"
 			"\t  Searched through: %s\n", fname, search.c_str());
+		s_clean = false;
 		return NULL;
-	} else {
-		map = parsefile(fp, search);
-		fclose(fp);
+	}
+
+	self.m_path = path;
+	self.m_hash = 0;
+	if (pcache_enabled())
+		self.m_hash = pcache_hash(mf.data(), mf.size());
+
+	if (s_deps) {
+		// An included file.  It belongs to the file that included it.
+		s_deps->push_back(self);
+		return parsemmfile(mf, search);
+	}
 
-		return map;
+	if ((!pcache_enabled())||(NULL == (map = pcache_load(path,
+					self.m_hash, search, deps)))) {
+		s_deps  = &deps;
+		s_clean = true;
+		map = parsemmfile(mf, search);
+		s_deps  = NULL;
+
+		if ((pcache_enabled())&&(s_clean))
+			pcache_store(path, self.m_hash, search, deps, *map);
 	}
+
+	deps.insert(deps.begin(), self);
+	return map;
+}
+
+MAPDHASH	*parsefile(const char *fname, const STRING &search) {
+	std::vector<PCDEP>	deps;
+
+	return parsefile(fname, search, deps);
 }
 
 MAPDHASH	*parsefile(const STRING &fname, const STRING &search) {
 	return parsefile((const char *)fname.c_str(), search);
 }
 
+
+//
+// parsefiles
+//
+// Parse a whole list of files, each into its own hash.  Since the files are
+// independent of each other until they are merged, they are parsed on a
+// pool of threads, each thread taking the next unparsed file from the list.
+// Merging the results, in order, is left to the caller.
+//
+void	parsefiles(std::vector<PARSEJOB> &jobs) {
+	std::atomic<unsigned>	next(0);
+	std::vector<std::thread>	pool;
+	unsigned	nthreads = std::thread::hardware_concurrency();
+
+	auto	worker = [&jobs, &next](void) {
+		unsigned	k;
+
+		while((k = next++) < jobs.size())
+			jobs[k].m_hash = parsefile(jobs[k].m_fname,
+					jobs[k].m_search, jobs[k].m_deps);
+	};
+
+	if (nthreads < 1)
+		nthreads = 1;
+	if (nthreads > jobs.size())
+		nthreads = jobs.size();
+
+	// The calling thread does its share of the work too
+	for(unsigned k=1; k<nthreads; k++)
+		pool.push_back(std::thread(worker));
+	worker();
+	for(unsigned k=0; k<pool.size(); k++)
+		pool[k].join();
+}
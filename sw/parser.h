@@ -47,12 +47,28 @@
 #include <string.h>
 #include <assert.h>
 
+#include <vector>
+
 #include "mapdhash.h"
+#include "pcache.h"
+
+// One input file to be parsed by parsefiles(), together with the search path
+// to look for it within.  m_hash is filled in with the result, and m_deps
+// with the file found followed by every file it included.
+typedef	struct	PARSEJOB_S {
+	const char	*m_fname;
+	STRING		m_search;
+	MAPDHASH	*m_hash;
+	std::vector<PCDEP>	m_deps;
+} PARSEJOB;
 
 extern	STRING	*rawline(FILE *fp);
 extern	STRING	*getline(FILE *fp);
 extern	MAPDHASH	*parsefile(FILE *fp, const STRING &search="");
 extern	MAPDHASH	*parsefile(const char *fname, const STRING &search="");
+extern	MAPDHASH	*parsefile(const char *fname, const STRING &search,
+				std::vector<PCDEP> &deps);
 extern	MAPDHASH	*parsefile(const STRING &fname, const STRING &search="");
+extern	void		parsefiles(std::vector<PARSEJOB> &jobs);
 
 #endif
@@ -0,0 +1,525 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/patch.cpp
+//
+// Project:	AutoFPGA, a utility for composing FPGA designs from peripherals
+// {{{
+// Purpose:	Applies a change to one input file directly to the resolved
+//		design, where doing so is safe.  Only the keys holding text for
+//		the output files (MAIN.INSERT, SIM.TICK, BDEF.DEFN, and the
+//		like) are ever patched this way.  No pass between parsing and
+//		writing the design reads any of them, so bus, clock, interrupt
+//		and address assignments all remain just as they were, and only
+//		the text itself (and any text that referenced it) needs to be
+//		evaluated again.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include <string>
+#include <vector>
+#include <set>
+#include <unordered_set>
+
+#include "parser.h"
+#include "mapdhash.h"
+#include "keys.h"
+#include "kveval.h"
+#include "ast.h"
+#include "msgs.h"
+#include "patch.h"
+
+// The groups of keys, within a component, holding only text for the output
+// files
+static	const char	*s_textkeys[] = {
+	"MAIN", "TOP", "SIM", "BDEF", "REGDEFS", "RTL", "OUT", "LD",
+	"XDC", "PCF", "LPF", "UCF", NULL };
+
+// A key found within one of the parsed files
+typedef	struct	PATCHKEY_S {
+	unsigned		m_job;	// Which file it was found within
+	STRING			m_key;	// Its full, dotted, name
+	std::vector<STRING>	m_path;	// That name, split at each dot
+} PATCHKEY;
+
+static	void	splitpath(const STRING &ky, std::vector<STRING> &path) {
+	// {{{
+	size_t	start = 0, pos;
+
+	path.clear();
+	do {
+		pos = ky.find('.', start);
+		path.push_back(ky.substr(start, (pos == STRING::npos)
+					? STRING::npos : pos-start));
+		start = pos+1;
+	} while(pos != STRING::npos);
+}
+// }}}
+
+//
+// lookup
+//
+// Find a key within a parsed file, without looking through any "+" maps for
+// it the way findkey() would.  Returns NULL if the key isn't there.
+static	MAPT	*lookup(MAPDHASH *top, const std::vector<STRING> &path) {
+	// {{{
+	MAPDHASH::iterator	kvpair;
+
+	for(unsigned k=0; k<path.size(); k++) {
+		kvpair = top->find(path[k]);
+		if (kvpair == top->end())
+			return NULL;
+		if (k+1 == path.size())
+			return &kvpair->second;
+		if (kvpair->second.m_typ != MAPT_MAP)
+			return NULL;
+		top = kvpair->second.u.m_m;
+	} return NULL;
+}
+// }}}
+
+static	STRING	asttext(AST *ast) {
+	// {{{
+	char	*buf = NULL;
+	size_t	len = 0;
+	FILE	*fp;
+	STRING	result;
+
+	if (NULL != (fp = open_memstream(&buf, &len))) {
+		ast->dump(fp, 0);
+		fclose(fp);
+		result = STRING(buf, len);
+	} free(buf);
+
+	return result;
+}
+// }}}
+
+static	bool	samevalue(MAPT &a, MAPT &b) {
+	// {{{
+	if (a.m_typ != b.m_typ)
+		return false;
+	switch(a.m_typ) {
+	case MAPT_INT:		return a.u.m_v == b.u.m_v;
+	case MAPT_STRING:	return *a.u.m_s == *b.u.m_s;
+	case MAPT_AST:		return asttext(a.u.m_a) == asttext(b.u.m_a);
+	default:		return false;
+	}
+}
+// }}}
+
+//
+// diffmaps
+//
+// List the full name of every key found in one map, but not the other, or
+// whose value differs between them.  A map found in only one is listed by its
+// own name, rather than by every key within it.
+static	void	diffmaps(MAPDHASH *a, MAPDHASH *b, const STRING &here,
+		std::vector<STRING> &changes) {
+	// {{{
+	MAPDHASH::iterator	kva, kvb;
+
+	for(kva = a->begin(); kva != a->end(); kva++) {
+		STRING	ky = (here.size() > 0) ? (here + "." + kva->first)
+					: kva->first;
+
+		kvb = b->find(kva->first);
+		if (kvb == b->end())
+			changes.push_back(ky);
+		else if ((kva->second.m_typ == MAPT_MAP)
+				&&(kvb->second.m_typ == MAPT_MAP))
+			diffmaps(kva->second.u.m_m, kvb->second.u.m_m, ky,
+				changes);
+		else if (!samevalue(kva->second, kvb->second))
+			changes.push_back(ky);
+	}
+
+	for(kvb = b->begin(); kvb != b->end(); kvb++) {
+		if (a->end() == a->find(kvb->first))
+			changes.push_back((here.size() > 0)
+				? (here + "." + kvb->first) : kvb->first);
+	}
+}
+// }}}
+
+// Keys beginning with any of these are handled specially by the parser, by
+// mergemaps(), or by flatten()
+static	bool	plainkey(const STRING &ky) {
+	return (ky.size() > 0)&&(NULL == strchr("+/$!@", ky[0]));
+}
+
+// Is this value nothing but text?
+static	bool	textvalue(MAPT &elm) {
+	// {{{
+	MAPDHASH::iterator	kvpair;
+
+	if (elm.m_typ == MAPT_STRING)
+		return true;
+	if (elm.m_typ != MAPT_MAP)
+		return false;
+
+	for(kvpair = elm.u.m_m->begin(); kvpair != elm.u.m_m->end(); kvpair++)
+		if ((!plainkey(kvpair->first))||(!textvalue(kvpair->second)))
+			return false;
+	return true;
+}
+// }}}
+
+//
+// inherits
+//
+// Is there a "+" map (from an @INCLUDEFILE), or a "+" key, anywhere along the
+// path to this key within a parsed file?  mergemaps() or flatten() might then
+// combine something else with it.
+static	bool	inherits(MAPDHASH *top, const std::vector<STRING> &path) {
+	// {{{
+	MAPDHASH::iterator	kvpair;
+
+	for(unsigned k=0; k<path.size(); k++) {
+		if ((top->end() != top->find(KYPLUSDOT))
+				||(top->end() != top->find("+" + path[k])))
+			return true;
+		kvpair = top->find(path[k]);
+		if ((kvpair == top->end())||(kvpair->second.m_typ != MAPT_MAP))
+			return false;
+		top = kvpair->second.u.m_m;
+	} return false;
+}
+// }}}
+
+// Does this (parsed) component define its own @PREFIX?
+static	bool	iscomponent(MAPDHASH *top, const STRING &name) {
+	// {{{
+	MAPDHASH::iterator	kvpair = top->find(name);
+
+	return (kvpair != top->end())&&(kvpair->second.m_typ == MAPT_MAP)
+		&&(kvpair->second.u.m_m->end()
+				!= kvpair->second.u.m_m->find(KYPREFIX));
+}
+// }}}
+
+//
+// patchable
+//
+// Can this key be patched into the master without building the design again?
+// It needs to hold only text for the output files, found within a component
+// whose shape isn't otherwise changing, and nothing may be merged into it
+// from anywhere else.
+static	bool	patchable(MAPDHASH &master, std::vector<MAPDHASH *> &files,
+		MAPDHASH *old, const PATCHKEY &pk,
+		const std::set<STRING> &intkeys) {
+	// {{{
+	const std::vector<STRING>	&path = pk.m_path;
+	MAPDHASH	*now = files[pk.m_job];
+	MAPT		*elm;
+	bool		text = false;
+
+	if (path.size() < 2)
+		return false;
+	for(unsigned k=0; k<path.size(); k++)
+		if (!plainkey(path[k]))
+			return false;
+	for(unsigned k=0; s_textkeys[k]; k++)
+		text = text || (path[1] == s_textkeys[k]);
+	if ((!text)||(intkeys.count(path[path.size()-1]) > 0))
+		return false;
+
+	if ((!iscomponent(now, path[0]))||((old)&&(!iscomponent(old, path[0]))))
+		return false;
+	if ((NULL != (elm = lookup(now, path)))&&(!textvalue(*elm)))
+		return false;
+
+	// The key's value must come from this one file, and from this one
+	// key within it, alone
+	if ((inherits(now, path))||((old)&&(inherits(old, path))))
+		return false;
+	for(unsigned j=0; j<files.size(); j++) {
+		if ((j == pk.m_job)||(NULL == files[j]))
+			continue;
+		if ((inherits(files[j], path))||(NULL != lookup(files[j], path)))
+			return false;
+	}
+
+	// Every map along the way, within the master, must be a map
+	MAPDHASH	*top = &master;
+	for(unsigned k=0; k+1<path.size(); k++) {
+		MAPDHASH::iterator	kvpair = top->find(path[k]);
+
+		if (kvpair == top->end())
+			// Only the component itself must already exist
+			return (k > 0);
+		if (kvpair->second.m_typ != MAPT_MAP)
+			return false;
+		top = kvpair->second.u.m_m;
+	}
+
+	return true;
+}
+// }}}
+
+// Collect the name of this key, together with every key beneath it, as
+// kvtoken() would find them
+static	void	keynames(const STRING &ky, MAPT *elm, std::set<STRING> &names) {
+	// {{{
+	MAPDHASH::iterator	kvpair;
+
+	names.insert(kvtoken(ky));
+	if ((NULL == elm)||(elm->m_typ != MAPT_MAP))
+		return;
+	for(kvpair = elm->u.m_m->begin(); kvpair != elm->u.m_m->end();
+			kvpair++)
+		keynames(kvpair->first, &kvpair->second, names);
+}
+// }}}
+
+//
+// references
+//
+// Does any @$(KEY) reference, within this text, name one of the given keys?
+// Only the last component of each reference is compared, since a reference
+// may be found relative to any component.
+static	bool	references(const STRING &str, const std::set<STRING> &names) {
+	// {{{
+	size_t	pos = 0;
+
+	while(STRING::npos != (pos = str.find("@$", pos))) {
+		const char	*ptr = str.c_str() + pos + 2, *start;
+
+		pos += 2;
+		if (*ptr == '[') {
+			while((*ptr)&&(*ptr != ']'))
+				ptr++;
+			if (*ptr)
+				ptr++;
+		} if (*ptr == '(')
+			ptr++;
+		start = ptr;
+		if ((*ptr == '+')||(*ptr == '!')||(*ptr == '/'))
+			ptr++;
+		while((isalnum(*ptr))||(*ptr == '_')||(*ptr == '.'))
+			ptr++;
+		if ((ptr > start)&&(names.count(kvtoken(STRING(start,
+						ptr-start))) > 0))
+			return true;
+	} return false;
+}
+// }}}
+
+//
+// dependents
+//
+// Find every key within a parsed file whose value might refer to any of the
+// given keys.  Text refers to them through @$(KEY) references, expressions by
+// name.
+static	void	dependents(MAPDHASH *m, const STRING &here, unsigned job,
+		const std::set<STRING> &names, std::vector<PATCHKEY> &found) {
+	// {{{
+	MAPDHASH::iterator	kvpair;
+
+	for(kvpair = m->begin(); kvpair != m->end(); kvpair++) {
+		STRING	ky = (here.size() > 0) ? (here + "." + kvpair->first)
+					: kvpair->first;
+		bool	refers = false;
+
+		if (kvpair->second.m_typ == MAPT_MAP) {
+			dependents(kvpair->second.u.m_m, ky, job, names, found);
+			continue;
+		} else if (kvpair->second.m_typ == MAPT_STRING)
+			refers = references(*kvpair->second.u.m_s, names);
+		else if (kvpair->second.m_typ == MAPT_AST) {
+			STRING	text = asttext(kvpair->second.u.m_a);
+
+			for(const STRING &name : names) {
+				if (STRING::npos != text.find(name)) {
+					refers = true;
+					break;
+				}
+			}
+		}
+
+		if (refers) {
+			PATCHKEY	pk;
+
+			pk.m_job = job;
+			pk.m_key = ky;
+			splitpath(ky, pk.m_path);
+			found.push_back(pk);
+		}
+	}
+}
+// }}}
+
+//
+// putkey
+//
+// Place a copy of a parsed value into the master, at the given key, replacing
+// whatever may have been there before.  With no value, the key is removed.
+// Returns the component the key was found within.
+static	MAPDHASH *putkey(MAPDHASH &master, const std::vector<STRING> &path,
+		MAPT *value) {
+	// {{{
+	MAPDHASH		*top = &master, *comp = NULL;
+	MAPDHASH::iterator	kvpair;
+
+	for(unsigned k=0; k+1<path.size(); k++) {
+		kvpair = top->find(path[k]);
+		if (kvpair == top->end()) {
+			MAPT	elm;
+
+			if (NULL == value)
+				return comp;
+			elm.m_typ = MAPT_MAP;
+			elm.u.m_m = new MAPDHASH;
+			kvpair = top->insert(KEYVALUE(path[k], elm)).first;
+		}
+
+		top = kvpair->second.u.m_m;
+		if (k == 0)
+			comp = top;
+	}
+
+	kvpair = top->find(path[path.size()-1]);
+	if (NULL == value) {
+		if (kvpair != top->end())
+			top->erase(kvpair);
+		return comp;
+	}
+
+	MAPT	elm;
+	elm.m_typ = value->m_typ;
+	if (value->m_typ == MAPT_STRING)
+		elm.u.m_s = new STRING(*value->u.m_s);
+	else
+		elm.u.m_m = copy(value->u.m_m);
+
+	if (kvpair == top->end())
+		top->insert(KEYVALUE(path[path.size()-1], elm));
+	else
+		kvpair->second = elm;
+
+	return comp;
+}
+// }}}
+
+int	patch_design(MAPDHASH &master, std::vector<PARSEJOB> &jobs, unsigned k,
+		MAPDHASH *fresh) {
+	// {{{
+	std::vector<MAPDHASH *>	files;
+	std::vector<STRING>	changes;
+	std::vector<PATCHKEY>	keys;
+	std::unordered_set<STRING>	seen;
+	std::set<STRING>	names, intkeys;
+	MAPDHASH		*old = jobs[k].m_hash;
+	STRINGP			str;
+
+	if ((NULL == old)||(NULL == fresh))
+		return -1;
+
+	for(unsigned j=0; j<jobs.size(); j++)
+		files.push_back((j == k) ? fresh : jobs[j].m_hash);
+
+	// Keys converted into integers, by cvtintbykeylist(), are no longer
+	// the text they were parsed as
+	if (NULL != (str = getstring(master, KYKEYS_INTLIST))) {
+		STRING	list = *str;
+		char	*save, *tok;
+
+		tok = strtok_r((char *)list.c_str(), ", \t\n", &save);
+		for(; tok; tok = strtok_r(NULL, ", \t\n", &save))
+			intkeys.insert(kvtoken(tok));
+	}
+
+	diffmaps(old, fresh, STRING(""), changes);
+	for(unsigned c=0; c<changes.size(); c++) {
+		PATCHKEY	pk;
+
+		pk.m_job = k;
+		pk.m_key = changes[c];
+		splitpath(changes[c], pk.m_path);
+		keys.push_back(pk);
+		seen.insert(std::to_string(k) + ":" + pk.m_key);
+	}
+
+	// Anything that referred to a changed key will need to be evaluated
+	// again, from the text it was parsed from--as will anything that
+	// referred to that, and so on.
+	for(unsigned first = 0; first < keys.size(); ) {
+		std::vector<PATCHKEY>	found;
+
+		for(unsigned p=first; p<keys.size(); p++) {
+			MAPT	*elm = lookup(files[keys[p].m_job], keys[p].m_path);
+
+			if (NULL == elm)
+				elm = lookup(old, keys[p].m_path);
+			keynames(keys[p].m_key, elm, names);
+		} first = keys.size();
+
+		for(unsigned j=0; j<files.size(); j++)
+			if (files[j])
+				dependents(files[j], STRING(""), j, names, found);
+		for(unsigned f=0; f<found.size(); f++) {
+			if (seen.insert(std::to_string(found[f].m_job) + ":"
+					+ found[f].m_key).second)
+				keys.push_back(found[f]);
+		}
+	}
+
+	for(unsigned p=0; p<keys.size(); p++) {
+		if (!patchable(master, files, (keys[p].m_job == k) ? old : NULL,
+				keys[p], intkeys)) {
+			gbl_msg.info("PATCH: %s cannot be patched\n",
+				keys[p].m_key.c_str());
+			return -1;
+		}
+	}
+
+	// Now that everything is known to be safe, make the changes
+	std::set<MAPDHASH *>	comps;
+	for(unsigned p=0; p<keys.size(); p++) {
+		gbl_msg.info("PATCH: %s\n", keys[p].m_key.c_str());
+		comps.insert(putkey(master, keys[p].m_path,
+			lookup(files[keys[p].m_job], keys[p].m_path)));
+	}
+
+	for(MAPDHASH *comp : comps)
+		kvinvalidate(*comp);
+	if (keys.size() > 0)
+		reeval(master);
+
+	freemap(old);
+	jobs[k].m_hash = fresh;
+
+	return keys.size();
+}
+// }}}
@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/patch.h
+//
+// Project:	AutoFPGA, a utility for composing FPGA designs from peripherals
+// {{{
+// Purpose:	Brings a design, already resolved, up to date with a newly
+//		parsed version of one of its input files--so long as all that
+//		changed was text headed for the output files.  Used by
+//		autofpga --watch, so that most edits need not rebuild the
+//		entire design.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+#ifndef	PATCH_H
+#define	PATCH_H
+
+#include <vector>
+
+#include "mapdhash.h"
+#include "parser.h"
+
+//
+// Bring master, resolved from the files in jobs, up to date with fresh--a new
+// parse of jobs[k].  Returns the number of keys that changed, after which
+// fresh has replaced jobs[k].m_hash.  Returns -1, having changed nothing, if
+// the change might reach anything other than the text copied into the output
+// files.  The design then needs to be built again from the start.
+//
+extern	int	patch_design(MAPDHASH &master, std::vector<PARSEJOB> &jobs,
+			unsigned k, MAPDHASH *fresh);
+
+#endif	// PATCH_H
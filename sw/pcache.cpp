@@ -0,0 +1,395 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/pcache.cpp
+//
+// Project:	AutoFPGA, a utility for composing FPGA designs from peripherals
+// {{{
+// Purpose:	To save parsed component files to, and to load them back from,
+//		the parse cache.
+//
+//	Each cache entry is a single file, named by a hash of the path of the
+//	component file and the search path it was parsed with.  It contains:
+//
+//	- A header: the format version, an identifier for the autofpga
+//		executable that wrote it, the path, the search path, and the
+//		hash of the file's contents
+//	- The path and content hash of every file it included
+//	- The parsed MAPDHASH itself.  Expressions are stored as compiled
+//		postfix programs, so they need not be parsed again either.
+//
+//	Entries are written to a temporary file and then renamed, so that a
+//	reader never sees a partially written entry.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <thread>
+#include <functional>
+
+#include "pcache.h"
+#include "mmfile.h"
+#include "ast.h"
+#include "msgs.h"
+
+// Change this any time the format below changes
+#define	PCACHE_VERSION	1
+static const char	PCACHE_MAGIC[4] = { 'A', 'F', 'P', 'C' };
+
+static	STRING		s_dir;
+static	bool		s_enabled = false;
+static	uint64_t	s_toolid = 0;
+
+uint64_t	pcache_hash(const char *data, size_t len) {
+	// 64-bit FNV-1a
+	uint64_t	h = 0xcbf29ce484222325ull;
+
+	for(size_t k=0; k<len; k++) {
+		h ^= (unsigned char)data[k];
+		h *= 0x100000001b3ull;
+	} return h;
+}
+
+void	pcache_open(const char *dir) {
+	struct	stat	sb;
+
+	s_enabled = false;
+
+	// Any rebuild of autofpga invalidates the cache, lest the new build
+	// parse (or compile) something differently
+	if (stat("/proc/self/exe", &sb) != 0) {
+		gbl_msg.warning("Cannot identify autofpga executable, "
+			"parse cache disabled\n");
+		return;
+	}
+	s_toolid = ((uint64_t)sb.st_size << 32) ^ (uint64_t)sb.st_mtime;
+
+	if (0 == stat(dir, &sb)) {
+		if (!S_ISDIR(sb.st_mode)) {
+			gbl_msg.warning("%s is not a directory, "
+				"parse cache disabled\n", dir);
+			return;
+		}
+	} else if (mkdir(dir, 0777) != 0) {
+		gbl_msg.warning("Could not create %s/, parse cache disabled\n",
+			dir);
+		return;
+	}
+
+	s_dir = dir;
+	s_enabled = true;
+}
+
+bool	pcache_enabled(void) {
+	return s_enabled;
+}
+
+static	STRING	entryname(const STRING &path, const STRING &search) {
+	STRING		key = path + STRING(1, '\0') + search;
+	char		buf[24];
+
+	snprintf(buf, sizeof(buf), "%016llx",
+		(unsigned long long)pcache_hash(key.c_str(), key.size()));
+	return s_dir + "/" + buf + ".bin";
+}
+
+////////////////////////////////////////////////////////////////////////
+//
+// Writing
+// {{{
+////////////////////////////////////////////////////////////////////////
+//
+//
+
+static	void	put(STRING &o, const void *p, size_t n) {
+	o.append((const char *)p, n);
+}
+
+static	void	put32(STRING &o, uint32_t v) { put(o, &v, sizeof(v)); }
+static	void	put64(STRING &o, uint64_t v) { put(o, &v, sizeof(v)); }
+
+static	void	putstr(STRING &o, const STRING &s) {
+	put32(o, s.size());
+	o.append(s);
+}
+
+static	void	putast(STRING &o, AST *a) {
+	AST_PROGRAM	*p;
+
+	// Any tree, such as one built by adding two expressions together,
+	// is stored as the program it compiles into
+	if (a->m_node_type == 'P')
+		p = (AST_PROGRAM *)a;
+	else
+		p = new AST_PROGRAM(a);
+
+	put32(o, p->m_insn.size());
+	for(unsigned k=0; k<p->m_insn.size(); k++) {
+		put32(o, p->m_insn[k].m_code);
+		put32(o, p->m_insn[k].m_op);
+		put64(o, p->m_insn[k].m_arg);
+	}
+
+	put32(o, p->m_slots.size());
+	for(unsigned k=0; k<p->m_slots.size(); k++) {
+		putstr(o, *p->m_slots[k].m_id);
+		put32(o, p->m_slots[k].m_def);
+		put32(o, p->m_slots[k].m_v);
+	}
+
+	put32(o, p->m_nundef);
+	put32(o, p->m_depth);
+}
+
+static	void	putmap(STRING &o, MAPDHASH &map) {
+	put32(o, map.size());
+	for(MAPDHASH::iterator kvpair = map.begin(); kvpair != map.end();
+			kvpair++) {
+		MAPT	&elm = kvpair->second;
+
+		putstr(o, kvpair->first);
+		put32(o, elm.m_typ);
+		switch(elm.m_typ) {
+		case MAPT_INT:		put32(o, elm.u.m_v); break;
+		case MAPT_STRING:	putstr(o, *elm.u.m_s); break;
+		case MAPT_MAP:		putmap(o, *elm.u.m_m); break;
+		case MAPT_AST:		putast(o, elm.u.m_a); break;
+		default: assert(0);
+		}
+	}
+}
+
+void	pcache_store(const STRING &path, uint64_t hash,
+		const STRING &search, const std::vector<PCDEP> &deps,
+		MAPDHASH &map) {
+	STRING	o, fname, tmpname;
+	FILE	*fp;
+	bool	ok;
+
+	if (!s_enabled)
+		return;
+
+	put(o, PCACHE_MAGIC, sizeof(PCACHE_MAGIC));
+	put32(o, PCACHE_VERSION);
+	put64(o, s_toolid);
+	putstr(o, path);
+	putstr(o, search);
+	put64(o, hash);
+
+	put32(o, deps.size());
+	for(unsigned k=0; k<deps.size(); k++) {
+		putstr(o, deps[k].m_path);
+		put64(o, deps[k].m_hash);
+	}
+
+	putmap(o, map);
+
+	// Several threads (or processes) may write at once, so each writes
+	// to a file of its own before renaming it into place
+	fname   = entryname(path, search);
+	tmpname = fname + "." + std::to_string(getpid()) + "."
+		+ std::to_string(std::hash<std::thread::id>()(
+					std::this_thread::get_id()));
+
+	if (NULL == (fp = fopen(tmpname.c_str(), "wb")))
+		return;
+	ok = (fwrite(o.data(), 1, o.size(), fp) == o.size());
+	ok = (fclose(fp) == 0) && ok;
+	if ((!ok)||(rename(tmpname.c_str(), fname.c_str()) != 0))
+		unlink(tmpname.c_str());
+}
+// }}}
+
+////////////////////////////////////////////////////////////////////////
+//
+// Reading
+// {{{
+////////////////////////////////////////////////////////////////////////
+//
+//
+
+// A read cursor over a cache entry.  Any attempt to read beyond the end of
+// the entry marks it as bad, rather than failing outright.
+typedef	struct	PCREAD_S {
+	const char	*m_ptr, *m_end;
+	bool		m_bad;
+} PCREAD;
+
+static	bool	get(PCREAD &r, void *p, size_t n) {
+	if ((r.m_bad)||((size_t)(r.m_end - r.m_ptr) < n)) {
+		r.m_bad = true;
+		memset(p, 0, n);
+		return false;
+	}
+
+	memcpy(p, r.m_ptr, n);
+	r.m_ptr += n;
+	return true;
+}
+
+static	uint32_t get32(PCREAD &r) { uint32_t v; get(r, &v, sizeof(v)); return v; }
+static	uint64_t get64(PCREAD &r) { uint64_t v; get(r, &v, sizeof(v)); return v; }
+
+static	STRING	getstr(PCREAD &r) {
+	uint32_t	n = get32(r);
+
+	if ((r.m_bad)||((size_t)(r.m_end - r.m_ptr) < n)) {
+		r.m_bad = true;
+		return STRING();
+	}
+
+	STRING	s(r.m_ptr, n);
+	r.m_ptr += n;
+	return s;
+}
+
+static	AST	*getast(PCREAD &r) {
+	AST_PROGRAM	*p = new AST_PROGRAM();
+	uint32_t	n;
+
+	n = get32(r);
+	for(unsigned k=0; (k<n)&&(!r.m_bad); k++) {
+		AST_PROGRAM::INSN	insn;
+
+		insn.m_code = get32(r);
+		insn.m_op   = get32(r);
+		insn.m_arg  = get64(r);
+		p->m_insn.push_back(insn);
+	}
+
+	n = get32(r);
+	for(unsigned k=0; (k<n)&&(!r.m_bad); k++) {
+		AST_PROGRAM::SLOT	slot;
+
+		slot.m_id  = kvintern(getstr(r));
+		slot.m_def = (get32(r) != 0);
+		slot.m_v   = get32(r);
+		p->m_slots.push_back(slot);
+	}
+
+	p->m_nundef = get32(r);
+	p->m_depth  = get32(r);
+	p->m_stack.resize(p->m_depth);
+	return p;
+}
+
+static	void	getmap(PCREAD &r, MAPDHASH &map) {
+	uint32_t	n = get32(r);
+
+	for(unsigned k=0; (k<n)&&(!r.m_bad); k++) {
+		STRING	key = getstr(r);
+		MAPT	elm;
+
+		elm.m_typ = get32(r);
+		switch(elm.m_typ) {
+		case MAPT_INT:	elm.u.m_v = get32(r); break;
+		case MAPT_STRING:
+			elm.u.m_s = new STRING(getstr(r));
+			break;
+		case MAPT_MAP:
+			elm.u.m_m = new MAPDHASH;
+			getmap(r, *elm.u.m_m);
+			break;
+		case MAPT_AST:	elm.u.m_a = getast(r); break;
+		default:
+			r.m_bad = true;
+			return;
+		}
+
+		map.insert(KEYVALUE(key, elm));
+	}
+}
+
+// Check that a file some entry depends upon remains as it was
+static	bool	unchanged(const STRING &path, uint64_t hash) {
+	MMFILE	mf;
+
+	if (!mf.open(path.c_str()))
+		return false;
+	return (pcache_hash(mf.data(), mf.size()) == hash);
+}
+
+MAPDHASH *pcache_load(const STRING &path, uint64_t hash,
+		const STRING &search, std::vector<PCDEP> &deps) {
+	MMFILE		mf;
+	PCREAD		r;
+	char		magic[sizeof(PCACHE_MAGIC)];
+	MAPDHASH	*map;
+
+	if ((!s_enabled)||(!mf.open(entryname(path, search).c_str())))
+		return NULL;
+
+	r.m_ptr = mf.data();
+	r.m_end = mf.data() + mf.size();
+	r.m_bad = false;
+
+	get(r, magic, sizeof(magic));
+	if ((memcmp(magic, PCACHE_MAGIC, sizeof(magic)) != 0)
+			||(get32(r) != PCACHE_VERSION)
+			||(get64(r) != s_toolid)
+			||(getstr(r) != path)
+			||(getstr(r) != search)
+			||(get64(r) != hash)
+			||(r.m_bad))
+		return NULL;
+
+	// Any included file may have changed since
+	uint32_t	ndeps = get32(r);
+	deps.clear();
+	for(unsigned k=0; k<ndeps; k++) {
+		PCDEP	dep;
+
+		dep.m_path = getstr(r);
+		dep.m_hash = get64(r);
+		if ((r.m_bad)||(!unchanged(dep.m_path, dep.m_hash))) {
+			deps.clear();
+			return NULL;
+		}
+		deps.push_back(dep);
+	}
+
+	map = new MAPDHASH;
+	getmap(r, *map);
+	if ((r.m_bad)||(r.m_ptr != r.m_end)) {
+		delete map;
+		deps.clear();
+		return NULL;
+	}
+
+	gbl_msg.info("Loaded %s from the parse cache\n", path.c_str());
+	return map;
+}
+// }}}
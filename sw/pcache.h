@@ -0,0 +1,74 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/pcache.h
+//
+// Project:	AutoFPGA, a utility for composing FPGA designs from peripherals
+// {{{
+// Purpose:	A persistent, on-disk cache of parsed component files.  Each
+//		file's hash is stored, once parsed, in a compact binary form.
+//	So long as neither the file, nor anything it includes, nor autofpga
+//	itself changes, later runs may then load the hash rather than parsing
+//	the file again.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	PCACHE_H
+#define	PCACHE_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "mapdhash.h"
+
+// A file a cached hash depends upon, such as one named by @INCLUDEFILE
+typedef	struct	PCDEP_S {
+	STRING		m_path;
+	uint64_t	m_hash;
+} PCDEP;
+
+// Cache parsed files within the given directory, creating it if need be.
+// The cache is disabled until this is called.
+extern	void	pcache_open(const char *dir);
+extern	bool	pcache_enabled(void);
+
+// The hash used to tell if a file's contents have changed
+extern	uint64_t	pcache_hash(const char *data, size_t len);
+
+// Return the cached hash of the file at path, provided the file (whose
+// contents hash to hash) and everything it depended upon remain unchanged.
+// Otherwise, return NULL.  The files it depended upon are returned in deps.
+extern	MAPDHASH *pcache_load(const STRING &path, uint64_t hash,
+			const STRING &search, std::vector<PCDEP> &deps);
+extern	void	pcache_store(const STRING &path, uint64_t hash,
+			const STRING &search, const std::vector<PCDEP> &deps,
+			MAPDHASH &map);
+
+#endif	// PCACHE_H
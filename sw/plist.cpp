@@ -279,9 +279,9 @@ bool	compare_naddr(PERIPHP a, PERIPHP b) {
 	if ((a->p_name)&&(b->p_name))
 		return (a->p_name->compare(*b->p_name) < 0) ? true:false;
 	else if (!a->p_name)
-		return true;
+		return (b->p_name) ? true : false;
 	else
-		return true;
+		return false;
 }
 
 bool	compare_address(PERIPHP a, PERIPHP b) {
@@ -432,7 +432,34 @@ void	PLIST::assign_addresses(unsigned dwidth, unsigned nullsz,
 		else
 			m_address_width = 0;
 		return;
-	} else if ((size() < 2)&&(nullsz == 0)) {
+	}
+
+	PACKOBJ	packing = PACK_SEQUENTIAL;
+	bool	fixed = false;
+	STRINGP	strp;
+
+	// The bus may ask for its peripherals to be packed by some other
+	// measure than the sequential layout below
+	assert((*this)[0]->p_slave_bus);
+	strp = getstring((*this)[0]->p_slave_bus->m_hash, KY_PACKING);
+	if ((strp)&&(!packing_objective(*strp, packing))) {
+		// The SIO and DIO lists share their parent's setting, so only
+		// complain about it once
+		if (this == (*this)[0]->p_slave_bus->m_plist)
+			gbl_msg.error("Unknown address packing, %s, "
+				"for the %s bus\n", strp->c_str(),
+				(*this)[0]->p_slave_bus->name()->c_str());
+		packing = PACK_SEQUENTIAL;
+	}
+
+	for(iterator p=begin(); p!=end(); p++) {
+		int	base;
+
+		if (getvalue(*(*p)->p_phash, KYSLAVE_BASE, base))
+			fixed = true;
+	}
+
+	if ((size() < 2)&&(nullsz == 0)&&(!fixed)) {
 		PERIPHP	p = (*this)[0];
 		MAPDHASH	*ph = p->p_phash;
 		GENBUS		*g = p->p_slave_bus->generator();
@@ -459,8 +486,11 @@ void	PLIST::assign_addresses(unsigned dwidth, unsigned nullsz,
 			if (!getstring(*ph, KYSLAVE_ANSPREFIX))
 				setstring(*ph, KYSLAVE_ANSPREFIX,
 							g->slave_ansprefix(p));
-			reeval(*ph);
+			kvqueue(*ph);
 		}
+	} else if (PACK_SEQUENTIAL != packing) {
+		assign_packed_addresses(daddr_abits, nullsz,
+			bus_min_address_width, packing);
 	} else {
 		bool	m_full_decode = false;
 
@@ -480,7 +510,16 @@ void	PLIST::assign_addresses(unsigned dwidth, unsigned nullsz,
 		// Sort our peripherals by the number of address lines they
 		// will be using.  At the end of this, we'll know that we'll
 		// need a minimum of (*p)[p->size()-1]->p_awid+1 address lines.
-		sort(begin(), end(), compare_naddr);
+		// Sort stably, so that any ties are left in their original
+		// (command line) order
+		stable_sort(begin(), end(), compare_naddr);
+
+		// Any peripherals asking for a fixed address keep it, and
+		// everything else is placed around them
+		std::vector<PACKITEM>	items(size());
+		unsigned long		end_address;
+
+		get_fixed_bases(daddr_abits, nullsz, items);
 
 		//
 		// We've got two Goals:
@@ -556,7 +595,10 @@ void	PLIST::assign_addresses(unsigned dwidth, unsigned nullsz,
 			// required to address one octet of this peripheral.
 			pfull=(*this)[i]->get_slave_address_width()+daddr_abits;
 			pa = pfull;
-			if (pa <= 0) {
+			if (items[i].m_fixed) {
+				(*this)[i]->p_base = items[i].m_base;
+				(*this)[i]->p_mask = (~0ul)<<(pfull-daddr_abits);
+			} else if (pa <= 0) {
 				// p_base is in octets
 				(*this)[i]->p_base = start_address;
 				(*this)[i]->p_mask = 0;
@@ -578,6 +620,27 @@ void	PLIST::assign_addresses(unsigned dwidth, unsigned nullsz,
 				// range
 				(*this)[i]->p_base &= (-1l<<pa);
 				//
+				// Skip past any fixed peripheral in the way
+				for(unsigned k=0; k<size(); k++) {
+					unsigned long	base=(*this)[i]->p_base,
+							fend;
+
+					if (!items[k].m_fixed)
+						continue;
+					fend = items[k].m_base
+						+ (1ul << items[k].m_lgsize);
+					if ((base >= fend)||(items[k].m_base
+							>= base + (1ul<<pa)))
+						continue;
+					(*this)[i]->p_base
+						= (fend + ((1ul<<pa)-1))
+							& (-1l<<pa);
+					// Start over, in case this new base
+					// overlaps a fixed peripheral already
+					// checked
+					k = (unsigned)-1;
+				}
+				//
 				// Now, advance the start address to the next
 				// open address after this peripheral
 				start_address = (*this)[i]->p_base + (1ul<<pa);
@@ -596,47 +659,195 @@ void	PLIST::assign_addresses(unsigned dwidth, unsigned nullsz,
 		}
 		assert(start_address != 0);
 
-		unsigned master_mask = nextlg(start_address);
-		master_mask = (1u << (master_mask-daddr_abits))-1;
+		// A fixed peripheral may lie beyond everything else
+		end_address = start_address;
+		for(unsigned k=0; k<size(); k++) {
+			unsigned long	fend = items[k].m_base
+						+ (1ul << items[k].m_lgsize);
+			if ((items[k].m_fixed)&&(fend > end_address))
+				end_address = fend;
+		}
 
-		// One more pass, now that we know the last address
-		for(unsigned i=0; i<size(); i++) {
+		unsigned master_mask = nextlg(end_address);
+		master_mask = (unsigned)((1ul << (master_mask-daddr_abits))-1);
 
-			//
-			// Trim the bits necessary to express the relevant
-			// bits of this address
-			(*this)[i]->p_mask &= master_mask;
-
-			gbl_msg.info("  %20s -> %08lx & 0x%08lx\n",
-					(*this)[i]->p_name->c_str(),
-					(*this)[i]->p_base,
-					(*this)[i]->p_mask << daddr_abits);
-
-			if ((*this)[i]->p_phash) {
-				PERIPHP	p = (*this)[i];
-				MAPDHASH	*ph = p->p_phash;
-				GENBUS		*g = p->p_slave_bus->generator();
-				setvalue(*ph, KYBASE, p->p_base);
-				setvalue(*ph, KYMASK, p->p_mask << daddr_abits);
-				if (g) {
-					setstring(*ph, KYSLAVE_PORTLIST,
-						g->slave_portlist(p));
-					setstring(*ph, KYSLAVE_ANSIPORTLIST,
-						g->slave_ansi_portlist(p));
-					if (!getstring(*ph, KYSLAVE_IANSI))
-						setstring(*ph, KYSLAVE_IANSI,
-							g->iansi(NULL));
-					if (!getstring(*ph, KYSLAVE_OANSI))
-						setstring(*ph, KYSLAVE_OANSI,
-							g->oansi(NULL));
-					if (!getstring(*ph, KYSLAVE_ANSPREFIX))
-						setstring(*ph, KYSLAVE_ANSPREFIX,
-							g->slave_ansprefix(p));
-					reeval(*ph);
-				}
-			}
-		} m_address_width = nextlg(start_address)-daddr_abits;
+		set_address_keys(daddr_abits, master_mask);
+		m_address_width = nextlg(end_address)-daddr_abits;
 	}
 
+	// Each peripheral changed above has been queued for evaluation.  Now
+	// evaluate them all together, along with anything depending upon them
 	reeval(gbl_hash);
 }
+
+//
+// set_address_keys
+// {{{
+// Once every peripheral has a base address and mask, and so we know the last
+// address used, trim each mask down to the bits that matter and record the
+// results in each peripheral's hash
+//
+void	PLIST::set_address_keys(unsigned daddr_abits, unsigned master_mask) {
+	for(unsigned i=0; i<size(); i++) {
+
+		//
+		// Trim the bits necessary to express the relevant
+		// bits of this address
+		(*this)[i]->p_mask &= master_mask;
+
+		gbl_msg.info("  %20s -> %08lx & 0x%08lx\n",
+				(*this)[i]->p_name->c_str(),
+				(*this)[i]->p_base,
+				(*this)[i]->p_mask << daddr_abits);
+
+		if ((*this)[i]->p_phash) {
+			PERIPHP	p = (*this)[i];
+			MAPDHASH	*ph = p->p_phash;
+			GENBUS		*g = p->p_slave_bus->generator();
+			setvalue(*ph, KYBASE, p->p_base);
+			setvalue(*ph, KYMASK, p->p_mask << daddr_abits);
+			if (g) {
+				setstring(*ph, KYSLAVE_PORTLIST,
+					g->slave_portlist(p));
+				setstring(*ph, KYSLAVE_ANSIPORTLIST,
+					g->slave_ansi_portlist(p));
+				if (!getstring(*ph, KYSLAVE_IANSI))
+					setstring(*ph, KYSLAVE_IANSI,
+						g->iansi(NULL));
+				if (!getstring(*ph, KYSLAVE_OANSI))
+					setstring(*ph, KYSLAVE_OANSI,
+						g->oansi(NULL));
+				if (!getstring(*ph, KYSLAVE_ANSPREFIX))
+					setstring(*ph, KYSLAVE_ANSPREFIX,
+						g->slave_ansprefix(p));
+				kvqueue(*ph);
+			}
+		}
+	}
+}
+// }}}
+
+//
+// get_fixed_bases
+// {{{
+// Size every peripheral, in octets, and check any request for a fixed base
+// address, given in octets by @SLAVE.BASE.  Requests that can't be honored
+// generate an error, and the peripheral is then placed as though it had
+// made no request.
+//
+void	PLIST::get_fixed_bases(unsigned daddr_abits, unsigned nullsz,
+		std::vector<PACKITEM> &items) {
+	for(unsigned i=0; i<size(); i++) {
+		PERIPHP		p = (*this)[i];
+		PACKITEM	&item = items[i];
+		int		base;
+
+		item.m_lgsize = p->get_slave_address_width() + daddr_abits;
+		item.m_fixed  = false;
+		item.m_base   = 0;
+		if (!getvalue(*p->p_phash, KYSLAVE_BASE, base))
+			continue;
+
+		item.m_base = (unsigned)base;
+		if (0 != (item.m_base & ((1ul << item.m_lgsize)-1))) {
+			gbl_msg.error("%s.BASE (0x%08lx) is not aligned to "
+				"the size of %s (0x%lx)\n",
+				p->p_name->c_str(), item.m_base,
+				p->p_name->c_str(), 1ul << item.m_lgsize);
+		} else if (item.m_base < nullsz) {
+			gbl_msg.error("%s.BASE (0x%08lx) is within the "
+				"null address range (0x%x)\n",
+				p->p_name->c_str(), item.m_base, nullsz);
+		} else {
+			item.m_fixed = true;
+			for(unsigned k=0; k<i; k++) {
+				if ((!items[k].m_fixed)
+					||(item.m_base >= items[k].m_base
+						+ (1ul << items[k].m_lgsize))
+					||(items[k].m_base >= item.m_base
+						+ (1ul << item.m_lgsize)))
+					continue;
+				gbl_msg.error("%s.BASE (0x%08lx) overlaps "
+					"%s at 0x%08lx\n",
+					p->p_name->c_str(), item.m_base,
+					(*this)[k]->p_name->c_str(),
+					items[k].m_base);
+				item.m_fixed = false;
+				break;
+			}
+		}
+
+		if (!item.m_fixed)
+			item.m_base = 0;
+	}
+
+}
+// }}}
+
+//
+// assign_packed_addresses
+// {{{
+// Place this bus's peripherals using the address packing engine, rather than
+// the sequential layout in assign_addresses().  Any fixed base addresses are
+// checked by get_fixed_bases(), and the packer places everything else around
+// them.
+//
+void	PLIST::assign_packed_addresses(unsigned daddr_abits, unsigned nullsz,
+		unsigned bus_min_address_width, PACKOBJ packing) {
+	std::vector<PACKITEM>	items(size());
+	unsigned	awid, master_mask;
+	BUSINFO		*bi = (*this)[0]->p_slave_bus;
+	bool		widen = true;
+
+	if (!bi->word_addressing())
+		daddr_abits = 0;
+
+	// A sub-bus, to include any SIO or DIO list, is sized before its
+	// parent lays out the room it's given, and so must not ask for any
+	// more of that room than it needs.  Only a bus with no parent may be
+	// made wider to shrink its address decoders.
+	if (this != bi->m_plist)
+		widen = false;
+	else if (bi->m_mlist) {
+		for(unsigned k=0; k<bi->m_mlist->size(); k++) {
+			MAPDHASH	*mh = (*bi->m_mlist)[k]->m_hash;
+
+			if ((mh)&&((issubbus(*mh))||(find_bus(mh))))
+				widen = false;
+		}
+	}
+
+	for(unsigned i=0; i<size(); i++) {
+		// Sizing a sub-bus assigns its addresses, and so must come
+		// before checking its NADDR
+		(void)(*this)[i]->get_slave_address_width();
+		if ((*this)[i]->naddr() <= 0) {
+			gbl_msg.error("Slave %s has zero "
+				"NADDR (now address assigned)\n",
+				(*this)[i]->p_name->c_str());
+		}
+	}
+
+	get_fixed_bases(daddr_abits, nullsz, items);
+
+	if (!pack_addresses(items, nullsz, bus_min_address_width, widen,
+				packing, awid)) {
+		gbl_msg.fatal("The peripherals of the %s bus will not fit "
+			"within a 32-bit address space\n",
+			bi->name()->c_str());
+	}
+
+	for(unsigned i=0; i<size(); i++) {
+		(*this)[i]->p_base = items[i].m_base;
+		(*this)[i]->p_mask = (~0ul)<<(items[i].m_lgregion-daddr_abits);
+	}
+
+	// Keep the list in address order, as the sequential layout leaves it
+	stable_sort(begin(), end(), compare_address);
+
+	// A full 32-bit bus would shift a 32-bit one by its own width
+	master_mask = (unsigned)((1ul << (awid-daddr_abits))-1);
+	set_address_keys(daddr_abits, master_mask);
+	m_address_width = awid - daddr_abits;
+}
+// }}}
@@ -44,6 +44,7 @@
 #include <vector>
 
 #include "parser.h"
+#include "addrpack.h"
 
 class	BUSINFO;
 
@@ -89,6 +90,13 @@ typedef	PERIPH *PERIPHP;
 
 class	PLIST : public std::vector<PERIPHP> {
 	unsigned	m_address_width;
+
+	void	get_fixed_bases(unsigned daddr_abits, unsigned nullsz,
+				std::vector<PACKITEM> &items);
+	void	assign_packed_addresses(unsigned daddr_abits,
+				unsigned nullsz, unsigned bus_min_address_width,
+				PACKOBJ packing);
+	void	set_address_keys(unsigned daddr_abits, unsigned master_mask);
 public:
 	PLIST(void) {}
 	STRINGP		m_stype;
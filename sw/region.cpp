@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/region.cpp
+//
+// Project:	AutoFPGA, a utility for composing FPGA designs from peripherals
+// {{{
+// Purpose:	Implements the REGION allocator
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdlib.h>
+#include <cstddef>
+#include <new>
+
+#include "region.h"
+
+// Regions grow RGBLOCK bytes at a time.  Any request larger than a quarter
+// of that gets a block of its own.
+#define	RGBLOCK	(64*1024)
+#define	RGALIGN	(alignof(std::max_align_t))
+
+REGION	gbl_region;
+
+void	*REGION::alloc(size_t sz) {
+	std::lock_guard<std::mutex>	guard(m_lock);
+	char	*r;
+
+	sz = (sz + RGALIGN-1) & ~(RGALIGN-1);
+	m_used += sz;
+
+	if (sz > RGBLOCK/4) {
+		// Put large allocations in front of the current block, so
+		// as not to waste what's left of it
+		if (NULL == (r = (char *)malloc(sz)))
+			throw std::bad_alloc();
+		m_blocks.insert(m_blocks.begin(), r);
+		return r;
+	}
+
+	if (sz > m_left) {
+		if (NULL == (m_ptr = (char *)malloc(RGBLOCK)))
+			throw std::bad_alloc();
+		m_blocks.push_back(m_ptr);
+		m_left = RGBLOCK;
+	}
+
+	r = m_ptr;
+	m_ptr  += sz;
+	m_left -= sz;
+	return r;
+}
+
+void	REGION::release(void) {
+	std::lock_guard<std::mutex>	guard(m_lock);
+
+	for(unsigned k=0; k<m_blocks.size(); k++)
+		free(m_blocks[k]);
+	m_blocks.clear();
+	m_ptr  = NULL;
+	m_left = 0;
+	m_used = 0;
+	m_generation++;
+}
@@ -0,0 +1,75 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/region.h
+//
+// Project:	AutoFPGA, a utility for composing FPGA designs from peripherals
+// {{{
+// Purpose:	A region (arena) allocator.  Objects allocated from a region
+//		are never freed individually.  Instead, the whole region is
+//	released at once, once whatever was built within it (an expression
+//	tree, for example) is no longer needed.  Allocation is then little
+//	more than a pointer increment.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	REGION_H
+#define	REGION_H
+
+#include <stdlib.h>
+#include <vector>
+#include <mutex>
+
+class	REGION {
+	std::mutex		m_lock;
+	std::vector<char *>	m_blocks;
+	char	*m_ptr;
+	size_t	m_left, m_used;
+	unsigned	m_generation;
+public:
+	REGION(void) : m_ptr(NULL), m_left(0), m_used(0), m_generation(0) {}
+	~REGION(void) { release(); }
+
+	// Safe to call from any thread
+	void	*alloc(size_t sz);
+	// Bytes allocated from this region since it was last released
+	size_t	used(void) const { return m_used; }
+	// Counts releases, so that anything caching pointers into the region
+	// can tell when those pointers are no longer valid
+	unsigned generation(void) const { return m_generation; }
+	// Release everything allocated from this region, all at once
+	void	release(void);
+};
+
+// The region used for everything built while processing a design, such
+// as the expression trees.
+extern	REGION	gbl_region;
+
+#endif	// REGION_H
@@ -0,0 +1,331 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/stats.cpp
+//
+// Project:	AutoFPGA, a utility for composing FPGA designs from peripherals
+// {{{
+// Purpose:	To count calls, time, and heap allocations for each phase of
+//		processing a design, and to report them.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+#include <new>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "stats.h"
+
+typedef	struct	STATREC_S {
+	std::string	m_name;
+	unsigned long	m_calls, m_nsec, m_nalloc, m_nbytes, m_iterations;
+} STATREC;
+
+static	bool	s_enabled = false;
+static	std::mutex	s_lock;
+static	std::vector<STATREC>	s_recs;
+static	std::unordered_map<std::string, int>	s_index;
+
+//
+// Heap allocations
+// {{{
+// Every operator new is counted (once stats are enabled), from whatever
+// thread it is called on.  Those allocations made while a phase is running
+// are then charged to that phase.  Nested phases are each charged for
+// everything within them, just as they are for their time.
+//
+static	std::atomic<unsigned long>	s_nalloc(0), s_nbytes(0);
+
+void	*operator new(size_t sz) {
+	void	*p;
+
+	if (s_enabled) {
+		s_nalloc.fetch_add(1, std::memory_order_relaxed);
+		s_nbytes.fetch_add(sz, std::memory_order_relaxed);
+	}
+
+	if (NULL == (p = malloc((sz) ? sz : 1)))
+		throw std::bad_alloc();
+	return p;
+}
+
+void	*operator new[](size_t sz) {
+	return operator new(sz);
+}
+
+void	operator delete(void *p) noexcept {
+	free(p);
+}
+
+void	operator delete[](void *p) noexcept {
+	free(p);
+}
+// }}}
+
+static	unsigned long	nsec_now(void) {
+	struct	timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000ul + ts.tv_nsec;
+}
+
+// Find (or create) the record for a given phase, returning its index
+static	int	stats_id(const std::string &name) {
+	std::lock_guard<std::mutex>	guard(s_lock);
+	std::unordered_map<std::string, int>::iterator	it;
+
+	it = s_index.find(name);
+	if (it != s_index.end())
+		return it->second;
+
+	STATREC	rec;
+	rec.m_name  = name;
+	rec.m_calls = rec.m_nsec = rec.m_nalloc = rec.m_nbytes = 0;
+	rec.m_iterations = 0;
+	s_recs.push_back(rec);
+	s_index[name] = s_recs.size()-1;
+	return s_recs.size()-1;
+}
+
+STATPHASE::STATPHASE(const char *name, const char *detail) {
+	m_id = -1;
+	if (!s_enabled)
+		return;
+
+	std::string	str = name;
+	if (detail) {
+		str += " ";
+		str += detail;
+	}
+
+	m_id = stats_id(str);
+	m_iterations = 0;
+	m_nalloc = s_nalloc.load(std::memory_order_relaxed);
+	m_nbytes = s_nbytes.load(std::memory_order_relaxed);
+	m_start  = nsec_now();
+}
+
+STATPHASE::STATPHASE(const char *name, const char *file, int line) {
+	m_id = -1;
+	if (!s_enabled)
+		return;
+
+	char	site[32];
+	std::string	str = name;
+
+	snprintf(site, sizeof(site), ":%d", line);
+	str = str + " " + file + site;
+
+	m_id = stats_id(str);
+	m_iterations = 0;
+	m_nalloc = s_nalloc.load(std::memory_order_relaxed);
+	m_nbytes = s_nbytes.load(std::memory_order_relaxed);
+	m_start  = nsec_now();
+}
+
+STATPHASE::~STATPHASE(void) {
+	if (m_id < 0)
+		return;
+
+	unsigned long	nsec = nsec_now() - m_start,
+			nalloc = s_nalloc.load(std::memory_order_relaxed),
+			nbytes = s_nbytes.load(std::memory_order_relaxed);
+
+	std::lock_guard<std::mutex>	guard(s_lock);
+	STATREC	&rec = s_recs[m_id];
+
+	rec.m_calls++;
+	rec.m_nsec   += nsec;
+	rec.m_nalloc += nalloc - m_nalloc;
+	rec.m_nbytes += nbytes - m_nbytes;
+	rec.m_iterations += m_iterations;
+}
+
+void	stats_enable(void) {
+	s_enabled = true;
+}
+
+bool	stats_enabled(void) {
+	return s_enabled;
+}
+
+void	stats_reset(void) {
+	std::lock_guard<std::mutex>	guard(s_lock);
+
+	s_recs.clear();
+	s_index.clear();
+}
+
+//
+// stats_send, stats_receive
+// {{{
+// Each record is sent as one line of tab separated fields, the name first.
+// The receiver adds these to its own records of the same name.
+//
+void	stats_send(int fd) {
+	std::string	msg;
+	char		line[128];
+
+	{
+		std::lock_guard<std::mutex>	guard(s_lock);
+
+		for(unsigned k=0; k<s_recs.size(); k++) {
+			snprintf(line, sizeof(line), "\t%lu\t%lu\t%lu\t%lu\t%lu\n",
+				s_recs[k].m_calls, s_recs[k].m_nsec,
+				s_recs[k].m_nalloc, s_recs[k].m_nbytes,
+				s_recs[k].m_iterations);
+			msg += s_recs[k].m_name;
+			msg += line;
+		}
+	}
+
+	for(size_t pos = 0; pos < msg.size(); ) {
+		ssize_t	nw = write(fd, msg.c_str() + pos, msg.size() - pos);
+		if (nw <= 0)
+			break;
+		pos += nw;
+	}
+}
+
+void	stats_receive(int fd) {
+	std::string	msg;
+	char		buf[4096];
+	ssize_t		nr;
+
+	while((nr = read(fd, buf, sizeof(buf))) > 0)
+		msg.append(buf, nr);
+
+	size_t	pos = 0, eol;
+	while(std::string::npos != (eol = msg.find('\n', pos))) {
+		std::string	line = msg.substr(pos, eol-pos);
+		size_t		tab = line.find('\t');
+		unsigned long	calls, nsec, nalloc, nbytes, niter;
+
+		pos = eol+1;
+		if (std::string::npos == tab)
+			continue;
+		if (5 != sscanf(line.c_str()+tab, "%lu %lu %lu %lu %lu",
+				&calls, &nsec, &nalloc, &nbytes, &niter))
+			continue;
+
+		int	id = stats_id(line.substr(0, tab));
+		std::lock_guard<std::mutex>	guard(s_lock);
+		STATREC	&rec = s_recs[id];
+		rec.m_calls  += calls;
+		rec.m_nsec   += nsec;
+		rec.m_nalloc += nalloc;
+		rec.m_nbytes += nbytes;
+		rec.m_iterations += niter;
+	}
+}
+// }}}
+
+// The larger of our own peak, and that of any child we've waited on
+static	long	max_rss_kb(void) {
+	struct	rusage	usage;
+	long	rss = 0;
+
+	if (0 == getrusage(RUSAGE_SELF, &usage))
+		rss = usage.ru_maxrss;
+	if ((0 == getrusage(RUSAGE_CHILDREN, &usage))&&(usage.ru_maxrss > rss))
+		rss = usage.ru_maxrss;
+	return rss;
+}
+
+//
+// stats_report
+// {{{
+// A table, one line per phase, in the order each phase was first entered.
+// Times (and allocations) of nested phases are included within those of the
+// phases around them.
+//
+void	stats_report(FILE *fp) {
+	std::lock_guard<std::mutex>	guard(s_lock);
+	unsigned	width = 5;
+
+	for(unsigned k=0; k<s_recs.size(); k++)
+		if (s_recs[k].m_name.size() > width)
+			width = s_recs[k].m_name.size();
+
+	fprintf(fp, "%-*s %8s %12s %10s %12s %10s\n", width, "PHASE",
+		"CALLS", "WALL(ms)", "ALLOCS", "ALLOC(kB)", "ITERS");
+	for(unsigned k=0; k<s_recs.size(); k++) {
+		const STATREC	&rec = s_recs[k];
+
+		fprintf(fp, "%-*s %8lu %12.3f %10lu %12lu ", width,
+			rec.m_name.c_str(), rec.m_calls, rec.m_nsec / 1e6,
+			rec.m_nalloc, (rec.m_nbytes + 1023) / 1024);
+		if (rec.m_iterations > 0)
+			fprintf(fp, "%10lu\n", rec.m_iterations);
+		else
+			fprintf(fp, "%10s\n", "-");
+	}
+	fprintf(fp, "Peak RSS: %ld kB\n", max_rss_kb());
+}
+// }}}
+
+//
+// stats_json
+// {{{
+// The same, as a JSON object that scripts can compare from one run (or one
+// version) to the next.
+//
+void	stats_json(FILE *fp) {
+	std::lock_guard<std::mutex>	guard(s_lock);
+
+	fprintf(fp, "{\n\t\"max_rss_kb\": %ld,\n\t\"phases\": [", max_rss_kb());
+	for(unsigned k=0; k<s_recs.size(); k++) {
+		const STATREC	&rec = s_recs[k];
+
+		fprintf(fp, "%s\n\t\t{ \"name\": \"", (k > 0) ? ",":"");
+		for(const char *ptr = rec.m_name.c_str(); *ptr; ptr++) {
+			if ((*ptr == '\"')||(*ptr == '\\'))
+				fputc('\\', fp);
+			fputc(*ptr, fp);
+		}
+		fprintf(fp, "\", \"calls\": %lu, \"wall_us\": %.1f, "
+			"\"allocs\": %lu, \"alloc_bytes\": %lu, "
+			"\"iterations\": %lu }",
+			rec.m_calls, rec.m_nsec / 1e3, rec.m_nalloc,
+			rec.m_nbytes, rec.m_iterations);
+	}
+	fprintf(fp, "\n\t]\n}\n");
+}
+// }}}
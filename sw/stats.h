@@ -0,0 +1,75 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/stats.h
+//
+// Project:	AutoFPGA, a utility for composing FPGA designs from peripherals
+// {{{
+// Purpose:	To measure where the time goes.  Each phase of processing a
+//		design is wrapped in a STATPHASE, which counts the calls to
+//	that phase, the wall clock time spent within it, and the heap
+//	allocations made while it ran.  With --stats, these are reported once
+//	the design is built, both as a table and (optionally) as JSON.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	STATS_H
+#define	STATS_H
+
+#include <stdio.h>
+
+class	STATPHASE {
+	int	m_id;
+	unsigned long	m_start, m_nalloc, m_nbytes, m_iterations;
+public:
+	// Times the phase from now until this object is destroyed.  Nothing
+	// is measured unless stats_enable() has been called.
+	STATPHASE(const char *name, const char *detail = NULL);
+	// As above, for a phase named after the source line it is called from
+	STATPHASE(const char *name, const char *file, int line);
+	~STATPHASE(void);
+
+	// Adds to the count of iterations this phase took
+	void	iterations(unsigned long n) { m_iterations += n; }
+};
+
+extern	void	stats_enable(void);
+extern	bool	stats_enabled(void);
+// Forget everything measured so far
+extern	void	stats_reset(void);
+
+// Pass what a child process measured back to its parent
+extern	void	stats_send(int fd);
+extern	void	stats_receive(int fd);
+
+extern	void	stats_report(FILE *fp);
+extern	void	stats_json(FILE *fp);
+
+#endif	// STATS_H
@@ -0,0 +1,135 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/watch.cpp
+//
+// Project:	AutoFPGA, a utility for composing FPGA designs from peripherals
+// {{{
+// Purpose:	To wait for any of a set of input files to change.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/inotify.h>
+
+#include <algorithm>
+
+#include "watch.h"
+
+// How long to keep collecting events, once the first has arrived.  Saving
+// a file often takes several steps, and several files may be saved at once.
+#define	WATCH_SETTLE_MS	100
+
+#define	WATCH_EVENTS	(IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE)
+
+WATCHER::~WATCHER(void) {
+	if (m_fd >= 0)
+		close(m_fd);
+}
+
+bool	WATCHER::open(void) {
+	m_fd = inotify_init1(IN_CLOEXEC);
+	return (m_fd >= 0);
+}
+
+void	WATCHER::add(const STRING &path) {
+	size_t	pos = path.rfind('/');
+	STRING	dir;
+	int	wd;
+
+	if (pos != STRING::npos)
+		dir = path.substr(0, (pos == 0) ? 1 : pos);
+
+	// The same directory always gets the same wd, no matter how it's named
+	wd = inotify_add_watch(m_fd, (dir.size() > 0) ? dir.c_str() : ".",
+			WATCH_EVENTS);
+	if (wd < 0)
+		return;
+
+	std::vector<STRING>	&names = m_dirs[wd];
+	if (std::find(names.begin(), names.end(), dir) == names.end())
+		names.push_back(dir);
+}
+
+void	WATCHER::events(const char *buf, size_t len,
+		std::vector<STRING> &changed) {
+	const char	*ptr = buf;
+
+	while(ptr < buf + len) {
+		const struct inotify_event *ev
+			= (const struct inotify_event *)ptr;
+
+		if ((ev->len > 0)&&(m_dirs.count(ev->wd) > 0)) {
+			std::vector<STRING>	&names = m_dirs[ev->wd];
+
+			for(unsigned k=0; k<names.size(); k++) {
+				const STRING	&dir = names[k];
+				STRING		path;
+
+				if (dir.size() == 0)
+					path = ev->name;
+				else if (dir[dir.size()-1] == '/')
+					path = dir + ev->name;
+				else
+					path = dir + "/" + ev->name;
+
+				if (std::find(changed.begin(), changed.end(),
+						path) == changed.end())
+					changed.push_back(path);
+			}
+		}
+
+		ptr += sizeof(struct inotify_event) + ev->len;
+	}
+}
+
+void	WATCHER::wait(std::vector<STRING> &changed) {
+	alignas(struct inotify_event) char	buf[8192];
+	struct	pollfd	pfd;
+	ssize_t		nr;
+
+	changed.clear();
+	pfd.fd = m_fd;
+	pfd.events = POLLIN;
+
+	// Wait, as long as it takes, for the first event, and then for
+	// everything else to settle
+	if (poll(&pfd, 1, -1) <= 0)
+		return;
+	do {
+		if ((nr = read(m_fd, buf, sizeof(buf))) <= 0)
+			break;
+		events(buf, nr, changed);
+	} while(poll(&pfd, 1, WATCH_SETTLE_MS) > 0);
+}
@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/watch.h
+//
+// Project:	AutoFPGA, a utility for composing FPGA designs from peripherals
+// {{{
+// Purpose:	Watches a set of input files, using inotify, and reports which
+//		of them have changed.  Used by autofpga --watch.
+//
+//	It is the directories holding the files that are actually watched.
+//	Many editors save a file by writing a new one and renaming it over
+//	the old, and a watch on the old file would be lost when they do.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	WATCH_H
+#define	WATCH_H
+
+#include <vector>
+#include <unordered_map>
+
+#include "mapdhash.h"
+
+class	WATCHER {
+	int	m_fd;
+	// The directory names each watch descriptor was added under
+	std::unordered_map<int, std::vector<STRING> >	m_dirs;
+
+	void	events(const char *buf, size_t len,
+			std::vector<STRING> &changed);
+public:
+	WATCHER(void) : m_fd(-1) {}
+	~WATCHER(void);
+
+	bool	open(void);
+	// Watch for changes to the file at path.  Adding a file twice is
+	// harmless.
+	void	add(const STRING &path);
+	// Block until one or more watched files change, and return the
+	// paths (as given to add()) of everything that has
+	void	wait(std::vector<STRING> &changed);
+};
+
+#endif	// WATCH_H